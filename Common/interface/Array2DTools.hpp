@@ -34,6 +34,8 @@
 namespace Diligent
 {
 
+struct IThreadPool;
+
 /// Computes the minimum and the maximum value in a 2D floating-point array
 
 /// \param[in]  pData		   - A pointer to the array data.
@@ -42,11 +44,13 @@ namespace Diligent
 /// \param[in]  Height		   - 2D array height.
 /// \param[out] MinValue	   - Minimum value.
 /// \param[out] MaxValue	   - Maximum value.
+/// \param[in]  pThreadPool	   - Optional thread pool to process the rows in parallel.
 void GetArray2DMinMaxValue(const float* pData,
                            size_t       StrideInFloats,
                            Uint32       Width,
                            Uint32       Height,
                            float&       MinValue,
-                           float&       MaxValue);
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool = nullptr);
 
 } // namespace Diligent
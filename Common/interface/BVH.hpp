@@ -0,0 +1,411 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Bounding volume hierarchy.
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+struct IThreadPool;
+
+/// Bounding volume hierarchy create information
+struct BVHCreateInfo
+{
+    /// A pointer to the array of NumPrimitives primitive bounding boxes.
+    const BoundBox* pBoxes = nullptr;
+
+    /// The number of primitives.
+    Uint32 NumPrimitives = 0;
+
+    /// The maximum number of primitives in a leaf node.
+
+    /// \remarks    Leaf nodes may contain fewer primitives if the surface area
+    ///             heuristic indicates that splitting the node is beneficial.
+    Uint32 MaxLeafSize = 4;
+
+    /// The number of bins used to evaluate the surface area heuristic, must be in [2, 32] range.
+    Uint32 NumBins = 16;
+
+    /// An optional thread pool to build the hierarchy in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Bounding volume hierarchy of axis-aligned bounding boxes.
+
+/// The hierarchy is built using the binned surface area heuristic (SAH) and
+/// is stored as a flat array of nodes in depth-first order: the first child of an
+/// inner node immediately follows the node, and the node keeps the index of the second child.
+///
+/// The hierarchy only keeps the primitive indices, and the query handlers are responsible
+/// for testing the actual primitives (triangles, meshes, etc.).
+class BVH
+{
+public:
+    /// Hierarchy node.
+    struct Node
+    {
+        /// Node bounding box min corner.
+        float3 Min;
+
+        /// For an inner node, the index of the second child (the first child immediately
+        /// follows the node). For a leaf node, the index of the first primitive in the
+        /// primitive index array, see GetPrimitiveIndices().
+        Uint32 Offset = 0;
+
+        /// Node bounding box max corner.
+        float3 Max;
+
+        /// The number of primitives in the leaf node, or zero for an inner node.
+        Uint32 NumPrimitives = 0;
+
+        bool IsLeaf() const { return NumPrimitives != 0; }
+
+        BoundBox GetBoundBox() const { return BoundBox{Min, Max}; }
+    };
+    static_assert(sizeof(Node) == 32, "Node size is expected to be 32 bytes");
+
+    /// The maximum depth of the hierarchy.
+
+    /// \remarks    Nodes at this depth are made leaves regardless of the number of primitives.
+    ///             This allows the traversal functions to use a small fixed-size stack.
+    static constexpr Uint32 MaxDepth = 64;
+
+    BVH() noexcept {}
+
+    explicit BVH(const BVHCreateInfo& CI);
+
+    // clang-format off
+    BVH           (const BVH&)  = default;
+    BVH& operator=(const BVH&)  = default;
+    BVH           (BVH&&)       = default;
+    BVH& operator=(BVH&&)       = default;
+    // clang-format on
+
+    /// Returns the hierarchy nodes. The first node is the root.
+    const std::vector<Node>& GetNodes() const { return m_Nodes; }
+
+    /// Returns the primitive indices referenced by the leaf nodes.
+    const std::vector<Uint32>& GetPrimitiveIndices() const { return m_PrimIndices; }
+
+    /// Returns the bounding box of all primitives.
+    BoundBox GetBoundBox() const
+    {
+        return !m_Nodes.empty() ? m_Nodes[0].GetBoundBox() : BoundBox{};
+    }
+
+    bool IsEmpty() const { return m_Nodes.empty(); }
+
+    /// Returns the hierarchy depth.
+    Uint32 GetDepth() const { return m_Depth; }
+
+
+    /// Casts the ray through the hierarchy.
+
+    /// \param[in]      RayOrigin    - Ray origin.
+    /// \param[in]      RayDirection - Ray direction.
+    /// \param[in]      MaxDist      - The maximum distance along the ray. Nodes that are
+    ///                                farther than this distance are skipped.
+    /// \param[in]      Handler      - Function that is called for every primitive whose leaf
+    ///                                node is intersected by the ray:
+    ///
+    ///                                     bool Handler(Uint32 PrimIndex, float& MaxDist);
+    ///
+    ///                                The handler should reduce the MaxDist when it finds
+    ///                                a closer hit, and return false to stop the traversal.
+    ///
+    /// \remarks    Child nodes are visited front to back, so the closest hits are typically
+    ///             found first, which allows culling the remaining nodes early.
+    template <typename HandlerType>
+    void CastRay(const float3& RayOrigin, const float3& RayDirection, float MaxDist, HandlerType&& Handler) const;
+
+
+    /// Finds all primitives whose leaf nodes overlap the box.
+
+    /// \param[in] Bounds  - Bounding box to test.
+    /// \param[in] Handler - Function that is called for every primitive whose leaf node
+    ///                      overlaps the box:
+    ///
+    ///                         bool Handler(Uint32 PrimIndex);
+    ///
+    ///                      The handler should return false to stop the traversal.
+    template <typename HandlerType>
+    void QueryBox(const BoundBox& Bounds, HandlerType&& Handler) const;
+
+
+    /// Finds all primitives whose leaf nodes are visible in the frustum.
+
+    /// \param[in] Frustum    - View frustum.
+    /// \param[in] Handler    - Function that is called for every primitive whose leaf node
+    ///                         is at least partially visible:
+    ///
+    ///                             void Handler(Uint32 PrimIndex, BoxVisibility NodeVisibility);
+    ///
+    ///                         NodeVisibility is BoxVisibility::FullyVisible if the node that contains
+    ///                         the primitive is fully visible, in which case the primitive does not need
+    ///                         to be tested, and BoxVisibility::Intersecting otherwise.
+    /// \param[in] PlaneFlags - Frustum planes to test the nodes against.
+    ///
+    /// \remarks    The planes that a node is fully inside of are not tested for its children.
+    ///             Fully visible subtrees are reported without testing their nodes.
+    template <typename HandlerType>
+    void QueryFrustum(const ViewFrustum& Frustum, HandlerType&& Handler, FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const;
+
+private:
+    std::vector<Node>   m_Nodes;
+    std::vector<Uint32> m_PrimIndices;
+    Uint32              m_Depth = 0;
+};
+
+
+template <typename HandlerType>
+void BVH::CastRay(const float3& RayOrigin, const float3& RayDirection, float MaxDist, HandlerType&& Handler) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    VERIFY_EXPR(RayDirection != float3(0, 0, 0));
+
+    // Replace zero components with a tiny value to avoid 0 * inf in the slab test
+    static constexpr float Epsilon = 1e-20f;
+
+    const float3 InvDir //
+        {
+            1.f / (std::abs(RayDirection.x) > Epsilon ? RayDirection.x : std::copysign(Epsilon, RayDirection.x)),
+            1.f / (std::abs(RayDirection.y) > Epsilon ? RayDirection.y : std::copysign(Epsilon, RayDirection.y)),
+            1.f / (std::abs(RayDirection.z) > Epsilon ? RayDirection.z : std::copysign(Epsilon, RayDirection.z)) //
+        };
+    const float3 OriginMulInvDir = RayOrigin * InvDir;
+
+    // Returns the distance to the node, or +FLT_MAX if the ray misses the node
+    // or the node is farther than MaxDist.
+    const auto GetNodeDistance = [&](const Node& N) {
+        const float3 t0 = N.Min * InvDir - OriginMulInvDir;
+        const float3 t1 = N.Max * InvDir - OriginMulInvDir;
+
+        const float3 tMin = std::min(t0, t1);
+        const float3 tMax = std::max(t0, t1);
+
+        const float EnterDist = (std::max)((std::max)(tMin.x, tMin.y), (std::max)(tMin.z, 0.f));
+        const float ExitDist  = (std::min)((std::min)(tMax.x, tMax.y), (std::min)(tMax.z, MaxDist));
+
+        return EnterDist <= ExitDist ? EnterDist : +FLT_MAX;
+    };
+
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        float  Dist;
+    };
+    StackEntry Stack[MaxDepth];
+    Uint32     StackSize = 0;
+
+    if (GetNodeDistance(m_Nodes[0]) == +FLT_MAX)
+        return;
+
+    Uint32 NodeIdx = 0;
+    while (true)
+    {
+        const Node& N = m_Nodes[NodeIdx];
+        if (N.IsLeaf())
+        {
+            for (Uint32 i = 0; i < N.NumPrimitives; ++i)
+            {
+                if (!Handler(m_PrimIndices[N.Offset + i], MaxDist))
+                    return;
+            }
+        }
+        else
+        {
+            Uint32 Child0 = NodeIdx + 1;
+            Uint32 Child1 = N.Offset;
+            float  Dist0  = GetNodeDistance(m_Nodes[Child0]);
+            float  Dist1  = GetNodeDistance(m_Nodes[Child1]);
+            if (Dist1 < Dist0)
+            {
+                std::swap(Child0, Child1);
+                std::swap(Dist0, Dist1);
+            }
+
+            if (Dist0 != +FLT_MAX)
+            {
+                if (Dist1 != +FLT_MAX)
+                {
+                    VERIFY_EXPR(StackSize < MaxDepth);
+                    Stack[StackSize++] = {Child1, Dist1};
+                }
+                NodeIdx = Child0;
+                continue;
+            }
+        }
+
+        // Pop the next node skipping the ones that are now farther than the closest hit
+        while (StackSize > 0 && Stack[StackSize - 1].Dist > MaxDist)
+            --StackSize;
+        if (StackSize == 0)
+            break;
+        NodeIdx = Stack[--StackSize].NodeIdx;
+    }
+}
+
+template <typename HandlerType>
+void BVH::QueryBox(const BoundBox& Bounds, HandlerType&& Handler) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    const auto Overlaps = [&Bounds](const Node& N) {
+        return (N.Min.x <= Bounds.Max.x && N.Max.x >= Bounds.Min.x &&
+                N.Min.y <= Bounds.Max.y && N.Max.y >= Bounds.Min.y &&
+                N.Min.z <= Bounds.Max.z && N.Max.z >= Bounds.Min.z);
+    };
+
+    Uint32 Stack[MaxDepth];
+    Uint32 StackSize = 0;
+
+    Uint32 NodeIdx = 0;
+    if (!Overlaps(m_Nodes[NodeIdx]))
+        return;
+
+    while (true)
+    {
+        const Node& N = m_Nodes[NodeIdx];
+        if (N.IsLeaf())
+        {
+            for (Uint32 i = 0; i < N.NumPrimitives; ++i)
+            {
+                if (!Handler(m_PrimIndices[N.Offset + i]))
+                    return;
+            }
+        }
+        else
+        {
+            const Uint32 Child0   = NodeIdx + 1;
+            const Uint32 Child1   = N.Offset;
+            const bool   Overlap0 = Overlaps(m_Nodes[Child0]);
+            const bool   Overlap1 = Overlaps(m_Nodes[Child1]);
+            if (Overlap0 || Overlap1)
+            {
+                if (Overlap0 && Overlap1)
+                {
+                    VERIFY_EXPR(StackSize < MaxDepth);
+                    Stack[StackSize++] = Child1;
+                }
+                NodeIdx = Overlap0 ? Child0 : Child1;
+                continue;
+            }
+        }
+
+        if (StackSize == 0)
+            break;
+        NodeIdx = Stack[--StackSize];
+    }
+}
+
+template <typename HandlerType>
+void BVH::QueryFrustum(const ViewFrustum& Frustum, HandlerType&& Handler, FRUSTUM_PLANE_FLAGS PlaneFlags) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    struct StackEntry
+    {
+        Uint32              NodeIdx;
+        FRUSTUM_PLANE_FLAGS PlaneFlags;
+    };
+    StackEntry Stack[MaxDepth];
+    Uint32     StackSize = 0;
+
+    Stack[StackSize++] = {0, PlaneFlags};
+    while (StackSize > 0)
+    {
+        const auto  Entry      = Stack[--StackSize];
+        auto        NodeFlags  = Entry.PlaneFlags;
+        const Node& N          = m_Nodes[Entry.NodeIdx];
+        const auto  NodeBounds = N.GetBoundBox();
+
+        bool IsInvisible = false;
+        for (Uint32 PlaneIdx = 0; PlaneIdx < ViewFrustum::NUM_PLANES && NodeFlags != FRUSTUM_PLANE_FLAG_NONE; ++PlaneIdx)
+        {
+            const auto PlaneFlag = static_cast<FRUSTUM_PLANE_FLAGS>(1 << PlaneIdx);
+            if ((NodeFlags & PlaneFlag) == 0)
+                continue;
+
+            const auto Visibility = GetBoxVisibilityAgainstPlane(Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(PlaneIdx)), NodeBounds);
+            if (Visibility == BoxVisibility::Invisible)
+            {
+                IsInvisible = true;
+                break;
+            }
+            if (Visibility == BoxVisibility::FullyVisible)
+            {
+                // The children are also fully inside this plane
+                NodeFlags = static_cast<FRUSTUM_PLANE_FLAGS>(NodeFlags & ~PlaneFlag);
+            }
+        }
+        if (IsInvisible)
+            continue;
+
+        if (NodeFlags == FRUSTUM_PLANE_FLAG_NONE)
+        {
+            // The node is fully visible. The primitives of the subtree occupy a contiguous range
+            // that starts at the leftmost leaf and ends at the rightmost leaf.
+            Uint32 FirstLeaf = Entry.NodeIdx;
+            while (!m_Nodes[FirstLeaf].IsLeaf())
+                ++FirstLeaf;
+            Uint32 LastLeaf = Entry.NodeIdx;
+            while (!m_Nodes[LastLeaf].IsLeaf())
+                LastLeaf = m_Nodes[LastLeaf].Offset;
+
+            const Uint32 FirstPrim = m_Nodes[FirstLeaf].Offset;
+            const Uint32 EndPrim   = m_Nodes[LastLeaf].Offset + m_Nodes[LastLeaf].NumPrimitives;
+            for (Uint32 i = FirstPrim; i < EndPrim; ++i)
+                Handler(m_PrimIndices[i], BoxVisibility::FullyVisible);
+        }
+        else if (N.IsLeaf())
+        {
+            for (Uint32 i = 0; i < N.NumPrimitives; ++i)
+                Handler(m_PrimIndices[N.Offset + i], BoxVisibility::Intersecting);
+        }
+        else
+        {
+            VERIFY_EXPR(StackSize + 2 <= MaxDepth);
+            // Push the second child first so that the first child is processed first
+            Stack[StackSize++] = {N.Offset, NodeFlags};
+            Stack[StackSize++] = {Entry.NodeIdx + 1, NodeFlags};
+        }
+    }
+}
+
+} // namespace Diligent
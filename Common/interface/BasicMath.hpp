@@ -53,6 +53,7 @@
 #include <iostream>
 
 #include "HashUtils.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
 
 #ifdef _MSC_VER
 #    pragma warning(push)
@@ -2003,6 +2004,304 @@ using double4x4 = Matrix4x4<double>;
 using double3x3 = Matrix3x3<double>;
 using double2x2 = Matrix2x2<double>;
 
+
+/// Transforms an array of 4-component vectors by the matrix: pDst[i] = pSrc[i] * m.
+/// The source and destination arrays may be the same.
+template <class T>
+void TransformVectors(const Vector4<T>* pSrc, Vector4<T>* pDst, size_t Count, const Matrix4x4<T>& m)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+}
+
+/// Transforms an array of points by the matrix: pDst[i] = pSrc[i] * m.
+/// Similar to Vector3::operator*(const Matrix4x4&), the results are divided by w.
+/// The source and destination arrays may be the same.
+template <class T>
+void TransformPoints(const Vector3<T>* pSrc, Vector3<T>* pDst, size_t Count, const Matrix4x4<T>& m)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+}
+
+
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+
+// SSE2 and NEON specializations of the most frequently used float4x4 operations.
+// Multiplication, transposition and transformations perform the same floating-point
+// operations in the same order as the generic versions, so the results are identical.
+// Inverse() uses the block-wise method and may differ from the generic version in the
+// last bits.
+
+namespace MathSIMD
+{
+
+#    if DILIGENT_SSE2_ENABLED
+
+using Vec4 = __m128;
+
+// clang-format off
+inline Vec4 Load(const float* p)    { return _mm_loadu_ps(p); }
+inline void Store(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 Set1(float f)           { return _mm_set1_ps(f); }
+inline Vec4 Add(Vec4 a, Vec4 b)     { return _mm_add_ps(a, b); }
+inline Vec4 Sub(Vec4 a, Vec4 b)     { return _mm_sub_ps(a, b); }
+inline Vec4 Mul(Vec4 a, Vec4 b)     { return _mm_mul_ps(a, b); }
+inline Vec4 Div(Vec4 a, Vec4 b)     { return _mm_div_ps(a, b); }
+// clang-format on
+
+inline Vec4 Set(float x, float y, float z, float w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+
+// Stores the first three components
+inline void Store3(float* p, Vec4 v)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+// Returns {a[i0], a[i1], b[i2], b[i3]}
+template <int i0, int i1, int i2, int i3>
+inline Vec4 Shuffle(Vec4 a, Vec4 b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0));
+}
+
+inline void Transpose(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+#    elif DILIGENT_NEON_ENABLED
+
+using Vec4 = float32x4_t;
+
+// clang-format off
+inline Vec4 Load(const float* p)    { return vld1q_f32(p); }
+inline void Store(float* p, Vec4 v) { vst1q_f32(p, v); }
+inline Vec4 Set1(float f)           { return vdupq_n_f32(f); }
+inline Vec4 Add(Vec4 a, Vec4 b)     { return vaddq_f32(a, b); }
+inline Vec4 Sub(Vec4 a, Vec4 b)     { return vsubq_f32(a, b); }
+inline Vec4 Mul(Vec4 a, Vec4 b)     { return vmulq_f32(a, b); }
+inline Vec4 Div(Vec4 a, Vec4 b)     { return vdivq_f32(a, b); }
+// clang-format on
+
+inline Vec4 Set(float x, float y, float z, float w)
+{
+    const float v[] = {x, y, z, w};
+    return vld1q_f32(v);
+}
+
+// Stores the first three components
+inline void Store3(float* p, Vec4 v)
+{
+    vst1_f32(p, vget_low_f32(v));
+    vst1q_lane_f32(p + 2, v, 2);
+}
+
+// Returns {a[i0], a[i1], b[i2], b[i3]}
+template <int i0, int i1, int i2, int i3>
+inline Vec4 Shuffle(Vec4 a, Vec4 b)
+{
+    Vec4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+    r      = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+    r      = vsetq_lane_f32(vgetq_lane_f32(b, i2), r, 2);
+    r      = vsetq_lane_f32(vgetq_lane_f32(b, i3), r, 3);
+    return r;
+}
+
+inline void Transpose(Vec4& r0, Vec4& r1, Vec4& r2, Vec4& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+#    endif
+
+// Computes x * Rows[0] + y * Rows[1] + z * Rows[2] + w * Rows[3] in the same order
+// as Vector4::operator*(const Matrix4x4&).
+inline Vec4 TransformVector(Vec4 x, Vec4 y, Vec4 z, Vec4 w, const Vec4 Rows[4])
+{
+    return Add(Add(Add(Mul(x, Rows[0]), Mul(y, Rows[1])), Mul(z, Rows[2])), Mul(w, Rows[3]));
+}
+
+// 2x2 matrices are stored in a vector as {m00, m01, m10, m11}
+
+// Computes a * b
+inline Vec4 Mat2Mul(Vec4 a, Vec4 b)
+{
+    return Add(Mul(a, Shuffle<0, 3, 0, 3>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+}
+
+// Computes adj(a) * b
+inline Vec4 Mat2AdjMul(Vec4 a, Vec4 b)
+{
+    return Sub(Mul(Shuffle<3, 3, 0, 0>(a, a), b), Mul(Shuffle<1, 1, 2, 2>(a, a), Shuffle<2, 3, 0, 1>(b, b)));
+}
+
+// Computes a * adj(b)
+inline Vec4 Mat2MulAdj(Vec4 a, Vec4 b)
+{
+    return Sub(Mul(a, Shuffle<3, 0, 3, 0>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+}
+
+// Computes m1 * m2
+inline void MulMatrix4x4(const float* m1, const float* m2, float* mOut)
+{
+    const Vec4 Rows2[] = {Load(m2), Load(m2 + 4), Load(m2 + 8), Load(m2 + 12)};
+    const Vec4 Zero    = Set1(0.f);
+    for (int i = 0; i < 4; ++i)
+    {
+        const float* Row1 = m1 + i * 4;
+
+        // Start with zero to match the generic version, which matters for negative zeros
+        Vec4 Row = Add(Zero, Mul(Set1(Row1[0]), Rows2[0]));
+        Row      = Add(Row, Mul(Set1(Row1[1]), Rows2[1]));
+        Row      = Add(Row, Mul(Set1(Row1[2]), Rows2[2]));
+        Row      = Add(Row, Mul(Set1(Row1[3]), Rows2[3]));
+        Store(mOut + i * 4, Row);
+    }
+}
+
+inline void TransposeMatrix4x4(const float* m, float* mOut)
+{
+    Vec4 r0 = Load(m);
+    Vec4 r1 = Load(m + 4);
+    Vec4 r2 = Load(m + 8);
+    Vec4 r3 = Load(m + 12);
+    Transpose(r0, r1, r2, r3);
+    Store(mOut, r0);
+    Store(mOut + 4, r1);
+    Store(mOut + 8, r2);
+    Store(mOut + 12, r3);
+}
+
+inline void InverseMatrix4x4(const float* m, float* mOut)
+{
+    // Block-wise inversion, see https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+    //
+    //       | A  B |              1    | X  Y |
+    //   M = |      |     inv(M) = ---- |      |
+    //       | C  D |              |M|  | Z  W |
+    //
+    // where A, B, C, D are 2x2 matrices.
+    const Vec4 r0 = Load(m);
+    const Vec4 r1 = Load(m + 4);
+    const Vec4 r2 = Load(m + 8);
+    const Vec4 r3 = Load(m + 12);
+
+    const Vec4 A = Shuffle<0, 1, 0, 1>(r0, r1);
+    const Vec4 B = Shuffle<2, 3, 2, 3>(r0, r1);
+    const Vec4 C = Shuffle<0, 1, 0, 1>(r2, r3);
+    const Vec4 D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+    // {|A|, |B|, |C|, |D|}
+    const Vec4 DetSub = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                            Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+
+    const Vec4 DetA = Shuffle<0, 0, 0, 0>(DetSub, DetSub);
+    const Vec4 DetB = Shuffle<1, 1, 1, 1>(DetSub, DetSub);
+    const Vec4 DetC = Shuffle<2, 2, 2, 2>(DetSub, DetSub);
+    const Vec4 DetD = Shuffle<3, 3, 3, 3>(DetSub, DetSub);
+
+    const Vec4 D_C = Mat2AdjMul(D, C);
+    const Vec4 A_B = Mat2AdjMul(A, B);
+
+    // adj(X) = |D|A - B(adj(D)C)
+    Vec4 X_ = Sub(Mul(DetD, A), Mat2Mul(B, D_C));
+    // adj(W) = |A|D - C(adj(A)B)
+    Vec4 W_ = Sub(Mul(DetA, D), Mat2Mul(C, A_B));
+    // adj(Y) = |B|C - D adj(adj(A)B)
+    Vec4 Y_ = Sub(Mul(DetB, C), Mat2MulAdj(D, A_B));
+    // adj(Z) = |C|B - A adj(adj(D)C)
+    Vec4 Z_ = Sub(Mul(DetC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A||D| + |B||C| - tr((adj(A)B)(adj(D)C))
+    Vec4 Tr = Mul(A_B, Shuffle<0, 2, 1, 3>(D_C, D_C));
+    Tr      = Add(Tr, Shuffle<2, 3, 0, 1>(Tr, Tr));
+    Tr      = Add(Tr, Shuffle<1, 0, 3, 2>(Tr, Tr));
+
+    const Vec4 DetM = Sub(Add(Mul(DetA, DetD), Mul(DetB, DetC)), Tr);
+
+    // {1/|M|, -1/|M|, -1/|M|, 1/|M|}
+    const Vec4 RcpDetM = Div(Set(1.f, -1.f, -1.f, 1.f), DetM);
+
+    X_ = Mul(X_, RcpDetM);
+    Y_ = Mul(Y_, RcpDetM);
+    Z_ = Mul(Z_, RcpDetM);
+    W_ = Mul(W_, RcpDetM);
+
+    // Apply the adjugate and store the rows
+    Store(mOut, Shuffle<3, 1, 3, 1>(X_, Y_));
+    Store(mOut + 4, Shuffle<2, 0, 2, 0>(X_, Y_));
+    Store(mOut + 8, Shuffle<3, 1, 3, 1>(Z_, W_));
+    Store(mOut + 12, Shuffle<2, 0, 2, 0>(Z_, W_));
+}
+
+} // namespace MathSIMD
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    Matrix4x4<float> mOut;
+    MathSIMD::MulMatrix4x4(m1.Data(), m2.Data(), mOut.Data());
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Transpose() const
+{
+    Matrix4x4<float> mOut;
+    MathSIMD::TransposeMatrix4x4(Data(), mOut.Data());
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Inverse() const
+{
+    Matrix4x4<float> inv;
+    MathSIMD::InverseMatrix4x4(Data(), inv.Data());
+    return inv;
+}
+
+template <>
+inline void TransformVectors<float>(const float4* pSrc, float4* pDst, size_t Count, const float4x4& m)
+{
+    using namespace MathSIMD;
+
+    const Vec4 Rows[] = {Load(m.m[0]), Load(m.m[1]), Load(m.m[2]), Load(m.m[3])};
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& v = pSrc[i];
+        Store(&pDst[i].x, TransformVector(Set1(v.x), Set1(v.y), Set1(v.z), Set1(v.w), Rows));
+    }
+}
+
+template <>
+inline void TransformPoints<float>(const float3* pSrc, float3* pDst, size_t Count, const float4x4& m)
+{
+    using namespace MathSIMD;
+
+    const Vec4 Rows[] = {Load(m.m[0]), Load(m.m[1]), Load(m.m[2]), Load(m.m[3])};
+    const Vec4 One    = Set1(1.f);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& v = pSrc[i];
+
+        const Vec4 Pos = TransformVector(Set1(v.x), Set1(v.y), Set1(v.z), One, Rows);
+        Store3(&pDst[i].x, Div(Pos, Shuffle<3, 3, 3, 3>(Pos, Pos)));
+    }
+}
+
+#endif
+
 template <typename T = float>
 struct Quaternion
 {
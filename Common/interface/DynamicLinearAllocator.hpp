@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <cstring>
+#include <algorithm>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -43,6 +44,11 @@ namespace Diligent
 {
 
 /// Implementation of a linear allocator on fixed memory pages
+///
+/// \remarks   Memory is allocated from the current block. When the block is exhausted,
+///            the allocator moves to the next block that was kept after Discard() or
+///            ResetToMarker(), or allocates a new one. The allocator is not thread-safe;
+///            use DynamicLinearAllocatorPool to allocate from multiple threads.
 class DynamicLinearAllocator
 {
 public:
@@ -72,16 +78,70 @@ public:
             m_pAllocator->Free(block.Data);
         }
         m_Blocks.clear();
+        m_CurrBlock    = 0;
+        m_UsedSize     = 0;
+        m_ReservedSize = 0;
 
         m_pAllocator = nullptr;
     }
 
+    /// Releases all allocations, but keeps the memory blocks for reuse.
     void Discard()
     {
         for (auto& block : m_Blocks)
         {
             block.CurrPtr = block.Data;
         }
+        m_CurrBlock = 0;
+        m_UsedSize  = 0;
+    }
+
+    /// Allocator state returned by GetMarker()
+    struct Marker
+    {
+        size_t BlockIndex = 0;
+        size_t Offset     = 0;
+        size_t UsedSize   = 0;
+    };
+
+    /// Returns the marker that can be used to release all allocations made after this call.
+    Marker GetMarker() const
+    {
+        Marker M;
+        if (m_CurrBlock < m_Blocks.size())
+        {
+            const auto& block = m_Blocks[m_CurrBlock];
+
+            M.BlockIndex = m_CurrBlock;
+            M.Offset     = static_cast<size_t>(block.CurrPtr - block.Data);
+        }
+        M.UsedSize = m_UsedSize;
+        return M;
+    }
+
+    /// Releases all allocations made after the marker was obtained with GetMarker().
+    /// The memory blocks are kept for reuse. Markers must be released in reverse order.
+    void ResetToMarker(const Marker& M)
+    {
+        if (m_Blocks.empty())
+        {
+            VERIFY(M.BlockIndex == 0 && M.Offset == 0 && M.UsedSize == 0, "The marker does not belong to this allocator");
+            return;
+        }
+
+        VERIFY(M.BlockIndex <= m_CurrBlock, "The marker is invalid or was already released");
+        VERIFY(M.UsedSize <= m_UsedSize, "The marker is invalid or was already released");
+        for (size_t i = M.BlockIndex + 1; i <= m_CurrBlock; ++i)
+        {
+            m_Blocks[i].CurrPtr = m_Blocks[i].Data;
+        }
+
+        auto& block = m_Blocks[M.BlockIndex];
+        VERIFY(block.Data + M.Offset <= block.CurrPtr, "The marker is invalid or was already released");
+        block.CurrPtr = block.Data + M.Offset;
+
+        m_CurrBlock = M.BlockIndex;
+        m_UsedSize  = M.UsedSize;
     }
 
     NODISCARD void* Allocate(size_t size, size_t align)
@@ -89,14 +149,12 @@ public:
         if (size == 0)
             return nullptr;
 
-        for (auto& block : m_Blocks)
+        // Blocks after the current one are empty. They are left after
+        // Discard() or ResetToMarker() and are reused in order.
+        for (; m_CurrBlock < m_Blocks.size(); ++m_CurrBlock)
         {
-            auto* Ptr = AlignUp(block.CurrPtr, align);
-            if (Ptr + size <= block.Data + block.Size)
-            {
-                block.CurrPtr = Ptr + size;
+            if (auto* Ptr = AllocateInBlock(m_Blocks[m_CurrBlock], size, align))
                 return Ptr;
-            }
         }
 
         // Create a new block
@@ -104,11 +162,11 @@ public:
         while (BlockSize < size + align - 1)
             BlockSize *= 2;
         m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize);
+        m_ReservedSize += BlockSize;
 
-        auto& block = m_Blocks.back();
-        auto* Ptr   = AlignUp(block.Data, align);
-        VERIFY(Ptr + size <= block.Data + block.Size, "Not enough space in the new block - this is a bug");
-        block.CurrPtr = Ptr + size;
+        m_CurrBlock = m_Blocks.size() - 1;
+        auto* Ptr   = AllocateInBlock(m_Blocks.back(), size, align);
+        VERIFY(Ptr != nullptr, "Not enough space in the new block - this is a bug");
         return Ptr;
     }
 
@@ -198,6 +256,16 @@ public:
         return m_Blocks.size();
     }
 
+    /// Returns the number of bytes currently allocated, including the alignment padding.
+    size_t GetUsedSize() const { return m_UsedSize; }
+
+    /// Returns the maximum number of bytes that were allocated at the same time
+    /// since the allocator was created.
+    size_t GetPeakUsedSize() const { return m_PeakUsedSize; }
+
+    /// Returns the total size of all memory blocks.
+    size_t GetReservedSize() const { return m_ReservedSize; }
+
     template <typename HandlerType>
     void ProcessBlocks(HandlerType&& Handler) const
     {
@@ -216,9 +284,25 @@ private:
             Data{static_cast<uint8_t*>(_Data)}, Size{_Size}, CurrPtr{Data} {}
     };
 
+    uint8_t* AllocateInBlock(Block& block, size_t size, size_t align)
+    {
+        auto* Ptr = AlignUp(block.CurrPtr, align);
+        if (Ptr + size > block.Data + block.Size)
+            return nullptr;
+
+        m_UsedSize += static_cast<size_t>(Ptr + size - block.CurrPtr);
+        m_PeakUsedSize = std::max(m_PeakUsedSize, m_UsedSize);
+        block.CurrPtr  = Ptr + size;
+        return Ptr;
+    }
+
     std::vector<Block> m_Blocks;
-    const Uint32       m_BlockSize  = 4 << 10;
-    IMemoryAllocator*  m_pAllocator = nullptr;
+    size_t             m_CurrBlock    = 0;
+    size_t             m_UsedSize     = 0;
+    size_t             m_PeakUsedSize = 0;
+    size_t             m_ReservedSize = 0;
+    const Uint32       m_BlockSize    = 4 << 10;
+    IMemoryAllocator*  m_pAllocator   = nullptr;
 };
 
 } // namespace Diligent
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::DynamicLinearAllocatorPool class
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Thread-safe pool of dynamic linear allocators (arenas).
+
+/// \remarks    A thread takes an arena from the pool with GetArena() and allocates from it
+///             without any synchronization. When the returned handle is destroyed, all allocations
+///             are discarded and the arena is returned to the pool. The memory blocks of the arena
+///             are kept, so that subsequent users of the arena do not allocate memory again.
+///             The arena released by a thread is cached in the thread's slot, and the next
+///             GetArena() call from the same thread normally gets it back without locking the pool.
+///             Nested GetArena() calls return different arenas.
+class DynamicLinearAllocatorPool
+{
+    struct Arena;
+
+public:
+    DynamicLinearAllocatorPool(IMemoryAllocator& RawAllocator, Uint32 BlockSize = 4 << 10);
+    ~DynamicLinearAllocatorPool();
+
+    // clang-format off
+    DynamicLinearAllocatorPool           (const DynamicLinearAllocatorPool&) = delete;
+    DynamicLinearAllocatorPool           (DynamicLinearAllocatorPool&&)      = delete;
+    DynamicLinearAllocatorPool& operator=(const DynamicLinearAllocatorPool&) = delete;
+    DynamicLinearAllocatorPool& operator=(DynamicLinearAllocatorPool&&)      = delete;
+    // clang-format on
+
+    /// Scoped handle of the arena taken from the pool.
+    /// The arena is returned to the pool when the handle is destroyed.
+    class ArenaHandle
+    {
+    public:
+        ArenaHandle() noexcept {}
+
+        ArenaHandle(ArenaHandle&& Other) noexcept :
+            m_pPool{Other.m_pPool},
+            m_pArena{Other.m_pArena}
+        {
+            Other.m_pPool  = nullptr;
+            Other.m_pArena = nullptr;
+        }
+
+        ArenaHandle& operator=(ArenaHandle&& Other) noexcept
+        {
+            if (this != &Other)
+            {
+                Release();
+                m_pPool        = Other.m_pPool;
+                m_pArena       = Other.m_pArena;
+                Other.m_pPool  = nullptr;
+                Other.m_pArena = nullptr;
+            }
+            return *this;
+        }
+
+        // clang-format off
+        ArenaHandle           (const ArenaHandle&) = delete;
+        ArenaHandle& operator=(const ArenaHandle&) = delete;
+        // clang-format on
+
+        ~ArenaHandle()
+        {
+            Release();
+        }
+
+        /// Discards all allocations and returns the arena to the pool.
+        void Release();
+
+        DynamicLinearAllocator& operator*() const
+        {
+            VERIFY_EXPR(m_pArena != nullptr);
+            return m_pArena->Allocator;
+        }
+
+        DynamicLinearAllocator* operator->() const
+        {
+            VERIFY_EXPR(m_pArena != nullptr);
+            return &m_pArena->Allocator;
+        }
+
+        explicit operator bool() const { return m_pArena != nullptr; }
+
+    private:
+        friend DynamicLinearAllocatorPool;
+
+        ArenaHandle(DynamicLinearAllocatorPool& Pool, Arena& Arena) noexcept :
+            m_pPool{&Pool},
+            m_pArena{&Arena}
+        {}
+
+        DynamicLinearAllocatorPool* m_pPool  = nullptr;
+        Arena*                      m_pArena = nullptr;
+    };
+
+    /// Takes an arena from the pool. The arena must only be used by one thread at a time.
+    ArenaHandle GetArena();
+
+    /// Pool statistics
+    struct Statistics
+    {
+        /// The number of arenas created by the pool.
+        Uint32 NumArenas = 0;
+
+        /// The number of arenas that are currently in use.
+        Uint32 NumActiveArenas = 0;
+
+        /// The total size of memory blocks owned by the arenas that are not in use.
+        size_t ReservedSize = 0;
+
+        /// The maximum number of bytes that were allocated from a single arena.
+        size_t PeakArenaUsedSize = 0;
+    };
+
+    /// Returns the pool statistics
+    Statistics GetStatistics() const;
+
+private:
+    struct Arena
+    {
+        DynamicLinearAllocator Allocator;
+
+        // The reserved size of the allocator when the arena was last returned to the pool.
+        size_t ReservedSize = 0;
+
+        Arena(IMemoryAllocator& RawAllocator, Uint32 BlockSize) :
+            Allocator{RawAllocator, BlockSize}
+        {}
+    };
+
+    void ReleaseArena(Arena& A);
+
+    // The slot size is a multiple of the cache line size, which prevents false sharing
+    // between slots used by different threads.
+    struct alignas(64) ThreadSlot
+    {
+        // The arena that was last released by the thread that uses this slot.
+        std::atomic<Arena*> pArena{nullptr};
+    };
+    std::vector<ThreadSlot> m_ThreadSlots;
+
+    mutable std::mutex                  m_Mtx;
+    std::vector<std::unique_ptr<Arena>> m_Arenas;
+    std::vector<Arena*>                 m_FreeArenas;
+
+    IMemoryAllocator& m_RawAllocator;
+    const Uint32      m_BlockSize;
+
+    std::atomic<Uint32> m_NumActiveArenas{0};
+    std::atomic<size_t> m_ReservedSize{0};
+    std::atomic<size_t> m_PeakArenaUsedSize{0};
+};
+
+} // namespace Diligent
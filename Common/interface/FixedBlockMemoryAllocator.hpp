@@ -36,14 +36,25 @@
 #include <vector>
 #include <cstring>
 #include <memory>
+#include <atomic>
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "STDAllocator.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+///
+/// \remarks    Every thread allocates and releases blocks through its own magazine (a small
+///             free list) that is refilled from the shared memory pages and returns blocks to them
+///             in batches, so that most operations do not lock the allocator mutex.
+///             Memory pages are aligned by their size, which allows finding the page
+///             that owns a block with address arithmetic. Pages are allocated in slabs of
+///             several pages, so that the alignment overhead is paid once per slab.
+///             Every page keeps a bitmap of blocks given out to the application, which
+///             detects double freeing in all build configurations.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
@@ -56,6 +67,30 @@ public:
     /// Releases memory
     virtual void Free(void* Ptr) override final;
 
+    /// Allocator contention statistics
+    struct Statistics
+    {
+        /// The number of times a magazine was refilled from the shared pages.
+        Uint64 NumMagazineRefills = 0;
+
+        /// The number of times a magazine returned blocks to the shared pages.
+        Uint64 NumMagazineFlushes = 0;
+
+        /// The number of times a thread had to wait for a magazine locked by another thread.
+        Uint64 NumMagazineContentions = 0;
+
+        /// The number of times a thread had to wait for the shared pages mutex.
+        Uint64 NumMutexContentions = 0;
+    };
+
+    /// Returns the allocator contention statistics
+    Statistics GetStatistics() const;
+
+    /// Returns the number of blocks in one memory page.
+    /// This number may be greater than the value requested at construction
+    /// as the page is expanded to fill its alignment.
+    Uint32 GetNumBlocksInPage() const { return m_NumBlocksInPage; }
+
 private:
     // clang-format off
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
@@ -64,7 +99,18 @@ private:
     FixedBlockMemoryAllocator& operator = (FixedBlockMemoryAllocator&&)      = delete;
     // clang-format on
 
-    void CreateNewPage();
+    void CreateNewSlab();
+
+    struct Magazine;
+    Magazine& LockThreadMagazine();
+    void      RefillMagazine(Magazine& Mag);
+    void      FlushMagazine(Magazine& Mag, Uint32 NumBlocksToFlush);
+
+    size_t GetPageId(const void* pBlockAddr) const;
+
+    // Marks the block as allocated or free in the page block state bitmap.
+    // Returns false if the block is already in the requested state.
+    bool SetBlockAllocated(void* pBlockAddr, bool Allocated);
 
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
@@ -76,7 +122,17 @@ private:
         static constexpr Uint8 DeallocatedBlockMemPattern = 0xDE;
         static constexpr Uint8 InitializedBlockMemPattern = 0xCF;
 
-        MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator);
+        // Page header that is located at the start of every page.
+        // The header is followed by the block state bitmap, see SetBlockAllocated().
+        struct Header
+        {
+            FixedBlockMemoryAllocator* pOwnerAllocator;
+            size_t                     PageId;
+        };
+
+        // pRawMemory is the slab memory that is owned by the page, or null if
+        // the page is not the first page in the slab.
+        MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator, size_t PageId, void* pPageStart, void* pRawMemory);
         MemoryPage(MemoryPage&& Page) noexcept;
 
         ~MemoryPage();
@@ -100,6 +156,7 @@ private:
 
         Uint32                     m_NumFreeBlocks        = 0;       // Num of remaining blocks
         Uint32                     m_NumInitializedBlocks = 0;       // Num of initialized blocks
+        void*                      m_pRawMemory           = nullptr; // Slab memory allocated from the raw allocator
         void*                      m_pPageStart           = nullptr; // Beginning of memory pool
         void*                      m_pNextFreeBlock       = nullptr; // Num of next free block
         FixedBlockMemoryAllocator* m_pOwnerAllocator      = nullptr;
@@ -108,14 +165,31 @@ private:
     std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage>>                                          m_PagePool;
     std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t>> m_AvailablePages;
 
-    using AddrToPageIdMapElem = std::pair<void* const, size_t>;
-    std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
+
+    // The magazine size is a multiple of the cache line size, which prevents false sharing
+    // between magazines used by different threads.
+    struct alignas(64) Magazine
+    {
+        Threading::SpinLock Lock;
+
+        void*  pHead     = nullptr; // Singly-linked list of free blocks
+        Uint32 NumBlocks = 0;
+    };
+    std::vector<Magazine, STDAllocatorRawMem<Magazine>> m_Magazines;
 
     std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
+    const size_t      m_PageAlignment;
     const Uint32      m_NumBlocksInPage;
+    const size_t      m_BlocksOffset;
+    const Uint32      m_MagazineSize;
+
+    std::atomic<Uint64> m_NumMagazineRefills{0};
+    std::atomic<Uint64> m_NumMagazineFlushes{0};
+    std::atomic<Uint64> m_NumMagazineContentions{0};
+    std::atomic<Uint64> m_NumMutexContentions{0};
 };
 
 IMemoryAllocator& GetRawAllocator();
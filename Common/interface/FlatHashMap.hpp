@@ -0,0 +1,764 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::FlatHashMap class
+
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace FlatHashMapInternal
+{
+
+// Slot control bytes. Full slots store the 7 low bits of the hash, so the high bit is zero.
+static constexpr Int8 CtrlEmpty   = -128; // 0b10000000
+static constexpr Int8 CtrlDeleted = -2;   // 0b11111110
+
+// Bit mask of the slots in the group that match some criteria.
+// Every slot may be represented by more than one bit (see BitsPerSlotLog2).
+template <Uint32 BitsPerSlotLog2>
+struct GroupMask
+{
+    Uint64 Bits = 0;
+
+    explicit operator bool() const { return Bits != 0; }
+
+    Uint32 LowestSlot() const
+    {
+        return PlatformMisc::GetLSB(Bits) >> BitsPerSlotLog2;
+    }
+
+    void ClearLowestSlot()
+    {
+        Bits &= Bits - 1;
+    }
+};
+
+// A group of 16 control bytes that are tested at once
+struct Group
+{
+    static constexpr Uint32 Width = 16;
+
+#if DILIGENT_SSE2_ENABLED
+    using Mask = GroupMask<0>;
+
+    explicit Group(const Int8* pCtrl) :
+        Ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl))}
+    {}
+
+    Mask Match(Int8 H2) const
+    {
+        return Mask{static_cast<Uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl)))};
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(CtrlEmpty);
+    }
+
+    Mask MatchEmptyOrDeleted() const
+    {
+        // Both empty and deleted slots have the high bit set
+        return Mask{static_cast<Uint32>(_mm_movemask_epi8(Ctrl))};
+    }
+
+    __m128i Ctrl;
+#elif DILIGENT_NEON_ENABLED
+    // Every slot is represented by 4 bits, only the highest one is kept
+    using Mask = GroupMask<2>;
+
+    explicit Group(const Int8* pCtrl) :
+        Ctrl{vld1q_s8(pCtrl)}
+    {}
+
+    static Mask ToMask(uint8x16_t Cmp)
+    {
+        const uint8x8_t Nibbles = vshrn_n_u16(vreinterpretq_u16_u8(Cmp), 4);
+        return Mask{vget_lane_u64(vreinterpret_u64_u8(Nibbles), 0) & Uint64{0x8888888888888888}};
+    }
+
+    Mask Match(Int8 H2) const
+    {
+        return ToMask(vceqq_s8(vdupq_n_s8(H2), Ctrl));
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(CtrlEmpty);
+    }
+
+    Mask MatchEmptyOrDeleted() const
+    {
+        return ToMask(vcltzq_s8(Ctrl));
+    }
+
+    int8x16_t Ctrl;
+#else
+    using Mask = GroupMask<0>;
+
+    explicit Group(const Int8* pCtrl)
+    {
+        memcpy(Ctrl, pCtrl, Width);
+    }
+
+    Mask Match(Int8 H2) const
+    {
+        Mask Res;
+        for (Uint32 i = 0; i < Width; ++i)
+            Res.Bits |= Uint64{Ctrl[i] == H2} << i;
+        return Res;
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(CtrlEmpty);
+    }
+
+    Mask MatchEmptyOrDeleted() const
+    {
+        Mask Res;
+        for (Uint32 i = 0; i < Width; ++i)
+            Res.Bits |= Uint64{Ctrl[i] < 0} << i;
+        return Res;
+    }
+
+    Int8 Ctrl[Width];
+#endif
+};
+
+} // namespace FlatHashMapInternal
+
+
+/// Open-addressing hash map that stores the elements in a flat array.
+
+/// The map uses the same approach as Swiss tables: every slot has a control byte
+/// that stores 7 bits of the element hash, and 16 control bytes are tested at once
+/// when looking up the element (using SSE2 or NEON instructions when available).
+/// Unlike std::unordered_map, the elements are not allocated individually.
+///
+/// The interface follows std::unordered_map with the following differences:
+/// - Inserting the element or calling reserve() invalidates all iterators, pointers and
+///   references to the elements.
+/// - Erasing the element does not invalidate other iterators, so elements can be
+///   erased while the map is being iterated.
+/// - The allocator does not need to be default-constructible or assignable, so
+///   STDAllocator can be used.
+template <typename KeyType,
+          typename ValueType,
+          typename HasherType    = std::hash<KeyType>,
+          typename KeyEqualType  = std::equal_to<KeyType>,
+          typename AllocatorType = std::allocator<std::pair<const KeyType, ValueType>>>
+class FlatHashMap
+{
+public:
+    using key_type        = KeyType;
+    using mapped_type     = ValueType;
+    using value_type      = std::pair<const KeyType, ValueType>;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = HasherType;
+    using key_equal       = KeyEqualType;
+    using allocator_type  = AllocatorType;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    using Group = FlatHashMapInternal::Group;
+
+    using SlotAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<value_type>;
+    using SlotAllocTraits   = std::allocator_traits<SlotAllocatorType>;
+
+    template <bool IsConst>
+    class IteratorBase
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename FlatHashMap::value_type;
+        using difference_type   = typename FlatHashMap::difference_type;
+        using reference         = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+        using pointer           = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+
+        IteratorBase() noexcept {}
+
+        // Allow conversion from iterator to const_iterator
+        template <bool RhsIsConst, typename = typename std::enable_if<IsConst && !RhsIsConst>::type>
+        IteratorBase(const IteratorBase<RhsIsConst>& rhs) noexcept :
+            m_pCtrl{rhs.m_pCtrl},
+            m_pSlot{rhs.m_pSlot},
+            m_pCtrlEnd{rhs.m_pCtrlEnd}
+        {}
+
+        reference operator*() const
+        {
+            VERIFY_EXPR(m_pCtrl != nullptr && m_pCtrl < m_pCtrlEnd && *m_pCtrl >= 0);
+            return *m_pSlot;
+        }
+
+        pointer operator->() const
+        {
+            VERIFY_EXPR(m_pCtrl != nullptr && m_pCtrl < m_pCtrlEnd && *m_pCtrl >= 0);
+            return m_pSlot;
+        }
+
+        IteratorBase& operator++()
+        {
+            VERIFY(m_pCtrl != m_pCtrlEnd, "Incrementing end iterator");
+            ++m_pCtrl;
+            ++m_pSlot;
+            SkipEmptySlots();
+            return *this;
+        }
+
+        IteratorBase operator++(int)
+        {
+            IteratorBase Tmp{*this};
+            ++(*this);
+            return Tmp;
+        }
+
+        template <bool RhsIsConst>
+        bool operator==(const IteratorBase<RhsIsConst>& rhs) const
+        {
+            return m_pCtrl == rhs.m_pCtrl;
+        }
+
+        template <bool RhsIsConst>
+        bool operator!=(const IteratorBase<RhsIsConst>& rhs) const
+        {
+            return m_pCtrl != rhs.m_pCtrl;
+        }
+
+    private:
+        friend class FlatHashMap;
+        template <bool>
+        friend class IteratorBase;
+
+        IteratorBase(const Int8* pCtrl, value_type* pSlot, const Int8* pCtrlEnd) noexcept :
+            m_pCtrl{pCtrl},
+            m_pSlot{pSlot},
+            m_pCtrlEnd{pCtrlEnd}
+        {}
+
+        void SkipEmptySlots()
+        {
+            while (m_pCtrl != m_pCtrlEnd && *m_pCtrl < 0)
+            {
+                ++m_pCtrl;
+                ++m_pSlot;
+            }
+        }
+
+        const Int8* m_pCtrl    = nullptr;
+        value_type* m_pSlot    = nullptr;
+        const Int8* m_pCtrlEnd = nullptr;
+    };
+
+public:
+    using iterator       = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    explicit FlatHashMap(const allocator_type& Allocator = allocator_type{}) :
+        m_Allocator{Allocator}
+    {}
+
+    FlatHashMap(size_type NumElements, const allocator_type& Allocator = allocator_type{}) :
+        m_Allocator{Allocator}
+    {
+        reserve(NumElements);
+    }
+
+    FlatHashMap(FlatHashMap&& rhs) noexcept :
+        m_Allocator{rhs.m_Allocator},
+        m_Hasher{std::move(rhs.m_Hasher)},
+        m_KeyEqual{std::move(rhs.m_KeyEqual)},
+        m_pSlots{rhs.m_pSlots},
+        m_pCtrl{rhs.m_pCtrl},
+        m_Capacity{rhs.m_Capacity},
+        m_Size{rhs.m_Size},
+        m_GrowthLeft{rhs.m_GrowthLeft}
+    {
+        rhs.ResetStorage();
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& rhs) noexcept
+    {
+        if (this == &rhs)
+            return *this;
+
+        // The allocator is not moved, so the allocators must be equal
+        VERIFY(m_Allocator == rhs.m_Allocator, "Moving the map between different allocators is not allowed");
+
+        DestroyAllSlots();
+        FreeStorage();
+
+        m_Hasher     = std::move(rhs.m_Hasher);
+        m_KeyEqual   = std::move(rhs.m_KeyEqual);
+        m_pSlots     = rhs.m_pSlots;
+        m_pCtrl      = rhs.m_pCtrl;
+        m_Capacity   = rhs.m_Capacity;
+        m_Size       = rhs.m_Size;
+        m_GrowthLeft = rhs.m_GrowthLeft;
+        rhs.ResetStorage();
+
+        return *this;
+    }
+
+    // clang-format off
+    FlatHashMap           (const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    // clang-format on
+
+    ~FlatHashMap()
+    {
+        DestroyAllSlots();
+        FreeStorage();
+    }
+
+    iterator begin() noexcept
+    {
+        iterator it{m_pCtrl, m_pSlots, m_pCtrl + m_Capacity};
+        it.SkipEmptySlots();
+        return it;
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{m_pCtrl + m_Capacity, m_pSlots + m_Capacity, m_pCtrl + m_Capacity};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_cast<FlatHashMap*>(this)->begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_cast<FlatHashMap*>(this)->end();
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool      empty() const noexcept { return m_Size == 0; }
+    size_type size() const noexcept { return m_Size; }
+
+    /// Returns the number of slots in the map.
+    size_type bucket_count() const noexcept { return m_Capacity; }
+
+    iterator find(const key_type& Key)
+    {
+        const auto Hash = ComputeHash(Key);
+        const auto Idx  = FindSlot(Key, Hash);
+        return Idx < m_Capacity ? MakeIterator(Idx) : end();
+    }
+
+    const_iterator find(const key_type& Key) const
+    {
+        return const_cast<FlatHashMap*>(this)->find(Key);
+    }
+
+    size_type count(const key_type& Key) const
+    {
+        return find(Key) != end() ? 1 : 0;
+    }
+
+    /// Inserts the element constructed from Args if the map does not contain the element
+    /// with the same key. Unlike try_emplace, always constructs the element.
+    template <typename... ArgsType>
+    std::pair<iterator, bool> emplace(ArgsType&&... Args)
+    {
+        // The key is not known until the element is constructed
+        value_type Elem{std::forward<ArgsType>(Args)...};
+        return InsertUnique(Elem.first, [&Elem](value_type* pSlot) {
+            ConstructSlot(pSlot, std::move(const_cast<key_type&>(Elem.first)), std::move(Elem.second));
+        });
+    }
+
+    std::pair<iterator, bool> insert(const value_type& Elem)
+    {
+        return InsertUnique(Elem.first, [&Elem](value_type* pSlot) {
+            ConstructSlot(pSlot, Elem);
+        });
+    }
+
+    std::pair<iterator, bool> insert(value_type&& Elem)
+    {
+        return InsertUnique(Elem.first, [&Elem](value_type* pSlot) {
+            ConstructSlot(pSlot, std::move(const_cast<key_type&>(Elem.first)), std::move(Elem.second));
+        });
+    }
+
+    /// Constructs the value from Args if the map does not contain the key.
+    /// Otherwise, Args are not used.
+    template <typename... ArgsType>
+    std::pair<iterator, bool> try_emplace(const key_type& Key, ArgsType&&... Args)
+    {
+        return InsertUnique(Key, [&](value_type* pSlot) {
+            ConstructSlot(pSlot, std::piecewise_construct, std::forward_as_tuple(Key), std::forward_as_tuple(std::forward<ArgsType>(Args)...));
+        });
+    }
+
+    template <typename... ArgsType>
+    std::pair<iterator, bool> try_emplace(key_type&& Key, ArgsType&&... Args)
+    {
+        return InsertUnique(Key, [&](value_type* pSlot) {
+            ConstructSlot(pSlot, std::piecewise_construct, std::forward_as_tuple(std::move(Key)), std::forward_as_tuple(std::forward<ArgsType>(Args)...));
+        });
+    }
+
+    mapped_type& operator[](const key_type& Key)
+    {
+        return try_emplace(Key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& Key)
+    {
+        return try_emplace(std::move(Key)).first->second;
+    }
+
+    /// Erases the element and returns the iterator to the next element.
+    /// Other iterators remain valid.
+    iterator erase(const_iterator it)
+    {
+        VERIFY(it != end(), "Erasing end iterator");
+        const auto Idx = static_cast<size_t>(it.m_pCtrl - m_pCtrl);
+        EraseSlot(Idx);
+
+        iterator Next = MakeIterator(Idx);
+        ++Next;
+        return Next;
+    }
+
+    iterator erase(iterator it)
+    {
+        return erase(const_iterator{it});
+    }
+
+    size_type erase(const key_type& Key)
+    {
+        const auto Idx = FindSlot(Key, ComputeHash(Key));
+        if (Idx >= m_Capacity)
+            return 0;
+
+        EraseSlot(Idx);
+        return 1;
+    }
+
+    /// Removes all elements, but keeps the storage.
+    void clear() noexcept
+    {
+        if (m_Capacity == 0)
+            return;
+
+        DestroyAllSlots();
+        memset(m_pCtrl, FlatHashMapInternal::CtrlEmpty, m_Capacity);
+        m_Size       = 0;
+        m_GrowthLeft = GetMaxLoad(m_Capacity);
+    }
+
+    /// Makes sure that NumElements elements can be inserted without rehashing.
+    void reserve(size_type NumElements)
+    {
+        if (NumElements > m_Size + m_GrowthLeft)
+            Rehash(GetCapacityForSize(NumElements));
+    }
+
+    void swap(FlatHashMap& rhs) noexcept
+    {
+        VERIFY(m_Allocator == rhs.m_Allocator, "Swapping maps with different allocators is not allowed");
+        std::swap(m_Hasher, rhs.m_Hasher);
+        std::swap(m_KeyEqual, rhs.m_KeyEqual);
+        std::swap(m_pSlots, rhs.m_pSlots);
+        std::swap(m_pCtrl, rhs.m_pCtrl);
+        std::swap(m_Capacity, rhs.m_Capacity);
+        std::swap(m_Size, rhs.m_Size);
+        std::swap(m_GrowthLeft, rhs.m_GrowthLeft);
+    }
+
+    allocator_type get_allocator() const { return allocator_type{m_Allocator}; }
+    hasher         hash_function() const { return m_Hasher; }
+    key_equal      key_eq() const { return m_KeyEqual; }
+
+private:
+    // The maximum load factor is 7/8
+    static size_t GetMaxLoad(size_t Capacity)
+    {
+        return Capacity - Capacity / 8;
+    }
+
+    static size_t GetCapacityForSize(size_t Size)
+    {
+        size_t Capacity = Group::Width;
+        while (GetMaxLoad(Capacity) < Size)
+            Capacity *= 2;
+        return Capacity;
+    }
+
+    size_t ComputeHash(const key_type& Key) const
+    {
+        // Many std::hash implementations (e.g. for pointers and integers) are identity
+        // functions, so mix the bits to make both the group index and the control byte random.
+        Uint64 Hash = static_cast<Uint64>(m_Hasher(Key)) * Uint64{0x9E3779B97F4A7C15};
+        return static_cast<size_t>(Hash ^ (Hash >> 32));
+    }
+
+    static Int8 GetH2(size_t Hash)
+    {
+        return static_cast<Int8>(Hash & 0x7F);
+    }
+
+    // Groups are probed using the triangular sequence, which visits every group
+    // when the number of groups is a power of two.
+    struct ProbeSequence
+    {
+        ProbeSequence(size_t Hash, size_t NumGroups) :
+            NumGroupsMask{NumGroups - 1},
+            GroupIdx{(Hash >> 7) & NumGroupsMask}
+        {}
+
+        size_t Offset() const { return GroupIdx * Group::Width; }
+
+        void Next()
+        {
+            ++Step;
+            GroupIdx = (GroupIdx + Step) & NumGroupsMask;
+        }
+
+        const size_t NumGroupsMask;
+        size_t       GroupIdx;
+        size_t       Step = 0;
+    };
+
+    // Returns the index of the slot that contains the key, or m_Capacity if there is no such slot.
+    size_t FindSlot(const key_type& Key, size_t Hash) const
+    {
+        if (m_Capacity == 0)
+            return m_Capacity;
+
+        const auto    H2 = GetH2(Hash);
+        ProbeSequence Seq{Hash, m_Capacity / Group::Width};
+        for (size_t i = 0; i < m_Capacity / Group::Width; ++i, Seq.Next())
+        {
+            const Group G{m_pCtrl + Seq.Offset()};
+            for (auto Match = G.Match(H2); Match; Match.ClearLowestSlot())
+            {
+                const size_t Idx = Seq.Offset() + Match.LowestSlot();
+                if (m_KeyEqual(m_pSlots[Idx].first, Key))
+                    return Idx;
+            }
+            // The probe sequence ends at the first group that has empty slots
+            if (G.MatchEmpty())
+                break;
+        }
+        return m_Capacity;
+    }
+
+    // Returns the index of the first empty or deleted slot in the probe sequence.
+    size_t FindInsertSlot(size_t Hash) const
+    {
+        VERIFY_EXPR(m_Capacity != 0);
+        ProbeSequence Seq{Hash, m_Capacity / Group::Width};
+        while (true)
+        {
+            const Group G{m_pCtrl + Seq.Offset()};
+            if (auto Mask = G.MatchEmptyOrDeleted())
+                return Seq.Offset() + Mask.LowestSlot();
+            Seq.Next();
+        }
+    }
+
+    template <typename ConstructSlotType>
+    std::pair<iterator, bool> InsertUnique(const key_type& Key, ConstructSlotType&& Construct)
+    {
+        const auto Hash = ComputeHash(Key);
+
+        auto Idx = FindSlot(Key, Hash);
+        if (Idx < m_Capacity)
+            return {MakeIterator(Idx), false};
+
+        if (m_Capacity == 0)
+        {
+            Rehash(Group::Width);
+        }
+
+        Idx = FindInsertSlot(Hash);
+        if (m_GrowthLeft == 0 && m_pCtrl[Idx] == FlatHashMapInternal::CtrlEmpty)
+        {
+            // If many slots are occupied by deleted elements, rehash in place to reclaim them.
+            // Otherwise, grow the table.
+            Rehash(m_Size < GetMaxLoad(m_Capacity) / 2 ? m_Capacity : m_Capacity * 2);
+            Idx = FindInsertSlot(Hash);
+        }
+
+        Construct(m_pSlots + Idx);
+        if (m_pCtrl[Idx] == FlatHashMapInternal::CtrlEmpty)
+        {
+            VERIFY_EXPR(m_GrowthLeft > 0);
+            --m_GrowthLeft;
+        }
+        m_pCtrl[Idx] = GetH2(Hash);
+        ++m_Size;
+
+        return {MakeIterator(Idx), true};
+    }
+
+    void EraseSlot(size_t Idx)
+    {
+        VERIFY_EXPR(Idx < m_Capacity && m_pCtrl[Idx] >= 0);
+        DestroySlot(m_pSlots + Idx);
+        --m_Size;
+
+        // If the group has empty slots, no probe sequence has ever passed through it,
+        // so the slot can be marked as empty. Otherwise, it must be marked as deleted to
+        // keep the probe sequences that pass through the group intact.
+        const auto GroupStart = Idx & ~size_t{Group::Width - 1};
+        if (Group{m_pCtrl + GroupStart}.MatchEmpty())
+        {
+            m_pCtrl[Idx] = FlatHashMapInternal::CtrlEmpty;
+            ++m_GrowthLeft;
+        }
+        else
+        {
+            m_pCtrl[Idx] = FlatHashMapInternal::CtrlDeleted;
+        }
+    }
+
+    void Rehash(size_t NewCapacity)
+    {
+        VERIFY_EXPR(NewCapacity >= Group::Width && (NewCapacity & (NewCapacity - 1)) == 0);
+        VERIFY_EXPR(GetMaxLoad(NewCapacity) >= m_Size);
+
+        value_type* const pOldSlots    = m_pSlots;
+        Int8* const       pOldCtrl     = m_pCtrl;
+        const size_t      OldCapacity  = m_Capacity;
+        const size_t      NumCtrlSlots = GetNumCtrlSlots(NewCapacity);
+
+        SlotAllocatorType SlotAllocator{m_Allocator};
+        m_pSlots   = SlotAllocTraits::allocate(SlotAllocator, NewCapacity + NumCtrlSlots);
+        m_pCtrl    = reinterpret_cast<Int8*>(m_pSlots + NewCapacity);
+        m_Capacity = NewCapacity;
+        memset(m_pCtrl, FlatHashMapInternal::CtrlEmpty, NewCapacity);
+        m_GrowthLeft = GetMaxLoad(NewCapacity) - m_Size;
+
+        for (size_t i = 0; i < OldCapacity; ++i)
+        {
+            if (pOldCtrl[i] < 0)
+                continue;
+
+            auto&        OldSlot = pOldSlots[i];
+            const size_t Hash    = ComputeHash(OldSlot.first);
+            const size_t Idx     = FindInsertSlot(Hash);
+            ConstructSlot(m_pSlots + Idx, std::move(const_cast<key_type&>(OldSlot.first)), std::move(OldSlot.second));
+            m_pCtrl[Idx] = GetH2(Hash);
+            DestroySlot(&OldSlot);
+        }
+
+        if (pOldSlots != nullptr)
+            SlotAllocTraits::deallocate(SlotAllocator, pOldSlots, OldCapacity + GetNumCtrlSlots(OldCapacity));
+    }
+
+    // Control bytes are stored after the slots in the same allocation
+    static size_t GetNumCtrlSlots(size_t Capacity)
+    {
+        return (Capacity + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+    template <typename... ArgsType>
+    static void ConstructSlot(value_type* pSlot, ArgsType&&... Args)
+    {
+        new (pSlot) value_type(std::forward<ArgsType>(Args)...);
+    }
+
+    static void DestroySlot(value_type* pSlot)
+    {
+        pSlot->~value_type();
+    }
+
+    void DestroyAllSlots()
+    {
+        if (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (size_t i = 0; i < m_Capacity; ++i)
+            {
+                if (m_pCtrl[i] >= 0)
+                    DestroySlot(m_pSlots + i);
+            }
+        }
+    }
+
+    void FreeStorage()
+    {
+        if (m_pSlots != nullptr)
+        {
+            SlotAllocatorType SlotAllocator{m_Allocator};
+            SlotAllocTraits::deallocate(SlotAllocator, m_pSlots, m_Capacity + GetNumCtrlSlots(m_Capacity));
+        }
+        ResetStorage();
+    }
+
+    void ResetStorage()
+    {
+        m_pSlots     = nullptr;
+        m_pCtrl      = nullptr;
+        m_Capacity   = 0;
+        m_Size       = 0;
+        m_GrowthLeft = 0;
+    }
+
+    iterator MakeIterator(size_t Idx)
+    {
+        return iterator{m_pCtrl + Idx, m_pSlots + Idx, m_pCtrl + m_Capacity};
+    }
+
+private:
+    allocator_type m_Allocator;
+    hasher         m_Hasher;
+    key_equal      m_KeyEqual;
+
+    value_type* m_pSlots     = nullptr;
+    Int8*       m_pCtrl      = nullptr;
+    size_t      m_Capacity   = 0;
+    size_t      m_Size       = 0;
+    size_t      m_GrowthLeft = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Batch frustum culling of bounding boxes.
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+struct IThreadPool;
+
+/// Axis-aligned bounding boxes stored in the structure-of-arrays layout.
+
+/// Every member points to an array of NumBoxes values, where
+/// the i-th element of each array belongs to the i-th box.
+struct BoundBoxSoA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Oriented bounding boxes stored in the structure-of-arrays layout.
+
+/// Every member points to an array of NumBoxes values, where
+/// the i-th element of each array belongs to the i-th box.
+struct OrientedBoundingBoxSoA
+{
+    const float* CenterX = nullptr;
+    const float* CenterY = nullptr;
+    const float* CenterZ = nullptr;
+
+    /// Axes[i][j] is the array of the j-th components of the i-th box axis.
+    const float* Axes[3][3] = {};
+
+    /// HalfExtents[i] is the array of the half extents along the i-th box axis.
+    const float* HalfExtents[3] = {};
+};
+
+/// Computes the visibility of multiple bounding boxes with respect to the view frustum.
+
+/// \param[in]  Frustum     - View frustum.
+/// \param[in]  Boxes       - Bounding boxes, see Diligent::BoundBoxSoA.
+/// \param[in]  NumBoxes    - The number of boxes.
+/// \param[out] pVisibility - An array of NumBoxes elements where the visibility
+///                           of each box will be written.
+/// \param[in]  PlaneFlags  - Frustum planes to test the boxes against.
+/// \param[in]  pThreadPool - Optional thread pool to test blocks of boxes in parallel.
+///
+/// \remarks    The results are identical to calling GetBoxVisibility() for every box.
+///             The boxes are processed with SSE2, AVX2 or NEON instructions
+///             when they are available.
+void GetBoxesVisibility(const ViewFrustum&  Frustum,
+                        const BoundBoxSoA&  Boxes,
+                        size_t              NumBoxes,
+                        BoxVisibility*      pVisibility,
+                        FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                        IThreadPool*        pThreadPool = nullptr);
+
+/// Computes the visibility of multiple bounding boxes with respect to the extended view frustum.
+void GetBoxesVisibility(const ViewFrustumExt& Frustum,
+                        const BoundBoxSoA&    Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                        IThreadPool*          pThreadPool = nullptr);
+
+/// Computes the visibility of multiple oriented bounding boxes with respect to the view frustum.
+void GetBoxesVisibility(const ViewFrustum&            Frustum,
+                        const OrientedBoundingBoxSoA& Boxes,
+                        size_t                        NumBoxes,
+                        BoxVisibility*                pVisibility,
+                        FRUSTUM_PLANE_FLAGS           PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                        IThreadPool*                  pThreadPool = nullptr);
+
+/// Computes the visibility of multiple oriented bounding boxes with respect to the extended view frustum.
+void GetBoxesVisibility(const ViewFrustumExt&         Frustum,
+                        const OrientedBoundingBoxSoA& Boxes,
+                        size_t                        NumBoxes,
+                        BoxVisibility*                pVisibility,
+                        FRUSTUM_PLANE_FLAGS           PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                        IThreadPool*                  pThreadPool = nullptr);
+
+
+/// Computes the visibility mask of multiple bounding boxes with respect to the view frustum.
+
+/// \param[in]  Frustum      - View frustum.
+/// \param[in]  Boxes        - Bounding boxes, see Diligent::BoundBoxSoA.
+/// \param[in]  NumBoxes     - The number of boxes.
+/// \param[out] pVisibleMask - An array of (NumBoxes + 31) / 32 elements. Bit i % 32 of
+///                            element i / 32 is set if the i-th box is at least
+///                            partially visible, and is cleared otherwise.
+/// \param[in]  PlaneFlags   - Frustum planes to test the boxes against.
+/// \param[in]  pThreadPool  - Optional thread pool to test blocks of boxes in parallel.
+void GetBoxesVisibilityMask(const ViewFrustum&  Frustum,
+                            const BoundBoxSoA&  Boxes,
+                            size_t              NumBoxes,
+                            Uint32*             pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                            IThreadPool*        pThreadPool = nullptr);
+
+/// Computes the visibility mask of multiple bounding boxes with respect to the extended view frustum.
+void GetBoxesVisibilityMask(const ViewFrustumExt& Frustum,
+                            const BoundBoxSoA&    Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                            IThreadPool*          pThreadPool = nullptr);
+
+/// Computes the visibility mask of multiple oriented bounding boxes with respect to the view frustum.
+void GetBoxesVisibilityMask(const ViewFrustum&            Frustum,
+                            const OrientedBoundingBoxSoA& Boxes,
+                            size_t                        NumBoxes,
+                            Uint32*                       pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS           PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                            IThreadPool*                  pThreadPool = nullptr);
+
+/// Computes the visibility mask of multiple oriented bounding boxes with respect to the extended view frustum.
+void GetBoxesVisibilityMask(const ViewFrustumExt&         Frustum,
+                            const OrientedBoundingBoxSoA& Boxes,
+                            size_t                        NumBoxes,
+                            Uint32*                       pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS           PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                            IThreadPool*                  pThreadPool = nullptr);
+
+} // namespace Diligent
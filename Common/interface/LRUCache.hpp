@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <deque>
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
 #include <algorithm>
 #include <atomic>
@@ -30,6 +31,97 @@
 namespace Diligent
 {
 
+/// Cache data wrapper that is shared by LRUCache and ShardedLRUCache.
+/// The data is initialized exactly once by the first thread that successfully
+/// runs the initializer; all other threads wait for the initialization to complete.
+template <typename DataType>
+class LRUCacheDataWrapper
+{
+public:
+    enum class DataState
+    {
+        InitFailure = -1,
+        Default,
+        InitializedUnaccounted,
+        InitializedAccounted
+    };
+
+    template <typename InitDataType>
+    const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
+    {
+        // Fast path: the data size is set after the data is initialized and is never reset,
+        // so the data can be safely read without locking the mutex.
+        if (m_DataSize.load() != 0)
+            return m_Data;
+
+        std::lock_guard<std::mutex> Lock{m_InitDataMtx};
+        if (m_DataSize == 0)
+        {
+            VERIFY_EXPR(m_State == DataState::Default || m_State == DataState::InitFailure);
+            m_State.store(DataState::Default); /* <F2D> */
+            try
+            {
+                size_t DataSize = 0;
+                InitData(m_Data, DataSize); // May throw
+                VERIFY_EXPR(DataSize > 0);
+                m_DataSize.store((std::max)(DataSize, size_t{1}));
+                m_State.store(DataState::InitializedUnaccounted); /* <D2U> */
+                IsNewObject = true;                               /* <NewObj> */
+            }
+            catch (...)
+            {
+                m_Data = {};
+                m_State.store(DataState::InitFailure); /* <D2F> */
+                throw;
+            }
+        }
+        else
+        {
+            VERIFY_EXPR(m_State == DataState::InitializedUnaccounted || m_State == DataState::InitializedAccounted);
+            VERIFY_EXPR(m_DataSize != 0);
+        }
+        return m_Data;
+    }
+
+    /// Copies the data if it has been initialized, and returns false otherwise.
+    bool TryGetData(DataType& Data) const
+    {
+        // See GetData()
+        if (m_DataSize.load() == 0)
+            return false;
+
+        Data = m_Data;
+        return true;
+    }
+
+    void SetAccounted()
+    {
+        VERIFY(m_State == DataState::InitializedUnaccounted, "Initializing accounted size for an object that is not initialized.");
+        VERIFY(m_AccountedSize == 0, "Accounted size has already been initialized.");
+        VERIFY(m_DataSize != 0, "Data size has not been initialized.");
+        m_AccountedSize.store(m_DataSize.load());
+        m_State.store(DataState::InitializedAccounted); /* <U2A> */
+    }
+
+    size_t GetAccountedSize() const
+    {
+        VERIFY_EXPR((m_State == DataState::InitializedAccounted && m_AccountedSize != 0) || (m_AccountedSize == 0));
+        return m_AccountedSize.load();
+    }
+
+    DataState GetState() const { return m_State; }
+
+private:
+    std::mutex m_InitDataMtx;
+    DataType   m_Data;
+
+    std::atomic<DataState> m_State{DataState::Default};
+
+    std::atomic<size_t> m_DataSize{0};
+    // The size that was accounted in the cache
+    std::atomic<size_t> m_AccountedSize{0};
+};
+
 /// A thread-safe and exception-safe LRU cache.
 ///
 /// Usage example:
@@ -242,76 +334,7 @@ public:
     }
 
 private:
-    class DataWrapper
-    {
-    public:
-        enum class DataState
-        {
-            InitFailure = -1,
-            Default,
-            InitializedUnaccounted,
-            InitializedAccounted
-        };
-
-        template <typename InitDataType>
-        const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
-        {
-            std::lock_guard<std::mutex> Lock{m_InitDataMtx};
-            if (m_DataSize == 0)
-            {
-                VERIFY_EXPR(m_State == DataState::Default || m_State == DataState::InitFailure);
-                m_State.store(DataState::Default); /* <F2D> */
-                try
-                {
-                    size_t DataSize = 0;
-                    InitData(m_Data, DataSize); // May throw
-                    VERIFY_EXPR(DataSize > 0);
-                    m_DataSize.store((std::max)(DataSize, size_t{1}));
-                    m_State.store(DataState::InitializedUnaccounted); /* <D2U> */
-                    IsNewObject = true;                               /* <NewObj> */
-                }
-                catch (...)
-                {
-                    m_Data = {};
-                    m_State.store(DataState::InitFailure); /* <D2F> */
-                    throw;
-                }
-            }
-            else
-            {
-                VERIFY_EXPR(m_State == DataState::InitializedUnaccounted || m_State == DataState::InitializedAccounted);
-                VERIFY_EXPR(m_DataSize != 0);
-            }
-            return m_Data;
-        }
-
-        void SetAccounted()
-        {
-            VERIFY(m_State == DataState::InitializedUnaccounted, "Initializing accounted size for an object that is not initialized.");
-            VERIFY(m_AccountedSize == 0, "Accounted size has already been initialized.");
-            VERIFY(m_DataSize != 0, "Data size has not been initialized.");
-            m_AccountedSize.store(m_DataSize.load());
-            m_State.store(DataState::InitializedAccounted); /* <U2A> */
-        }
-
-        size_t GetAccountedSize() const
-        {
-            VERIFY_EXPR((m_State == DataState::InitializedAccounted && m_AccountedSize != 0) || (m_AccountedSize == 0));
-            return m_AccountedSize.load();
-        }
-
-        DataState GetState() const { return m_State; }
-
-    private:
-        std::mutex m_InitDataMtx;
-        DataType   m_Data;
-
-        std::atomic<DataState> m_State{DataState::Default};
-
-        std::atomic<size_t> m_DataSize{0};
-        // The size that was accounted in the cache
-        std::atomic<size_t> m_AccountedSize{0};
-    };
+    using DataWrapper = LRUCacheDataWrapper<DataType>;
 
     std::shared_ptr<DataWrapper> GetDataWrapper(const KeyType& Key)
     {
@@ -349,4 +372,275 @@ private:
     std::atomic<size_t> m_MaxSize{0};
 };
 
+/// A thread-safe and exception-safe sharded cache with approximate LRU eviction.
+///
+/// The cache has the same interface and the same data initialization semantics as LRUCache,
+/// but is optimized for read-mostly workloads where many threads access the same keys:
+///
+/// - Keys are distributed between independent shards, each protected by its own reader-writer lock.
+/// - Cache hits only take the shared lock of the shard and copy the data without touching the
+///   entry's reference counter. The exclusive lock is only taken when a new key is added to the
+///   cache, when a new object is accounted for, and during eviction.
+///   The lookup is not lock-free: a reader may copy the data of an entry that is concurrently
+///   evicted, and the entry can only be released once no reader can access it. The shared lock
+///   provides this guarantee without a separate memory reclamation scheme.
+/// - Instead of reordering the LRU queue on every access, a hit only sets the entry's
+///   reference bit. Eviction uses the clock (second-chance) algorithm: entries that were
+///   referenced since the last sweep are spared once.
+///
+/// \note   Similar to LRUCache, the Get() method returns the data by value.
+template <typename KeyType, typename DataType, typename KeyHasher = std::hash<KeyType>>
+class ShardedLRUCache
+{
+public:
+    static constexpr size_t DefaultNumShards = 16;
+
+    explicit ShardedLRUCache(size_t MaxSize = 0, size_t NumShards = DefaultNumShards) noexcept :
+        m_MaxSize{MaxSize},
+        m_Shards(std::max(NumShards, size_t{1}))
+    {}
+
+    /// Finds the data in the cache and returns it. If the data is not found, it is atomically created
+    /// using the provided initializer.
+    ///
+    /// \param [in] Key      - The data key.
+    /// \param [in] InitData - Initializer function that is called if the data is not found in the cache.
+    ///
+    /// \return     Data with the specified key, either retrieved from the cache or initialized with
+    ///             the InitData function.
+    ///
+    /// \remarks    InitData function may throw in case of an error.
+    template <typename InitDataType>
+    DataType Get(const KeyType& Key,
+                 InitDataType&& InitData // May throw
+                 ) noexcept(false)
+    {
+        if (m_MaxSize.load() == 0 && m_CurrSize.load() == 0)
+        {
+            DataType Data;
+            size_t   DataSize = 0;
+            InitData(Data, DataSize); // May throw
+            return Data;
+        }
+
+        const size_t ShardIdx = m_Hasher(Key) % m_Shards.size();
+        Shard&       Shard    = m_Shards[ShardIdx];
+
+        {
+            DataType Data;
+            if (Shard.TryGetData(Key, Data))
+                return Data;
+        }
+
+        // Keep the strong reference to the entry so that it is not destroyed if it is
+        // evicted from the cache by another thread while the data is being initialized.
+        auto pEntry = Shard.FindOrAdd(Key);
+        VERIFY_EXPR(pEntry);
+
+        bool IsNewObject = false;
+        // InitData may throw, which will leave the wrapper in the cache in the 'InitFailure' state.
+        // It will be removed from the cache when it is reached by the clock hand.
+        auto Data = pEntry->Wrapper.GetData(std::forward<InitDataType>(InitData), IsNewObject);
+
+        if (IsNewObject)
+        {
+            // The size is accounted under the shard lock, which makes the state transitions
+            // equivalent to those of LRUCache (see LRUCache::Get()).
+            if (Shard.SetAccounted(pEntry))
+                m_CurrSize += pEntry->Wrapper.GetAccountedSize();
+
+            if (m_CurrSize.load() > m_MaxSize.load())
+                Evict(ShardIdx);
+        }
+
+        return Data;
+    }
+
+    /// Sets the maximum cache size.
+    void SetMaxSize(size_t MaxSize)
+    {
+        m_MaxSize = MaxSize;
+    }
+
+    /// Returns the current cache size.
+    size_t GetCurrSize() const
+    {
+        return m_CurrSize;
+    }
+
+    /// Returns the number of shards.
+    size_t GetNumShards() const
+    {
+        return m_Shards.size();
+    }
+
+    ~ShardedLRUCache()
+    {
+#ifdef DILIGENT_DEBUG
+        size_t DbgSize = 0;
+        for (auto& Shard : m_Shards)
+        {
+            VERIFY_EXPR(Shard.Map.size() == Shard.Clock.size());
+            for (const auto& pEntry : Shard.Clock)
+                DbgSize += pEntry->Wrapper.GetAccountedSize();
+        }
+        VERIFY_EXPR(DbgSize == m_CurrSize);
+#endif
+    }
+
+private:
+    using DataWrapper = LRUCacheDataWrapper<DataType>;
+
+    struct Entry
+    {
+        explicit Entry(const KeyType& _Key) :
+            Key{_Key}
+        {}
+
+        const KeyType Key;
+        DataWrapper   Wrapper;
+
+        // New entries are not referenced, so that a key that is never looked up again is evicted
+        // first, and the sweep does not degrade to FIFO order when all entries are referenced.
+        std::atomic<bool> Referenced{false};
+    };
+
+    using MapType = std::unordered_map<KeyType, std::shared_ptr<Entry>, KeyHasher>;
+
+    struct Shard
+    {
+        // Copies the data of the entry with the given key under the shared lock.
+        // Returns false if the key is not found or the data has not been initialized.
+        bool TryGetData(const KeyType& Key, DataType& Data)
+        {
+            std::shared_lock<std::shared_timed_mutex> Lock{Mtx};
+
+            auto it = Map.find(Key);
+            if (it == Map.end())
+                return false;
+
+            auto& Entry = *it->second;
+            if (!Entry.Wrapper.TryGetData(Data))
+                return false;
+
+            // Avoid writing to the cache line of the hot entries
+            if (!Entry.Referenced.load(std::memory_order_relaxed))
+                Entry.Referenced.store(true, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        std::shared_ptr<Entry> FindOrAdd(const KeyType& Key)
+        {
+            std::lock_guard<std::shared_timed_mutex> Lock{Mtx};
+
+            auto it = Map.find(Key);
+            if (it == Map.end())
+            {
+                it = Map.emplace(Key, std::make_shared<Entry>(Key)).first;
+                Clock.emplace_back(it->second);
+            }
+            else
+            {
+                it->second->Referenced.store(true, std::memory_order_relaxed);
+            }
+            VERIFY_EXPR(Map.size() == Clock.size());
+
+            return it->second;
+        }
+
+        // Returns true if the entry is still in the shard and its size has been accounted for.
+        bool SetAccounted(const std::shared_ptr<Entry>& pEntry)
+        {
+            std::lock_guard<std::shared_timed_mutex> Lock{Mtx};
+            VERIFY_EXPR(pEntry->Wrapper.GetState() == DataWrapper::DataState::InitializedUnaccounted);
+
+            // NB: since the shard lock was released, the entry may have been evicted by
+            //     another thread. In this case it is a dangling entry that will be released
+            //     when the last reference to it is gone.
+            auto it = Map.find(pEntry->Key);
+            if (it == Map.end() || it->second != pEntry)
+                return false;
+
+            pEntry->Wrapper.SetAccounted();
+            return true;
+        }
+
+        // Runs the clock hand over the shard and evicts entries until the cache size is
+        // not greater than MaxSize or all entries have been visited twice.
+        void Evict(std::atomic<size_t>& CurrSize, size_t MaxSize, std::vector<std::shared_ptr<Entry>>& DeleteList)
+        {
+            std::lock_guard<std::shared_timed_mutex> Lock{Mtx};
+
+            // Every entry is visited at most twice: first to clear its reference bit,
+            // and second to evict it.
+            for (size_t NumSteps = Clock.size() * 2; NumSteps > 0 && !Clock.empty() && CurrSize.load() > MaxSize; --NumSteps)
+            {
+                if (ClockHand >= Clock.size())
+                    ClockHand = 0;
+
+                auto& pEntry = Clock[ClockHand];
+
+                // See the state transition table in LRUCache::Get().
+                // Objects in Default and InitializedUnaccounted states are skipped as they are
+                // being initialized or accounted for by other threads.
+                const auto State = pEntry->Wrapper.GetState();
+                if (State == DataWrapper::DataState::Default || State == DataWrapper::DataState::InitializedUnaccounted)
+                {
+                    ++ClockHand;
+                    continue;
+                }
+
+                if (pEntry->Referenced.exchange(false, std::memory_order_relaxed))
+                {
+                    // Give the entry the second chance
+                    ++ClockHand;
+                    continue;
+                }
+
+                const auto AccountedSize = pEntry->Wrapper.GetAccountedSize();
+                VERIFY_EXPR(CurrSize >= AccountedSize);
+                CurrSize -= AccountedSize;
+
+                Map.erase(pEntry->Key);
+                DeleteList.emplace_back(std::move(pEntry));
+                // Swap the last entry in place of the evicted one. The order of the entries is not
+                // important as the clock hand visits all of them.
+                pEntry = std::move(Clock.back());
+                Clock.pop_back();
+            }
+            VERIFY_EXPR(Map.size() == Clock.size());
+        }
+
+        // Readers take the shared lock, while adding, accounting and evicting entries
+        // requires the exclusive lock.
+        std::shared_timed_mutex Mtx;
+
+        MapType Map;
+
+        // Entries in the order they are visited by the clock hand.
+        std::vector<std::shared_ptr<Entry>> Clock;
+        size_t                              ClockHand = 0;
+    };
+
+    void Evict(size_t StartShard)
+    {
+        std::vector<std::shared_ptr<Entry>> DeleteList;
+        // Start with the shard that has just grown and proceed to other shards if that is not enough.
+        for (size_t i = 0; i < m_Shards.size() && m_CurrSize.load() > m_MaxSize.load(); ++i)
+        {
+            m_Shards[(StartShard + i) % m_Shards.size()].Evict(m_CurrSize, m_MaxSize.load(), DeleteList);
+        }
+
+        // Delete objects after releasing the shard locks
+        DeleteList.clear();
+    }
+
+    std::atomic<size_t> m_CurrSize{0};
+    std::atomic<size_t> m_MaxSize{0};
+
+    const KeyHasher    m_Hasher{};
+    std::vector<Shard> m_Shards;
+};
+
 } // namespace Diligent
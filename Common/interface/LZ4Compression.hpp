@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// LZ4 block format compression
+
+#include <cstddef>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Returns the maximum size of the compressed data for the source data of the given size.
+size_t LZ4CompressBound(size_t SrcSize) noexcept;
+
+/// Compresses the data using the LZ4 block format.
+
+/// \param [in]  pSrc        - Source data.
+/// \param [in]  SrcSize     - Source data size.
+/// \param [out] pDst        - Destination buffer.
+/// \param [in]  DstCapacity - Destination buffer size.
+///
+/// \return     The size of the compressed data, or zero if the compressed
+///             data does not fit into the destination buffer.
+///
+/// \remarks    The compressed data is compatible with the LZ4 block format and can be
+///             decompressed by any conforming decoder. The destination buffer of
+///             LZ4CompressBound(SrcSize) bytes is always sufficient.
+size_t LZ4Compress(const void* pSrc, size_t SrcSize, void* pDst, size_t DstCapacity) noexcept;
+
+/// Decompresses the data compressed in the LZ4 block format.
+
+/// \param [in]  pSrc    - Compressed data.
+/// \param [in]  SrcSize - Compressed data size.
+/// \param [out] pDst    - Destination buffer.
+/// \param [in]  DstSize - Expected size of the decompressed data.
+///
+/// \return     true if the data was successfully decompressed and its size is exactly
+///             DstSize, and false otherwise.
+///
+/// \remarks    The input is fully validated, so the function can be safely used
+///             with untrusted data.
+bool LZ4Decompress(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize) noexcept;
+
+} // namespace Diligent
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface that references a memory-mapped file
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that maps the file into the process address space.
+///
+/// The file contents are not read until the corresponding pages are accessed,
+/// so that only the parts of the file that are actually used are loaded into memory.
+/// The mapping is copy-on-write: modifying the data does not affect the file.
+/// If the file can't be mapped, its contents are read into memory.
+class MappedFileDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    /// Maps the file. Returns null if the file can't be opened.
+    static RefCntAutoPtr<MappedFileDataBlob> Create(const Char* FilePath);
+
+    ~MappedFileDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Sets the size of the data buffer.
+    ///
+    /// \remarks    The data are copied to the memory buffer and the file is unmapped.
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the data buffer
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override
+    {
+        return m_Size;
+    }
+
+    /// Returns the pointer to the data buffer
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override
+    {
+        return m_pData;
+    }
+
+    /// Returns const pointer to the data buffer
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override
+    {
+        return m_pData;
+    }
+
+    /// Returns true if the data blob references the file mapping rather than a memory copy
+    bool IsMapped() const
+    {
+        return m_pMapping != nullptr;
+    }
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* FilePath);
+
+    bool Map(const Char* FilePath);
+    void Unmap();
+
+private:
+    void*  m_pData = nullptr;
+    size_t m_Size  = 0;
+
+    // Start of the mapped view, or null if the file is not mapped
+    void* m_pMapping = nullptr;
+
+    // Memory copy of the data that is used when the file is not mapped
+    std::vector<Uint8> m_DataBuff;
+};
+
+} // namespace Diligent
@@ -189,6 +189,26 @@ public:
         static_assert(Mode == SerializerMode::Read || Mode == SerializerMode::Write, "Only Read or Write mode is supported");
     }
 
+    /// Creates the serializer in Read mode.
+
+    /// \param [in] Data          - Serialized data.
+    /// \param [in] InPlaceArrays - Whether SerializeArrayRaw should return pointers into Data
+    ///                             for arrays of trivially serializable elements instead of
+    ///                             copying them to the allocator. In this case, Data must
+    ///                             outlive the deserialized objects.
+    ///
+    /// \remarks Strings and byte arrays always point into Data.
+    Serializer(const SerializedData& Data, bool InPlaceArrays) :
+        // clang-format off
+        m_Start        {static_cast<TPointer>(Data.Ptr())},
+        m_End          {m_Start + Data.Size()},
+        m_Ptr          {m_Start},
+        m_InPlaceArrays{InPlaceArrays}
+    // clang-format on
+    {
+        static_assert(Mode == SerializerMode::Read, "Only Read mode is supported");
+    }
+
     template <typename T>
     TEnable<T> Serialize(ConstQual<T>& Value)
     {
@@ -231,6 +251,13 @@ public:
                         CountType&              Count,
                         ArrayElemSerializerType ElemSerializer);
 
+    /// Serializes the array of elements using the default element serializer.
+    ///
+    /// Arrays of trivially serializable elements are stored as a single block of memory
+    /// that is aligned by the element alignment. In Read mode, if the serializer was
+    /// created with InPlaceArrays flag, Elements is a pointer to const, and the data is
+    /// properly aligned in memory, Elements is set to point into the source data.
+    /// Otherwise, the elements are copied to the allocator.
     template <typename ElemPtrType, typename CountType>
     bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                            ElemPtrType&            Elements,
@@ -292,16 +319,37 @@ public:
 
     static constexpr SerializerMode GetMode() { return Mode; }
 
+    bool HasInPlaceArrays() const { return m_InPlaceArrays; }
+
 private:
     template <typename T>
     bool Copy(T* pData, size_t Size);
 
-    void AlignOffset(size_t Alignment)
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                           ElemPtrType&            Elements,
+                           CountType&              Count,
+                           std::false_type /*IsTrivialElem*/);
+
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                           ElemPtrType&            Elements,
+                           CountType&              Count,
+                           std::true_type /*IsTrivialElem*/);
+
+    bool AlignOffset(size_t Alignment)
     {
         const auto Size       = GetSize();
         const auto AlignShift = AlignUp(Size, Alignment) - Size;
-        VERIFY_EXPR(m_Ptr + AlignShift <= m_End);
+        if (m_Ptr + AlignShift > m_End)
+        {
+            // In Read mode, this happens when the data is truncated or corrupted.
+            // In Write mode, the buffer must have been sized by the Measure mode.
+            VERIFY(Mode == SerializerMode::Read, "Not enough space for the alignment padding");
+            return false;
+        }
         m_Ptr += AlignShift;
+        return true;
     }
 
 private:
@@ -309,6 +357,8 @@ private:
     TPointer const m_End   = nullptr;
 
     TPointer m_Ptr = nullptr;
+
+    const bool m_InPlaceArrays = false;
 };
 
 #define CHECK_REMAINING_SIZE(Size, ...) \
@@ -390,7 +440,8 @@ inline bool Serializer<SerializerMode::Read>::SerializeBytes(VoidPtr pBytes, Con
 
     Size = Size32;
 
-    AlignOffset(Alignment);
+    if (!AlignOffset(Alignment))
+        return false;
 
     CHECK_REMAINING_SIZE(Size, "Note enough data to read ", Size, " bytes.");
 
@@ -406,7 +457,8 @@ inline bool Serializer<Mode>::SerializeBytes(VoidPtr pBytes, ConstQual<size_t>&
     static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
     if (!Serialize<Uint32>(static_cast<Uint32>(Size)))
         return false;
-    AlignOffset(Alignment);
+    if (!AlignOffset(Alignment))
+        return false;
     return Copy(pBytes, Size);
 }
 
@@ -487,6 +539,17 @@ template <typename ElemPtrType, typename CountType>
 bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                                          ElemPtrType&            Elements,
                                          CountType&              Count)
+{
+    using ElemType = RawType<decltype(Elements[0])>;
+    return SerializeArrayRaw(Allocator, Elements, Count, std::integral_constant<bool, IsTriviallySerializable<ElemType>::value>{});
+}
+
+template <SerializerMode Mode>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                         ElemPtrType&            Elements,
+                                         CountType&              Count,
+                                         std::false_type /*IsTrivialElem*/)
 {
     return SerializeArray(Allocator, Elements, Count,
                           [](Serializer<Mode>& Ser, auto& Elem) //
@@ -495,6 +558,66 @@ bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                           });
 }
 
+template <SerializerMode Mode> // Write or Measure
+template <typename ElemPtrType, typename CountType>
+bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                         ElemPtrType&            Elements,
+                                         CountType&              Count,
+                                         std::true_type /*IsTrivialElem*/)
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+    VERIFY_EXPR((Elements != nullptr) == (Count != 0));
+
+    if (!(*this)(Count))
+        return false;
+
+    using ElemType = RawType<decltype(Elements[0])>;
+    if (!AlignOffset(alignof(ElemType)))
+        return false;
+
+    return Count != 0 ? Copy(&Elements[0], sizeof(ElemType) * static_cast<size_t>(Count)) : true;
+}
+
+template <>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<SerializerMode::Read>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                                         ElemPtrType&            Elements,
+                                                         CountType&              Count,
+                                                         std::true_type /*IsTrivialElem*/)
+{
+    VERIFY_EXPR(Allocator != nullptr);
+    VERIFY_EXPR(Elements == nullptr);
+
+    if (!(*this)(Count))
+        return false;
+
+    using ElemType = RawType<decltype(Elements[0])>;
+    if (!AlignOffset(alignof(ElemType)))
+        return false;
+
+    const size_t Size = sizeof(ElemType) * static_cast<size_t>(Count);
+    CHECK_REMAINING_SIZE(Size, "Note enough data to read ", Count, " array elements.");
+    if (Size == 0)
+        return true;
+
+    // Only pointers to const elements may reference the source data
+    using ElemPtrQualType         = std::remove_reference_t<decltype(Elements[0])>*;
+    constexpr bool IsConstElemPtr = std::is_const<std::remove_pointer_t<ElemPtrQualType>>::value;
+    if (IsConstElemPtr && m_InPlaceArrays && reinterpret_cast<size_t>(m_Ptr) % alignof(ElemType) == 0)
+    {
+        Elements = reinterpret_cast<ElemPtrQualType>(const_cast<Uint8*>(m_Ptr));
+    }
+    else
+    {
+        auto* pDstElements = Allocator->Allocate<ElemType>(static_cast<size_t>(Count));
+        std::memcpy(pDstElements, m_Ptr, Size);
+        Elements = pDstElements;
+    }
+    m_Ptr += Size;
+
+    return true;
+}
+
 #undef CHECK_REMAINING_SIZE
 
 } // namespace Diligent
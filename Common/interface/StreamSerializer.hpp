@@ -0,0 +1,481 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::StreamSerializer class
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include "../../Primitives/interface/FileStream.h"
+#include "Serializer.hpp"
+
+namespace Diligent
+{
+
+/// Serializer that reads or writes the data sequentially through a file stream.
+
+/// The data is transferred through a fixed-size staging buffer, so the memory usage does not
+/// depend on the total data size. The data layout is the same as the one produced by
+/// Serializer, so the data written by one class can be read by the other.
+///
+/// In Write mode, the data is flushed to the stream when the staging buffer is full, when
+/// Flush() is called, and when the serializer is destroyed.
+///
+/// In Read mode, the data is read from the beginning of the stream. Strings, byte arrays
+/// and serialized data objects are copied to the allocator passed to the constructor.
+template <SerializerMode Mode>
+class StreamSerializer
+{
+public:
+    template <typename T>
+    using RawType = typename Serializer<Mode>::template RawType<T>;
+
+    template <typename T>
+    using TEnable = typename Serializer<Mode>::template TEnable<T>;
+
+    template <typename T>
+    using TEnableStr = typename Serializer<Mode>::template TEnableStr<T>;
+
+    using CharPtr = typename Serializer<Mode>::CharPtr;
+    using VoidPtr = typename Serializer<Mode>::VoidPtr;
+
+    template <typename T>
+    using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
+
+    static constexpr size_t DefaultStagingBufferSize = size_t{64} << 10u;
+
+    /// \param [in] pStream           - File stream to read the data from or write the data to.
+    /// \param [in] StagingBufferSize - Size of the staging buffer.
+    /// \param [in] pAllocator        - Allocator for strings and byte arrays (Read mode only).
+    explicit StreamSerializer(IFileStream*            pStream,
+                              size_t                  StagingBufferSize = DefaultStagingBufferSize,
+                              DynamicLinearAllocator* pAllocator        = nullptr) :
+        // clang-format off
+        m_pStream   {pStream},
+        m_pAllocator{pAllocator},
+        m_Staging   (std::max(StagingBufferSize, size_t{64}))
+    // clang-format on
+    {
+        static_assert(Mode == SerializerMode::Read || Mode == SerializerMode::Write, "Only Read or Write mode is supported");
+        VERIFY(m_pStream != nullptr, "File stream must not be null");
+        VERIFY(Mode != SerializerMode::Read || m_pAllocator != nullptr, "Allocator is required in Read mode");
+        if (Mode == SerializerMode::Read)
+            m_StreamRemaining = m_pStream->GetSize();
+    }
+
+    ~StreamSerializer()
+    {
+        if (Mode == SerializerMode::Write)
+            Flush();
+    }
+
+    // clang-format off
+    StreamSerializer           (const StreamSerializer&)  = delete;
+    StreamSerializer           (      StreamSerializer&&) = delete;
+    StreamSerializer& operator=(const StreamSerializer&)  = delete;
+    StreamSerializer& operator=(      StreamSerializer&&) = delete;
+    // clang-format on
+
+    template <typename T>
+    TEnable<T> Serialize(ConstQual<T>& Value)
+    {
+        return Copy(&Value, sizeof(Value));
+    }
+
+    // Copies Size bytes to/from pData
+    bool CopyBytes(ConstQual<void>* pData, size_t Size)
+    {
+        return Copy(pData, Size);
+    }
+
+    template <typename T>
+    TEnableStr<T> Serialize(CharPtr Str);
+
+    bool Serialize(ConstQual<SerializedData>& Data);
+
+    /// Serializes Size bytes to/from pBytes, see Serializer::SerializeBytes().
+    bool SerializeBytes(VoidPtr pBytes, ConstQual<size_t>& Size, size_t Alignment = 8);
+
+    template <typename Arg0Type, typename... ArgTypes>
+    bool operator()(Arg0Type& Arg0, ArgTypes&... Args)
+    {
+        if (!Serialize<RawType<Arg0Type>>(Arg0))
+            return false;
+
+        return operator()(Args...);
+    }
+
+    template <typename Arg0Type>
+    bool operator()(Arg0Type& Arg0)
+    {
+        return Serialize<RawType<Arg0Type>>(Arg0);
+    }
+
+    /// Writes the data in the staging buffer to the stream (Write mode only).
+    bool Flush();
+
+    /// Returns the total number of bytes read or written so far.
+    size_t GetSize() const
+    {
+        return m_Offset;
+    }
+
+    /// Returns true if all data has been read from the stream (Read mode only).
+    bool IsEnded() const
+    {
+        static_assert(Mode == SerializerMode::Read, "This method is only allowed in Read mode");
+        return m_StreamRemaining == 0 && m_StagingPos == m_StagingEnd;
+    }
+
+    /// Returns true if a stream operation has failed.
+    bool HasFailed() const
+    {
+        return m_Failed;
+    }
+
+    static constexpr SerializerMode GetMode() { return Mode; }
+
+private:
+    template <typename T>
+    bool Copy(T* pData, size_t Size);
+
+    bool AlignOffset(size_t Alignment);
+
+    // Reads the next portion of the stream data to the staging buffer
+    bool Refill();
+
+    // Returns the number of bytes that have not been read yet (Read mode only)
+    size_t GetRemainingSize() const
+    {
+        return m_StagingEnd - m_StagingPos + m_StreamRemaining;
+    }
+
+    ConstQual<void>* AllocateData(size_t Size, size_t Alignment);
+
+private:
+    IFileStream* const            m_pStream;
+    DynamicLinearAllocator* const m_pAllocator;
+
+    std::vector<Uint8> m_Staging;
+
+    // Read mode:  range [m_StagingPos, m_StagingEnd) contains the data that has not been read yet.
+    // Write mode: range [0, m_StagingPos) contains the data that has not been flushed yet.
+    size_t m_StagingPos = 0;
+    size_t m_StagingEnd = 0;
+
+    // The number of bytes in the stream that have not been read to the staging buffer
+    size_t m_StreamRemaining = 0;
+
+    size_t m_Offset = 0;
+    bool   m_Failed = false;
+};
+
+
+template <>
+inline bool StreamSerializer<SerializerMode::Write>::Flush()
+{
+    if (m_StagingPos == 0 || m_Failed)
+        return !m_Failed;
+
+    if (!m_pStream->Write(m_Staging.data(), m_StagingPos))
+    {
+        LOG_ERROR_MESSAGE("Failed to write ", m_StagingPos, " bytes to the file stream");
+        m_Failed = true;
+    }
+    m_StagingPos = 0;
+    return !m_Failed;
+}
+
+template <>
+inline bool StreamSerializer<SerializerMode::Read>::Flush()
+{
+    UNEXPECTED("Flush is only allowed in Write mode");
+    return false;
+}
+
+
+template <>
+inline bool StreamSerializer<SerializerMode::Read>::Refill()
+{
+    VERIFY_EXPR(m_StagingPos == m_StagingEnd);
+    m_StagingPos = 0;
+    m_StagingEnd = 0;
+
+    const auto ReadSize = std::min(m_Staging.size(), m_StreamRemaining);
+    if (ReadSize == 0)
+        return false;
+
+    if (!m_pStream->Read(m_Staging.data(), ReadSize))
+    {
+        LOG_ERROR_MESSAGE("Failed to read ", ReadSize, " bytes from the file stream");
+        m_Failed          = true;
+        m_StreamRemaining = 0;
+        return false;
+    }
+
+    m_StagingEnd = ReadSize;
+    m_StreamRemaining -= ReadSize;
+    return true;
+}
+
+
+template <>
+template <typename T>
+bool StreamSerializer<SerializerMode::Read>::Copy(T* pData, size_t Size)
+{
+    static_assert(IsAlignedBaseClass<T>::Value, "There is unused space at the end of the structure that may be filled with garbage. Use padding to zero-initialize this space and avoid nasty issues.");
+    if (m_Failed)
+        return false;
+
+    auto* pDst = reinterpret_cast<Uint8*>(pData);
+    while (Size > 0)
+    {
+        if (m_StagingPos == m_StagingEnd)
+        {
+            if (Size >= m_Staging.size() && Size <= m_StreamRemaining)
+            {
+                // Large blocks are read directly to the destination
+                if (!m_pStream->Read(pDst, Size))
+                {
+                    LOG_ERROR_MESSAGE("Failed to read ", Size, " bytes from the file stream");
+                    m_Failed          = true;
+                    m_StreamRemaining = 0;
+                    return false;
+                }
+                m_StreamRemaining -= Size;
+                m_Offset += Size;
+                return true;
+            }
+
+            if (!Refill())
+            {
+                UNEXPECTED("Note enough data to read ", Size, " bytes");
+                return false;
+            }
+        }
+
+        const auto CopySize = std::min(Size, m_StagingEnd - m_StagingPos);
+        std::memcpy(pDst, &m_Staging[m_StagingPos], CopySize);
+        m_StagingPos += CopySize;
+        m_Offset += CopySize;
+        pDst += CopySize;
+        Size -= CopySize;
+    }
+
+    return true;
+}
+
+template <>
+template <typename T>
+bool StreamSerializer<SerializerMode::Write>::Copy(T* pData, size_t Size)
+{
+    static_assert(IsAlignedBaseClass<T>::Value, "There is unused space at the end of the structure that may be filled with garbage. Use padding to zero-initialize this space and avoid nasty issues.");
+    if (m_Failed)
+        return false;
+
+    if (m_StagingPos + Size > m_Staging.size())
+    {
+        if (!Flush())
+            return false;
+
+        if (Size >= m_Staging.size())
+        {
+            // Large blocks are written directly to the stream
+            if (!m_pStream->Write(pData, Size))
+            {
+                LOG_ERROR_MESSAGE("Failed to write ", Size, " bytes to the file stream");
+                m_Failed = true;
+                return false;
+            }
+            m_Offset += Size;
+            return true;
+        }
+    }
+
+    if (Size > 0)
+        std::memcpy(&m_Staging[m_StagingPos], pData, Size);
+    m_StagingPos += Size;
+    m_Offset += Size;
+    return true;
+}
+
+
+template <>
+inline bool StreamSerializer<SerializerMode::Read>::AlignOffset(size_t Alignment)
+{
+    auto PaddingSize = AlignUp(m_Offset, Alignment) - m_Offset;
+    while (PaddingSize > 0)
+    {
+        if (m_StagingPos == m_StagingEnd && !Refill())
+        {
+            UNEXPECTED("Note enough data to read ", PaddingSize, " padding bytes");
+            return false;
+        }
+
+        const auto SkipSize = std::min(PaddingSize, m_StagingEnd - m_StagingPos);
+        m_StagingPos += SkipSize;
+        m_Offset += SkipSize;
+        PaddingSize -= SkipSize;
+    }
+    return true;
+}
+
+template <>
+inline bool StreamSerializer<SerializerMode::Write>::AlignOffset(size_t Alignment)
+{
+    static constexpr Uint8 Padding[64] = {};
+
+    auto PaddingSize = AlignUp(m_Offset, Alignment) - m_Offset;
+    while (PaddingSize > 0)
+    {
+        const auto Size = std::min(PaddingSize, sizeof(Padding));
+        if (!Copy(Padding, Size))
+            return false;
+        PaddingSize -= Size;
+    }
+    return true;
+}
+
+
+template <>
+inline void* StreamSerializer<SerializerMode::Read>::AllocateData(size_t Size, size_t Alignment)
+{
+    return m_pAllocator->Allocate(Size, std::max(Alignment, size_t{1}));
+}
+
+
+template <>
+template <typename T>
+typename StreamSerializer<SerializerMode::Read>::TEnableStr<T> StreamSerializer<SerializerMode::Read>::Serialize(CharPtr Str)
+{
+    Uint32 LenWithNull = 0;
+    if (!Serialize<Uint32>(LenWithNull))
+        return false;
+
+    if (LenWithNull == 0)
+    {
+        Str = "";
+        return true;
+    }
+
+    // Check the size before allocating the memory, since the length may be corrupted
+    if (LenWithNull > GetRemainingSize())
+    {
+        UNEXPECTED("Not enough data to read a string of length ", LenWithNull);
+        return false;
+    }
+
+    auto* pStr = static_cast<char*>(AllocateData(LenWithNull, 1));
+    if (!Copy(pStr, LenWithNull))
+        return false;
+
+    VERIFY_EXPR(strlen(pStr) < LenWithNull);
+    pStr[LenWithNull - 1] = '\0';
+
+    Str = pStr;
+    return true;
+}
+
+template <>
+template <typename T>
+typename StreamSerializer<SerializerMode::Write>::TEnableStr<T> StreamSerializer<SerializerMode::Write>::Serialize(CharPtr Str)
+{
+    const Uint32 LenWithNull = static_cast<Uint32>((Str != nullptr && Str[0] != '\0') ? strlen(Str) + 1 : 0);
+    if (!Serialize<Uint32>(LenWithNull))
+        return false;
+
+    return Copy(Str, LenWithNull);
+}
+
+
+template <>
+inline bool StreamSerializer<SerializerMode::Read>::SerializeBytes(VoidPtr pBytes, ConstQual<size_t>& Size, size_t Alignment)
+{
+    Uint32 Size32 = 0;
+    if (!Serialize<Uint32>(Size32))
+        return false;
+
+    Size = Size32;
+
+    if (!AlignOffset(Alignment))
+        return false;
+
+    if (Size == 0)
+    {
+        pBytes = nullptr;
+        return true;
+    }
+
+    // Check the size before allocating the memory, since the size may be corrupted
+    if (Size > GetRemainingSize())
+    {
+        UNEXPECTED("Not enough data to read ", Size, " bytes");
+        return false;
+    }
+
+    auto* pData = AllocateData(Size, Alignment);
+    if (!Copy(pData, Size))
+        return false;
+
+    pBytes = pData;
+    return true;
+}
+
+template <>
+inline bool StreamSerializer<SerializerMode::Write>::SerializeBytes(VoidPtr pBytes, ConstQual<size_t>& Size, size_t Alignment)
+{
+    if (!Serialize<Uint32>(static_cast<Uint32>(Size)))
+        return false;
+
+    if (!AlignOffset(Alignment))
+        return false;
+
+    return Copy(pBytes, Size);
+}
+
+
+template <>
+inline bool StreamSerializer<SerializerMode::Read>::Serialize(SerializedData& Data)
+{
+    size_t      Size = 0;
+    const void* Ptr  = nullptr;
+    if (!SerializeBytes(Ptr, Size))
+        return false;
+    Data = SerializedData{const_cast<void*>(Ptr), Size};
+    return true;
+}
+
+template <>
+inline bool StreamSerializer<SerializerMode::Write>::Serialize(const SerializedData& Data)
+{
+    return SerializeBytes(Data.Ptr(), Data.Size());
+}
+
+} // namespace Diligent
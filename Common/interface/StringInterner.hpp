@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::StringInterner class
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Handle of the string stored in the StringInterner.
+
+/// Handles of equal strings interned by the same interner are equal,
+/// so interned strings can be compared by pointer.
+class InternedString
+{
+public:
+    InternedString() noexcept {}
+
+    /// Returns the null-terminated string, or null if the handle is null.
+    const Char* GetStr() const
+    {
+        return m_Str;
+    }
+
+    /// Returns the string length, not including the null terminator.
+    size_t GetLength() const
+    {
+        return m_Str != nullptr ? GetHeader().Length : 0;
+    }
+
+    /// Returns the string hash that was computed when the string was interned.
+    size_t GetHash() const
+    {
+        return m_Str != nullptr ? GetHeader().Hash : 0;
+    }
+
+    explicit operator bool() const
+    {
+        return m_Str != nullptr;
+    }
+
+    bool operator==(const InternedString& Rhs) const
+    {
+        return m_Str == Rhs.m_Str;
+    }
+
+    bool operator!=(const InternedString& Rhs) const
+    {
+        return m_Str != Rhs.m_Str;
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const InternedString& Str) const
+        {
+            return Str.GetHash();
+        }
+    };
+
+private:
+    friend class StringInterner;
+
+    // The header is stored in memory right before the string characters
+    struct Header
+    {
+        size_t Hash   = 0;
+        size_t Length = 0;
+    };
+
+    explicit InternedString(const Char* Str) noexcept :
+        m_Str{Str}
+    {}
+
+    const Header& GetHeader() const
+    {
+        VERIFY_EXPR(m_Str != nullptr);
+        return reinterpret_cast<const Header*>(m_Str)[-1];
+    }
+
+private:
+    const Char* m_Str = nullptr;
+};
+
+
+/// Thread-safe string interning table.
+
+/// Every unique string is stored once and is not released until the interner is destroyed,
+/// so the handles are stable. Looking up strings that are already interned does not
+/// take locks: new strings are added under the mutex, and the hash table is published
+/// atomically when it grows.
+class StringInterner
+{
+public:
+    explicit StringInterner(IMemoryAllocator& Allocator       = DefaultRawMemoryAllocator::GetAllocator(),
+                            size_t            InitialCapacity = 1024);
+    ~StringInterner();
+
+    // clang-format off
+    StringInterner           (const StringInterner&)  = delete;
+    StringInterner           (      StringInterner&&) = delete;
+    StringInterner& operator=(const StringInterner&)  = delete;
+    StringInterner& operator=(      StringInterner&&) = delete;
+    // clang-format on
+
+    /// Returns the global interner that lives until the end of the program.
+    static StringInterner& GetGlobal();
+
+    /// Interns the string and returns its handle. Returns null handle if Str is null.
+    InternedString Intern(const Char* Str);
+
+    /// Interns the string of the given length that does not need to be null-terminated.
+    InternedString Intern(const Char* Str, size_t Length);
+
+    InternedString Intern(const String& Str)
+    {
+        return Intern(Str.c_str(), Str.length());
+    }
+
+    /// Returns the handle of the string if it has been interned, and null handle otherwise.
+    /// This method never takes locks.
+    InternedString Find(const Char* Str) const;
+
+    InternedString Find(const Char* Str, size_t Length) const;
+
+    /// Returns the number of unique strings in the interner.
+    size_t GetNumStrings() const
+    {
+        return m_NumStrings.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct HashTable;
+
+    static InternedString FindInTable(const HashTable& Table, const Char* Str, size_t Length, size_t Hash);
+
+    HashTable& CreateTable(size_t Capacity);
+
+private:
+    std::atomic<HashTable*> m_pTable{nullptr};
+    std::atomic<size_t>     m_NumStrings{0};
+
+    std::mutex m_Mtx;
+
+    // All tables created by the interner. Previous tables are kept alive as other
+    // threads may still be reading them.
+    std::vector<std::unique_ptr<HashTable>> m_Tables;
+
+    // String storage
+    DynamicLinearAllocator m_Allocator;
+};
+
+/// Interns the string in the global interner.
+inline InternedString InternString(const Char* Str)
+{
+    return StringInterner::GetGlobal().Intern(Str);
+}
+
+} // namespace Diligent
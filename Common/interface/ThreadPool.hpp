@@ -29,220 +29,41 @@
 #include <atomic>
 #include <functional>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#include <algorithm>
 
 #include "../../Primitives/interface/Object.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
+#include "ThreadPool.h"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
 
-/// Asynchronous task status
-enum ASYNC_TASK_STATUS
+/// Thread pool scheduling mode
+enum THREAD_POOL_MODE
 {
-    /// The asynchronous task status is unknown.
-    ASYNC_TASK_STATUS_UNKNOWN = 0,
-
-    /// The asynchronous task has not been started yet.
-    ASYNC_TASK_STATUS_NOT_STARTED,
-
-    /// The asynchronous task is running.
-    ASYNC_TASK_STATUS_RUNNING,
-
-    /// The asynchronous task was cancelled.
-    ASYNC_TASK_STATUS_CANCELLED,
-
-    /// The asynchronous task is complete.
-    ASYNC_TASK_STATUS_COMPLETE
-};
-
-
-// {B06D1DDA-AEA0-4CFD-969A-C8E2011DC294}
-static const INTERFACE_ID IID_AsyncTask =
-    {0xb06d1dda, 0xaea0, 0x4cfd, {0x96, 0x9a, 0xc8, 0xe2, 0x1, 0x1d, 0xc2, 0x94}};
-
-/// Asynchronous task interface
-class IAsyncTask : public IObject
-{
-public:
-    /// Run the asynchronous task.
-
-    /// \param [in] ThreadId - Id of the thread that is running this task.
-    ///
-    /// \remarks    This method is only called once by the thread pool.
-    ///             Before starting the task, the thread pool sets its
-    ///             status to ASYNC_TASK_STATUS_RUNNING.
-    ///
-    ///             Before returning from the function, the task implementation must
-    ///             set the task status to either ASYNC_TASK_STATUS_CANCELLED or
-    ///             ASYNC_TASK_STATUS_COMPLETE.
-    virtual void Run(Uint32 ThreadId) = 0;
-
-    /// Cancel the task, if possible.
+    /// All tasks are kept in a single priority queue protected by a mutex.
+    /// Tasks with equal priorities are started in the order they were enqueued.
+    THREAD_POOL_MODE_PRIORITY_QUEUE = 0,
+
+    /// Every worker thread owns its own task queue and steals tasks from other
+    /// workers when its queue is empty. Tasks with non-zero priority are kept in
+    /// a separate priority lane: tasks with positive priority are started before
+    /// any task from the worker queues, tasks with negative priority - after all
+    /// worker queues are empty.
     ///
-    /// \remarks    If the task is running, the task implementation should
-    ///             abort the task execution, if possible.
-    virtual void Cancel() = 0;
-
-    /// Sets the task status, see Diligent::ASYNC_TASK_STATUS.
-    virtual void SetStatus(ASYNC_TASK_STATUS Status) = 0;
-
-    /// Gets the task status, see Diligent::ASYNC_TASK_STATUS.
-    virtual ASYNC_TASK_STATUS GetStatus() const = 0;
-
-    /// Sets the task priorirty.
-    virtual void SetPriority(float fPriority) = 0;
-
-    /// Returns the task priorirty.
-    virtual float GetPriority() const = 0;
-
-    /// Checks if the task is finished (i.e. cancelled or complete).
-    virtual bool IsFinished() const = 0;
-
-    /// Waits until the task is complete.
-    ///
-    /// \note   This method must not be called from the same thread that is
-    ///         running the task or a deadlock will occur.
-    virtual void WaitForCompletion() const = 0;
-
-    /// Waits until the tasks is running.
-    ///
-    /// \warning  An application is responsible to make sure that
-    ///           tasks currently in the queue will eventually finish
-    ///           allowing the task to start.
-    ///
-    ///           This method must not be called from the worker thread.
-    virtual void WaitUntilRunning() const = 0;
+    /// \remarks    This mode greatly reduces contention when many small tasks are
+    ///             enqueued and processed by many threads. Tasks with equal priority
+    ///             are not guaranteed to start in the order they were enqueued.
+    THREAD_POOL_MODE_WORK_STEALING
 };
 
-
-// {8BB92B5E-3EAB-4CC3-9DA2-5470DBBA7120}
-static const INTERFACE_ID IID_ThreadPool =
-    {0x8bb92b5e, 0x3eab, 0x4cc3, {0x9d, 0xa2, 0x54, 0x70, 0xdb, 0xba, 0x71, 0x20}};
-
-/// Thread pool interface
-class IThreadPool : public IObject
-{
-public:
-    /// Enqueues asynchronous task for execution.
-
-    /// \param[in] pTask - Task to run.
-    ///
-    /// \remarks   Thread pool will keep a strong reference to the task,
-    ///            so an application is free to release it after enqueuing.
-    virtual void EnqueueTask(IAsyncTask* pTask) = 0;
-
-
-    /// Reprioritizes the task in the queue.
-
-    /// \param[in] pTask - Task to reprioritize.
-    ///
-    /// \return     true if the task was found in the queue and was
-    ///             successfully reprioritized, and false otherwise.
-    ///
-    /// \remarks    When the tasks is enqueued, its priority is used to
-    ///             place it in the priority queue. When an application changes
-    ///             the task priority, it should call this method to update the task
-    ///             position in the queue.
-    virtual bool ReprioritizeTask(IAsyncTask* pTask) = 0;
-
-
-    /// Reprioritizes all tasks in the queue.
-
-    /// \remarks    This method should be called if task priorities have changed
-    ///             to update the positions of all tasks in the queue.
-    virtual void ReprioritizeAllTasks() = 0;
-
-
-    /// Removes the task from the queue, if possible.
-
-    /// \param[in] pTask - Task to remove from the queue.
-    ///
-    /// \return    true if the task was successfully removed from the queue,
-    ///            and false otherwise.
-    virtual bool RemoveTask(IAsyncTask* pTask) = 0;
-
-
-    /// Waits until all tasks in the queue are finished.
-
-    /// \remarks    The method blocks the calling thread until all
-    ///             tasks in the quque are finished and the queue is empty.
-    ///             An application is responsible to make sure that all tasks
-    ///             will finish eventually.
-    virtual void WaitForAllTasks() = 0;
-
-
-    /// Returns the current queue size.
-    virtual Uint32 GetQueueSize() = 0;
-
-    /// Returns the number of currently running tasks
-    virtual Uint32 GetRunningTaskCount() const = 0;
-
-
-    /// Stops all worker threads.
-
-    /// \note   This method makes all worker threads to exit.
-    ///         If an application enqueues tasks after calling this methods,
-    ///         this tasks will never run.
-    virtual void StopThreads() = 0;
-
-
-    /// Manually processes the next task from the queue.
-
-    /// \param[in] ThreadId    - Id of the thread that is running this task.
-    /// \param[in] WaitForTask - whether the function should wait for the next task:
-    ///                          - if true, the function will block the thread until the next task
-    ///                            is retrieved from the queue and processed.
-    ///                          - if false, the function will return immediately if there are no
-    ///                            tasks in the queue.
-    ///
-    /// \return     Whether there are more tasks to process. The calling thread must keep
-    ///             calling the function until it returns false.
-    ///
-    /// \remarks    This method allows an application to implement its own threading strategy.
-    ///             A thread pool may be created with zero threads, and the application may call
-    ///             ProcessTask() method from its own threads.
-    ///
-    ///             An application must keep calling the method until it returns false.
-    ///             If there are unhandled tasks in the queue and the application stops processing
-    ///             them, the thread pool will hang up.
-    ///
-    ///             An example of handling the tasks is shown below:
-    ///
-    ///                 // Initialization
-    ///                 auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{0});
-    ///
-    ///                 std::vector<std::thread> WorkerThreads(4);
-    ///                 for (Uint32 i = 0; i < WorkerThreads.size(); ++i)
-    ///                 {
-    ///                     WorkerThreads[i] = std::thread{
-    ///                         [&ThreadPool = *pThreadPool, i] //
-    ///                         {
-    ///                             while (ThreadPool.ProcessTask(i, true))
-    ///                             {
-    ///                             }
-    ///                         }};
-    ///                 }
-    ///
-    ///                 // Enqueue async tasks
-    ///
-    ///                 pThreadPool->WaitForAllTasks();
-    ///
-    ///                 // Stop all threads in the pool
-    ///                 pThreadPool->StopThreads();
-    ///
-    ///                 // Cleanup (must be done after all threads are stopped)
-    ///                 for (auto& Thread : WorkerThreads)
-    ///                 {
-    ///                     Thread.join();
-    ///                 }
-    ///
-    virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) = 0;
-};
-
-
 /// Thread pool create information
 struct ThreadPoolCreateInfo
 {
@@ -261,6 +82,9 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Thread pool scheduling mode, see Diligent::THREAD_POOL_MODE.
+    THREAD_POOL_MODE Mode = THREAD_POOL_MODE_PRIORITY_QUEUE;
 };
 
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
@@ -281,12 +105,12 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_AsyncTask, TBase)
 
-    virtual void Cancel() override
+    virtual void DILIGENT_CALL_TYPE Cancel() override
     {
         m_bSafelyCancel.store(true);
     }
 
-    virtual void SetStatus(ASYNC_TASK_STATUS Status) override final
+    virtual void DILIGENT_CALL_TYPE SetStatus(ASYNC_TASK_STATUS Status) override final
     {
 #ifdef DILIGENT_DEVELOPMENT
         if (Status != m_TaskStatus)
@@ -323,53 +147,88 @@ public:
         }
 #endif
         m_TaskStatus.store(Status);
+
+        // Both the status and the number of waiters are sequentially consistent, so either
+        // the waiting thread sees the new status, or we see the waiting thread.
+        if (m_NumWaiters.load() > 0)
+        {
+            {
+                // Make sure that the waiting thread is blocked on the condition variable.
+                std::lock_guard<std::mutex> Lock{m_StatusMtx};
+            }
+            m_StatusCond.notify_all();
+        }
     }
 
-    ASYNC_TASK_STATUS GetStatus() const override final
+    virtual ASYNC_TASK_STATUS DILIGENT_CALL_TYPE GetStatus() const override final
     {
         return m_TaskStatus.load();
     }
 
-    virtual void SetPriority(float fPriority) override final
+    virtual void DILIGENT_CALL_TYPE SetPriority(float fPriority) override final
     {
         m_fPriority.store(fPriority);
     }
 
-    virtual float GetPriority() const override final
+    virtual float DILIGENT_CALL_TYPE GetPriority() const override final
     {
         return m_fPriority.load();
     }
 
-    virtual bool IsFinished() const override final
+    virtual Bool DILIGENT_CALL_TYPE IsFinished() const override final
     {
         static_assert(ASYNC_TASK_STATUS_COMPLETE > ASYNC_TASK_STATUS_CANCELLED && ASYNC_TASK_STATUS_CANCELLED > ASYNC_TASK_STATUS_RUNNING,
                       "Unexpected enum values");
         return m_TaskStatus.load() >= ASYNC_TASK_STATUS_CANCELLED;
     }
 
-    virtual void WaitForCompletion() const override final
+    virtual void DILIGENT_CALL_TYPE WaitForCompletion() const override final
     {
-        while (!IsFinished())
-            std::this_thread::yield();
+        WaitForStatus([this]() { return IsFinished(); });
     }
 
-    virtual void WaitUntilRunning() const override final
+    virtual void DILIGENT_CALL_TYPE WaitUntilRunning() const override final
     {
-        while (GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED)
-            std::this_thread::yield();
+        WaitForStatus([this]() { return GetStatus() != ASYNC_TASK_STATUS_NOT_STARTED; });
     }
 
 protected:
     std::atomic<bool> m_bSafelyCancel{false};
 
+private:
+    template <typename PredicateType>
+    void WaitForStatus(PredicateType&& Predicate) const
+    {
+        if (Predicate())
+            return;
+
+        // NB: the number of waiters must be incremented before the status is checked
+        //     under the mutex, see SetStatus().
+        m_NumWaiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> Lock{m_StatusMtx};
+            m_StatusCond.wait(Lock, Predicate);
+        }
+        m_NumWaiters.fetch_add(-1);
+    }
+
 private:
     std::atomic<float>             m_fPriority{0};
     std::atomic<ASYNC_TASK_STATUS> m_TaskStatus{ASYNC_TASK_STATUS_NOT_STARTED};
+
+    // Threads blocked in WaitForCompletion() or WaitUntilRunning()
+    mutable std::atomic<int>        m_NumWaiters{0};
+    mutable std::mutex              m_StatusMtx;
+    mutable std::condition_variable m_StatusCond;
 };
 
 
 template <typename HanlderType>
-RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
+                                           IAsyncTask**  ppPrerequisites,
+                                           Uint32        NumPrerequisites,
+                                           HanlderType   Handler,
+                                           float         fPriority = 0)
 {
     class TaskImpl final : public AsyncTaskBase
     {
@@ -381,7 +240,7 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
             m_Handler{std::move(Handler)}
         {}
 
-        virtual void Run(Uint32 ThreadId) override final
+        virtual void DILIGENT_CALL_TYPE Run(Uint32 ThreadId) override final
         {
             m_Handler(ThreadId);
             SetStatus(ASYNC_TASK_STATUS_COMPLETE);
@@ -392,9 +251,214 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
     };
 
     RefCntAutoPtr<TaskImpl> pTask{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
-    pThreadPool->EnqueueTask(pTask);
+    pThreadPool->EnqueueTask(pTask, ppPrerequisites, NumPrerequisites);
 
     return pTask;
 }
 
+template <typename HanlderType>
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+{
+    return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority);
+}
+
+/// Hands out chunks of the index range to the threads that participate
+/// in ParallelFor() and ParallelReduce().
+template <typename IndexType, typename BodyType>
+class ParallelRange
+{
+public:
+    ParallelRange(IndexType Begin,
+                  IndexType End,
+                  IndexType Grain,
+                  Uint32    NumParticipants,
+                  BodyType& Body) noexcept :
+        m_End{End},
+        m_Grain{std::max(Grain, IndexType{1})},
+        m_NumParticipants{static_cast<IndexType>(std::max(NumParticipants, 1u))},
+        m_Body{Body},
+        m_Next{Begin}
+    {}
+
+    /// Claims the next chunk of the range. Returns false if the entire range has been claimed.
+
+    /// \remarks    Chunk size adapts to the remaining work: large chunks are claimed first,
+    ///             and the size then gradually decreases down to the grain size, so that
+    ///             threads that started late or got cheaper chunks can take the remaining work.
+    bool ClaimChunk(IndexType& ChunkBegin, IndexType& ChunkEnd) noexcept
+    {
+        auto Curr = m_Next.load();
+        while (Curr < m_End)
+        {
+            const IndexType Remaining = m_End - Curr;
+            const IndexType ChunkSize = std::min(std::max(m_Grain, static_cast<IndexType>(Remaining / (m_NumParticipants * 2))), Remaining);
+            if (m_Next.compare_exchange_weak(Curr, static_cast<IndexType>(Curr + ChunkSize)))
+            {
+                ChunkBegin = Curr;
+                ChunkEnd   = Curr + ChunkSize;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Processes the range on a helper thread.
+    void RunHelper()
+    {
+        // NB: the counter must be incremented before the range is checked, see Wait().
+        m_NumActiveHelpers.fetch_add(1);
+        // The body must not be accessed if the range has been exhausted as the
+        // thread that called ParallelFor() may have already returned.
+        if (m_Next.load() < m_End)
+            m_Body(*this);
+
+        {
+            std::lock_guard<std::mutex> Lock{m_HelpersMtx};
+            m_NumActiveHelpers.fetch_add(-1);
+        }
+        m_HelpersCond.notify_all();
+    }
+
+    /// Waits until all helper threads that have claimed chunks finish processing.
+    /// Must only be called after the range has been exhausted.
+    void Wait()
+    {
+        VERIFY_EXPR(m_Next.load() >= m_End);
+        // Both the counter and the next index are sequentially consistent, so a helper
+        // that starts after this point will see the exhausted range.
+        std::unique_lock<std::mutex> Lock{m_HelpersMtx};
+        m_HelpersCond.wait(Lock, [this]() { return m_NumActiveHelpers.load() == 0; });
+    }
+
+private:
+    const IndexType m_End;
+    const IndexType m_Grain;
+    const IndexType m_NumParticipants;
+    BodyType&       m_Body;
+
+    std::atomic<IndexType> m_Next;
+
+    std::atomic<int>        m_NumActiveHelpers{0};
+    std::mutex              m_HelpersMtx;
+    std::condition_variable m_HelpersCond;
+};
+
+/// Runs Body(Range) on the calling thread and on the thread pool worker threads.
+template <typename IndexType, typename BodyType>
+void ParallelProcessRange(IThreadPool* pThreadPool, IndexType Begin, IndexType End, IndexType Grain, BodyType&& Body)
+{
+    using RangeType = ParallelRange<IndexType, BodyType>;
+
+    const IndexType NumChunks = (End - Begin + std::max(Grain, IndexType{1}) - 1) / std::max(Grain, IndexType{1});
+
+    // The calling thread is one of the participants, and every worker thread of the pool may help it
+    Uint32 NumHelpers = 0;
+    if (pThreadPool != nullptr && NumChunks > 1)
+    {
+        const auto NumThreads = pThreadPool->GetNumThreads();
+        NumHelpers            = static_cast<Uint32>(std::min(static_cast<IndexType>(NumThreads), static_cast<IndexType>(NumChunks - 1)));
+    }
+
+    // The range is shared with helper tasks that may start after this function returns
+    auto pRange = std::make_shared<RangeType>(Begin, End, Grain, NumHelpers + 1, Body);
+    for (Uint32 i = 0; i < NumHelpers; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [pRange](Uint32 ThreadId) //
+                         {
+                             pRange->RunHelper();
+                         });
+    }
+
+    Body(*pRange);
+
+    if (NumHelpers > 0)
+        pRange->Wait();
+}
+
+
+/// Processes the [Begin, End) range in parallel using the thread pool.
+
+/// \param[in] pThreadPool - Thread pool to use. If null, the range is processed
+///                          on the calling thread.
+/// \param[in] Begin       - Range begin.
+/// \param[in] End         - Range end.
+/// \param[in] Grain       - Minimal number of elements in a chunk.
+/// \param[in] Func        - Function that processes a chunk of the range:
+///
+///                              void Func(IndexType ChunkBegin, IndexType ChunkEnd);
+///
+/// \remarks    The calling thread processes chunks along with the worker threads,
+///             and the function returns when the entire range has been processed.
+///             Chunks are claimed dynamically, so a pool busy with other tasks or
+///             a pool with no threads does not block the caller.
+template <typename IndexType, typename FuncType>
+void ParallelFor(IThreadPool* pThreadPool, IndexType Begin, IndexType End, IndexType Grain, FuncType Func)
+{
+    if (Begin >= End)
+        return;
+
+    ParallelProcessRange(pThreadPool, Begin, End, Grain,
+                         [&Func](auto& Range) //
+                         {
+                             IndexType ChunkBegin = 0;
+                             IndexType ChunkEnd   = 0;
+                             while (Range.ClaimChunk(ChunkBegin, ChunkEnd))
+                                 Func(ChunkBegin, ChunkEnd);
+                         });
+}
+
+
+/// Reduces the [Begin, End) range in parallel using the thread pool.
+
+/// \param[in] pThreadPool - Thread pool to use. If null, the range is processed
+///                          on the calling thread.
+/// \param[in] Begin       - Range begin.
+/// \param[in] End         - Range end.
+/// \param[in] Grain       - Minimal number of elements in a chunk.
+/// \param[in] Identity    - Identity value of the reduction.
+/// \param[in] Func        - Function that accumulates a chunk of the range into the value:
+///
+///                              ValueType Func(IndexType ChunkBegin, IndexType ChunkEnd, ValueType Value);
+///
+/// \param[in] Reduce      - Function that combines two values:
+///
+///                              ValueType Reduce(ValueType Value0, ValueType Value1);
+///
+/// \return    The result of the reduction.
+///
+/// \remarks    Every participating thread accumulates its chunks into its own value
+///             starting from Identity, after which the values are combined with Reduce.
+///             The order in which chunks and values are combined is not defined, so
+///             the Reduce function must be associative and commutative.
+template <typename IndexType, typename ValueType, typename FuncType, typename ReduceType>
+ValueType ParallelReduce(IThreadPool* pThreadPool,
+                         IndexType    Begin,
+                         IndexType    End,
+                         IndexType    Grain,
+                         ValueType    Identity,
+                         FuncType     Func,
+                         ReduceType   Reduce)
+{
+    if (Begin >= End)
+        return Identity;
+
+    std::mutex ResultMtx;
+    ValueType  Result = Identity;
+    ParallelProcessRange(pThreadPool, Begin, End, Grain,
+                         [&](auto& Range) //
+                         {
+                             ValueType Value      = Identity;
+                             IndexType ChunkBegin = 0;
+                             IndexType ChunkEnd   = 0;
+                             while (Range.ClaimChunk(ChunkBegin, ChunkEnd))
+                                 Value = Func(ChunkBegin, ChunkEnd, std::move(Value));
+
+                             std::lock_guard<std::mutex> Lock{ResultMtx};
+                             Result = Reduce(std::move(Result), std::move(Value));
+                         });
+
+    return Result;
+}
+
 } // namespace Diligent
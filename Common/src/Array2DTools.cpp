@@ -27,10 +27,12 @@
 #include "Array2DTools.hpp"
 
 #include <algorithm>
+#include <utility>
 
 #include "Intrinsics.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -127,6 +129,22 @@ bool GetArray2DMinMaxValueAVX2(const float* pData,
 }
 #endif
 
+void GetArray2DMinMaxValueSerial(const float* pData,
+                                 size_t       StrideInFloats,
+                                 Uint32       Width,
+                                 Uint32       Height,
+                                 float&       MinValue,
+                                 float&       MaxValue)
+{
+    MinValue = MaxValue = pData[0];
+#if DILIGENT_AVX2_ENABLED
+    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
+        return;
+#endif
+
+    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+}
+
 } // namespace
 
 void GetArray2DMinMaxValue(const float* pData,
@@ -134,7 +152,8 @@ void GetArray2DMinMaxValue(const float* pData,
                            Uint32       Width,
                            Uint32       Height,
                            float&       MinValue,
-                           float&       MaxValue)
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool)
 {
     if (Width == 0 || Height == 0)
         return;
@@ -143,13 +162,34 @@ void GetArray2DMinMaxValue(const float* pData,
     DEV_CHECK_ERR(Height == 1 || StrideInFloats >= Width, "Row stride (", StrideInFloats, ") must be at least ", Width);
     DEV_CHECK_ERR(AlignDown(pData, alignof(float)) == pData, "Data pointer is not naturally aligned");
 
-    MinValue = MaxValue = pData[0];
-#if DILIGENT_AVX2_ENABLED
-    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
+    if (pThreadPool == nullptr)
+    {
+        GetArray2DMinMaxValueSerial(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
         return;
-#endif
+    }
 
-    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+    // Make sure that every chunk contains enough elements to amortize the scheduling cost
+    constexpr Uint32 MinElementsPerChunk = 16384;
+    const Uint32     RowGrain            = std::max(MinElementsPerChunk / Width, 1u);
+
+    using MinMaxType = std::pair<float, float>;
+
+    const auto MinMax = ParallelReduce(
+        pThreadPool, 0u, Height, RowGrain,
+        MinMaxType{pData[0], pData[0]},
+        [&](Uint32 StartRow, Uint32 EndRow, MinMaxType Value) //
+        {
+            MinMaxType ChunkMinMax;
+            GetArray2DMinMaxValueSerial(pData + StartRow * StrideInFloats, StrideInFloats, Width, EndRow - StartRow, ChunkMinMax.first, ChunkMinMax.second);
+            return MinMaxType{std::min(Value.first, ChunkMinMax.first), std::max(Value.second, ChunkMinMax.second)};
+        },
+        [](const MinMaxType& Value0, const MinMaxType& Value1) //
+        {
+            return MinMaxType{std::min(Value0.first, Value1.first), std::max(Value0.second, Value1.second)};
+        });
+
+    MinValue = MinMax.first;
+    MaxValue = MinMax.second;
 }
 
 } // namespace Diligent
@@ -0,0 +1,463 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 MaxBins = 32;
+
+// Ranges larger than this are binned and partitioned using the thread pool
+constexpr Uint32 MinParallelRangeSize = 16384;
+
+// The minimal size of the subtrees that are built in parallel
+constexpr Uint32 MinParallelSubtreeSize = 4096;
+
+// The cost of traversing a node relative to the cost of testing a primitive
+constexpr float NodeTraversalCost = 1.f;
+
+BoundBox GetEmptyBox()
+{
+    return BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+void Enclose(BoundBox& Box, const BoundBox& Other)
+{
+    Box.Min = std::min(Box.Min, Other.Min);
+    Box.Max = std::max(Box.Max, Other.Max);
+}
+
+void Enclose(BoundBox& Box, const float3& Point)
+{
+    Box.Min = std::min(Box.Min, Point);
+    Box.Max = std::max(Box.Max, Point);
+}
+
+// Returns half of the box surface area, or zero if the box is empty
+float GetHalfArea(const BoundBox& Box)
+{
+    const float3 Size = Box.Max - Box.Min;
+    if (Size.x < 0 || Size.y < 0 || Size.z < 0)
+        return 0;
+    return Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+struct BuildTask
+{
+    Uint32 NodeIdx = 0;
+    Uint32 First   = 0;
+    Uint32 Count   = 0;
+    Uint32 Depth   = 0;
+};
+
+struct RangeBounds
+{
+    // Bounds of the primitive boxes
+    BoundBox Bounds = GetEmptyBox();
+
+    // Bounds of the primitive centroids
+    BoundBox CentroidBounds = GetEmptyBox();
+};
+
+struct Bin
+{
+    BoundBox Bounds = GetEmptyBox();
+    Uint32   Count  = 0;
+};
+
+struct RangeBins
+{
+    Bin Bins[3][MaxBins];
+};
+
+// Maps primitive centroids to bins along each axis
+struct BinMapping
+{
+    BinMapping(const BoundBox& CentroidBounds, Uint32 _NumBins) :
+        Min{CentroidBounds.Min},
+        NumBins{_NumBins}
+    {
+        const float3 Extent = CentroidBounds.Max - CentroidBounds.Min;
+        for (int axis = 0; axis < 3; ++axis)
+            Scale[axis] = Extent[axis] > 0 ? static_cast<float>(NumBins) / Extent[axis] : 0;
+    }
+
+    Uint32 GetBin(const float3& Centroid, int Axis) const
+    {
+        const auto Bin = static_cast<Uint32>(std::max((Centroid[Axis] - Min[Axis]) * Scale[Axis], 0.f));
+        return std::min(Bin, NumBins - 1);
+    }
+
+    float3 Min;
+    float3 Scale;
+    Uint32 NumBins;
+};
+
+class BVHBuilder
+{
+public:
+    BVHBuilder(const BVHCreateInfo& CI, std::vector<BVH::Node>& Nodes, std::vector<Uint32>& PrimIndices) :
+        m_pBoxes{CI.pBoxes},
+        m_MaxLeafSize{std::max(CI.MaxLeafSize, 1u)},
+        m_NumBins{std::min(std::max(CI.NumBins, 2u), MaxBins)},
+        m_Nodes{Nodes},
+        m_PrimIndices{PrimIndices}
+    {
+        DEV_CHECK_ERR(CI.NumBins >= 2 && CI.NumBins <= MaxBins, "The number of bins (", CI.NumBins, ") must be in [2, ", MaxBins, "] range");
+        DEV_CHECK_ERR(CI.MaxLeafSize > 0, "The maximum leaf size must not be zero");
+
+        m_Centroids.resize(CI.NumPrimitives);
+        ParallelFor(CI.pThreadPool, Uint32{0}, CI.NumPrimitives, MinParallelRangeSize,
+                    [this](Uint32 Begin, Uint32 End) {
+                        for (Uint32 i = Begin; i < End; ++i)
+                            m_Centroids[i] = (m_pBoxes[i].Min + m_pBoxes[i].Max) * 0.5f;
+                    });
+    }
+
+    void Build(Uint32 NumPrimitives, IThreadPool* pThreadPool)
+    {
+        m_PrimIndices.resize(NumPrimitives);
+        std::iota(m_PrimIndices.begin(), m_PrimIndices.end(), 0u);
+
+        // Every leaf contains at least one primitive, so a subtree of N primitives
+        // has at most 2N - 1 nodes. This allows assigning node ranges to the subtrees
+        // before they are built, so that they can be built independently.
+        // The unused nodes are removed by Compact().
+        m_Nodes.resize(size_t{NumPrimitives} * 2 - 1);
+
+        const BuildTask Root{0, 0, NumPrimitives, 0};
+        if (pThreadPool == nullptr)
+        {
+            auto pBins = std::make_unique<RangeBins>();
+            BuildSubtree(Root, *pBins);
+            return;
+        }
+
+        // Split the top of the tree until the subtrees are small enough to be
+        // distributed between the threads.
+        const Uint32 NumCores    = std::max(std::thread::hardware_concurrency(), 1u);
+        const Uint32 SubtreeSize = std::max(MinParallelSubtreeSize, NumPrimitives / (NumCores * 8));
+
+        auto pBins = std::make_unique<RangeBins>();
+
+        std::vector<BuildTask> Pending{Root};
+        std::vector<BuildTask> Subtrees;
+        while (!Pending.empty())
+        {
+            const auto Task = Pending.back();
+            Pending.pop_back();
+            if (Task.Count <= SubtreeSize)
+            {
+                Subtrees.push_back(Task);
+                continue;
+            }
+
+            BuildTask Left, Right;
+            if (Split(Task, Left, Right, *pBins, pThreadPool))
+            {
+                Pending.push_back(Left);
+                Pending.push_back(Right);
+            }
+        }
+
+        // Start with the largest subtrees for better load balancing
+        std::sort(Subtrees.begin(), Subtrees.end(), [](const BuildTask& T0, const BuildTask& T1) { return T0.Count > T1.Count; });
+        ParallelFor(pThreadPool, size_t{0}, Subtrees.size(), size_t{1},
+                    [&](size_t Begin, size_t End) {
+                        auto pSubtreeBins = std::make_unique<RangeBins>();
+                        for (size_t i = Begin; i < End; ++i)
+                            BuildSubtree(Subtrees[i], *pSubtreeBins);
+                    });
+    }
+
+    // Removes unused nodes and returns the hierarchy depth
+    Uint32 Compact()
+    {
+        std::vector<BVH::Node> Nodes;
+        Nodes.reserve(m_NumNodes.load());
+
+        Uint32 Depth = 0;
+        CopySubtree(0, 1, Nodes, Depth);
+        VERIFY_EXPR(Nodes.size() == m_NumNodes.load());
+
+        m_Nodes.swap(Nodes);
+        return Depth;
+    }
+
+private:
+    void AccumulateBounds(Uint32 Begin, Uint32 End, RangeBounds& Bounds) const
+    {
+        for (Uint32 i = Begin; i < End; ++i)
+        {
+            const auto PrimIdx = m_PrimIndices[i];
+            Enclose(Bounds.Bounds, m_pBoxes[PrimIdx]);
+            Enclose(Bounds.CentroidBounds, m_Centroids[PrimIdx]);
+        }
+    }
+
+    RangeBounds ComputeBounds(Uint32 First, Uint32 Count, IThreadPool* pThreadPool) const
+    {
+        if (pThreadPool == nullptr || Count < MinParallelRangeSize)
+        {
+            RangeBounds Bounds;
+            AccumulateBounds(First, First + Count, Bounds);
+            return Bounds;
+        }
+
+        return ParallelReduce(
+            pThreadPool, First, First + Count, MinParallelRangeSize, RangeBounds{},
+            [this](Uint32 Begin, Uint32 End, RangeBounds Bounds) {
+                AccumulateBounds(Begin, End, Bounds);
+                return Bounds;
+            },
+            [](RangeBounds Bounds0, const RangeBounds& Bounds1) {
+                Enclose(Bounds0.Bounds, Bounds1.Bounds);
+                Enclose(Bounds0.CentroidBounds, Bounds1.CentroidBounds);
+                return Bounds0;
+            });
+    }
+
+    void AccumulateBins(Uint32 Begin, Uint32 End, const BinMapping& Mapping, RangeBins& Bins) const
+    {
+        for (Uint32 i = Begin; i < End; ++i)
+        {
+            const auto  PrimIdx  = m_PrimIndices[i];
+            const auto& Centroid = m_Centroids[PrimIdx];
+            const auto& Box      = m_pBoxes[PrimIdx];
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                auto& Bin = Bins.Bins[axis][Mapping.GetBin(Centroid, axis)];
+                Enclose(Bin.Bounds, Box);
+                ++Bin.Count;
+            }
+        }
+    }
+
+    void BinPrimitives(Uint32 First, Uint32 Count, const BinMapping& Mapping, IThreadPool* pThreadPool, RangeBins& Bins) const
+    {
+        if (pThreadPool == nullptr || Count < MinParallelRangeSize)
+        {
+            // Only reset the bins that are used
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                for (Uint32 i = 0; i < m_NumBins; ++i)
+                    Bins.Bins[axis][i] = Bin{};
+            }
+            AccumulateBins(First, First + Count, Mapping, Bins);
+            return;
+        }
+
+        Bins = ParallelReduce(
+            pThreadPool, First, First + Count, MinParallelRangeSize, RangeBins{},
+            [&](Uint32 Begin, Uint32 End, RangeBins Value) {
+                AccumulateBins(Begin, End, Mapping, Value);
+                return Value;
+            },
+            [this](RangeBins Bins0, const RangeBins& Bins1) {
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    for (Uint32 i = 0; i < m_NumBins; ++i)
+                    {
+                        Enclose(Bins0.Bins[axis][i].Bounds, Bins1.Bins[axis][i].Bounds);
+                        Bins0.Bins[axis][i].Count += Bins1.Bins[axis][i].Count;
+                    }
+                }
+                return Bins0;
+            });
+    }
+
+    // Initializes the node for the task and splits it into two children.
+    // Returns false if the node was made a leaf.
+    // Bins is the scratch space that is reused between the nodes.
+    bool Split(const BuildTask& Task, BuildTask& Left, BuildTask& Right, RangeBins& Bins, IThreadPool* pThreadPool)
+    {
+        VERIFY_EXPR(Task.Count > 0);
+        m_NumNodes.fetch_add(1);
+
+        const auto Bounds = ComputeBounds(Task.First, Task.Count, pThreadPool);
+
+        auto& Node = m_Nodes[Task.NodeIdx];
+        Node.Min   = Bounds.Bounds.Min;
+        Node.Max   = Bounds.Bounds.Max;
+
+        if (Task.Count == 1 || Task.Depth + 1 >= BVH::MaxDepth)
+        {
+            Node.Offset        = Task.First;
+            Node.NumPrimitives = Task.Count;
+            return false;
+        }
+
+        const BinMapping Mapping{Bounds.CentroidBounds, m_NumBins};
+        BinPrimitives(Task.First, Task.Count, Mapping, pThreadPool, Bins);
+
+        // Find the split with the lowest surface area heuristic cost
+        int    BestAxis = -1;
+        Uint32 BestBin  = 0;
+        float  BestCost = +FLT_MAX;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (Mapping.Scale[axis] == 0)
+                continue;
+
+            // RightCost[i] is the cost of the bins [i, NumBins)
+            float    RightCost[MaxBins] = {};
+            BoundBox RightBounds        = GetEmptyBox();
+            Uint32   RightCount         = 0;
+            for (Uint32 i = m_NumBins - 1; i > 0; --i)
+            {
+                Enclose(RightBounds, Bins.Bins[axis][i].Bounds);
+                RightCount += Bins.Bins[axis][i].Count;
+                RightCost[i] = GetHalfArea(RightBounds) * static_cast<float>(RightCount);
+            }
+
+            BoundBox LeftBounds = GetEmptyBox();
+            Uint32   LeftCount  = 0;
+            for (Uint32 i = 0; i + 1 < m_NumBins; ++i)
+            {
+                Enclose(LeftBounds, Bins.Bins[axis][i].Bounds);
+                LeftCount += Bins.Bins[axis][i].Count;
+                if (LeftCount == 0 || LeftCount == Task.Count)
+                    continue;
+
+                const float Cost = GetHalfArea(LeftBounds) * static_cast<float>(LeftCount) + RightCost[i + 1];
+                if (Cost < BestCost)
+                {
+                    BestAxis = axis;
+                    BestBin  = i;
+                    BestCost = Cost;
+                }
+            }
+        }
+
+        const float NodeArea = GetHalfArea(Bounds.Bounds);
+        const float LeafCost = NodeArea * static_cast<float>(Task.Count);
+        if (Task.Count <= m_MaxLeafSize && (BestAxis < 0 || NodeArea * NodeTraversalCost + BestCost >= LeafCost))
+        {
+            Node.Offset        = Task.First;
+            Node.NumPrimitives = Task.Count;
+            return false;
+        }
+
+        const auto RangeBegin = m_PrimIndices.begin() + Task.First;
+        const auto RangeEnd   = RangeBegin + Task.Count;
+
+        Uint32 LeftCount = 0;
+        if (BestAxis >= 0)
+        {
+            const auto Middle = std::partition(RangeBegin, RangeEnd,
+                                               [&](Uint32 PrimIdx) {
+                                                   return Mapping.GetBin(m_Centroids[PrimIdx], BestAxis) <= BestBin;
+                                               });
+            LeftCount         = static_cast<Uint32>(Middle - RangeBegin);
+        }
+
+        if (LeftCount == 0 || LeftCount == Task.Count)
+        {
+            // All centroids are the same, or the node has to be split even though
+            // splitting is not beneficial: split the range in the middle.
+            const float3 Extent = Bounds.CentroidBounds.Max - Bounds.CentroidBounds.Min;
+            const int    Axis   = Extent.x >= Extent.y && Extent.x >= Extent.z ? 0 : (Extent.y >= Extent.z ? 1 : 2);
+
+            LeftCount = Task.Count / 2;
+            std::nth_element(RangeBegin, RangeBegin + LeftCount, RangeEnd,
+                             [&](Uint32 PrimIdx0, Uint32 PrimIdx1) {
+                                 return m_Centroids[PrimIdx0][Axis] < m_Centroids[PrimIdx1][Axis];
+                             });
+        }
+
+        // The left subtree takes at most 2 * LeftCount - 1 nodes
+        Left  = BuildTask{Task.NodeIdx + 1, Task.First, LeftCount, Task.Depth + 1};
+        Right = BuildTask{Task.NodeIdx + 2 * LeftCount, Task.First + LeftCount, Task.Count - LeftCount, Task.Depth + 1};
+
+        Node.Offset        = Right.NodeIdx;
+        Node.NumPrimitives = 0;
+        return true;
+    }
+
+    void BuildSubtree(const BuildTask& Task, RangeBins& Bins)
+    {
+        BuildTask Left, Right;
+        if (Split(Task, Left, Right, Bins, nullptr))
+        {
+            BuildSubtree(Left, Bins);
+            BuildSubtree(Right, Bins);
+        }
+    }
+
+    Uint32 CopySubtree(Uint32 SrcIdx, Uint32 NodeDepth, std::vector<BVH::Node>& DstNodes, Uint32& Depth) const
+    {
+        const auto DstIdx = static_cast<Uint32>(DstNodes.size());
+        DstNodes.push_back(m_Nodes[SrcIdx]);
+        Depth = std::max(Depth, NodeDepth);
+
+        if (!m_Nodes[SrcIdx].IsLeaf())
+        {
+            CopySubtree(SrcIdx + 1, NodeDepth + 1, DstNodes, Depth);
+            DstNodes[DstIdx].Offset = CopySubtree(m_Nodes[SrcIdx].Offset, NodeDepth + 1, DstNodes, Depth);
+        }
+
+        return DstIdx;
+    }
+
+private:
+    const BoundBox* const m_pBoxes;
+    const Uint32          m_MaxLeafSize;
+    const Uint32          m_NumBins;
+
+    std::vector<BVH::Node>& m_Nodes;
+    std::vector<Uint32>&    m_PrimIndices;
+    std::vector<float3>     m_Centroids;
+
+    std::atomic<Uint32> m_NumNodes{0};
+};
+
+} // namespace
+
+BVH::BVH(const BVHCreateInfo& CI)
+{
+    if (CI.NumPrimitives == 0)
+        return;
+
+    DEV_CHECK_ERR(CI.pBoxes != nullptr, "Primitive bounding boxes must not be null");
+
+    BVHBuilder Builder{CI, m_Nodes, m_PrimIndices};
+    Builder.Build(CI.NumPrimitives, CI.pThreadPool);
+    m_Depth = Builder.Compact();
+}
+
+} // namespace Diligent
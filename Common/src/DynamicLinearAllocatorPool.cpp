@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "DynamicLinearAllocatorPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Every thread gets a unique slot on its first request. Slots are assigned
+// sequentially, so that threads map to different arena slots.
+Uint32 GetThreadSlot()
+{
+    static std::atomic<Uint32> NextSlot{0};
+    static thread_local const Uint32 Slot = NextSlot.fetch_add(1);
+    return Slot;
+}
+
+size_t ComputeNumThreadSlots()
+{
+    // Use twice as many slots as there are hardware threads to reduce the
+    // probability that two active threads share the same slot.
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 1u) * 2;
+
+    size_t NumSlots = 1;
+    while (NumSlots < NumThreads)
+        NumSlots <<= 1;
+    return NumSlots;
+}
+
+void AtomicMax(std::atomic<size_t>& Val, size_t NewVal)
+{
+    auto CurrVal = Val.load(std::memory_order_relaxed);
+    while (CurrVal < NewVal && !Val.compare_exchange_weak(CurrVal, NewVal, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+DynamicLinearAllocatorPool::DynamicLinearAllocatorPool(IMemoryAllocator& RawAllocator, Uint32 BlockSize) :
+    m_ThreadSlots(ComputeNumThreadSlots()),
+    m_RawAllocator{RawAllocator},
+    m_BlockSize{BlockSize}
+{
+    VERIFY(IsPowerOfTwo(BlockSize), "Block size (", BlockSize, ") is not power of two");
+}
+
+DynamicLinearAllocatorPool::~DynamicLinearAllocatorPool()
+{
+    VERIFY(m_NumActiveArenas.load() == 0, "Destroying the pool while ", m_NumActiveArenas.load(), " arena(s) are still in use");
+}
+
+DynamicLinearAllocatorPool::ArenaHandle DynamicLinearAllocatorPool::GetArena()
+{
+    auto& Slot = m_ThreadSlots[GetThreadSlot() & (m_ThreadSlots.size() - 1)];
+
+    Arena* pArena = Slot.pArena.exchange(nullptr, std::memory_order_acquire);
+    if (pArena == nullptr)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_FreeArenas.empty())
+        {
+            pArena = m_FreeArenas.back();
+            m_FreeArenas.pop_back();
+        }
+        else
+        {
+            m_Arenas.emplace_back(std::unique_ptr<Arena>{new Arena{m_RawAllocator, m_BlockSize}});
+            pArena = m_Arenas.back().get();
+        }
+    }
+
+    m_NumActiveArenas.fetch_add(1);
+    m_ReservedSize.fetch_sub(pArena->ReservedSize);
+
+    return ArenaHandle{*this, *pArena};
+}
+
+void DynamicLinearAllocatorPool::ReleaseArena(Arena& A)
+{
+    AtomicMax(m_PeakArenaUsedSize, A.Allocator.GetPeakUsedSize());
+
+    A.Allocator.Discard();
+    A.ReservedSize = A.Allocator.GetReservedSize();
+    m_ReservedSize.fetch_add(A.ReservedSize);
+    m_NumActiveArenas.fetch_sub(1);
+
+    auto&  Slot     = m_ThreadSlots[GetThreadSlot() & (m_ThreadSlots.size() - 1)];
+    Arena* Expected = nullptr;
+    if (!Slot.pArena.compare_exchange_strong(Expected, &A, std::memory_order_release, std::memory_order_relaxed))
+    {
+        // The slot is occupied by another arena - return this one to the shared list.
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_FreeArenas.push_back(&A);
+    }
+}
+
+void DynamicLinearAllocatorPool::ArenaHandle::Release()
+{
+    if (m_pArena != nullptr)
+    {
+        VERIFY_EXPR(m_pPool != nullptr);
+        m_pPool->ReleaseArena(*m_pArena);
+        m_pArena = nullptr;
+        m_pPool  = nullptr;
+    }
+}
+
+DynamicLinearAllocatorPool::Statistics DynamicLinearAllocatorPool::GetStatistics() const
+{
+    Statistics Stats;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        Stats.NumArenas = static_cast<Uint32>(m_Arenas.size());
+    }
+    Stats.NumActiveArenas   = m_NumActiveArenas.load();
+    Stats.ReservedSize      = m_ReservedSize.load();
+    Stats.PeakArenaUsedSize = m_PeakArenaUsedSize.load();
+    return Stats;
+}
+
+} // namespace Diligent
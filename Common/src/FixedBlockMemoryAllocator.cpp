@@ -27,12 +27,66 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <thread>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// The size of the page header, see FixedBlockMemoryAllocator::MemoryPage::Header
+constexpr size_t PageHeaderSize = 16;
+
+// The maximum number of blocks in a thread magazine
+constexpr Uint32 MaxMagazineSize = 64;
+
+// The maximum number of pages in one slab. Slabs grow with the number of pages,
+// so that allocators that only use a few pages do not reserve memory they never use.
+constexpr size_t MaxPagesInSlab = 16;
+
+// The number of blocks whose state is tracked by one bitmap word
+constexpr Uint32 NumBlocksInBitmapWord = 64;
+
+// Returns the offset of the first block in the page that contains NumBlocks blocks.
+// The offset accounts for the page header and the block state bitmap.
+size_t GetBlocksOffset(Uint32 NumBlocks)
+{
+    const size_t NumBitmapWords = (size_t{NumBlocks} + NumBlocksInBitmapWord - 1) / NumBlocksInBitmapWord;
+    return AlignUp(PageHeaderSize + NumBitmapWords * sizeof(Uint64), PageHeaderSize);
+}
+
+size_t GetNextPowerOfTwo(size_t Val)
+{
+    size_t Pow2 = 1;
+    while (Pow2 < Val)
+        Pow2 <<= 1;
+    return Pow2;
+}
+
+// Every thread gets a unique slot on its first allocation. Slots are assigned
+// sequentially, so that threads map to different magazines.
+Uint32 GetThreadSlot()
+{
+    static std::atomic<Uint32> NextSlot{0};
+    static thread_local const Uint32 Slot = NextSlot.fetch_add(1);
+    return Slot;
+}
+
+template <typename LockType>
+void LockAndCountContention(LockType& Lock, std::atomic<Uint64>& NumContentions)
+{
+    if (!Lock.try_lock())
+    {
+        NumContentions.fetch_add(1, std::memory_order_relaxed);
+        Lock.lock();
+    }
+}
+
+} // namespace
+
 #ifdef DILIGENT_DEBUG
 inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 {
@@ -42,25 +96,38 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 #    define FillWithDebugPattern(...)
 #endif
 
-FixedBlockMemoryAllocator::MemoryPage::MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator) :
+FixedBlockMemoryAllocator::MemoryPage::MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator, size_t PageId, void* pPageStart, void* pRawMemory) :
     // clang-format off
     m_NumFreeBlocks       {OwnerAllocator.m_NumBlocksInPage},
     m_NumInitializedBlocks{0},
+    m_pRawMemory          {pRawMemory},
+    m_pPageStart          {pPageStart},
     m_pOwnerAllocator     {&OwnerAllocator}
 // clang-format on
 {
-    const auto PageSize = OwnerAllocator.m_BlockSize * OwnerAllocator.m_NumBlocksInPage;
-    VERIFY_EXPR(PageSize > 0);
-    m_pPageStart = reinterpret_cast<Uint8*>(
-        OwnerAllocator.m_RawMemoryAllocator.Allocate(PageSize, "FixedBlockMemoryAllocator page", __FILE__, __LINE__));
-    m_pNextFreeBlock = m_pPageStart;
-    FillWithDebugPattern(m_pPageStart, NewPageMemPattern, PageSize);
+    static_assert(sizeof(Header) <= PageHeaderSize, "Page header does not fit into the reserved space");
+
+    VERIFY_EXPR(OwnerAllocator.m_PageAlignment >= OwnerAllocator.m_BlocksOffset + OwnerAllocator.m_BlockSize * OwnerAllocator.m_NumBlocksInPage);
+    VERIFY(AlignDown(m_pPageStart, OwnerAllocator.m_PageAlignment) == m_pPageStart, "Page start is not aligned by the page size");
+    FillWithDebugPattern(m_pPageStart, NewPageMemPattern, OwnerAllocator.m_PageAlignment);
+
+    auto* pHeader            = reinterpret_cast<Header*>(m_pPageStart);
+    pHeader->pOwnerAllocator = &OwnerAllocator;
+    pHeader->PageId          = PageId;
+
+    // No blocks are allocated
+    auto* pBitmap = reinterpret_cast<Uint8*>(m_pPageStart) + PageHeaderSize;
+    for (size_t Offset = PageHeaderSize; Offset < OwnerAllocator.m_BlocksOffset; Offset += sizeof(Uint64), pBitmap += sizeof(Uint64))
+        new (pBitmap) std::atomic<Uint64>{0};
+
+    m_pNextFreeBlock = GetBlockStartAddress(0);
 }
 
 FixedBlockMemoryAllocator::MemoryPage::MemoryPage(MemoryPage&& Page) noexcept :
     // clang-format off
     m_NumFreeBlocks       {Page.m_NumFreeBlocks       },
     m_NumInitializedBlocks{Page.m_NumInitializedBlocks},
+    m_pRawMemory          {Page.m_pRawMemory          },
     m_pPageStart          {Page.m_pPageStart          },
     m_pNextFreeBlock      {Page.m_pNextFreeBlock      },
     m_pOwnerAllocator     {Page.m_pOwnerAllocator     }
@@ -68,6 +135,7 @@ FixedBlockMemoryAllocator::MemoryPage::MemoryPage(MemoryPage&& Page) noexcept :
 {
     Page.m_NumFreeBlocks        = 0;
     Page.m_NumInitializedBlocks = 0;
+    Page.m_pRawMemory           = nullptr;
     Page.m_pPageStart           = nullptr;
     Page.m_pNextFreeBlock       = nullptr;
     Page.m_pOwnerAllocator      = nullptr;
@@ -75,21 +143,22 @@ FixedBlockMemoryAllocator::MemoryPage::MemoryPage(MemoryPage&& Page) noexcept :
 
 FixedBlockMemoryAllocator::MemoryPage::~MemoryPage()
 {
-    if (m_pOwnerAllocator)
-        m_pOwnerAllocator->m_RawMemoryAllocator.Free(m_pPageStart);
+    // Only the first page in the slab owns the slab memory
+    if (m_pOwnerAllocator != nullptr && m_pRawMemory != nullptr)
+        m_pOwnerAllocator->m_RawMemoryAllocator.Free(m_pRawMemory);
 }
 
 void* FixedBlockMemoryAllocator::MemoryPage::GetBlockStartAddress(Uint32 BlockIndex) const
 {
     VERIFY_EXPR(m_pOwnerAllocator != nullptr);
     VERIFY(BlockIndex < m_pOwnerAllocator->m_NumBlocksInPage, "Invalid block index");
-    return reinterpret_cast<Uint8*>(m_pPageStart) + BlockIndex * m_pOwnerAllocator->m_BlockSize;
+    return reinterpret_cast<Uint8*>(m_pPageStart) + m_pOwnerAllocator->m_BlocksOffset + BlockIndex * m_pOwnerAllocator->m_BlockSize;
 }
 
 #ifdef DILIGENT_DEBUG
 void FixedBlockMemoryAllocator::MemoryPage::dbgVerifyAddress(const void* pBlockAddr) const
 {
-    size_t Delta = reinterpret_cast<const Uint8*>(pBlockAddr) - reinterpret_cast<Uint8*>(m_pPageStart);
+    size_t Delta = reinterpret_cast<const Uint8*>(pBlockAddr) - reinterpret_cast<const Uint8*>(GetBlockStartAddress(0));
     VERIFY(Delta % m_pOwnerAllocator->m_BlockSize == 0, "Invalid address");
     Uint32 BlockIndex = static_cast<Uint32>(Delta / m_pOwnerAllocator->m_BlockSize);
     VERIFY(BlockIndex < m_pOwnerAllocator->m_NumBlocksInPage, "Invalid block index");
@@ -169,27 +238,73 @@ static size_t AdjustBlockSize(size_t BlockSize)
     return AlignUp(BlockSize, sizeof(void*));
 }
 
+// Pages are aligned by their size rounded up to the power of two
+static size_t ComputePageAlignment(size_t BlockSize, Uint32 NumBlocksInPage)
+{
+    NumBlocksInPage = std::max(NumBlocksInPage, 1u);
+    return GetNextPowerOfTwo(GetBlocksOffset(NumBlocksInPage) + BlockSize * NumBlocksInPage);
+}
+
+// Use all space in the aligned page
+static Uint32 ComputeNumBlocksInPage(size_t BlockSize, Uint32 NumBlocksInPage)
+{
+    if (BlockSize == 0)
+        return NumBlocksInPage;
+
+    const auto PageAlignment = ComputePageAlignment(BlockSize, NumBlocksInPage);
+
+    auto NumBlocks = static_cast<Uint32>((PageAlignment - PageHeaderSize) / BlockSize);
+    // Leave space for the block state bitmap
+    while (GetBlocksOffset(NumBlocks) + BlockSize * NumBlocks > PageAlignment)
+        --NumBlocks;
+    VERIFY_EXPR(NumBlocks >= NumBlocksInPage);
+    return NumBlocks;
+}
+
+static Uint32 ComputeMagazineSize(Uint32 NumBlocksInPage)
+{
+    return std::min(std::max(NumBlocksInPage / 4, 1u), MaxMagazineSize);
+}
+
+static size_t ComputeNumMagazines()
+{
+    // Use twice as many magazines as there are hardware threads to reduce the
+    // probability that two active threads share the same magazine.
+    return GetNextPowerOfTwo(std::max(std::thread::hardware_concurrency(), 1u) * 2);
+}
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
                                                      Uint32            NumBlocksInPage) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
     m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
-    m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
-    m_RawMemoryAllocator{RawMemoryAllocator        },
+    m_Magazines         (ComputeNumMagazines(), STD_ALLOCATOR_RAW_MEM(Magazine, RawMemoryAllocator, "Allocator for vector<Magazine>")),
+    m_RawMemoryAllocator{RawMemoryAllocator},
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_PageAlignment     {ComputePageAlignment(m_BlockSize, NumBlocksInPage)},
+    m_NumBlocksInPage   {ComputeNumBlocksInPage(m_BlockSize, NumBlocksInPage)},
+    m_BlocksOffset      {GetBlocksOffset(m_NumBlocksInPage)},
+    m_MagazineSize      {ComputeMagazineSize(m_NumBlocksInPage)}
 // clang-format on
 {
     // Allocate one page
     if (m_BlockSize > 0)
     {
-        CreateNewPage();
+        CreateNewSlab();
     }
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    // Return all blocks cached by the magazines to the pages
+    for (auto& Mag : m_Magazines)
+    {
+        Threading::SpinLockGuard Guard{Mag.Lock};
+        if (Mag.NumBlocks > 0)
+            FlushMagazine(Mag, Mag.NumBlocks);
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -199,12 +314,134 @@ FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 #endif
 }
 
-void FixedBlockMemoryAllocator::CreateNewPage()
+void FixedBlockMemoryAllocator::CreateNewSlab()
 {
     VERIFY_EXPR(m_BlockSize > 0);
-    m_PagePool.emplace_back(*this);
-    m_AvailablePages.insert(m_PagePool.size() - 1);
-    m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
+
+    // Double the number of pages with every new slab
+    const size_t NumPages = std::min(std::max(m_PagePool.size(), size_t{1}), MaxPagesInSlab);
+
+    const auto PageSize = m_PageAlignment;
+    // Allocate extra space to align the first page by its size. The following pages
+    // are then aligned as well.
+    auto* pRawMemory = m_RawMemoryAllocator.Allocate(PageSize * NumPages + PageSize - 1, "FixedBlockMemoryAllocator slab", __FILE__, __LINE__);
+    auto* pSlabStart = AlignUp(reinterpret_cast<Uint8*>(pRawMemory), PageSize);
+
+    m_PagePool.reserve(m_PagePool.size() + NumPages);
+    for (size_t i = 0; i < NumPages; ++i)
+    {
+        m_PagePool.emplace_back(*this, m_PagePool.size(), pSlabStart + i * PageSize, i == 0 ? pRawMemory : nullptr);
+        m_AvailablePages.insert(m_PagePool.size() - 1);
+    }
+}
+
+size_t FixedBlockMemoryAllocator::GetPageId(const void* pBlockAddr) const
+{
+    const auto* pHeader = reinterpret_cast<const MemoryPage::Header*>(AlignDown(pBlockAddr, m_PageAlignment));
+    VERIFY(pHeader->pOwnerAllocator == this, "The block was not allocated by this allocator");
+#ifdef DILIGENT_DEBUG
+    {
+        const auto Offset = reinterpret_cast<const Uint8*>(pBlockAddr) - reinterpret_cast<const Uint8*>(pHeader);
+        VERIFY(Offset >= static_cast<ptrdiff_t>(m_BlocksOffset) && (Offset - m_BlocksOffset) % m_BlockSize == 0, "Invalid address");
+        VERIFY((Offset - m_BlocksOffset) / m_BlockSize < m_NumBlocksInPage, "Invalid block index");
+    }
+#endif
+    return pHeader->PageId;
+}
+
+bool FixedBlockMemoryAllocator::SetBlockAllocated(void* pBlockAddr, bool Allocated)
+{
+    auto* pPageStart = AlignDown(reinterpret_cast<Uint8*>(pBlockAddr), m_PageAlignment);
+
+    const auto BlockIndex = static_cast<size_t>(reinterpret_cast<Uint8*>(pBlockAddr) - pPageStart - m_BlocksOffset) / m_BlockSize;
+    VERIFY_EXPR(BlockIndex < m_NumBlocksInPage);
+
+    auto*        pBitmap = reinterpret_cast<std::atomic<Uint64>*>(pPageStart + PageHeaderSize);
+    auto&        Word    = pBitmap[BlockIndex / NumBlocksInBitmapWord];
+    const Uint64 Mask    = Uint64{1} << (BlockIndex % NumBlocksInBitmapWord);
+    // The magazine lock orders the accesses to the block itself, so relaxed order is sufficient
+    if (Allocated)
+        return (Word.fetch_or(Mask, std::memory_order_relaxed) & Mask) == 0;
+    else
+        return (Word.fetch_and(~Mask, std::memory_order_relaxed) & Mask) != 0;
+}
+
+FixedBlockMemoryAllocator::Magazine& FixedBlockMemoryAllocator::LockThreadMagazine()
+{
+    // The number of magazines is a power of two
+    auto& Mag = m_Magazines[GetThreadSlot() & (m_Magazines.size() - 1)];
+    LockAndCountContention(Mag.Lock, m_NumMagazineContentions);
+    return Mag;
+}
+
+void FixedBlockMemoryAllocator::RefillMagazine(Magazine& Mag)
+{
+    VERIFY_EXPR(Mag.Lock.is_locked() && Mag.NumBlocks == 0);
+
+    const auto NumBlocksToAllocate = std::max(m_MagazineSize / 2, 1u);
+
+    LockAndCountContention(m_Mutex, m_NumMutexContentions);
+    std::lock_guard<std::mutex> LockGuard{m_Mutex, std::adopt_lock};
+
+    // Keep the order in which the blocks are allocated from the page
+    void** ppTail = &Mag.pHead;
+    for (Uint32 i = 0; i < NumBlocksToAllocate; ++i)
+    {
+        if (m_AvailablePages.empty())
+        {
+            CreateNewSlab();
+        }
+
+        auto  PageId = *m_AvailablePages.begin();
+        auto& Page   = m_PagePool[PageId];
+        auto* Ptr    = Page.Allocate();
+        if (!Page.HasSpace())
+        {
+            m_AvailablePages.erase(m_AvailablePages.begin());
+        }
+
+        *ppTail = Ptr;
+        ppTail  = reinterpret_cast<void**>(Ptr);
+    }
+    *ppTail       = nullptr;
+    Mag.NumBlocks = NumBlocksToAllocate;
+    m_NumMagazineRefills.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FixedBlockMemoryAllocator::FlushMagazine(Magazine& Mag, Uint32 NumBlocksToFlush)
+{
+    VERIFY_EXPR(Mag.Lock.is_locked());
+    VERIFY_EXPR(NumBlocksToFlush > 0 && NumBlocksToFlush <= Mag.NumBlocks);
+
+    // Release the least recently freed blocks from the end of the list
+    void** ppLink = &Mag.pHead;
+    for (Uint32 i = 0; i < Mag.NumBlocks - NumBlocksToFlush; ++i)
+        ppLink = reinterpret_cast<void**>(*ppLink);
+
+    void* pBlocks[MaxMagazineSize];
+    Uint32 NumBlocks = 0;
+    for (void* pBlock = *ppLink; pBlock != nullptr; pBlock = *reinterpret_cast<void**>(pBlock))
+    {
+        VERIFY_EXPR(NumBlocks < MaxMagazineSize);
+        pBlocks[NumBlocks++] = pBlock;
+    }
+    VERIFY_EXPR(NumBlocks == NumBlocksToFlush);
+    *ppLink = nullptr;
+    Mag.NumBlocks -= NumBlocks;
+
+    LockAndCountContention(m_Mutex, m_NumMutexContentions);
+    std::lock_guard<std::mutex> LockGuard{m_Mutex, std::adopt_lock};
+
+    // Return the blocks in the order they were freed
+    for (Uint32 i = NumBlocks; i > 0; --i)
+    {
+        auto* pBlock = pBlocks[i - 1];
+        auto  PageId = GetPageId(pBlock);
+        VERIFY_EXPR(PageId < m_PagePool.size());
+        m_PagePool[PageId].DeAllocate(pBlock);
+        m_AvailablePages.insert(PageId);
+    }
+    m_NumMagazineFlushes.fetch_add(1, std::memory_order_relaxed);
 }
 
 void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
@@ -214,49 +451,66 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     Size = AdjustBlockSize(Size);
     VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
 
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    auto& Mag = LockThreadMagazine();
+    Threading::SpinLockGuard Guard{Mag.Lock, std::adopt_lock};
 
-    if (m_AvailablePages.empty())
+    if (Mag.NumBlocks == 0)
     {
-        CreateNewPage();
+        RefillMagazine(Mag);
     }
 
-    auto  PageId = *m_AvailablePages.begin();
-    auto& Page   = m_PagePool[PageId];
-    auto* Ptr    = Page.Allocate();
-    m_AddrToPageId.insert(std::make_pair(Ptr, PageId));
-    if (!Page.HasSpace())
-    {
-        m_AvailablePages.erase(m_AvailablePages.begin());
-    }
+    void* Ptr = Mag.pHead;
+    VERIFY_EXPR(Ptr != nullptr);
+    Mag.pHead = *reinterpret_cast<void**>(Ptr);
+    --Mag.NumBlocks;
 
+    const auto IsFree = SetBlockAllocated(Ptr, true);
+    VERIFY(IsFree, "The block is already allocated");
+    (void)IsFree;
+    FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
     return Ptr;
 }
 
 void FixedBlockMemoryAllocator::Free(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
-    if (PageIdIt != m_AddrToPageId.end())
+    if (Ptr == nullptr)
     {
-        auto PageId = PageIdIt->second;
-        VERIFY_EXPR(PageId < m_PagePool.size());
-        m_PagePool[PageId].DeAllocate(Ptr);
-        m_AvailablePages.insert(PageId);
-        m_AddrToPageId.erase(PageIdIt);
-        if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
-        {
-            // In current implementation pages are never released!
-            // Note that if we delete a page, all indices past it will be invalid
+        UNEXPECTED("Attempting to free null pointer");
+        return;
+    }
 
-            //m_PagePool.erase(m_PagePool.begin() + PageId);
-            //m_AvailablePages.erase(PageId);
-        }
+#ifdef DILIGENT_DEBUG
+    GetPageId(Ptr); // Verify the address
+#endif
+    if (!SetBlockAllocated(Ptr, false))
+    {
+        // Putting the block into the magazine again would corrupt the free list
+        LOG_ERROR_MESSAGE("The block is not allocated - double freeing memory?");
+        return;
     }
-    else
+    FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+
+    auto& Mag = LockThreadMagazine();
+    Threading::SpinLockGuard Guard{Mag.Lock, std::adopt_lock};
+
+    if (Mag.NumBlocks >= m_MagazineSize)
     {
-        UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+        FlushMagazine(Mag, std::max(m_MagazineSize / 2, 1u));
     }
+
+    *reinterpret_cast<void**>(Ptr) = Mag.pHead;
+    Mag.pHead                      = Ptr;
+    ++Mag.NumBlocks;
+}
+
+FixedBlockMemoryAllocator::Statistics FixedBlockMemoryAllocator::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumMagazineRefills     = m_NumMagazineRefills.load(std::memory_order_relaxed);
+    Stats.NumMagazineFlushes     = m_NumMagazineFlushes.load(std::memory_order_relaxed);
+    Stats.NumMagazineContentions = m_NumMagazineContentions.load(std::memory_order_relaxed);
+    Stats.NumMutexContentions    = m_NumMutexContentions.load(std::memory_order_relaxed);
+    return Stats;
 }
 
 } // namespace Diligent
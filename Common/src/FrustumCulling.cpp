@@ -0,0 +1,539 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrustumCulling.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Intrinsics.hpp"
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Every SIMD implementation provides the same set of operations on vectors of floats and
+// on comparison masks, so that the culling code is written once for all instruction sets.
+// The operations are performed in the same order as in the scalar functions in AdvancedMath.hpp,
+// so that the results are bit-exact.
+
+struct ScalarOps
+{
+    using Vec  = float;
+    using Mask = bool;
+
+    static constexpr size_t Width = 1;
+
+    // clang-format off
+    static Vec    Load(const float* p)       { return *p; }
+    static Vec    Set(float f)               { return f; }
+    static Vec    Add(Vec a, Vec b)          { return a + b; }
+    static Vec    Sub(Vec a, Vec b)          { return a - b; }
+    static Vec    Mul(Vec a, Vec b)          { return a * b; }
+    static Vec    Abs(Vec a)                 { return std::abs(a); }
+    static Mask   Less(Vec a, Vec b)         { return a < b; }
+    static Mask   Greater(Vec a, Vec b)      { return a > b; }
+    static Mask   LessEqual(Vec a, Vec b)    { return a <= b; }
+    static Mask   GreaterEqual(Vec a, Vec b) { return a >= b; }
+    static Mask   Or(Mask a, Mask b)         { return a || b; }
+    static Mask   And(Mask a, Mask b)        { return a && b; }
+    static Mask   AndNot(Mask a, Mask b)     { return a && !b; }
+    static Mask   AllSet()                   { return true; }
+    static Mask   NoneSet()                  { return false; }
+    static Uint32 ToBits(Mask m)             { return m ? 1u : 0u; }
+    // clang-format on
+};
+
+#if DILIGENT_SSE2_ENABLED
+struct SSE2Ops
+{
+    using Vec  = __m128;
+    using Mask = __m128;
+
+    static constexpr size_t Width = 4;
+
+    // clang-format off
+    static Vec    Load(const float* p)       { return _mm_loadu_ps(p); }
+    static Vec    Set(float f)               { return _mm_set1_ps(f); }
+    static Vec    Add(Vec a, Vec b)          { return _mm_add_ps(a, b); }
+    static Vec    Sub(Vec a, Vec b)          { return _mm_sub_ps(a, b); }
+    static Vec    Mul(Vec a, Vec b)          { return _mm_mul_ps(a, b); }
+    static Vec    Abs(Vec a)                 { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Mask   Less(Vec a, Vec b)         { return _mm_cmplt_ps(a, b); }
+    static Mask   Greater(Vec a, Vec b)      { return _mm_cmpgt_ps(a, b); }
+    static Mask   LessEqual(Vec a, Vec b)    { return _mm_cmple_ps(a, b); }
+    static Mask   GreaterEqual(Vec a, Vec b) { return _mm_cmpge_ps(a, b); }
+    static Mask   Or(Mask a, Mask b)         { return _mm_or_ps(a, b); }
+    static Mask   And(Mask a, Mask b)        { return _mm_and_ps(a, b); }
+    static Mask   AndNot(Mask a, Mask b)     { return _mm_andnot_ps(b, a); }
+    static Mask   AllSet()                   { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Mask   NoneSet()                  { return _mm_setzero_ps(); }
+    static Uint32 ToBits(Mask m)             { return static_cast<Uint32>(_mm_movemask_ps(m)); }
+    // clang-format on
+};
+#endif
+
+#if DILIGENT_AVX2_ENABLED
+struct AVX2Ops
+{
+    using Vec  = __m256;
+    using Mask = __m256;
+
+    static constexpr size_t Width = 8;
+
+    // clang-format off
+    static Vec    Load(const float* p)       { return _mm256_loadu_ps(p); }
+    static Vec    Set(float f)               { return _mm256_set1_ps(f); }
+    static Vec    Add(Vec a, Vec b)          { return _mm256_add_ps(a, b); }
+    static Vec    Sub(Vec a, Vec b)          { return _mm256_sub_ps(a, b); }
+    static Vec    Mul(Vec a, Vec b)          { return _mm256_mul_ps(a, b); }
+    static Vec    Abs(Vec a)                 { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Mask   Less(Vec a, Vec b)         { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask   Greater(Vec a, Vec b)      { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask   LessEqual(Vec a, Vec b)    { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask   GreaterEqual(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask   Or(Mask a, Mask b)         { return _mm256_or_ps(a, b); }
+    static Mask   And(Mask a, Mask b)        { return _mm256_and_ps(a, b); }
+    static Mask   AndNot(Mask a, Mask b)     { return _mm256_andnot_ps(b, a); }
+    static Mask   AllSet()                   { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Mask   NoneSet()                  { return _mm256_setzero_ps(); }
+    static Uint32 ToBits(Mask m)             { return static_cast<Uint32>(_mm256_movemask_ps(m)); }
+    // clang-format on
+};
+#endif
+
+#if DILIGENT_NEON_ENABLED
+struct NEONOps
+{
+    using Vec  = float32x4_t;
+    using Mask = uint32x4_t;
+
+    static constexpr size_t Width = 4;
+
+    // clang-format off
+    static Vec    Load(const float* p)       { return vld1q_f32(p); }
+    static Vec    Set(float f)               { return vdupq_n_f32(f); }
+    static Vec    Add(Vec a, Vec b)          { return vaddq_f32(a, b); }
+    static Vec    Sub(Vec a, Vec b)          { return vsubq_f32(a, b); }
+    static Vec    Mul(Vec a, Vec b)          { return vmulq_f32(a, b); }
+    static Vec    Abs(Vec a)                 { return vabsq_f32(a); }
+    static Mask   Less(Vec a, Vec b)         { return vcltq_f32(a, b); }
+    static Mask   Greater(Vec a, Vec b)      { return vcgtq_f32(a, b); }
+    static Mask   LessEqual(Vec a, Vec b)    { return vcleq_f32(a, b); }
+    static Mask   GreaterEqual(Vec a, Vec b) { return vcgeq_f32(a, b); }
+    static Mask   Or(Mask a, Mask b)         { return vorrq_u32(a, b); }
+    static Mask   And(Mask a, Mask b)        { return vandq_u32(a, b); }
+    static Mask   AndNot(Mask a, Mask b)     { return vbicq_u32(a, b); }
+    static Mask   AllSet()                   { return vdupq_n_u32(~0u); }
+    static Mask   NoneSet()                  { return vdupq_n_u32(0); }
+    static Uint32 ToBits(Mask m)
+    {
+        static const uint32_t LaneBits[4] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(m, vld1q_u32(LaneBits)));
+    }
+    // clang-format on
+};
+#endif
+
+// Frustum data shared by all boxes
+struct FrustumCullingData
+{
+    struct PlaneData
+    {
+        float3 Normal;
+        float3 AbsNormal;
+        float  Distance;
+    };
+    PlaneData Planes[ViewFrustum::NUM_PLANES];
+    Uint32    NumPlanes = 0;
+
+    // Whether to test the frustum corners against the box planes
+    bool    TestCorners = false;
+    float3  Corners[8];
+    float3  CornersMin;
+    float3  CornersMax;
+
+    FrustumCullingData(const ViewFrustum& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags)
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1 << plane_idx)) == 0)
+                continue;
+
+            const auto& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            auto& Dst{Planes[NumPlanes++]};
+            Dst.Normal    = Plane.Normal;
+            Dst.AbsNormal = abs(Plane.Normal);
+            Dst.Distance  = Plane.Distance;
+        }
+    }
+
+    FrustumCullingData(const ViewFrustumExt& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags) :
+        FrustumCullingData{static_cast<const ViewFrustum&>(Frustum), PlaneFlags}
+    {
+        TestCorners = (PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) == FRUSTUM_PLANE_FLAG_FULL_FRUSTUM;
+
+        CornersMin = CornersMax = Frustum.FrustumCorners[0];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            Corners[i] = Frustum.FrustumCorners[i];
+            CornersMin = std::min(CornersMin, Corners[i]);
+            CornersMax = std::max(CornersMax, Corners[i]);
+        }
+    }
+};
+
+struct BoxTestResult
+{
+    Uint32 InvisibleBits;
+    Uint32 FullyVisibleBits;
+};
+
+template <typename Ops>
+BoxTestResult TestBoxes(const FrustumCullingData& Frustum, const BoundBoxSoA& Boxes, size_t Offset)
+{
+    using Vec  = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec MinX = Ops::Load(Boxes.MinX + Offset);
+    const Vec MinY = Ops::Load(Boxes.MinY + Offset);
+    const Vec MinZ = Ops::Load(Boxes.MinZ + Offset);
+    const Vec MaxX = Ops::Load(Boxes.MaxX + Offset);
+    const Vec MaxY = Ops::Load(Boxes.MaxY + Offset);
+    const Vec MaxZ = Ops::Load(Boxes.MaxZ + Offset);
+
+    const Vec SumX  = Ops::Add(MaxX, MinX);
+    const Vec SumY  = Ops::Add(MaxY, MinY);
+    const Vec SumZ  = Ops::Add(MaxZ, MinZ);
+    const Vec DiffX = Ops::Sub(MaxX, MinX);
+    const Vec DiffY = Ops::Sub(MaxY, MinY);
+    const Vec DiffZ = Ops::Sub(MaxZ, MinZ);
+    const Vec Half  = Ops::Set(0.5f);
+    const Vec Zero  = Ops::Set(0.f);
+
+    constexpr Uint32 AllBoxesBits = (1u << Ops::Width) - 1u;
+
+    Mask Invisible    = Ops::NoneSet();
+    Mask FullyVisible = Ops::AllSet();
+    for (Uint32 i = 0; i < Frustum.NumPlanes; ++i)
+    {
+        const auto& Plane = Frustum.Planes[i];
+
+        // See GetBoxVisibilityAgainstPlane(const Plane3D&, const BoundBox&)
+        Vec Dot = Ops::Add(Ops::Add(Ops::Mul(SumX, Ops::Set(Plane.Normal.x)), Ops::Mul(SumY, Ops::Set(Plane.Normal.y))), Ops::Mul(SumZ, Ops::Set(Plane.Normal.z)));
+
+        const Vec DistanceToCenter = Ops::Add(Ops::Mul(Dot, Half), Ops::Set(Plane.Distance));
+
+        Dot = Ops::Add(Ops::Add(Ops::Mul(DiffX, Ops::Set(Plane.AbsNormal.x)), Ops::Mul(DiffY, Ops::Set(Plane.AbsNormal.y))), Ops::Mul(DiffZ, Ops::Set(Plane.AbsNormal.z)));
+
+        const Vec ProjHalfLen = Ops::Mul(Dot, Half);
+
+        Invisible    = Ops::Or(Invisible, Ops::Less(DistanceToCenter, Ops::Sub(Zero, ProjHalfLen)));
+        FullyVisible = Ops::And(FullyVisible, Ops::Greater(DistanceToCenter, ProjHalfLen));
+
+        // Similar to the scalar version, stop as soon as all boxes are known to be invisible
+        if (Ops::ToBits(Invisible) == AllBoxesBits)
+            break;
+    }
+
+    if (Frustum.TestCorners)
+    {
+        // See GetBoxVisibility(const ViewFrustumExt&, const BoundBox&, FRUSTUM_PLANE_FLAGS).
+        // All frustum corners are outside of the box min plane if the maximum corner coordinate
+        // is not greater than the plane coordinate, and similarly for the max plane.
+        Mask CornersOutside = Ops::LessEqual(Ops::Set(Frustum.CornersMax.x), MinX);
+        CornersOutside      = Ops::Or(CornersOutside, Ops::LessEqual(Ops::Set(Frustum.CornersMax.y), MinY));
+        CornersOutside      = Ops::Or(CornersOutside, Ops::LessEqual(Ops::Set(Frustum.CornersMax.z), MinZ));
+        CornersOutside      = Ops::Or(CornersOutside, Ops::GreaterEqual(Ops::Set(Frustum.CornersMin.x), MaxX));
+        CornersOutside      = Ops::Or(CornersOutside, Ops::GreaterEqual(Ops::Set(Frustum.CornersMin.y), MaxY));
+        CornersOutside      = Ops::Or(CornersOutside, Ops::GreaterEqual(Ops::Set(Frustum.CornersMin.z), MaxZ));
+
+        // Only boxes that intersect the frustum are tested against the corners
+        Invisible = Ops::Or(Invisible, Ops::AndNot(CornersOutside, FullyVisible));
+    }
+
+    return {Ops::ToBits(Invisible), Ops::ToBits(FullyVisible)};
+}
+
+template <typename Ops>
+BoxTestResult TestBoxes(const FrustumCullingData& Frustum, const OrientedBoundingBoxSoA& Boxes, size_t Offset)
+{
+    using Vec  = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec CenterX = Ops::Load(Boxes.CenterX + Offset);
+    const Vec CenterY = Ops::Load(Boxes.CenterY + Offset);
+    const Vec CenterZ = Ops::Load(Boxes.CenterZ + Offset);
+
+    Vec Axes[3][3];
+    Vec HalfExtents[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+            Axes[i][j] = Ops::Load(Boxes.Axes[i][j] + Offset);
+        HalfExtents[i] = Ops::Load(Boxes.HalfExtents[i] + Offset);
+    }
+
+    const Vec Zero = Ops::Set(0.f);
+
+    constexpr Uint32 AllBoxesBits = (1u << Ops::Width) - 1u;
+
+    Mask Invisible    = Ops::NoneSet();
+    Mask FullyVisible = Ops::AllSet();
+    for (Uint32 i = 0; i < Frustum.NumPlanes; ++i)
+    {
+        const auto& Plane = Frustum.Planes[i];
+
+        const Vec Nx = Ops::Set(Plane.Normal.x);
+        const Vec Ny = Ops::Set(Plane.Normal.y);
+        const Vec Nz = Ops::Set(Plane.Normal.z);
+
+        // See GetBoxVisibilityAgainstPlane(const Plane3D&, const OrientedBoundingBox&)
+        const Vec Distance = Ops::Add(Ops::Add(Ops::Add(Ops::Mul(CenterX, Nx), Ops::Mul(CenterY, Ny)), Ops::Mul(CenterZ, Nz)), Ops::Set(Plane.Distance));
+
+        Vec ProjHalfExtents = Zero;
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            const Vec AxisDotN = Ops::Add(Ops::Add(Ops::Mul(Axes[axis][0], Nx), Ops::Mul(Axes[axis][1], Ny)), Ops::Mul(Axes[axis][2], Nz));
+
+            const Vec Proj  = Ops::Mul(Ops::Abs(AxisDotN), HalfExtents[axis]);
+            ProjHalfExtents = axis == 0 ? Proj : Ops::Add(ProjHalfExtents, Proj);
+        }
+
+        Invisible    = Ops::Or(Invisible, Ops::Less(Distance, Ops::Sub(Zero, ProjHalfExtents)));
+        FullyVisible = Ops::And(FullyVisible, Ops::Greater(Distance, ProjHalfExtents));
+
+        // Similar to the scalar version, stop as soon as all boxes are known to be invisible
+        if (Ops::ToBits(Invisible) == AllBoxesBits)
+            break;
+    }
+
+    // The corner test is relatively expensive, so skip it if all boxes in the group are
+    // either invisible or fully visible.
+    if (Frustum.TestCorners && Ops::ToBits(Ops::Or(Invisible, FullyVisible)) != AllBoxesBits)
+    {
+        // See GetBoxVisibility(const ViewFrustumExt&, const OrientedBoundingBox&, FRUSTUM_PLANE_FLAGS).
+        // The frustum is outside of the box plane if none of the distances from the frustum
+        // corners to the plane is negative.
+        Mask AllOutside[3][2];
+        for (size_t axis = 0; axis < 3; ++axis)
+            AllOutside[axis][0] = AllOutside[axis][1] = Ops::AllSet();
+
+        for (size_t corner = 0; corner < 8; ++corner)
+        {
+            const Vec CornerX = Ops::Sub(Ops::Set(Frustum.Corners[corner].x), CenterX);
+            const Vec CornerY = Ops::Sub(Ops::Set(Frustum.Corners[corner].y), CenterY);
+            const Vec CornerZ = Ops::Sub(Ops::Set(Frustum.Corners[corner].z), CenterZ);
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                const Vec Dot = Ops::Add(Ops::Add(Ops::Mul(CornerX, Axes[axis][0]), Ops::Mul(CornerY, Axes[axis][1])), Ops::Mul(CornerZ, Axes[axis][2]));
+
+                // Positive and negative axis directions
+                AllOutside[axis][0] = Ops::AndNot(AllOutside[axis][0], Ops::Less(Ops::Sub(Dot, HalfExtents[axis]), Zero));
+                AllOutside[axis][1] = Ops::AndNot(AllOutside[axis][1], Ops::Less(Ops::Sub(Ops::Sub(Zero, Dot), HalfExtents[axis]), Zero));
+            }
+        }
+
+        Mask CornersOutside = Ops::NoneSet();
+        for (size_t axis = 0; axis < 3; ++axis)
+            CornersOutside = Ops::Or(CornersOutside, Ops::Or(AllOutside[axis][0], AllOutside[axis][1]));
+
+        // Only boxes that intersect the frustum are tested against the corners
+        Invisible = Ops::Or(Invisible, Ops::AndNot(CornersOutside, FullyVisible));
+    }
+
+    return {Ops::ToBits(Invisible), Ops::ToBits(FullyVisible)};
+}
+
+// Tests boxes [Begin, End) using the widest available instruction set and calls
+// Handler(Offset, Count, Result) for every group of boxes.
+template <typename BoxSoAType, typename HandlerType>
+void ProcessBoxRange(const FrustumCullingData& Frustum, const BoxSoAType& Boxes, size_t Begin, size_t End, HandlerType& Handler)
+{
+    size_t i = Begin;
+#if DILIGENT_AVX2_ENABLED
+    for (; i + AVX2Ops::Width <= End; i += AVX2Ops::Width)
+        Handler(i, AVX2Ops::Width, TestBoxes<AVX2Ops>(Frustum, Boxes, i));
+#endif
+#if DILIGENT_SSE2_ENABLED
+    for (; i + SSE2Ops::Width <= End; i += SSE2Ops::Width)
+        Handler(i, SSE2Ops::Width, TestBoxes<SSE2Ops>(Frustum, Boxes, i));
+#elif DILIGENT_NEON_ENABLED
+    for (; i + NEONOps::Width <= End; i += NEONOps::Width)
+        Handler(i, NEONOps::Width, TestBoxes<NEONOps>(Frustum, Boxes, i));
+#endif
+    for (; i < End; ++i)
+        Handler(i, size_t{1}, TestBoxes<ScalarOps>(Frustum, Boxes, i));
+}
+
+// The number of boxes in a block processed by a single thread. Blocks start at multiples
+// of 32, so that threads never write to the same visibility mask element.
+constexpr size_t BoxBlockSize = 1024;
+
+// Tests all boxes and calls Handler(Offset, Count, Result) for every group of boxes.
+// If the thread pool is not null, blocks of boxes are processed in parallel.
+template <typename BoxSoAType, typename HandlerType>
+void ProcessBoxes(const FrustumCullingData& Frustum, const BoxSoAType& Boxes, size_t NumBoxes, IThreadPool* pThreadPool, HandlerType&& Handler)
+{
+    const size_t NumBlocks = (NumBoxes + BoxBlockSize - 1) / BoxBlockSize;
+    ParallelFor(pThreadPool, size_t{0}, NumBlocks, size_t{1},
+                [&](size_t BlockBegin, size_t BlockEnd) {
+                    ProcessBoxRange(Frustum, Boxes, BlockBegin * BoxBlockSize, std::min(BlockEnd * BoxBlockSize, NumBoxes), Handler);
+                });
+}
+
+template <typename BoxSoAType>
+void WriteBoxesVisibility(const FrustumCullingData& Frustum,
+                          const BoxSoAType&         Boxes,
+                          size_t                    NumBoxes,
+                          BoxVisibility*            pVisibility,
+                          IThreadPool*              pThreadPool)
+{
+    if (NumBoxes == 0)
+        return;
+    DEV_CHECK_ERR(pVisibility != nullptr, "pVisibility must not be null");
+
+    ProcessBoxes(Frustum, Boxes, NumBoxes, pThreadPool,
+                 [pVisibility](size_t Offset, size_t Count, const BoxTestResult& Res) {
+                     for (size_t i = 0; i < Count; ++i)
+                     {
+                         const auto Bit = 1u << i;
+
+                         pVisibility[Offset + i] = (Res.InvisibleBits & Bit) != 0 ?
+                             BoxVisibility::Invisible :
+                             ((Res.FullyVisibleBits & Bit) != 0 ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting);
+                     }
+                 });
+}
+
+template <typename BoxSoAType>
+void WriteBoxesVisibilityMask(const FrustumCullingData& Frustum,
+                              const BoxSoAType&         Boxes,
+                              size_t                    NumBoxes,
+                              Uint32*                   pVisibleMask,
+                              IThreadPool*              pThreadPool)
+{
+    if (NumBoxes == 0)
+        return;
+    DEV_CHECK_ERR(pVisibleMask != nullptr, "pVisibleMask must not be null");
+
+    std::fill(pVisibleMask, pVisibleMask + (NumBoxes + 31) / 32, 0u);
+    ProcessBoxes(Frustum, Boxes, NumBoxes, pThreadPool,
+                 [pVisibleMask](size_t Offset, size_t Count, const BoxTestResult& Res) {
+                     // Groups never straddle the 32-bit word boundary since all group sizes are powers of two
+                     const auto VisibleBits = ~Res.InvisibleBits & ((1u << Count) - 1u);
+                     pVisibleMask[Offset / 32] |= VisibleBits << (Offset % 32);
+                 });
+}
+
+} // namespace
+
+void GetBoxesVisibility(const ViewFrustum&  Frustum,
+                        const BoundBoxSoA&  Boxes,
+                        size_t              NumBoxes,
+                        BoxVisibility*      pVisibility,
+                        FRUSTUM_PLANE_FLAGS PlaneFlags,
+                        IThreadPool*        pThreadPool)
+{
+    WriteBoxesVisibility(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibility, pThreadPool);
+}
+
+void GetBoxesVisibility(const ViewFrustumExt& Frustum,
+                        const BoundBoxSoA&    Boxes,
+                        size_t                NumBoxes,
+                        BoxVisibility*        pVisibility,
+                        FRUSTUM_PLANE_FLAGS   PlaneFlags,
+                        IThreadPool*          pThreadPool)
+{
+    WriteBoxesVisibility(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibility, pThreadPool);
+}
+
+void GetBoxesVisibility(const ViewFrustum&            Frustum,
+                        const OrientedBoundingBoxSoA& Boxes,
+                        size_t                        NumBoxes,
+                        BoxVisibility*                pVisibility,
+                        FRUSTUM_PLANE_FLAGS           PlaneFlags,
+                        IThreadPool*                  pThreadPool)
+{
+    WriteBoxesVisibility(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibility, pThreadPool);
+}
+
+void GetBoxesVisibility(const ViewFrustumExt&         Frustum,
+                        const OrientedBoundingBoxSoA& Boxes,
+                        size_t                        NumBoxes,
+                        BoxVisibility*                pVisibility,
+                        FRUSTUM_PLANE_FLAGS           PlaneFlags,
+                        IThreadPool*                  pThreadPool)
+{
+    WriteBoxesVisibility(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibility, pThreadPool);
+}
+
+void GetBoxesVisibilityMask(const ViewFrustum&  Frustum,
+                            const BoundBoxSoA&  Boxes,
+                            size_t              NumBoxes,
+                            Uint32*             pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS PlaneFlags,
+                            IThreadPool*        pThreadPool)
+{
+    WriteBoxesVisibilityMask(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibleMask, pThreadPool);
+}
+
+void GetBoxesVisibilityMask(const ViewFrustumExt& Frustum,
+                            const BoundBoxSoA&    Boxes,
+                            size_t                NumBoxes,
+                            Uint32*               pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS   PlaneFlags,
+                            IThreadPool*          pThreadPool)
+{
+    WriteBoxesVisibilityMask(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibleMask, pThreadPool);
+}
+
+void GetBoxesVisibilityMask(const ViewFrustum&            Frustum,
+                            const OrientedBoundingBoxSoA& Boxes,
+                            size_t                        NumBoxes,
+                            Uint32*                       pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS           PlaneFlags,
+                            IThreadPool*                  pThreadPool)
+{
+    WriteBoxesVisibilityMask(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibleMask, pThreadPool);
+}
+
+void GetBoxesVisibilityMask(const ViewFrustumExt&         Frustum,
+                            const OrientedBoundingBoxSoA& Boxes,
+                            size_t                        NumBoxes,
+                            Uint32*                       pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS           PlaneFlags,
+                            IThreadPool*                  pThreadPool)
+{
+    WriteBoxesVisibilityMask(FrustumCullingData{Frustum, PlaneFlags}, Boxes, NumBoxes, pVisibleMask, pThreadPool);
+}
+
+} // namespace Diligent
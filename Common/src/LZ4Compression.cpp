@@ -0,0 +1,258 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "LZ4Compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// LZ4 block format parameters, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+constexpr size_t MinMatch     = 4;
+constexpr size_t LastLiterals = 5;     // The last 5 bytes are always literals
+constexpr size_t MFLimit      = 12;    // The last match must start at least 12 bytes before the end of the block
+constexpr size_t MaxOffset    = 65535; // Offsets are encoded with 2 bytes
+constexpr Uint32 HashLog      = 12;
+
+inline Uint32 Read32(const Uint8* pData)
+{
+    Uint32 Value;
+    memcpy(&Value, pData, sizeof(Value));
+    return Value;
+}
+
+inline Uint32 Hash4(Uint32 Value)
+{
+    return (Value * 2654435761u) >> (32 - HashLog);
+}
+
+// Writes the extra length bytes of the literal or match length
+bool WriteLength(Uint8*& pDst, const Uint8* pDstEnd, size_t Length)
+{
+    for (; Length >= 255; Length -= 255)
+    {
+        if (pDst == pDstEnd)
+            return false;
+        *(pDst++) = 255;
+    }
+    if (pDst == pDstEnd)
+        return false;
+    *(pDst++) = static_cast<Uint8>(Length);
+    return true;
+}
+
+bool ReadLength(const Uint8*& pSrc, const Uint8* pSrcEnd, size_t& Length)
+{
+    Uint8 Byte = 0;
+    do
+    {
+        if (pSrc == pSrcEnd || Length > (~size_t{0} >> 1))
+            return false;
+        Byte = *(pSrc++);
+        Length += Byte;
+    } while (Byte == 255);
+    return true;
+}
+
+// Writes the sequence of literals followed by the match. The last sequence has no match (MatchLen == 0).
+bool WriteSequence(Uint8*& pDst, const Uint8* pDstEnd, const Uint8* pLiterals, size_t NumLiterals, size_t Offset, size_t MatchLen)
+{
+    if (pDst == pDstEnd)
+        return false;
+
+    auto* pToken = pDst++;
+    Uint8 Token  = static_cast<Uint8>(std::min(NumLiterals, size_t{15}) << 4);
+    if (NumLiterals >= 15 && !WriteLength(pDst, pDstEnd, NumLiterals - 15))
+        return false;
+
+    if (static_cast<size_t>(pDstEnd - pDst) < NumLiterals)
+        return false;
+    if (NumLiterals > 0)
+        memcpy(pDst, pLiterals, NumLiterals);
+    pDst += NumLiterals;
+
+    if (MatchLen != 0)
+    {
+        VERIFY_EXPR(MatchLen >= MinMatch && Offset > 0 && Offset <= MaxOffset);
+        if (pDstEnd - pDst < 2)
+            return false;
+        *(pDst++) = static_cast<Uint8>(Offset & 0xFF);
+        *(pDst++) = static_cast<Uint8>(Offset >> 8);
+
+        const auto Length = MatchLen - MinMatch;
+        Token |= static_cast<Uint8>(std::min(Length, size_t{15}));
+        if (Length >= 15 && !WriteLength(pDst, pDstEnd, Length - 15))
+            return false;
+    }
+
+    *pToken = Token;
+    return true;
+}
+
+} // namespace
+
+size_t LZ4CompressBound(size_t SrcSize) noexcept
+{
+    return SrcSize + SrcSize / 255 + 16;
+}
+
+size_t LZ4Compress(const void* pSrc, size_t SrcSize, void* pDst, size_t DstCapacity) noexcept
+{
+    VERIFY_EXPR(pSrc != nullptr || SrcSize == 0);
+    VERIFY_EXPR(pDst != nullptr || DstCapacity == 0);
+
+    const auto* const pIn     = static_cast<const Uint8*>(pSrc);
+    auto* const       pOut    = static_cast<Uint8*>(pDst);
+    const auto* const pOutEnd = pOut + DstCapacity;
+
+    auto*  pCurrOut = pOut;
+    size_t Anchor   = 0;
+    if (SrcSize > MFLimit)
+    {
+        // Positions of the last occurrences of 4-byte sequences
+        std::array<Uint32, size_t{1} << HashLog> HashTable{};
+
+        const size_t MatchLimit = SrcSize - LastLiterals;
+        const size_t SearchEnd  = SrcSize - MFLimit;
+
+        size_t Pos = 0;
+        while (Pos <= SearchEnd)
+        {
+            const auto Sequence = Read32(pIn + Pos);
+            auto&      Entry    = HashTable[Hash4(Sequence)];
+            size_t     Cand     = Entry;
+            Entry               = static_cast<Uint32>(Pos);
+
+            if (Cand >= Pos || Pos - Cand > MaxOffset || Read32(pIn + Cand) != Sequence)
+            {
+                // Skip faster through incompressible data
+                Pos += 1 + ((Pos - Anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards
+            while (Pos > Anchor && Cand > 0 && pIn[Pos - 1] == pIn[Cand - 1])
+            {
+                --Pos;
+                --Cand;
+            }
+
+            size_t MatchLen = MinMatch;
+            while (Pos + MatchLen < MatchLimit && pIn[Pos + MatchLen] == pIn[Cand + MatchLen])
+                ++MatchLen;
+
+            if (!WriteSequence(pCurrOut, pOutEnd, pIn + Anchor, Pos - Anchor, Pos - Cand, MatchLen))
+                return 0;
+
+            Pos += MatchLen;
+            Anchor = Pos;
+
+            // Index the position inside the match to improve the ratio on repetitive data
+            if (Pos <= SearchEnd)
+                HashTable[Hash4(Read32(pIn + Pos - 2))] = static_cast<Uint32>(Pos - 2);
+        }
+    }
+
+    if (!WriteSequence(pCurrOut, pOutEnd, pIn + Anchor, SrcSize - Anchor, 0, 0))
+        return 0;
+
+    return static_cast<size_t>(pCurrOut - pOut);
+}
+
+bool LZ4Decompress(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize) noexcept
+{
+    if (pSrc == nullptr || SrcSize == 0 || (pDst == nullptr && DstSize != 0))
+        return false;
+
+    const auto*       pIn     = static_cast<const Uint8*>(pSrc);
+    const auto* const pInEnd  = pIn + SrcSize;
+    auto* const       pOut    = static_cast<Uint8*>(pDst);
+    auto*             pCurr   = pOut;
+    const auto* const pOutEnd = pOut + DstSize;
+
+    while (true)
+    {
+        if (pIn == pInEnd)
+            return false;
+
+        const auto Token = *(pIn++);
+
+        size_t NumLiterals = Token >> 4;
+        if (NumLiterals == 15 && !ReadLength(pIn, pInEnd, NumLiterals))
+            return false;
+
+        if (NumLiterals > static_cast<size_t>(pInEnd - pIn) || NumLiterals > static_cast<size_t>(pOutEnd - pCurr))
+            return false;
+        if (NumLiterals > 0)
+            memcpy(pCurr, pIn, NumLiterals);
+        pIn += NumLiterals;
+        pCurr += NumLiterals;
+
+        // The last sequence contains only literals
+        if (pIn == pInEnd)
+            break;
+
+        if (pInEnd - pIn < 2)
+            return false;
+        const size_t Offset = size_t{pIn[0]} | (size_t{pIn[1]} << 8);
+        pIn += 2;
+        if (Offset == 0 || Offset > static_cast<size_t>(pCurr - pOut))
+            return false;
+
+        size_t MatchLen = Token & 0x0F;
+        if (MatchLen == 15 && !ReadLength(pIn, pInEnd, MatchLen))
+            return false;
+        MatchLen += MinMatch;
+        if (MatchLen > static_cast<size_t>(pOutEnd - pCurr))
+            return false;
+
+        const auto* pMatch = pCurr - Offset;
+        if (Offset >= MatchLen)
+        {
+            memcpy(pCurr, pMatch, MatchLen);
+        }
+        else
+        {
+            // Overlapping match repeats the last Offset bytes
+            for (size_t i = 0; i < MatchLen; ++i)
+                pCurr[i] = pMatch[i];
+        }
+        pCurr += MatchLen;
+    }
+
+    return pCurr == pOutEnd;
+}
+
+} // namespace Diligent
@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "MappedFileDataBlob.hpp"
+
+#include <cstdint>
+
+#if PLATFORM_WIN32
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    include "StringTools.hpp"
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    define USE_POSIX_FILE_MAPPING 1
+#endif
+
+namespace Diligent
+{
+
+RefCntAutoPtr<MappedFileDataBlob> MappedFileDataBlob::Create(const Char* FilePath)
+{
+    try
+    {
+        return RefCntAutoPtr<MappedFileDataBlob>{MakeNewRCObj<MappedFileDataBlob>()(FilePath)};
+    }
+    catch (...)
+    {
+        return {};
+    }
+}
+
+MappedFileDataBlob::MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* FilePath) :
+    TBase{pRefCounters}
+{
+    if (FilePath == nullptr)
+        LOG_ERROR_AND_THROW("File path must not be null");
+
+    if (!FileSystem::FileExists(FilePath))
+        LOG_ERROR_AND_THROW("File '", FilePath, "' does not exist");
+
+    if (!Map(FilePath))
+    {
+        // Fall back to reading the file
+        if (!FileWrapper::ReadWholeFile(FilePath, m_DataBuff))
+            LOG_ERROR_AND_THROW("Failed to read file '", FilePath, "'");
+
+        m_pData = !m_DataBuff.empty() ? m_DataBuff.data() : nullptr;
+        m_Size  = m_DataBuff.size();
+    }
+}
+
+MappedFileDataBlob::~MappedFileDataBlob()
+{
+    Unmap();
+}
+
+#if PLATFORM_WIN32
+
+bool MappedFileDataBlob::Map(const Char* FilePath)
+{
+    HANDLE hFile = CreateFileW(WidenString(FilePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(hFile, &FileSize) || FileSize.QuadPart <= 0 || static_cast<Uint64>(FileSize.QuadPart) > SIZE_MAX)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    // Copy-on-write mapping allows modifying the data without affecting the file
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    // The mapping object keeps the file open
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+        return false;
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+    // The view keeps the mapping object alive
+    CloseHandle(hMapping);
+    if (pView == nullptr)
+        return false;
+
+    m_pMapping = pView;
+    m_pData    = pView;
+    m_Size     = static_cast<size_t>(FileSize.QuadPart);
+
+    return true;
+}
+
+void MappedFileDataBlob::Unmap()
+{
+    if (m_pMapping != nullptr)
+    {
+        UnmapViewOfFile(m_pMapping);
+        m_pMapping = nullptr;
+    }
+}
+
+#elif USE_POSIX_FILE_MAPPING
+
+bool MappedFileDataBlob::Map(const Char* FilePath)
+{
+    const int fd = open(FilePath, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat FileStat = {};
+    if (fstat(fd, &FileStat) != 0 || FileStat.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    const auto FileSize = static_cast<size_t>(FileStat.st_size);
+
+    // Private mapping allows modifying the data without affecting the file
+    void* pView = mmap(nullptr, FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open
+    close(fd);
+    if (pView == MAP_FAILED)
+        return false;
+
+    m_pMapping = pView;
+    m_pData    = pView;
+    m_Size     = FileSize;
+
+    return true;
+}
+
+void MappedFileDataBlob::Unmap()
+{
+    if (m_pMapping != nullptr)
+    {
+        munmap(m_pMapping, m_Size);
+        m_pMapping = nullptr;
+    }
+}
+
+#else
+
+bool MappedFileDataBlob::Map(const Char* FilePath)
+{
+    // File mapping is not supported on this platform
+    return false;
+}
+
+void MappedFileDataBlob::Unmap()
+{
+    VERIFY_EXPR(m_pMapping == nullptr);
+}
+
+#endif
+
+void MappedFileDataBlob::Resize(size_t NewSize)
+{
+    if (m_pMapping != nullptr)
+    {
+        // Mapped view can't be resized, so copy the data to the memory buffer
+        const auto* pData = static_cast<const Uint8*>(m_pData);
+        m_DataBuff.assign(pData, pData + m_Size);
+        Unmap();
+    }
+    m_DataBuff.resize(NewSize);
+
+    m_pData = !m_DataBuff.empty() ? m_DataBuff.data() : nullptr;
+    m_Size  = m_DataBuff.size();
+}
+
+} // namespace Diligent
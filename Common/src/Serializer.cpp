@@ -92,7 +92,7 @@ size_t SerializedData::GetHash() const
     if (Hash != 0)
         return Hash;
 
-    Hash = ComputeHash(m_Size, ComputeHashRaw(m_Ptr, m_Size));
+    Hash = ComputeHashRaw(m_Ptr, m_Size);
     m_Hash.store(Hash);
 
     return Hash;
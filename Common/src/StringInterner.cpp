@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "StringInterner.hpp"
+
+#include <cstring>
+
+#include "Align.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+struct StringInterner::HashTable
+{
+    explicit HashTable(size_t Capacity) :
+        Mask{Capacity - 1},
+        Slots{new std::atomic<const Char*>[Capacity]}
+    {
+        VERIFY_EXPR(IsPowerOfTwo(Capacity));
+        for (size_t i = 0; i < Capacity; ++i)
+            Slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_t GetCapacity() const
+    {
+        return Mask + 1;
+    }
+
+    // Must only be called under the mutex
+    void Insert(const Char* Str, size_t Hash)
+    {
+        for (size_t Idx = Hash & Mask;; Idx = (Idx + 1) & Mask)
+        {
+            if (Slots[Idx].load(std::memory_order_relaxed) == nullptr)
+            {
+                // Release ordering guarantees that readers that see the pointer also see the string data
+                Slots[Idx].store(Str, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    const size_t                                Mask;
+    std::unique_ptr<std::atomic<const Char*>[]> Slots;
+};
+
+StringInterner::StringInterner(IMemoryAllocator& Allocator, size_t InitialCapacity) :
+    m_Allocator{Allocator, 16 << 10}
+{
+    // The table is at most half full, see Intern()
+    size_t Capacity = 16;
+    while (Capacity < InitialCapacity * 2)
+        Capacity *= 2;
+    m_pTable.store(&CreateTable(Capacity), std::memory_order_release);
+}
+
+StringInterner::~StringInterner()
+{
+}
+
+StringInterner& StringInterner::GetGlobal()
+{
+    static StringInterner GlobalInterner;
+    return GlobalInterner;
+}
+
+StringInterner::HashTable& StringInterner::CreateTable(size_t Capacity)
+{
+    m_Tables.emplace_back(std::make_unique<HashTable>(Capacity));
+    return *m_Tables.back();
+}
+
+InternedString StringInterner::FindInTable(const HashTable& Table, const Char* Str, size_t Length, size_t Hash)
+{
+    // The table is never full, so the loop always reaches an empty slot
+    for (size_t Idx = Hash & Table.Mask;; Idx = (Idx + 1) & Table.Mask)
+    {
+        const auto* Entry = Table.Slots[Idx].load(std::memory_order_acquire);
+        if (Entry == nullptr)
+            return {};
+
+        InternedString Handle{Entry};
+        if (Handle.GetHash() == Hash && Handle.GetLength() == Length && memcmp(Entry, Str, Length) == 0)
+            return Handle;
+    }
+}
+
+InternedString StringInterner::Find(const Char* Str) const
+{
+    return Str != nullptr ? Find(Str, strlen(Str)) : InternedString{};
+}
+
+InternedString StringInterner::Find(const Char* Str, size_t Length) const
+{
+    if (Str == nullptr)
+        return {};
+
+    const auto Hash = ComputeHashRaw(Str, Length);
+    return FindInTable(*m_pTable.load(std::memory_order_acquire), Str, Length, Hash);
+}
+
+InternedString StringInterner::Intern(const Char* Str)
+{
+    return Str != nullptr ? Intern(Str, strlen(Str)) : InternedString{};
+}
+
+InternedString StringInterner::Intern(const Char* Str, size_t Length)
+{
+    if (Str == nullptr)
+        return {};
+
+    const auto Hash = ComputeHashRaw(Str, Length);
+
+    // Fast path: the string has already been interned
+    if (auto Handle = FindInTable(*m_pTable.load(std::memory_order_acquire), Str, Length, Hash))
+        return Handle;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // The string may have been added by another thread
+    auto* pTable = m_pTable.load(std::memory_order_relaxed);
+    if (auto Handle = FindInTable(*pTable, Str, Length, Hash))
+        return Handle;
+
+    const auto NumStrings = m_NumStrings.load(std::memory_order_relaxed);
+    if ((NumStrings + 1) * 2 > pTable->GetCapacity())
+    {
+        // Move all strings to the new table that is twice as large.
+        // Readers that use the old table will not see new strings and will take the slow path.
+        auto& NewTable = CreateTable(pTable->GetCapacity() * 2);
+        for (size_t i = 0; i < pTable->GetCapacity(); ++i)
+        {
+            if (const auto* Entry = pTable->Slots[i].load(std::memory_order_relaxed))
+                NewTable.Insert(Entry, InternedString{Entry}.GetHash());
+        }
+        m_pTable.store(&NewTable, std::memory_order_release);
+        pTable = &NewTable;
+    }
+
+    auto* pHeader = static_cast<InternedString::Header*>(m_Allocator.Allocate(sizeof(InternedString::Header) + Length + 1, alignof(InternedString::Header)));
+    pHeader->Hash   = Hash;
+    pHeader->Length = Length;
+
+    auto* Entry = reinterpret_cast<Char*>(pHeader + 1);
+    if (Length != 0)
+        memcpy(Entry, Str, Length);
+    Entry[Length] = '\0';
+
+    pTable->Insert(Entry, Hash);
+    m_NumStrings.store(NumStrings + 1, std::memory_order_relaxed);
+
+    return InternedString{Entry};
+}
+
+} // namespace Diligent
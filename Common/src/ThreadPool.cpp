@@ -29,9 +29,15 @@
 #include <mutex>
 #include <thread>
 #include <map>
+#include <unordered_map>
+#include <deque>
 #include <vector>
+#include <memory>
+#include <algorithm>
 #include <condition_variable>
 
+#include "SpinLock.hpp"
+
 namespace Diligent
 {
 
@@ -39,37 +45,201 @@ AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
-class ThreadPoolImpl final : public ObjectBase<IThreadPool>
+namespace
+{
+
+void StartWorkerThreads(IThreadPool&                ThreadPool,
+                        const ThreadPoolCreateInfo& PoolCI,
+                        std::vector<std::thread>&   WorkerThreads)
+{
+    WorkerThreads.reserve(PoolCI.NumThreads);
+    for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
+    {
+        WorkerThreads.emplace_back(
+            [&ThreadPool, PoolCI, i] //
+            {
+                if (PoolCI.OnThreadStarted)
+                    PoolCI.OnThreadStarted(i);
+
+                while (ThreadPool.ProcessTask(i, /*WaitForTask =*/true))
+                {
+                }
+
+                if (PoolCI.OnThreadExiting)
+                    PoolCI.OnThreadExiting(i);
+            });
+    }
+}
+
+// Keeps track of the tasks that wait for their prerequisites to finish
+class TaskDependencyTracker
 {
 public:
-    using TBase = ObjectBase<IThreadPool>;
+    ~TaskDependencyTracker()
+    {
+        VERIFY(m_PendingTasks.empty(), "Thread pool is destroyed while there are tasks waiting for prerequisites");
+    }
 
-    ThreadPoolImpl(IReferenceCounters*         pRefCounters,
-                   const ThreadPoolCreateInfo& PoolCI) :
-        TBase{pRefCounters}
+    // Adds the task that must wait for its prerequisites. Returns false if all prerequisites
+    // are already finished, in which case the task should be enqueued immediately.
+    bool AddTask(IAsyncTask* pTask, IAsyncTask** ppPrerequisites, Uint32 NumPrerequisites)
     {
-        m_WorkerThreads.reserve(PoolCI.NumThreads);
-        for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        Uint32 NumUnfinishedPrerequisites = 0;
+        for (Uint32 i = 0; i < NumPrerequisites; ++i)
         {
-            m_WorkerThreads.emplace_back(
-                [this, PoolCI, i] //
-                {
-                    if (PoolCI.OnThreadStarted)
-                        PoolCI.OnThreadStarted(i);
+            auto* pPrerequisite = ppPrerequisites[i];
+            if (pPrerequisite == nullptr)
+                continue;
+            DEV_CHECK_ERR(pPrerequisite != pTask, "A task can't be its own prerequisite");
+
+            // NB: the dependency counter must be incremented before the prerequisite status is checked,
+            //     see OnTaskFinished().
+            m_NumDependencies.fetch_add(1);
+            if (pPrerequisite->IsFinished())
+            {
+                m_NumDependencies.fetch_add(-1);
+                continue;
+            }
+
+            auto& Dependents = m_Dependents[pPrerequisite];
+            if (!Dependents.pPrerequisite)
+                Dependents.pPrerequisite = pPrerequisite;
+            Dependents.Tasks.push_back(pTask);
+            ++NumUnfinishedPrerequisites;
+        }
+
+        if (NumUnfinishedPrerequisites == 0)
+            return false;
+
+        DEV_CHECK_ERR(m_PendingTasks.find(pTask) == m_PendingTasks.end(), "The task is already waiting for prerequisites");
+        m_PendingTasks.emplace(pTask, PendingTask{RefCntAutoPtr<IAsyncTask>{pTask}, NumUnfinishedPrerequisites});
+        m_NumPendingTasks.store(static_cast<Uint32>(m_PendingTasks.size()));
 
-                    while (ProcessTask(i, /*WaitForTask =*/true))
-                    {
-                    }
+        return true;
+    }
+
+    // Must be called after the task is finished or removed from the queue.
+    // Moves the tasks that have no more unfinished prerequisites to ReadyTasks.
+    void OnTaskFinished(IAsyncTask* pTask, std::vector<RefCntAutoPtr<IAsyncTask>>& ReadyTasks)
+    {
+        // The task status is updated before this method is called, so either
+        // AddTask() sees the task finished, or we see the dependency counter incremented.
+        if (m_NumDependencies.load() == 0)
+            return;
 
-                    if (PoolCI.OnThreadExiting)
-                        PoolCI.OnThreadExiting(i);
-                });
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto dep_it = m_Dependents.find(pTask);
+        if (dep_it == m_Dependents.end())
+            return;
+
+        for (auto* pDependent : dep_it->second.Tasks)
+        {
+            auto pending_it = m_PendingTasks.find(pDependent);
+            VERIFY_EXPR(pending_it != m_PendingTasks.end() && pending_it->second.NumPrerequisites > 0);
+            if (--pending_it->second.NumPrerequisites == 0)
+            {
+                ReadyTasks.emplace_back(std::move(pending_it->second.pTask));
+                m_PendingTasks.erase(pending_it);
+            }
         }
+        m_NumDependencies.fetch_add(-static_cast<int>(dep_it->second.Tasks.size()));
+        m_Dependents.erase(dep_it);
+        m_NumPendingTasks.store(static_cast<Uint32>(m_PendingTasks.size()));
+    }
+
+    // Removes the task that waits for prerequisites.
+    bool RemoveTask(IAsyncTask* pTask)
+    {
+        if (m_NumPendingTasks.load() == 0)
+            return false;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto pending_it = m_PendingTasks.find(pTask);
+        if (pending_it == m_PendingTasks.end())
+            return false;
+
+        m_PendingTasks.erase(pending_it);
+        m_NumPendingTasks.store(static_cast<Uint32>(m_PendingTasks.size()));
+
+        // Remove the task from the dependent lists of its prerequisites
+        auto dep_it = m_Dependents.begin();
+        while (dep_it != m_Dependents.end())
+        {
+            auto& Tasks = dep_it->second.Tasks;
+
+            const auto NumTasks = Tasks.size();
+            Tasks.erase(std::remove(Tasks.begin(), Tasks.end(), pTask), Tasks.end());
+            m_NumDependencies.fetch_add(-static_cast<int>(NumTasks - Tasks.size()));
+
+            if (Tasks.empty())
+                dep_it = m_Dependents.erase(dep_it);
+            else
+                ++dep_it;
+        }
+
+        return true;
+    }
+
+    bool HasTask(IAsyncTask* pTask)
+    {
+        if (m_NumPendingTasks.load() == 0)
+            return false;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_PendingTasks.find(pTask) != m_PendingTasks.end();
+    }
+
+    Uint32 GetNumPendingTasks() const
+    {
+        return m_NumPendingTasks.load();
+    }
+
+private:
+    struct PendingTask
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+        Uint32                    NumPrerequisites = 0;
+    };
+
+    struct DependentTasks
+    {
+        // Keep strong reference to make sure that the prerequisite address is not reused
+        RefCntAutoPtr<IAsyncTask> pPrerequisite;
+        std::vector<IAsyncTask*>  Tasks;
+    };
+
+    std::mutex m_Mtx;
+
+    std::unordered_map<IAsyncTask*, PendingTask>    m_PendingTasks;
+    std::unordered_map<IAsyncTask*, DependentTasks> m_Dependents;
+
+    std::atomic<Uint32> m_NumPendingTasks{0};
+    // The total number of dependencies in m_Dependents
+    std::atomic<int> m_NumDependencies{0};
+};
+
+} // namespace
+
+class ThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    ThreadPoolImpl(IReferenceCounters*         pRefCounters,
+                   const ThreadPoolCreateInfo& PoolCI) :
+        TBase{pRefCounters},
+        m_NumThreads{static_cast<Uint32>(PoolCI.NumThreads)}
+    {
+        StartWorkerThreads(*this, PoolCI, m_WorkerThreads);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
 
-    virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
+    virtual Bool DILIGENT_CALL_TYPE ProcessTask(Uint32 ThreadId, Bool WaitForTask) override final
     {
         RefCntAutoPtr<IAsyncTask> pTask;
         {
@@ -114,11 +284,15 @@ public:
                            pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
                           "Finished tasks must be in COMPLETE or CANCELLED state");
 
+            // NB: dependent tasks must be enqueued before the running task counter is decremented,
+            //     otherwise WaitForAllTasks() may miss them.
+            EnqueueDependentTasks(pTask);
+
             {
                 std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
                 const auto NumRunningTasks = m_NumRunningTasks.fetch_add(-1) - 1;
-                if (m_TasksQueue.empty() && NumRunningTasks == 0)
+                if (m_TasksQueue.empty() && NumRunningTasks == 0 && m_Dependencies.GetNumPendingTasks() == 0)
                 {
                     m_TasksFinishedCond.notify_one();
                 }
@@ -128,7 +302,8 @@ public:
         return true;
     }
 
-    virtual void EnqueueTask(IAsyncTask* pTask) override final
+    // Enqueues the task whose prerequisites are all finished
+    void EnqueueReadyTask(IAsyncTask* pTask)
     {
         VERIFY_EXPR(pTask != nullptr);
         if (pTask == nullptr)
@@ -143,21 +318,31 @@ public:
         m_NextTaskCond.notify_one();
     }
 
-    virtual void WaitForAllTasks() override final
+    virtual void DILIGENT_CALL_TYPE EnqueueTask(IAsyncTask* pTask, IAsyncTask** ppPrerequisites, Uint32 NumPrerequisites) override final
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        if (NumPrerequisites == 0 || !m_Dependencies.AddTask(pTask, ppPrerequisites, NumPrerequisites))
+            EnqueueReadyTask(pTask);
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0)
+        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0 || m_Dependencies.GetNumPendingTasks() > 0)
         {
             m_TasksFinishedCond.wait(lock,
                                      [this] //
                                      {
-                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0;
+                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && m_Dependencies.GetNumPendingTasks() == 0;
                                      } //
             );
         }
     }
 
-    virtual void StopThreads() override final
+    virtual void DILIGENT_CALL_TYPE StopThreads() override final
     {
         {
             std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
@@ -175,24 +360,45 @@ public:
         m_WorkerThreads.clear();
     }
 
-    virtual bool RemoveTask(IAsyncTask* pTask) override final
+    virtual Bool DILIGENT_CALL_TYPE RemoveTask(IAsyncTask* pTask) override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        bool Removed = false;
+        {
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+            auto it = m_TasksQueue.begin();
+            while (it != m_TasksQueue.end() && it->second != pTask)
+                ++it;
+            if (it != m_TasksQueue.end())
+            {
+                m_TasksQueue.erase(it);
+                Removed = true;
+            }
+        }
+
+        if (!Removed)
+            Removed = m_Dependencies.RemoveTask(pTask);
+
+        if (Removed)
         {
-            m_TasksQueue.erase(it);
-            return true;
+            // Tasks that depend on the removed task can't wait for it anymore
+            EnqueueDependentTasks(pTask);
+
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            if (m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && m_Dependencies.GetNumPendingTasks() == 0)
+                m_TasksFinishedCond.notify_one();
         }
 
-        return false;
+        return Removed;
     }
 
-    virtual bool ReprioritizeTask(IAsyncTask* pTask) override final
+    virtual Bool DILIGENT_CALL_TYPE ReprioritizeTask(IAsyncTask* pTask) override final
     {
+        // Tasks waiting for prerequisites will be placed into the queue
+        // according to their priority once they are ready.
+        if (m_Dependencies.HasTask(pTask))
+            return true;
+
         const auto Priority = pTask->GetPriority();
 
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
@@ -214,7 +420,7 @@ public:
         return false;
     }
 
-    virtual void ReprioritizeAllTasks() override final
+    virtual void DILIGENT_CALL_TYPE ReprioritizeAllTasks() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
@@ -241,17 +447,22 @@ public:
         m_ReprioritizationList.clear();
     }
 
-    Uint32 GetQueueSize() override final
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueueSize() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        return StaticCast<Uint32>(m_TasksQueue.size());
+        return StaticCast<Uint32>(m_TasksQueue.size()) + m_Dependencies.GetNumPendingTasks();
     }
 
-    virtual Uint32 GetRunningTaskCount() const override final
+    virtual Uint32 DILIGENT_CALL_TYPE GetRunningTaskCount() const override final
     {
         return m_NumRunningTasks.load();
     }
 
+    virtual Uint32 DILIGENT_CALL_TYPE GetNumThreads() const override final
+    {
+        return m_NumThreads;
+    }
+
     ~ThreadPoolImpl()
     {
         StopThreads();
@@ -260,6 +471,16 @@ public:
     }
 
 private:
+    void EnqueueDependentTasks(IAsyncTask* pTask)
+    {
+        std::vector<RefCntAutoPtr<IAsyncTask>> ReadyTasks;
+        m_Dependencies.OnTaskFinished(pTask, ReadyTasks);
+        for (auto& pReadyTask : ReadyTasks)
+            EnqueueReadyTask(pReadyTask);
+    }
+
+private:
+    const Uint32             m_NumThreads;
     std::vector<std::thread> m_WorkerThreads;
 
     // Priority queue
@@ -273,11 +494,510 @@ private:
     std::atomic<bool>       m_Stop{false};
 
     std::atomic<int> m_NumRunningTasks{0};
+
+    TaskDependencyTracker m_Dependencies;
 };
 
+
+class WorkStealingThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    WorkStealingThreadPoolImpl(IReferenceCounters*         pRefCounters,
+                               const ThreadPoolCreateInfo& PoolCI) :
+        TBase{pRefCounters},
+        m_NumThreads{static_cast<Uint32>(PoolCI.NumThreads)}
+    {
+        // Always create at least one queue so that the pool with zero threads
+        // can be processed by the application threads through ProcessTask().
+        const size_t NumQueues = std::max(PoolCI.NumThreads, size_t{1});
+        m_Queues.reserve(NumQueues);
+        for (size_t i = 0; i < NumQueues; ++i)
+            m_Queues.emplace_back(new WorkerQueue);
+
+        StartWorkerThreads(*this, PoolCI, m_WorkerThreads);
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
+
+    virtual Bool DILIGENT_CALL_TYPE ProcessTask(Uint32 ThreadId, Bool WaitForTask) override final
+    {
+        const auto QueueIdx = static_cast<Uint32>(ThreadId % m_Queues.size());
+        while (true)
+        {
+            if (auto pTask = DequeueTask(QueueIdx))
+            {
+                RunTask(pTask, ThreadId, QueueIdx);
+                return true;
+            }
+
+            if (m_Stop.load() && m_NumQueuedTasks.load() <= 0)
+                return false;
+
+            if (!WaitForTask)
+                return true;
+
+            std::unique_lock<std::mutex> lock{m_WakeMtx};
+            // NB: the number of sleeping threads must be incremented before the queue size
+            //     is checked, see WakeThread().
+            m_NumSleepingThreads.fetch_add(1);
+            m_WakeCond.wait(lock,
+                            [this] //
+                            {
+                                return m_Stop.load() || m_NumQueuedTasks.load() > 0;
+                            } //
+            );
+            m_NumSleepingThreads.fetch_add(-1);
+        }
+    }
+
+    // Enqueues the task whose prerequisites are all finished
+    void EnqueueReadyTask(IAsyncTask* pTask)
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+
+        // NB: the counter must be incremented before the task becomes visible to worker threads,
+        //     otherwise a worker may process the task and observe an empty queue with no running
+        //     tasks before the counter is incremented, which will break WaitForAllTasks().
+        m_NumQueuedTasks.fetch_add(1);
+
+        const auto Priority = pTask->GetPriority();
+        if (Priority != 0)
+        {
+            std::lock_guard<std::mutex> lock{m_PriorityLaneMtx};
+            m_PriorityLane.emplace(Priority, pTask);
+            UpdatePriorityLaneState();
+        }
+        else
+        {
+            // Tasks enqueued from a task running in this pool go to the queue of the
+            // current thread, all other tasks are evenly distributed between the queues.
+            const auto QueueIdx = (tl_WorkerCtx.pPool == this) ?
+                tl_WorkerCtx.QueueIdx :
+                m_NextQueueIdx.fetch_add(1) % m_Queues.size();
+
+            auto& Queue = *m_Queues[QueueIdx];
+
+            Threading::SpinLockGuard Guard{Queue.Lock};
+            Queue.Tasks.emplace_back(pTask);
+            Queue.NumTasks.fetch_add(1);
+        }
+
+        WakeThread();
+    }
+
+    virtual void DILIGENT_CALL_TYPE EnqueueTask(IAsyncTask* pTask, IAsyncTask** ppPrerequisites, Uint32 NumPrerequisites) override final
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        if (NumPrerequisites == 0 || !m_Dependencies.AddTask(pTask, ppPrerequisites, NumPrerequisites))
+            EnqueueReadyTask(pTask);
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
+    {
+        std::unique_lock<std::mutex> lock{m_TasksFinishedMtx};
+        m_TasksFinishedCond.wait(lock,
+                                 [this] //
+                                 {
+                                     return AllTasksFinished();
+                                 } //
+        );
+    }
+
+    virtual void DILIGENT_CALL_TYPE StopThreads() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_WakeMtx};
+            // NB: even if the shared variable is atomic, it must be modified under the mutex
+            //     in order to correctly publish the modification to the waiting thread.
+            m_Stop.store(true);
+        }
+        m_WakeCond.notify_all();
+        for (std::thread& worker : m_WorkerThreads)
+            worker.join();
+
+        m_WorkerThreads.clear();
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE RemoveTask(IAsyncTask* pTask) override final
+    {
+        bool Removed = false;
+        for (auto& pQueue : m_Queues)
+        {
+            Threading::SpinLockGuard Guard{pQueue->Lock};
+
+            auto it = std::find(pQueue->Tasks.begin(), pQueue->Tasks.end(), pTask);
+            if (it != pQueue->Tasks.end())
+            {
+                pQueue->Tasks.erase(it);
+                pQueue->NumTasks.fetch_add(-1);
+                Removed = true;
+                break;
+            }
+        }
+
+        if (!Removed)
+        {
+            std::lock_guard<std::mutex> lock{m_PriorityLaneMtx};
+
+            auto it = FindInPriorityLane(pTask);
+            if (it != m_PriorityLane.end())
+            {
+                m_PriorityLane.erase(it);
+                UpdatePriorityLaneState();
+                Removed = true;
+            }
+        }
+
+        if (Removed)
+        {
+            m_NumQueuedTasks.fetch_add(-1);
+        }
+        else
+        {
+            Removed = m_Dependencies.RemoveTask(pTask);
+        }
+
+        if (Removed)
+        {
+            // Tasks that depend on the removed task can't wait for it anymore
+            EnqueueDependentTasks(pTask);
+
+            if (AllTasksFinished())
+                NotifyTasksFinished();
+        }
+
+        return Removed;
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE ReprioritizeTask(IAsyncTask* pTask) override final
+    {
+        // Tasks waiting for prerequisites will be placed into the queue
+        // according to their priority once they are ready.
+        if (m_Dependencies.HasTask(pTask))
+            return true;
+
+        const auto Priority = pTask->GetPriority();
+
+        // NB: the priority lane mutex is held while the task is moved from the worker queue,
+        //     so that RemoveTask(), which checks the queues first and the lane next, always
+        //     finds the task in one of them.
+        std::lock_guard<std::mutex> lock{m_PriorityLaneMtx};
+
+        auto lane_it = FindInPriorityLane(pTask);
+        if (lane_it != m_PriorityLane.end())
+        {
+            if (lane_it->first != Priority)
+            {
+                auto pExistingTask = std::move(lane_it->second);
+                m_PriorityLane.erase(lane_it);
+                m_PriorityLane.emplace(Priority, std::move(pExistingTask));
+                UpdatePriorityLaneState();
+            }
+            return true;
+        }
+
+        for (auto& pQueue : m_Queues)
+        {
+            Threading::SpinLockGuard Guard{pQueue->Lock};
+
+            auto it = std::find(pQueue->Tasks.begin(), pQueue->Tasks.end(), pTask);
+            if (it == pQueue->Tasks.end())
+                continue;
+
+            // Tasks with default priority stay in the worker queue
+            if (Priority != 0)
+            {
+                m_PriorityLane.emplace(Priority, std::move(*it));
+                pQueue->Tasks.erase(it);
+                pQueue->NumTasks.fetch_add(-1);
+                UpdatePriorityLaneState();
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReprioritizeAllTasks() override final
+    {
+        // NB: as in ReprioritizeTask(), the priority lane mutex must be held while tasks are
+        //     moved from the worker queues, otherwise RemoveTask() may miss them.
+        std::lock_guard<std::mutex> lock{m_PriorityLaneMtx};
+
+        std::vector<std::pair<float, RefCntAutoPtr<IAsyncTask>>> ReprioritizationList;
+        for (auto& pQueue : m_Queues)
+        {
+            Threading::SpinLockGuard Guard{pQueue->Lock};
+
+            auto it = pQueue->Tasks.begin();
+            while (it != pQueue->Tasks.end())
+            {
+                const auto Priority = (*it)->GetPriority();
+                if (Priority != 0)
+                {
+                    ReprioritizationList.emplace_back(Priority, std::move(*it));
+                    it = pQueue->Tasks.erase(it);
+                    pQueue->NumTasks.fetch_add(-1);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        auto it = m_PriorityLane.begin();
+        while (it != m_PriorityLane.end())
+        {
+            const auto Priority = it->second->GetPriority();
+            if (it->first != Priority)
+            {
+                ReprioritizationList.emplace_back(Priority, std::move(it->second));
+                it = m_PriorityLane.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (!ReprioritizationList.empty())
+            m_PriorityLane.insert(ReprioritizationList.begin(), ReprioritizationList.end());
+
+        UpdatePriorityLaneState();
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueueSize() override final
+    {
+        return static_cast<Uint32>(std::max(m_NumQueuedTasks.load(), 0)) + m_Dependencies.GetNumPendingTasks();
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetRunningTaskCount() const override final
+    {
+        return m_NumRunningTasks.load();
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetNumThreads() const override final
+    {
+        return m_NumThreads;
+    }
+
+    ~WorkStealingThreadPoolImpl()
+    {
+        StopThreads();
+        VERIFY_EXPR(m_NumQueuedTasks.load() == 0);
+        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+    }
+
+private:
+    using PriorityLaneType = std::multimap<float, RefCntAutoPtr<IAsyncTask>, std::greater<float>>;
+
+    RefCntAutoPtr<IAsyncTask> DequeueTask(Uint32 QueueIdx)
+    {
+        // Tasks with positive priority go first
+        if (m_PriorityLaneTopPriority.load() > 0)
+        {
+            if (auto pTask = PopFromPriorityLane(/*PositiveOnly = */ true))
+                return pTask;
+        }
+
+        // Try own queue first, then try to steal from other queues
+        const auto NumQueues = m_Queues.size();
+        for (size_t i = 0; i < NumQueues; ++i)
+        {
+            auto& Queue = *m_Queues[(QueueIdx + i) % NumQueues];
+            if (Queue.NumTasks.load() == 0)
+                continue;
+
+            Threading::SpinLockGuard Guard{Queue.Lock};
+            if (Queue.Tasks.empty())
+                continue;
+
+            auto pTask = std::move(Queue.Tasks.front());
+            Queue.Tasks.pop_front();
+            Queue.NumTasks.fetch_add(-1);
+            OnTaskDequeued();
+            return pTask;
+        }
+
+        // Tasks with negative priority go last
+        if (m_NumPriorityLaneTasks.load() > 0)
+            return PopFromPriorityLane(/*PositiveOnly = */ false);
+
+        return {};
+    }
+
+    RefCntAutoPtr<IAsyncTask> PopFromPriorityLane(bool PositiveOnly)
+    {
+        std::lock_guard<std::mutex> lock{m_PriorityLaneMtx};
+        if (m_PriorityLane.empty())
+            return {};
+
+        auto front = m_PriorityLane.begin();
+        if (PositiveOnly && front->first <= 0)
+            return {};
+
+        auto pTask = std::move(front->second);
+        m_PriorityLane.erase(front);
+        UpdatePriorityLaneState();
+        OnTaskDequeued();
+        return pTask;
+    }
+
+    void OnTaskDequeued()
+    {
+        // NB: we must increment the running task counter before decrementing the number of
+        //     queued tasks, otherwise WaitForAllTasks() may miss the task.
+        m_NumRunningTasks.fetch_add(1);
+        m_NumQueuedTasks.fetch_add(-1);
+    }
+
+    void RunTask(IAsyncTask* pTask, Uint32 ThreadId, Uint32 QueueIdx)
+    {
+        // Make tasks enqueued by this task go to the queue of the current thread.
+        // Save the previous context as ProcessTask() may be called recursively.
+        const auto PrevCtx = tl_WorkerCtx;
+        tl_WorkerCtx       = {this, QueueIdx};
+
+        pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+        pTask->Run(ThreadId);
+        DEV_CHECK_ERR((pTask->GetStatus() == ASYNC_TASK_STATUS_COMPLETE ||
+                       pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
+                      "Finished tasks must be in COMPLETE or CANCELLED state");
+
+        // NB: dependent tasks must be enqueued before the running task counter is decremented,
+        //     otherwise WaitForAllTasks() may miss them.
+        EnqueueDependentTasks(pTask);
+
+        tl_WorkerCtx = PrevCtx;
+
+        m_NumRunningTasks.fetch_add(-1);
+        if (AllTasksFinished())
+            NotifyTasksFinished();
+    }
+
+    void EnqueueDependentTasks(IAsyncTask* pTask)
+    {
+        std::vector<RefCntAutoPtr<IAsyncTask>> ReadyTasks;
+        m_Dependencies.OnTaskFinished(pTask, ReadyTasks);
+        for (auto& pReadyTask : ReadyTasks)
+            EnqueueReadyTask(pReadyTask);
+    }
+
+    bool AllTasksFinished() const
+    {
+        return m_NumQueuedTasks.load() <= 0 && m_NumRunningTasks.load() == 0 && m_Dependencies.GetNumPendingTasks() == 0;
+    }
+
+    void WakeThread()
+    {
+        // Both the counter of queued tasks and the counter of sleeping threads are sequentially
+        // consistent, so either the sleeping thread sees the new task, or we see the sleeping thread.
+        if (m_NumSleepingThreads.load() > 0)
+        {
+            {
+                // Make sure that the thread that has incremented the counter is
+                // already waiting on the condition variable.
+                std::lock_guard<std::mutex> lock{m_WakeMtx};
+            }
+            m_WakeCond.notify_one();
+        }
+    }
+
+    void NotifyTasksFinished()
+    {
+        {
+            // The predicate is checked by WaitForAllTasks() under the mutex, so we need to
+            // lock it to make sure the waiting thread does not miss the notification.
+            std::lock_guard<std::mutex> lock{m_TasksFinishedMtx};
+        }
+        m_TasksFinishedCond.notify_all();
+    }
+
+    PriorityLaneType::iterator FindInPriorityLane(IAsyncTask* pTask)
+    {
+        auto it = m_PriorityLane.begin();
+        while (it != m_PriorityLane.end() && it->second != pTask)
+            ++it;
+        return it;
+    }
+
+    // Must be called while holding m_PriorityLaneMtx
+    void UpdatePriorityLaneState()
+    {
+        m_PriorityLaneTopPriority.store(!m_PriorityLane.empty() ? m_PriorityLane.begin()->first : 0.f);
+        m_NumPriorityLaneTasks.store(static_cast<Uint32>(m_PriorityLane.size()));
+    }
+
+private:
+    struct WorkerQueue
+    {
+        Threading::SpinLock                   Lock;
+        std::deque<RefCntAutoPtr<IAsyncTask>> Tasks;
+        // The number of tasks in the queue that can be checked without taking the lock
+        std::atomic<size_t> NumTasks{0};
+    };
+
+    struct WorkerContext
+    {
+        const WorkStealingThreadPoolImpl* pPool    = nullptr;
+        Uint32                            QueueIdx = 0;
+    };
+    static thread_local WorkerContext tl_WorkerCtx;
+
+    const Uint32             m_NumThreads;
+    std::vector<std::thread> m_WorkerThreads;
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+    std::atomic<size_t>                       m_NextQueueIdx{0};
+
+    // Tasks with non-zero priority
+    std::mutex          m_PriorityLaneMtx;
+    PriorityLaneType    m_PriorityLane;
+    std::atomic<float>  m_PriorityLaneTopPriority{0};
+    std::atomic<Uint32> m_NumPriorityLaneTasks{0};
+
+    std::mutex              m_WakeMtx;
+    std::condition_variable m_WakeCond;
+    std::atomic<int>        m_NumSleepingThreads{0};
+    std::atomic<bool>       m_Stop{false};
+
+    std::mutex              m_TasksFinishedMtx;
+    std::condition_variable m_TasksFinishedCond;
+
+    // Total number of tasks in all queues including the priority lane
+    std::atomic<int> m_NumQueuedTasks{0};
+    std::atomic<int> m_NumRunningTasks{0};
+
+    TaskDependencyTracker m_Dependencies;
+};
+
+thread_local WorkStealingThreadPoolImpl::WorkerContext WorkStealingThreadPoolImpl::tl_WorkerCtx;
+
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
-    return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
+    switch (ThreadPoolCI.Mode)
+    {
+        case THREAD_POOL_MODE_PRIORITY_QUEUE:
+            return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
+
+        case THREAD_POOL_MODE_WORK_STEALING:
+            return RefCntAutoPtr<WorkStealingThreadPoolImpl>{MakeNewRCObj<WorkStealingThreadPoolImpl>()(ThreadPoolCI)};
+
+        default:
+            UNEXPECTED("Unexpected thread pool mode");
+            return {};
+    }
 }
 
 } // namespace Diligent
@@ -93,6 +93,10 @@ public:
 private:
     bool AddRenderPass(IRenderPass* pRP);
 
+    // Adds all objects to the archive. The archive references the object data,
+    // so it must not outlive the archiver.
+    void InitArchive(DeviceObjectArchive& Archive);
+
 private:
     using DeviceType   = DeviceObjectArchive::DeviceType;
     using ResourceType = DeviceObjectArchive::ResourceType;
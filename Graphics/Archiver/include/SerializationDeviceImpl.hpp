@@ -37,6 +37,7 @@
 #include "ObjectBase.hpp"
 #include "DXCompiler.hpp"
 #include "RenderDeviceBase.hpp"
+#include "../../GraphicsTools/interface/BytecodeCache.h"
 
 namespace Diligent
 {
@@ -145,9 +146,10 @@ public:
 
     struct VkProperties
     {
-        IDXCompiler* pDxCompiler     = nullptr;
-        Uint32       VkVersion       = 0;
-        bool         SupportsSpirv14 = false;
+        IDXCompiler*    pDxCompiler     = nullptr;
+        Uint32          VkVersion       = 0;
+        bool            SupportsSpirv14 = false;
+        IBytecodeCache* pBytecodeCache  = nullptr;
     };
 
     struct MtlProperties
@@ -196,6 +198,8 @@ private:
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
     std::unique_ptr<IDXCompiler> m_pVkDxCompiler;
 
+    RefCntAutoPtr<IBytecodeCache> m_pVkBytecodeCache;
+
     D3D11Properties m_D3D11Props;
     D3D12Properties m_D3D12Props;
     VkProperties    m_VkProps;
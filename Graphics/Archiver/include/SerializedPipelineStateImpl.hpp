@@ -89,6 +89,9 @@ public:
     UNSUPPORTED_CONST_METHOD(IPipelineResourceSignature*, GetResourceSignature, Uint32 Index)
     // clang-format on
 
+    // Serialized pipelines are always created synchronously
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(Bool WaitForCompletion) override final { return PIPELINE_STATE_STATUS_READY; }
+
     virtual Uint32 DILIGENT_CALL_TYPE GetPatchedShaderCount(ARCHIVE_DEVICE_DATA_FLAGS DeviceType) const override final;
 
     virtual ShaderCreateInfo DILIGENT_CALL_TYPE GetPatchedShaderCreateInfo(
@@ -67,6 +67,9 @@ public:
     UNSUPPORTED_CONST_METHOD(IObject*, GetUserData)
     UNSUPPORTED_CONST_METHOD(void, GetBytecode, const void** ppBytecode, Uint64& Size);
 
+    // Serialized shaders are always compiled synchronously
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(Bool WaitForCompletion) override final { return SHADER_STATUS_READY; }
+
     virtual IShader* DILIGENT_CALL_TYPE GetDeviceShader(RENDER_DEVICE_TYPE Type) const override final;
 
     struct CompiledShader
@@ -81,6 +81,19 @@ DILIGENT_TYPED_ENUM(ARCHIVE_DEVICE_DATA_FLAGS, Uint32)
 };
 DEFINE_FLAG_ENUM_OPERATORS(ARCHIVE_DEVICE_DATA_FLAGS)
 
+/// Archive data compression mode.
+DILIGENT_TYPED_ENUM(ARCHIVE_COMPRESSION, Uint8)
+{
+    /// The data is not compressed.
+    ARCHIVE_COMPRESSION_NONE = 0,
+
+    /// The data is compressed using the LZ4 block format.
+    /// LZ4 provides moderate compression ratio and very fast decompression.
+    ARCHIVE_COMPRESSION_LZ4,
+
+    ARCHIVE_COMPRESSION_COUNT
+};
+
 
 /// Render state object archiver interface
 DILIGENT_BEGIN_INTERFACE(IArchiver, IObject)
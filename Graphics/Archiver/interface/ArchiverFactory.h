@@ -31,10 +31,13 @@
 
 #include "../../../Primitives/interface/Object.h"
 #include "../../../Primitives/interface/DebugOutput.h"
+#include "../../../Common/interface/ThreadPool.h"
 #include "SerializationDevice.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
+struct IBytecodeCache;
+
 // {F20B91EB-BDE3-4615-81CC-F720AA32410E}
 static const INTERFACE_ID IID_ArchiverFactory =
     {0xf20b91eb, 0xbde3, 0x4615, {0x81, 0xcc, 0xf7, 0x20, 0xaa, 0x32, 0x41, 0xe}};
@@ -107,13 +110,21 @@ struct SerializationDeviceVkInfo
     /// Path to DX compiler for Vulkan
     const Char* DxCompilerPath  DEFAULT_INITIALIZER(nullptr);
 
+    /// An optional bytecode cache, see Diligent::IBytecodeCache.
+
+    /// \remarks   When the cache is provided, glslang and DXC look up the SPIRV
+    ///             in the cache before compiling a shader and add the compiled SPIRV
+    ///             to the cache. The serialization device keeps a strong reference to the cache.
+    struct IBytecodeCache* pBytecodeCache DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     /// Tests if two structures are equivalent
     bool operator==(const SerializationDeviceVkInfo& RHS) const noexcept
     {
         return ApiVersion      == RHS.ApiVersion &&
                SupportsSpirv14 == RHS.SupportsSpirv14 &&
-               SafeStrEqual(DxCompilerPath, RHS.DxCompilerPath);
+               SafeStrEqual(DxCompilerPath, RHS.DxCompilerPath) &&
+               pBytecodeCache  == RHS.pBytecodeCache;
     }
     bool operator!=(const SerializationDeviceVkInfo& RHS) const noexcept
     {
@@ -265,6 +276,26 @@ DILIGENT_BEGIN_INTERFACE(IArchiverFactory, IObject)
                                        IDataBlob**      ppDstArchive) CONST PURE;
 
 
+    /// Compresses device-specific shader data in the archive and writes a new archive to the stream.
+
+    /// \param [in]  pSrcArchive  - Source archive.
+    /// \param [in]  DeviceFlags  - Combination of device types whose shaders will be compressed.
+    /// \param [in]  Compression  - Compression mode, see Diligent::ARCHIVE_COMPRESSION.
+    ///                             Use ARCHIVE_COMPRESSION_NONE to decompress the shaders.
+    /// \param [out] ppDstArchive - Memory address where a pointer to the new archive will be written.
+    /// \param [in]  pThreadPool  - Optional thread pool that will be used to compress the shaders in parallel.
+    /// \return     true if the archive was successfully compressed, and false otherwise.
+    ///
+    /// \remarks    Every shader is compressed individually and is decompressed by the dearchiver
+    ///             when it is unpacked. Shaders that do not benefit from compression are stored as is.
+    VIRTUAL Bool METHOD(CompressArchive)(THIS_
+                                         const IDataBlob*          pSrcArchive,
+                                         ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags,
+                                         ARCHIVE_COMPRESSION       Compression,
+                                         IDataBlob**               ppDstArchive,
+                                         IThreadPool*              pThreadPool DEFAULT_VALUE(nullptr)) CONST PURE;
+
+
     /// Prints archive content for debugging and validation.
     VIRTUAL Bool METHOD(PrintArchiveContent)(THIS_
                                              const IDataBlob* pArchive) CONST PURE;
@@ -287,6 +318,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiverFactory_RemoveDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, RemoveDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_AppendDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, AppendDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_MergeArchives(This, ...)                           CALL_IFACE_METHOD(ArchiverFactory, MergeArchives,                          This, __VA_ARGS__)
+#    define IArchiverFactory_CompressArchive(This, ...)                         CALL_IFACE_METHOD(ArchiverFactory, CompressArchive,                        This, __VA_ARGS__)
 #    define IArchiverFactory_PrintArchiveContent(This, ...)                     CALL_IFACE_METHOD(ArchiverFactory, PrintArchiveContent,                    This, __VA_ARGS__)
 #    define IArchiverFactory_SetMessageCallback(This, ...)                      CALL_IFACE_METHOD(ArchiverFactory, SetMessageCallback,                     This, __VA_ARGS__)
 
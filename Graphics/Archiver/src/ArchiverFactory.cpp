@@ -75,6 +75,23 @@ DeviceObjectArchive::DeviceType ArchiveDeviceDataFlagToArchiveDeviceType(ARCHIVE
 namespace
 {
 
+DeviceObjectArchive::CompressionMode ArchiveCompressionToCompressionMode(ARCHIVE_COMPRESSION Compression)
+{
+    using CompressionMode = DeviceObjectArchive::CompressionMode;
+    static_assert(ARCHIVE_COMPRESSION_COUNT == 2, "Please handle the new compression mode below");
+    switch (Compression)
+    {
+        case ARCHIVE_COMPRESSION_NONE:
+            return CompressionMode::None;
+
+        case ARCHIVE_COMPRESSION_LZ4:
+            return CompressionMode::LZ4;
+
+        default:
+            return CompressionMode::Count;
+    }
+}
+
 class ArchiverFactoryImpl final : public IArchiverFactory
 {
 public:
@@ -133,6 +150,13 @@ public:
         Uint32           NumSrcArchives,
         IDataBlob**      ppDstArchive) const override final;
 
+    virtual Bool DILIGENT_CALL_TYPE CompressArchive(
+        const IDataBlob*          pSrcArchive,
+        ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags,
+        ARCHIVE_COMPRESSION       Compression,
+        IDataBlob**               ppDstArchive,
+        IThreadPool*              pThreadPool) const override final;
+
     virtual Bool DILIGENT_CALL_TYPE PrintArchiveContent(const IDataBlob* pArchive) const override final;
 
     virtual void DILIGENT_CALL_TYPE SetMessageCallback(DebugMessageCallbackType MessageCallback) const override final;
@@ -318,6 +342,52 @@ Bool ArchiverFactoryImpl::MergeArchives(
     }
 }
 
+Bool ArchiverFactoryImpl::CompressArchive(const IDataBlob*          pSrcArchive,
+                                          ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags,
+                                          ARCHIVE_COMPRESSION       Compression,
+                                          IDataBlob**               ppDstArchive,
+                                          IThreadPool*              pThreadPool) const
+{
+    if (pSrcArchive == nullptr)
+    {
+        DEV_ERROR("pSrcArchive must not be null");
+        return false;
+    }
+    if (ppDstArchive == nullptr)
+    {
+        DEV_ERROR("ppDstArchive must not be null");
+        return false;
+    }
+    DEV_CHECK_ERR(*ppDstArchive == nullptr, "*ppDstArchive must be null");
+
+    const auto CompressionMode = ArchiveCompressionToCompressionMode(Compression);
+    if (CompressionMode == DeviceObjectArchive::CompressionMode::Count)
+    {
+        DEV_ERROR("Unknown archive compression mode");
+        return false;
+    }
+
+    try
+    {
+        DeviceObjectArchive ObjectArchive{DeviceObjectArchive::CreateInfo{pSrcArchive}};
+
+        while (DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE)
+        {
+            const auto DataTypeFlag      = ExtractLSB(DeviceFlags);
+            const auto ArchiveDeviceType = ArchiveDeviceDataFlagToArchiveDeviceType(DataTypeFlag);
+
+            ObjectArchive.SetShaderCompression(ArchiveDeviceType, CompressionMode);
+        }
+
+        ObjectArchive.Serialize(ppDstArchive, pThreadPool);
+        return *ppDstArchive != nullptr;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
 Bool ArchiverFactoryImpl::PrintArchiveContent(const IDataBlob* pArchive) const
 {
     try
@@ -69,14 +69,8 @@ ArchiverImpl::~ArchiverImpl()
 {
 }
 
-Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
+void ArchiverImpl::InitArchive(DeviceObjectArchive& Archive)
 {
-    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
-    if (ppBlob == nullptr)
-        return false;
-
-    DeviceObjectArchive Archive{ContentVersion};
-
     // A hash map that maps shader byte code to the index in the archive, for each device type
     std::array<std::unordered_map<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> BytecodeHashToIdx;
 
@@ -202,6 +196,16 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
             VERIFY_EXPR(Ser.IsEnded());
         }
     }
+}
+
+Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    if (ppBlob == nullptr)
+        return false;
+
+    DeviceObjectArchive Archive{ContentVersion};
+    InitArchive(Archive);
 
     Archive.Serialize(ppBlob);
 
@@ -215,11 +219,11 @@ Bool ArchiverImpl::SerializeToStream(Uint32 ContentVersion, IFileStream* pStream
     if (pStream == nullptr)
         return false;
 
-    RefCntAutoPtr<IDataBlob> pDataBlob;
-    if (!SerializeToBlob(ContentVersion, &pDataBlob))
-        return false;
+    DeviceObjectArchive Archive{ContentVersion};
+    InitArchive(Archive);
 
-    return pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
+    // The archive is written directly to the stream without allocating the entire archive in memory
+    return Archive.Serialize(pStream);
 }
 
 template <typename ObjectImplType,
@@ -168,6 +168,7 @@ void SerializedPipelineStateImpl::PatchShadersVk(const CreateInfoType& CreateInf
                                                           BindIndexToDescSetIndex,
                                                           false, // bVerifyOnly
                                                           bStripReflection,
+                                                          nullptr, // pThreadPool: serialized pipelines are always created synchronously
                                                           CreateInfo.PSODesc.Name);
     }
 
@@ -210,6 +211,8 @@ void SerializedShaderImpl::CreateShaderVk(IReferenceCounters*     pRefCounters,
         // Do not overwrite compiler output from other APIs.
         // TODO: collect all outputs.
         ppCompilerOutput == nullptr || *ppCompilerOutput == nullptr ? ppCompilerOutput : nullptr,
+        nullptr, // pCompilationThreadPool: serialized shaders are always compiled synchronously
+        VkProps.pBytecodeCache,
     };
     CreateShader<CompiledShaderVk>(DeviceType::Vulkan, pRefCounters, ShaderCI, VkShaderCI, pRenderDeviceVk);
 }
@@ -88,6 +88,8 @@ SerializationDeviceImpl::SerializationDeviceImpl(IReferenceCounters* pRefCounter
         m_pVkDxCompiler           = CreateDXCompiler(DXCompilerTarget::Vulkan, m_VkProps.VkVersion, CreateInfo.Vulkan.DxCompilerPath);
         m_VkProps.pDxCompiler     = m_pVkDxCompiler.get();
         m_VkProps.SupportsSpirv14 = ApiVersion >= Version{1, 2} || CreateInfo.Vulkan.SupportsSpirv14;
+        m_pVkBytecodeCache        = CreateInfo.Vulkan.pBytecodeCache;
+        m_VkProps.pBytecodeCache  = m_pVkBytecodeCache;
     }
 
     if (m_ValidDeviceFlags & ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS)
@@ -0,0 +1,598 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TLSFBlockManager class
+
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+
+// The class manages free blocks of a linear address space using the two-level segregated fit (TLSF)
+// algorithm (M. Masmano, I. Ripoll, A. Crespo, J. Real, "TLSF: a New Dynamic Memory Allocator for
+// Real-Time Systems", 2004). Both allocation and deallocation run in constant time.
+//
+// Free blocks are kept in segregated lists. The first-level index is the position of the most significant
+// bit of the block size, and the second level splits every power-of-two range into SLCount linear
+// sub-ranges. Two levels of bitmaps allow finding a non-empty list that is guaranteed to satisfy
+// the request with a couple of bit scans:
+//
+//   FL bitmap        SL bitmaps             free lists
+//   1 0 1 1 ...  ->  FL=0: 0 1 0 0 ...  ->  [sl=1]: {Offset=96, Size=1}
+//                    FL=2: 0 0 1 0 ...  ->  [sl=2]: {Offset=0, Size=80} -> {Offset=256, Size=82}
+//                    ...
+//
+// Since the managed memory is not CPU-accessible in general (e.g. GPU heaps), block descriptions are kept
+// in a separate array rather than in block headers. Blocks are linked in the physical order to enable
+// constant-time merging, and allocated blocks are found by offset in an open-addressing hash table.
+// Neither the array nor the table allocate memory for individual blocks.
+class TLSFBlockManager
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr OffsetType InvalidOffset = ~OffsetType{0};
+
+    TLSFBlockManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        // clang-format off
+        m_Blocks    {STD_ALLOCATOR_RAW_MEM(Block,     Allocator, "Allocator for vector<TLSFBlockManager::Block>")},
+        m_UsedBlocks{STD_ALLOCATOR_RAW_MEM(HashEntry, Allocator, "Allocator for vector<TLSFBlockManager::HashEntry>")}
+    // clang-format on
+    {
+        m_SLBitmaps.fill(0);
+        m_FreeListHeads.fill(InvalidIndex);
+        if (MaxSize > 0)
+            Extend(MaxSize);
+    }
+
+    ~TLSFBlockManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_MaxSize > 0)
+        {
+            VERIFY(m_NumUsedBlocks == 0, "Not all allocations have been released");
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            VERIFY(m_FreeSize == m_MaxSize, "The entire space is expected to be free");
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFBlockManager             (TLSFBlockManager&&)      = delete;
+    TLSFBlockManager& operator = (TLSFBlockManager&&)      = delete;
+    TLSFBlockManager             (const TLSFBlockManager&) = delete;
+    TLSFBlockManager& operator = (const TLSFBlockManager&) = delete;
+    // clang-format on
+
+    // Allocates Size bytes at the offset aligned by Alignment.
+    // Returns InvalidOffset if there is no free block that can accommodate the request.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        if (Size > m_FreeSize)
+            return InvalidOffset;
+
+        // All blocks in the list found for Size are at least Size bytes large. If the first of them
+        // does not have enough space to align the offset, search for a list with larger blocks.
+        auto BlockIdx = FindFreeBlock(Size);
+        if (BlockIdx == InvalidIndex || AlignUp(m_Blocks[BlockIdx].Offset, Alignment) + Size > m_Blocks[BlockIdx].Offset + m_Blocks[BlockIdx].Size)
+        {
+            if (Alignment == 1 || Size + (Alignment - 1) > m_FreeSize)
+                return InvalidOffset;
+
+            BlockIdx = FindFreeBlock(Size + (Alignment - 1));
+            if (BlockIdx == InvalidIndex)
+                return InvalidOffset;
+        }
+
+        RemoveFreeBlock(BlockIdx);
+
+        const auto BlockOffset   = m_Blocks[BlockIdx].Offset;
+        const auto AlignedOffset = AlignUp(BlockOffset, Alignment);
+        VERIFY_EXPR(AlignedOffset + Size <= BlockOffset + m_Blocks[BlockIdx].Size);
+
+        if (AlignedOffset > BlockOffset)
+        {
+            // Return the alignment padding to the free lists
+            //
+            //   BlockOffset     AlignedOffset
+            //      |<--Padding-->|<------Size------>|<---Remainder--->|
+            //
+            auto PaddingIdx = SplitBlock(BlockIdx, AlignedOffset - BlockOffset);
+            std::swap(PaddingIdx, BlockIdx);
+            InsertFreeBlock(PaddingIdx);
+        }
+
+        if (m_Blocks[BlockIdx].Size > Size)
+        {
+            const auto RemainderIdx = SplitBlock(BlockIdx, Size);
+            InsertFreeBlock(RemainderIdx);
+        }
+
+        auto& Blk = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Blk.Offset == AlignedOffset && Blk.Size == Size);
+        Blk.IsFree = false;
+        InsertUsedBlock(AlignedOffset, BlockIdx);
+        m_FreeSize -= Size;
+
+        return AlignedOffset;
+    }
+
+    // Releases the allocation. Offset and Size must be the same as the ones
+    // passed to and returned by Allocate().
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        auto BlockIdx = RemoveUsedBlock(Offset);
+        if (BlockIdx == InvalidIndex)
+        {
+            UNEXPECTED("Block at offset ", Offset, " is not allocated - double free?");
+            return;
+        }
+        VERIFY(m_Blocks[BlockIdx].Size == Size, "Size of the released block (", Size, ") does not match the allocation size (", m_Blocks[BlockIdx].Size, ")");
+        (void)Size;
+
+        m_Blocks[BlockIdx].IsFree = true;
+        m_FreeSize += m_Blocks[BlockIdx].Size;
+
+        // Merge with the previous block
+        const auto PrevIdx = m_Blocks[BlockIdx].PrevPhys;
+        if (PrevIdx != InvalidIndex && m_Blocks[PrevIdx].IsFree)
+        {
+            RemoveFreeBlock(PrevIdx);
+            MergeWithNext(PrevIdx);
+            BlockIdx = PrevIdx;
+        }
+
+        // Merge with the next block
+        const auto NextIdx = m_Blocks[BlockIdx].NextPhys;
+        if (NextIdx != InvalidIndex && m_Blocks[NextIdx].IsFree)
+        {
+            RemoveFreeBlock(NextIdx);
+            MergeWithNext(BlockIdx);
+        }
+
+        InsertFreeBlock(BlockIdx);
+    }
+
+    // Adds ExtraSize bytes at the end of the managed space.
+    void Extend(OffsetType ExtraSize)
+    {
+        if (ExtraSize == 0)
+            return;
+
+        if (m_LastBlock != InvalidIndex && m_Blocks[m_LastBlock].IsFree)
+        {
+            // Extend the last block
+            RemoveFreeBlock(m_LastBlock);
+            m_Blocks[m_LastBlock].Size += ExtraSize;
+            InsertFreeBlock(m_LastBlock);
+        }
+        else
+        {
+            const auto NewIdx = CreateBlock(m_MaxSize, ExtraSize);
+            m_Blocks[NewIdx].PrevPhys = m_LastBlock;
+            if (m_LastBlock != InvalidIndex)
+                m_Blocks[m_LastBlock].NextPhys = NewIdx;
+            m_LastBlock = NewIdx;
+            InsertFreeBlock(NewIdx);
+        }
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+    }
+
+    OffsetType GetMaxSize() const { return m_MaxSize; }
+    OffsetType GetFreeSize() const { return m_FreeSize; }
+    size_t     GetNumFreeBlocks() const { return m_NumFreeBlocks; }
+    size_t     GetNumUsedBlocks() const { return m_NumUsedBlocks; }
+
+    // Returns the size of the largest free block.
+    // The method only scans the list of the largest size class.
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+        OffsetType MaxSize = 0;
+        for (auto Idx = m_FreeListHeads[FL * SLCount + SL]; Idx != InvalidIndex; Idx = m_Blocks[Idx].NextFree)
+            MaxSize = std::max(MaxSize, m_Blocks[Idx].Size);
+        return MaxSize;
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyConsistency() const
+    {
+        OffsetType TotalFreeSize = 0;
+        size_t     NumFreeBlocks = 0;
+        size_t     NumUsedBlocks = 0;
+        OffsetType CurrOffset    = 0;
+
+        auto PrevIdx = InvalidIndex;
+        for (auto Idx = m_LastBlock; Idx != InvalidIndex; Idx = m_Blocks[Idx].PrevPhys)
+        {
+            const auto& Blk = m_Blocks[Idx];
+            VERIFY_EXPR(Blk.Size > 0);
+            VERIFY_EXPR(Blk.NextPhys == PrevIdx);
+            VERIFY(PrevIdx == InvalidIndex || !(Blk.IsFree && m_Blocks[PrevIdx].IsFree), "Unmerged adjacent blocks detected");
+            if (PrevIdx == InvalidIndex)
+                VERIFY_EXPR(Blk.Offset + Blk.Size == m_MaxSize);
+            else
+                VERIFY_EXPR(Blk.Offset + Blk.Size == m_Blocks[PrevIdx].Offset);
+            if (Blk.IsFree)
+            {
+                TotalFreeSize += Blk.Size;
+                ++NumFreeBlocks;
+            }
+            else
+            {
+                VERIFY_EXPR(FindUsedBlock(Blk.Offset) == Idx);
+                ++NumUsedBlocks;
+            }
+            CurrOffset = Blk.Offset;
+            PrevIdx    = Idx;
+        }
+        VERIFY_EXPR(CurrOffset == 0);
+
+        size_t NumListedBlocks = 0;
+        for (Uint32 FL = 0; FL < FLCount; ++FL)
+        {
+            for (Uint32 SL = 0; SL < SLCount; ++SL)
+            {
+                const auto Head = m_FreeListHeads[FL * SLCount + SL];
+                VERIFY_EXPR((Head != InvalidIndex) == ((m_SLBitmaps[FL] & (1u << SL)) != 0));
+                for (auto Idx = Head; Idx != InvalidIndex; Idx = m_Blocks[Idx].NextFree)
+                {
+                    Uint32 BlockFL = 0, BlockSL = 0;
+                    MapSize(m_Blocks[Idx].Size, BlockFL, BlockSL);
+                    VERIFY_EXPR(m_Blocks[Idx].IsFree && BlockFL == FL && BlockSL == SL);
+                    ++NumListedBlocks;
+                }
+            }
+            VERIFY_EXPR((m_SLBitmaps[FL] != 0) == ((m_FLBitmap & (Uint64{1} << FL)) != 0));
+        }
+
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+        VERIFY_EXPR(NumFreeBlocks == m_NumFreeBlocks && NumListedBlocks == m_NumFreeBlocks);
+        VERIFY_EXPR(NumUsedBlocks == m_NumUsedBlocks);
+    }
+#endif
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    // log2 of the number of second-level lists
+    static constexpr Uint32 SLBits  = 5;
+    static constexpr Uint32 SLCount = 1u << SLBits;
+    // Blocks smaller than SLCount are all kept in the first-level list 0
+    static constexpr Uint32 FLCount = sizeof(OffsetType) * 8 - SLBits + 1;
+    static_assert(FLCount <= 64, "First-level bitmap is too small");
+
+    struct Block
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Neighbors in the address space
+        Uint32 PrevPhys = InvalidIndex;
+        Uint32 NextPhys = InvalidIndex;
+
+        // Neighbors in the free list. For unused entries of the block array,
+        // NextFree is the next unused entry.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+
+        bool IsFree = true;
+    };
+
+    struct HashEntry
+    {
+        OffsetType Offset   = InvalidOffset;
+        Uint32     BlockIdx = InvalidIndex;
+    };
+
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SLCount)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+            FL             = MSB - SLBits + 1;
+            SL             = static_cast<Uint32>(Size >> (MSB - SLBits)) ^ SLCount;
+        }
+        VERIFY_EXPR(FL < FLCount && SL < SLCount);
+    }
+
+    // Finds a free block that is at least Size bytes large
+    Uint32 FindFreeBlock(OffsetType Size) const
+    {
+        if (Size >= SLCount)
+        {
+            // Round the size up to the next list boundary so that any block in the list fits
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+            Size += (OffsetType{1} << (MSB - SLBits)) - 1;
+        }
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        auto SLMap = m_SLBitmaps[FL] & (~0u << SL);
+        if (SLMap == 0)
+        {
+            if (FL + 1 >= FLCount)
+                return InvalidIndex;
+
+            const auto FLMap = m_FLBitmap & (~Uint64{0} << (FL + 1));
+            if (FLMap == 0)
+                return InvalidIndex;
+
+            FL    = PlatformMisc::GetLSB(FLMap);
+            SLMap = m_SLBitmaps[FL];
+            VERIFY_EXPR(SLMap != 0);
+        }
+        SL = PlatformMisc::GetLSB(SLMap);
+
+        return m_FreeListHeads[FL * SLCount + SL];
+    }
+
+    void InsertFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Blk = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Blk.Size > 0);
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Blk.Size, FL, SL);
+
+        auto& Head   = m_FreeListHeads[FL * SLCount + SL];
+        Blk.IsFree   = true;
+        Blk.PrevFree = InvalidIndex;
+        Blk.NextFree = Head;
+        if (Head != InvalidIndex)
+            m_Blocks[Head].PrevFree = BlockIdx;
+        Head = BlockIdx;
+
+        m_FLBitmap |= Uint64{1} << FL;
+        m_SLBitmaps[FL] |= 1u << SL;
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Blk = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Blk.IsFree);
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Blk.Size, FL, SL);
+
+        if (Blk.PrevFree != InvalidIndex)
+            m_Blocks[Blk.PrevFree].NextFree = Blk.NextFree;
+        if (Blk.NextFree != InvalidIndex)
+            m_Blocks[Blk.NextFree].PrevFree = Blk.PrevFree;
+
+        auto& Head = m_FreeListHeads[FL * SLCount + SL];
+        if (Head == BlockIdx)
+        {
+            Head = Blk.NextFree;
+            if (Head == InvalidIndex)
+            {
+                m_SLBitmaps[FL] &= ~(1u << SL);
+                if (m_SLBitmaps[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        Blk.PrevFree = InvalidIndex;
+        Blk.NextFree = InvalidIndex;
+
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+    }
+
+    Uint32 CreateBlock(OffsetType Offset, OffsetType Size)
+    {
+        Uint32 Idx = m_FirstUnusedBlock;
+        if (Idx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[Idx].NextFree;
+            m_Blocks[Idx]      = Block{};
+        }
+        else
+        {
+            Idx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        m_Blocks[Idx].Offset = Offset;
+        m_Blocks[Idx].Size   = Size;
+        return Idx;
+    }
+
+    void ReleaseBlock(Uint32 BlockIdx)
+    {
+        m_Blocks[BlockIdx].NextFree = m_FirstUnusedBlock;
+        m_FirstUnusedBlock          = BlockIdx;
+    }
+
+    // Splits the block in two and returns the index of the second part that starts at offset Size
+    Uint32 SplitBlock(Uint32 BlockIdx, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0 && Size < m_Blocks[BlockIdx].Size);
+
+        const auto NewIdx = CreateBlock(m_Blocks[BlockIdx].Offset + Size, m_Blocks[BlockIdx].Size - Size);
+        // NB: m_Blocks may have been reallocated by CreateBlock()
+        auto& Blk    = m_Blocks[BlockIdx];
+        auto& NewBlk = m_Blocks[NewIdx];
+        Blk.Size     = Size;
+
+        NewBlk.PrevPhys = BlockIdx;
+        NewBlk.NextPhys = Blk.NextPhys;
+        if (Blk.NextPhys != InvalidIndex)
+            m_Blocks[Blk.NextPhys].PrevPhys = NewIdx;
+        else
+            m_LastBlock = NewIdx;
+        Blk.NextPhys = NewIdx;
+
+        return NewIdx;
+    }
+
+    // Merges the block with its next physical neighbor
+    void MergeWithNext(Uint32 BlockIdx)
+    {
+        auto&      Blk     = m_Blocks[BlockIdx];
+        const auto NextIdx = Blk.NextPhys;
+        VERIFY_EXPR(NextIdx != InvalidIndex);
+
+        const auto& NextBlk = m_Blocks[NextIdx];
+        VERIFY_EXPR(Blk.Offset + Blk.Size == NextBlk.Offset);
+        Blk.Size += NextBlk.Size;
+        Blk.NextPhys = NextBlk.NextPhys;
+        if (NextBlk.NextPhys != InvalidIndex)
+            m_Blocks[NextBlk.NextPhys].PrevPhys = BlockIdx;
+        else
+            m_LastBlock = BlockIdx;
+
+        ReleaseBlock(NextIdx);
+    }
+
+    static size_t HashOffset(OffsetType Offset)
+    {
+        // Offsets are often aligned, so mix the high bits into the low ones
+        auto Hash = static_cast<Uint64>(Offset) * Uint64{0x9E3779B97F4A7C15};
+        return static_cast<size_t>(Hash ^ (Hash >> 32));
+    }
+
+    void InsertUsedBlock(OffsetType Offset, Uint32 BlockIdx)
+    {
+        // Keep the load factor below 1/2
+        if ((m_NumUsedBlocks + 1) * 2 > m_UsedBlocks.size())
+            RehashUsedBlocks(std::max(m_UsedBlocks.size() * 2, size_t{64}));
+
+        const auto Mask = m_UsedBlocks.size() - 1;
+        auto       Pos  = HashOffset(Offset) & Mask;
+        while (m_UsedBlocks[Pos].BlockIdx != InvalidIndex)
+        {
+            VERIFY(m_UsedBlocks[Pos].Offset != Offset, "Block at offset ", Offset, " is already allocated");
+            Pos = (Pos + 1) & Mask;
+        }
+        m_UsedBlocks[Pos] = HashEntry{Offset, BlockIdx};
+        ++m_NumUsedBlocks;
+    }
+
+    size_t FindUsedBlockPos(OffsetType Offset) const
+    {
+        if (m_UsedBlocks.empty())
+            return ~size_t{0};
+
+        const auto Mask = m_UsedBlocks.size() - 1;
+        for (auto Pos = HashOffset(Offset) & Mask; m_UsedBlocks[Pos].BlockIdx != InvalidIndex; Pos = (Pos + 1) & Mask)
+        {
+            if (m_UsedBlocks[Pos].Offset == Offset)
+                return Pos;
+        }
+        return ~size_t{0};
+    }
+
+    Uint32 FindUsedBlock(OffsetType Offset) const
+    {
+        const auto Pos = FindUsedBlockPos(Offset);
+        return Pos != ~size_t{0} ? m_UsedBlocks[Pos].BlockIdx : InvalidIndex;
+    }
+
+    Uint32 RemoveUsedBlock(OffsetType Offset)
+    {
+        auto Pos = FindUsedBlockPos(Offset);
+        if (Pos == ~size_t{0})
+            return InvalidIndex;
+
+        const auto BlockIdx = m_UsedBlocks[Pos].BlockIdx;
+
+        // Backward-shift deletion keeps the probe sequences intact without tombstones
+        const auto Mask = m_UsedBlocks.size() - 1;
+        for (auto Next = (Pos + 1) & Mask; m_UsedBlocks[Next].BlockIdx != InvalidIndex; Next = (Next + 1) & Mask)
+        {
+            const auto Home = HashOffset(m_UsedBlocks[Next].Offset) & Mask;
+            // Move the entry if its home position is not in the cyclic range (Pos, Next]
+            if (((Next - Home) & Mask) >= ((Next - Pos) & Mask))
+            {
+                m_UsedBlocks[Pos] = m_UsedBlocks[Next];
+                Pos               = Next;
+            }
+        }
+        m_UsedBlocks[Pos] = HashEntry{};
+        --m_NumUsedBlocks;
+
+        return BlockIdx;
+    }
+
+    void RehashUsedBlocks(size_t NewSize)
+    {
+        VERIFY_EXPR(IsPowerOfTwo(NewSize));
+        decltype(m_UsedBlocks) OldBlocks(NewSize, m_UsedBlocks.get_allocator());
+        OldBlocks.swap(m_UsedBlocks);
+        m_NumUsedBlocks = 0;
+        for (const auto& Entry : OldBlocks)
+        {
+            if (Entry.BlockIdx != InvalidIndex)
+                InsertUsedBlock(Entry.Offset, Entry.BlockIdx);
+        }
+    }
+
+private:
+    std::vector<Block, STDAllocatorRawMem<Block>>         m_Blocks;
+    std::vector<HashEntry, STDAllocatorRawMem<HashEntry>> m_UsedBlocks;
+
+    Uint64                                m_FLBitmap = 0;
+    std::array<Uint32, FLCount>           m_SLBitmaps;
+    std::array<Uint32, FLCount * SLCount> m_FreeListHeads;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    Uint32 m_LastBlock        = InvalidIndex;
+
+    size_t m_NumFreeBlocks = 0;
+    size_t m_NumUsedBlocks = 0;
+
+    OffsetType m_MaxSize  = 0;
+    OffsetType m_FreeSize = 0;
+};
+
+} // namespace Diligent
@@ -32,11 +32,13 @@
 
 #include <map>
 #include <algorithm>
+#include <memory>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/Align.hpp"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "TLSFBlockManager.hpp"
 
 namespace Diligent
 {
@@ -61,6 +63,10 @@ namespace Diligent
 //
 //                32 ------------------> 104 ---------->  {size = 32, &m_FreeBlocksBySize[3]}
 //
+// Alternatively, the free blocks may be managed by the TLSFBlockManager (see CreateInfo::UseTLSF).
+// In this mode, allocation and deallocation take constant time and do not allocate map nodes, but
+// the first suitable block is used instead of the smallest one.
+//
 class VariableSizeAllocationsManager
 {
 public:
@@ -103,6 +109,9 @@ public:
         IMemoryAllocator& Allocator;
         OffsetType        MaxSize                   = 0;
         bool              DbgDisableDebugValidation = false;
+
+        // Use the two-level segregated fit algorithm instead of the ordered maps
+        bool UseTLSF = false;
     };
     explicit VariableSizeAllocationsManager(const CreateInfo& CI)
         // clang-format off
@@ -115,12 +124,31 @@ public:
 #endif
     // clang-format on
     {
-        // Insert single maximum-size block
-        AddNewBlock(0, m_MaxSize);
+        if (CI.UseTLSF)
+        {
+            void* pRawMem = CI.Allocator.Allocate(sizeof(TLSFBlockManager), "Memory for TLSFBlockManager", __FILE__, __LINE__);
+            try
+            {
+                m_pTLSF = TLSFBlockManagerPtr{new (pRawMem) TLSFBlockManager{m_MaxSize, CI.Allocator}, STDDeleterRawMem<TLSFBlockManager>{CI.Allocator}};
+            }
+            catch (...)
+            {
+                CI.Allocator.Free(pRawMem);
+                throw;
+            }
+        }
+        else
+        {
+            // Insert single maximum-size block
+            AddNewBlock(0, m_MaxSize);
+        }
         ResetCurrAlignment();
 
 #ifdef DILIGENT_DEBUG
-        DbgVerifyList();
+        if (m_pTLSF)
+            m_pTLSF->DbgVerifyConsistency();
+        else
+            DbgVerifyList();
 #endif
     }
 
@@ -153,6 +181,7 @@ public:
         , m_MaxSize           {rhs.m_MaxSize      }
         , m_FreeSize          {rhs.m_FreeSize     }
         , m_CurrAlignment     {rhs.m_CurrAlignment}
+        , m_pTLSF             {std::move(rhs.m_pTLSF)}
 #ifdef DILIGENT_DEBUG
         , m_DbgDisableDebugValidation{rhs.m_DbgDisableDebugValidation}
 #endif
@@ -211,6 +240,9 @@ public:
         if (m_FreeSize < Size)
             return Allocation::InvalidAllocation();
 
+        if (m_pTLSF)
+            return AllocateTLSF(Size, Alignment);
+
         auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
         // Get the first block that is large enough to encompass Size + AlignmentReserve bytes
         // lower_bound() returns an iterator pointing to the first element that
@@ -279,6 +311,12 @@ public:
     {
         VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
 
+        if (m_pTLSF)
+        {
+            FreeTLSF(Offset, Size);
+            return;
+        }
+
         // Find the first element whose offset is greater than the specified offset.
         // upper_bound() returns an iterator pointing to the first element in the
         // container whose key is considered to go after k.
@@ -383,16 +421,46 @@ public:
 
     size_t GetNumFreeBlocks() const
     {
-        return m_FreeBlocksByOffset.size();
+        return m_pTLSF ? m_pTLSF->GetNumFreeBlocks() : m_FreeBlocksByOffset.size();
     }
 
     OffsetType GetMaxFreeBlockSize() const
     {
+        if (m_pTLSF)
+            return m_pTLSF->GetMaxFreeBlockSize();
+
         return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
     }
 
+    // Returns the fraction of the free space that is not in the largest free block:
+    // 0 means that all free space is contiguous, while values close to 1 indicate
+    // that the free space is scattered across many small blocks.
+    float GetFragmentation() const
+    {
+        return m_FreeSize > 0 ?
+            1.f - static_cast<float>(GetMaxFreeBlockSize()) / static_cast<float>(m_FreeSize) :
+            0.f;
+    }
+
+    bool IsTLSF() const
+    {
+        return m_pTLSF != nullptr;
+    }
+
     void Extend(size_t ExtraSize)
     {
+        if (m_pTLSF)
+        {
+            m_pTLSF->Extend(ExtraSize);
+            m_MaxSize += ExtraSize;
+            m_FreeSize += ExtraSize;
+#ifdef DILIGENT_DEBUG
+            if (!m_DbgDisableDebugValidation)
+                m_pTLSF->DbgVerifyConsistency();
+#endif
+            return;
+        }
+
         size_t NewBlockOffset = m_MaxSize;
         size_t NewBlockSize   = ExtraSize;
 
@@ -429,6 +497,33 @@ public:
     }
 
 private:
+    Allocation AllocateTLSF(OffsetType Size, OffsetType Alignment)
+    {
+        // TLSF manager returns aligned offsets and does not need the alignment reserve
+        const auto Offset = m_pTLSF->Allocate(Size, Alignment);
+        if (Offset == TLSFBlockManager::InvalidOffset)
+            return Allocation::InvalidAllocation();
+
+        m_FreeSize -= Size;
+        VERIFY_EXPR(m_FreeSize == m_pTLSF->GetFreeSize());
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            m_pTLSF->DbgVerifyConsistency();
+#endif
+        return Allocation{Offset, Size};
+    }
+
+    void FreeTLSF(OffsetType Offset, OffsetType Size)
+    {
+        m_pTLSF->Free(Offset, Size);
+        m_FreeSize += Size;
+        VERIFY_EXPR(m_FreeSize == m_pTLSF->GetFreeSize());
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            m_pTLSF->DbgVerifyConsistency();
+#endif
+    }
+
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
         auto NewBlockIt = m_FreeBlocksByOffset.emplace(Offset, Size);
@@ -488,6 +583,10 @@ private:
     OffsetType m_MaxSize       = 0;
     OffsetType m_FreeSize      = 0;
     OffsetType m_CurrAlignment = 0;
+
+    // Non-null if the free blocks are managed by the TLSF algorithm
+    using TLSFBlockManagerPtr = std::unique_ptr<TLSFBlockManager, STDDeleterRawMem<TLSFBlockManager>>;
+    TLSFBlockManagerPtr m_pTLSF;
 #ifdef DILIGENT_DEBUG
     bool m_DbgDisableDebugValidation = false;
 #endif
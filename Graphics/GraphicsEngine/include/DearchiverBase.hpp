@@ -32,7 +32,9 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
+#include <condition_variable>
 
 #include "Dearchiver.h"
 #include "RenderDevice.h"
@@ -43,6 +45,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "DeviceObjectArchive.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "DynamicLinearAllocatorPool.hpp"
 
 namespace Diligent
 {
@@ -73,6 +76,13 @@ public:
     virtual void DILIGENT_CALL_TYPE UnpackPipelineState(const PipelineStateUnpackInfo& DeArchiveInfo,
                                                         IPipelineState**               ppPSO) override final;
 
+    /// Implementation of IDearchiver::UnpackPipelineStates().
+    virtual void DILIGENT_CALL_TYPE UnpackPipelineStates(const PipelineStateUnpackInfo* pUnpackInfos,
+                                                         Uint32                         NumPipelines,
+                                                         IThreadPool*                   pThreadPool,
+                                                         IPipelineState**               ppPSOs,
+                                                         IAsyncTask**                   ppTasks) override final;
+
     /// Implementation of IDearchiver::UnpackResourceSignature().
     virtual void DILIGENT_CALL_TYPE UnpackResourceSignature(const ResourceSignatureUnpackInfo& DeArchiveInfo,
                                                             IPipelineResourceSignature**       ppSignature) override final;
@@ -140,15 +150,21 @@ protected:
         NamedResourceCache<IPipelineState>             PSO;
     } m_Cache;
 
+    // Arenas for temporary data of the objects being unpacked. Objects may be unpacked
+    // by multiple threads, and memory blocks are reused by subsequent unpack operations.
+    DynamicLinearAllocatorPool m_AllocatorPool{GetRawAllocator(), 2 << 10};
+
     struct PRSData
     {
-        DynamicLinearAllocator        Allocator;
-        PipelineResourceSignatureDesc Desc;
+        DynamicLinearAllocatorPool::ArenaHandle Arena;
+        DynamicLinearAllocator&                 Allocator;
+        PipelineResourceSignatureDesc           Desc;
 
         static constexpr ResourceType ArchiveResType = ResourceType::ResourceSignature;
 
-        explicit PRSData(IMemoryAllocator& Allocator, Uint32 BlockSize = 1 << 10) :
-            Allocator{Allocator, BlockSize}
+        explicit PRSData(DynamicLinearAllocatorPool& AllocatorPool) :
+            Arena{AllocatorPool.GetArena()},
+            Allocator{*Arena}
         {}
 
         bool Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser);
@@ -165,8 +181,12 @@ private:
     struct ShaderCacheData
     {
         std::mutex Mtx;
+        // Signaled when shaders unpacked by one of the threads are added to the cache
+        std::condition_variable Cond;
 
         std::vector<RefCntAutoPtr<IShader>> Shaders;
+        // Indices of the shaders that are currently being unpacked by some thread
+        std::unordered_set<Uint32> InProgress;
 
         ShaderCacheData() = default;
         ShaderCacheData(ShaderCacheData&& rhs) noexcept :
@@ -205,19 +225,21 @@ private:
     template <typename CreateInfoType>
     bool UnpackPSOShaders(ArchiveData&             Archive,
                           PSOData<CreateInfoType>& PSO,
-                          IRenderDevice*           pDevice);
+                          IRenderDevice*           pDevice,
+                          IThreadPool*             pThreadPool);
 
     template <typename CreateInfoType>
-    void UnpackPipelineStateImpl(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO);
+    void UnpackPipelineStateImpl(const PipelineStateUnpackInfo& UnpackInfo, IThreadPool* pThreadPool, IPipelineState** ppPSO);
 
-    ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
+    // Unpacks the pipeline state. If pThreadPool is not null, it is used to read
+    // the shaders of the pipeline in parallel.
+    void UnpackPipelineState(const PipelineStateUnpackInfo& UnpackInfo, IThreadPool* pThreadPool, IPipelineState** ppPSO);
 
-private:
-    // Resource type and name -> archive index that contains this resource.
+    // Returns the first loaded archive that contains the resource.
     // Names must be unique for each resource type.
-    using NamedResourceKey = DeviceObjectArchive::NamedResourceKey;
-    std::unordered_map<NamedResourceKey, size_t, NamedResourceKey::Hasher> m_ResNameToArchiveIdx;
+    ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
 
+private:
     std::vector<ArchiveData> m_Archives;
 };
 
@@ -238,29 +260,27 @@ RefCntAutoPtr<IPipelineResourceSignature> DearchiverBase::UnpackResourceSignatur
     }
 
     // Find the archive that contains this signature
-    auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{PRSData::ArchiveResType, DeArchiveInfo.Name});
-    if (archive_idx_it == m_ResNameToArchiveIdx.end())
+    auto* pArchiveData = FindArchive(PRSData::ArchiveResType, DeArchiveInfo.Name);
+    if (pArchiveData == nullptr)
         return {};
 
-    const auto& pObjArchive = m_Archives[archive_idx_it->second].pObjArchive;
-    if (!pObjArchive)
-    {
-        UNEXPECTED("Null object archives should never be added to the list. This is a bug.");
-        return {};
-    }
+    const auto& pObjArchive = pArchiveData->pObjArchive;
+    VERIFY_EXPR(pObjArchive);
 
-    PRSData PRS{GetRawAllocator()};
+    PRSData PRS{m_AllocatorPool};
     if (!pObjArchive->LoadResourceCommonData(PRSData::ArchiveResType, DeArchiveInfo.Name, PRS))
         return {};
 
     PRS.Desc.SRBAllocationGranularity = DeArchiveInfo.SRBAllocationGranularity;
 
     const auto  DevType = GetArchiveDeviceType(DeArchiveInfo.pDevice);
-    const auto& Data    = pObjArchive->GetDeviceSpecificData(PRSData::ArchiveResType, DeArchiveInfo.Name, DevType);
+    const auto  Data    = pObjArchive->GetDeviceSpecificData(PRSData::ArchiveResType, DeArchiveInfo.Name, DevType);
     if (!Data)
         return {};
 
-    Serializer<SerializerMode::Read> Ser{Data};
+    // Arrays are read in place from the archive data, which is only valid while pObjArchive is alive.
+    // This is safe because the signature copies the arrays into its own memory when it is created below.
+    Serializer<SerializerMode::Read> Ser{Data, /*InPlaceArrays = */ true};
 
     bool SpecialDesc = false;
     if (!Ser(SpecialDesc))
@@ -44,11 +44,21 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header | Table of Contents |  Resource Data  |  Shader Data  |
+//
+//     | Table of Contents | = | Resource TOC | OpenGL shader TOC | D3D11 shader TOC | ... | Metal-iOS shader TOC |
+//
+//         | Resource TOC | = | Res1 entry | Res2 entry | ... | ResN entry |   (sorted by type and name)
+//
+//             | ResI entry | = | Type | Name size | Name offset | Data offset | Data size |
+//
+//         | Device shader TOC | = | Shader0 entry | Shader1 entry | ... |
+//
+//             | ShaderI entry | = | Offset | Size | Decompressed size |
 //
 //     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
 //
-//         | ResI | = | Type | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
+//         | ResI | = | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
 //
 //     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
 //
@@ -56,9 +66,18 @@
 // - Magic number
 // - Archive version
 // - API version
-
+// - The number of resources and the number of shaders for each device type
+// - Shader data compression mode for each device type
+//
+// The table of contents allows resolving a resource by a binary search and a shader
+// by its index without deserializing the entire archive. All offsets are relative
+// to the start of the archive and are aligned by 8 bytes.
+//
+// Shaders of a device type may be compressed. Every shader is compressed individually
+// so that it can be decompressed on demand. Shaders that do not benefit from
+// compression are stored as is, in which case their size equals the decompressed size.
+//
 // Resource data contains an array of resources. Each resource contains:
-// - Type (Signature, Graphics Pipeline, Render Pass, etc.)
 // - Name
 // - Common data (e.g. a resource description)
 // - Device-specific data (e.g. shader indices)
@@ -69,16 +88,18 @@
 // For pipelines, device-specific data is the array of shader indices in the
 // archive's shader array, e.g.:
 //
-// | PsoX | = |   Type   |   Name   |   Common Data   |   OpenGL data   |    D3D11 data   | ...
-//              Graphics   "My PSO"    <Description>        {0, 1}             {1, 2}
-//                                                                  ____________|  |
-//                                                                 |               |
-//                                                                 V               V
+// | PsoX | = |   Name   |   Common Data   |   OpenGL data   |    D3D11 data   | ...
+//             "My PSO"    <Description>        {0, 1}             {1, 2}
+//                                                      ____________|  |
+//                                                     |               |
+//                                                     V               V
 // | GL Shader 0 | GL Shader 1 |  ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
 
 namespace Diligent
 {
 
+struct IThreadPool;
+
 /// Device object archive object.
 class DeviceObjectArchive
 {
@@ -126,8 +147,16 @@ public:
         Count
     };
 
+    // Shader data compression mode.
+    enum class CompressionMode : Uint32
+    {
+        None = 0,
+        LZ4,
+        Count
+    };
+
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 5;
+    static constexpr Uint32 ArchiveVersion    = 8;
 
     struct ArchiveHeader
     {
@@ -232,6 +261,10 @@ public:
         bool             MakeCopy       = false;
     };
     /// Initializes a new device object archive from pData.
+    ///
+    /// \remarks    Only the archive header and the table of contents are read.
+    ///             Resources and shaders are resolved on demand and reference
+    ///             the source data, so pData may be e.g. a memory-mapped file.
     explicit DeviceObjectArchive(const CreateInfo& CI) noexcept(false);
 
     /// Initializes an empty archive.
@@ -241,64 +274,162 @@ public:
     void AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false);
     void Merge(const DeviceObjectArchive& Src) noexcept(false);
 
-    void Deserialize(const CreateInfo& CI) noexcept(false);
-    void Serialize(IFileStream* pStream) const;
-    void Serialize(IDataBlob** ppDataBlob) const;
+    /// Writes the archive to the file stream. The data is written through the staging buffer
+    /// of the given size, so the full archive is never allocated in memory.
+    /// If the thread pool is not null, the shaders are compressed in parallel.
+    bool Serialize(IFileStream* pStream, size_t StagingBufferSize = size_t{1} << 20u, IThreadPool* pThreadPool = nullptr) const;
+    void Serialize(IDataBlob** ppDataBlob, IThreadPool* pThreadPool = nullptr) const;
 
     std::string ToString() const;
 
+    /// Deserializes the common data of the resource. Strings and trivial arrays
+    /// in ResData reference the archive data.
     template <typename ReourceDataType>
     bool LoadResourceCommonData(ResourceType     Type,
                                 const char*      Name,
                                 ReourceDataType& ResData) const
     {
-        auto it = m_NamedResources.find(NamedResourceKey{Type, Name});
-        if (it == m_NamedResources.end())
+        ResourceData Data;
+        // Use the name string from the archive
+        const auto* ArchiveName = FindResource(Type, Name, Data);
+        if (ArchiveName == nullptr)
         {
             LOG_ERROR_MESSAGE("Resource '", Name, "' is not present in the archive");
             return false;
         }
-        VERIFY_EXPR(SafeStrEqual(Name, it->first.GetName()));
-        // Use string copy from the map
-        Name = it->first.GetName();
+        VERIFY_EXPR(SafeStrEqual(Name, ArchiveName));
 
-        Serializer<SerializerMode::Read> Ser{it->second.Common};
+        Serializer<SerializerMode::Read> Ser{Data.Common, /*InPlaceArrays = */ true};
 
-        auto Res = ResData.Deserialize(Name, Ser);
+        auto Res = ResData.Deserialize(ArchiveName, Ser);
         VERIFY_EXPR(Ser.IsEnded());
         return Res;
     }
 
-    const SerializedData& GetDeviceSpecificData(ResourceType Type,
-                                                const char*  Name,
-                                                DeviceType   DevType) const noexcept;
+    bool HasResource(ResourceType Type, const char* Name) const noexcept
+    {
+        ResourceData Data;
+        return FindResource(Type, Name, Data) != nullptr;
+    }
+
+    /// Returns the device-specific data of the resource. The returned object references the archive data.
+    SerializedData GetDeviceSpecificData(ResourceType Type,
+                                         const char*  Name,
+                                         DeviceType   DevType) const noexcept;
 
-    ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept
+    ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept(false)
     {
+        MaterializeTOC();
         constexpr auto MakeCopy = true;
         return m_NamedResources[NamedResourceKey{Type, Name, MakeCopy}];
     }
 
-    auto& GetDeviceShaders(DeviceType Type) noexcept
+    std::vector<SerializedData>& GetDeviceShaders(DeviceType Type) noexcept(false)
     {
+        MaterializeTOC();
         return m_DeviceShaders[static_cast<size_t>(Type)];
     }
 
-    const auto& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+    size_t GetNumShaders(DeviceType Type) const noexcept
     {
-        const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
-        if (Idx < DeviceShaders.size())
-            return DeviceShaders[Idx];
+        return m_UseTOC ?
+            m_TOC.NumShaders[static_cast<size_t>(Type)] :
+            m_DeviceShaders[static_cast<size_t>(Type)].size();
+    }
 
-        static const SerializedData NullData;
-        return NullData;
+    /// Returns the serialized shader data.
+
+    /// \remarks   If the shader is compressed, the returned object owns the decompressed data.
+    ///             Otherwise, it references the archive data.
+    SerializedData GetSerializedShader(DeviceType Type, size_t Idx) const noexcept;
+
+    /// Returns the serialized data of multiple shaders, see GetSerializedShader().
+
+    /// \param [in]  Type        - Device type.
+    /// \param [in]  pIndices    - Shader indices.
+    /// \param [in]  NumShaders  - The number of shaders.
+    /// \param [out] pShaders    - Pointer to the array of NumShaders elements where the
+    ///                            shader data will be written.
+    /// \param [in]  pThreadPool - Optional thread pool that will be used to decompress
+    ///                            the shaders in parallel.
+    ///
+    /// \return     true if all shaders have been successfully read, and false otherwise.
+    bool GetSerializedShaders(DeviceType      Type,
+                              const Uint32*   pIndices,
+                              size_t          NumShaders,
+                              SerializedData* pShaders,
+                              IThreadPool*    pThreadPool = nullptr) const noexcept;
+
+    /// Sets the compression mode of the shaders of the given device type.
+    /// The shaders are compressed when the archive is serialized.
+    void SetShaderCompression(DeviceType Type, CompressionMode Mode) noexcept(false);
+
+    CompressionMode GetShaderCompression(DeviceType Type) const noexcept
+    {
+        return m_ShaderCompression[static_cast<size_t>(Type)];
     }
 
-    const auto& GetNamedResources() const
+    /// Calls Handler(ResourceType Type, const char* Name, const ResourceData& Data) for every resource in the archive.
+    template <typename HandlerType>
+    void ProcessResources(HandlerType&& Handler) const noexcept(false)
     {
-        return m_NamedResources;
+        if (m_UseTOC)
+        {
+            for (Uint32 i = 0; i < m_TOC.NumResources; ++i)
+            {
+                ResourceData Data;
+                const auto*  Name = ResolveTOCEntry(m_TOC.pResources[i], Data);
+                if (Name == nullptr)
+                    LOG_ERROR_AND_THROW("Failed to read resource ", i, "/", m_TOC.NumResources, ". Archive file may be corrupted or invalid.");
+                Handler(m_TOC.pResources[i].Type, Name, Data);
+            }
+        }
+        else
+        {
+            for (const auto& res_it : m_NamedResources)
+                Handler(res_it.first.GetType(), res_it.first.GetName(), res_it.second);
+        }
     }
 
+private:
+    void Deserialize(const CreateInfo& CI) noexcept(false);
+
+    // Measures the archive and calls WriteHandler(ArchiveSize, SerializeThis), where
+    // SerializeThis(Writer) writes the archive data using the given serializer and
+    // returns false if the serializer has failed, e.g. when a stream write has failed.
+    template <typename WriteHandlerType>
+    void SerializeArchive(IThreadPool* pThreadPool, WriteHandlerType&& WriteHandler) const;
+
+    // Copies the resource and shader references from the table of contents
+    // to m_NamedResources and m_DeviceShaders so that the archive can be modified.
+    void MaterializeTOC() noexcept(false);
+
+    // Returns the resource name stored in the archive, or null if the resource is not found.
+    const char* FindResource(ResourceType Type, const char* Name, ResourceData& Data) const noexcept;
+
+    struct ResourceTOCEntry
+    {
+        ResourceType Type       = ResourceType::Undefined;
+        Uint32       NameSize   = 0; // Including the null terminator
+        Uint64       NameOffset = 0;
+        Uint64       DataOffset = 0;
+        Uint64       DataSize   = 0;
+    };
+    static_assert(sizeof(ResourceTOCEntry) == 32, "Archive format depends on the size of ResourceTOCEntry");
+
+    struct ShaderTOCEntry
+    {
+        Uint64 Offset           = 0;
+        Uint32 Size             = 0; // The size of the data stored in the archive
+        Uint32 DecompressedSize = 0; // Equals Size if the shader is not compressed
+    };
+    static_assert(sizeof(ShaderTOCEntry) == 16, "Archive format depends on the size of ShaderTOCEntry");
+
+    // Returns the resource name referenced by the entry, or null if the entry is invalid.
+    const char* GetTOCEntryName(const ResourceTOCEntry& Entry) const noexcept;
+    // Reads the resource data referenced by the entry and returns the resource name, or null if the entry is invalid.
+    const char* ResolveTOCEntry(const ResourceTOCEntry& Entry, ResourceData& Data) const noexcept;
+
 private:
     // Named resources
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
@@ -306,6 +437,23 @@ private:
     // Shaders
     std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
 
+    // Table of contents that references the archive data.
+    struct TableOfContents
+    {
+        const ResourceTOCEntry* pResources   = nullptr;
+        Uint32                  NumResources = 0;
+
+        std::array<const ShaderTOCEntry*, static_cast<size_t>(DeviceType::Count)> pShaders{};
+        std::array<Uint32, static_cast<size_t>(DeviceType::Count)>                NumShaders{};
+    };
+    TableOfContents m_TOC;
+
+    std::array<CompressionMode, static_cast<size_t>(DeviceType::Count)> m_ShaderCompression{};
+
+    // If true, resources and shaders are resolved through m_TOC, and m_NamedResources and
+    // m_DeviceShaders are empty. Any modification of the archive materializes the TOC.
+    bool m_UseTOC = false;
+
     // Strong reference to the original data blob.
     // Resources will not make copies and reference this data.
     RefCntAutoPtr<IDataBlob> m_pArchiveData;
@@ -81,6 +81,59 @@ Uint32 FindResource(const PipelineResourceDesc Resources[],
                     SHADER_TYPE                ShaderStage,
                     const char*                ResourceName);
 
+/// Returns the size of the hash table that maps resource names to resource indices.
+/// The size is a power of two that is at least twice the number of resources.
+Uint32 GetResourceNameTableSize(Uint32 NumResources);
+
+/// Initializes the hash table that maps resource names to resource indices.
+/// Every table entry contains the resource index plus one in the lower 16 bits (zero marks an
+/// empty entry) and the upper bits of the name hash in the upper 16 bits (see GetResourceNameTableEntryTag()).
+/// The table uses linear probing, and resources are inserted in the order of increasing index.
+/// Throws an exception if the number of resources exceeds MAX_RESOURCES_IN_SIGNATURE.
+void InitResourceNameTable(const PipelineResourceDesc Resources[],
+                           Uint32                     NumResources,
+                           Uint32                     NameTable[],
+                           Uint32                     TableSize) noexcept(false);
+
+/// Returns the tag that is stored in the upper 16 bits of the resource name table entry.
+inline Uint32 GetResourceNameTableEntryTag(size_t NameHash)
+{
+    return static_cast<Uint32>((NameHash >> 16u) & 0xFFFFu) << 16u;
+}
+
+/// Calls Handler(ResIndex) for every resource with the given name in the order of increasing
+/// resource index until the handler returns true. Returns true if the handler returned true,
+/// and false otherwise.
+template <typename HandlerType>
+bool FindResourcesByName(const PipelineResourceDesc Resources[],
+                         const Uint32               NameTable[],
+                         Uint32                     TableSize,
+                         const char*                Name,
+                         HandlerType&&              Handler)
+{
+    VERIFY_EXPR(Name != nullptr);
+    if (TableSize == 0)
+        return false;
+
+    VERIFY(IsPowerOfTwo(TableSize), "Table size must be a power of two");
+    const auto NameHash = CStringHash<Char>{}(Name);
+    const auto Tag      = GetResourceNameTableEntryTag(NameHash);
+    const auto Mask     = TableSize - 1;
+    for (Uint32 Slot = static_cast<Uint32>(NameHash) & Mask;; Slot = (Slot + 1) & Mask)
+    {
+        const auto Entry = NameTable[Slot];
+        if (Entry == 0)
+            return false;
+
+        if ((Entry & 0xFFFF0000u) == Tag)
+        {
+            const Uint32 ResIndex = (Entry & 0xFFFFu) - 1;
+            if (strcmp(Resources[ResIndex].Name, Name) == 0 && Handler(ResIndex))
+                return true;
+        }
+    }
+}
+
 /// Returns true if two pipeline resource signature descriptions are compatible, and false otherwise
 bool PipelineResourceSignaturesCompatible(const PipelineResourceSignatureDesc& Desc0,
                                           const PipelineResourceSignatureDesc& Desc1,
@@ -637,7 +690,26 @@ public:
     /// index in m_Desc.Resources[], or InvalidPipelineResourceIndex if the resource is not found.
     Uint32 FindResource(SHADER_TYPE ShaderStage, const char* ResourceName) const
     {
-        return Diligent::FindResource(this->m_Desc.Resources, this->m_Desc.NumResources, ShaderStage, ResourceName);
+        VERIFY_EXPR(ResourceName != nullptr && ResourceName[0] != '\0');
+        Uint32 ResIndex = InvalidPipelineResourceIndex;
+        FindResourcesByName(ResourceName,
+                            [&](Uint32 Idx) {
+                                if ((this->m_Desc.Resources[Idx].ShaderStages & ShaderStage) == 0)
+                                    return false;
+                                ResIndex = Idx;
+                                return true;
+                            });
+        return ResIndex;
+    }
+
+    /// Calls Handler(ResIndex) for every resource with the given name in the order of increasing
+    /// resource index until the handler returns true. Returns true if the handler returned true.
+    /// The lookup uses the name hash table that is built when the signature is initialized.
+    template <typename HandlerType>
+    bool FindResourcesByName(const char* ResourceName, HandlerType&& Handler) const
+    {
+        return Diligent::FindResourcesByName(this->m_Desc.Resources, m_pResourceNameTable, m_ResourceNameTableSize,
+                                             ResourceName, std::forward<HandlerType>(Handler));
     }
 
     /// Finds an immutable with the given name in the specified shader stage and returns its
@@ -740,6 +812,9 @@ protected:
 
         ReserveSpaceForPipelineResourceSignatureDesc(Allocator, Desc);
 
+        const auto ResourceNameTableSize = GetResourceNameTableSize(Desc.NumResources);
+        Allocator.AddSpace<Uint32>(ResourceNameTableSize);
+
         Allocator.AddSpace<PipelineResourceAttribsType>(Desc.NumResources);
 
         const auto NumStaticResStages = GetNumStaticResStages();
@@ -757,6 +832,14 @@ protected:
 
         CopyPipelineResourceSignatureDesc(Allocator, Desc, this->m_Desc, m_ResourceOffsets);
 
+        if (ResourceNameTableSize > 0)
+        {
+            auto* pNameTable = Allocator.Allocate<Uint32>(ResourceNameTableSize);
+            InitResourceNameTable(this->m_Desc.Resources, this->m_Desc.NumResources, pNameTable, ResourceNameTableSize);
+            m_pResourceNameTable    = pNameTable;
+            m_ResourceNameTableSize = ResourceNameTableSize;
+        }
+
 #ifdef DILIGENT_DEBUG
         VERIFY_EXPR(m_ResourceOffsets[SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES] == this->m_Desc.NumResources);
         for (Uint32 VarType = 0; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; ++VarType)
@@ -931,6 +1014,9 @@ protected:
         static_assert(std::is_trivially_destructible<PipelineResourceAttribsType>::value, "Destructors for m_pResourceAttribs[] are required");
         m_pResourceAttribs = nullptr;
 
+        m_pResourceNameTable    = nullptr;
+        m_ResourceNameTableSize = 0;
+
         m_pRawMemory.reset();
 
 #if DILIGENT_DEBUG
@@ -985,6 +1071,12 @@ protected:
     // Pipeline resource attributes
     PipelineResourceAttribsType* m_pResourceAttribs = nullptr; // [m_Desc.NumResources]
 
+    // Hash table that maps resource names to indices in m_Desc.Resources[], see InitResourceNameTable().
+    // The table is shared by all variable managers that use this signature.
+    const Uint32* m_pResourceNameTable = nullptr; // [m_ResourceNameTableSize]
+
+    Uint32 m_ResourceNameTableSize = 0;
+
     // Static resource cache for all static resources
     ShaderResourceCacheImplType* m_pStaticResCache = nullptr;
 
@@ -35,6 +35,7 @@
 #include <unordered_set>
 #include <cstring>
 #include <vector>
+#include <atomic>
 
 #include "PrivateConstants.h"
 #include "PipelineState.h"
@@ -45,6 +46,7 @@
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
 #include "PipelineResourceSignatureBase.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -107,6 +109,10 @@ void ValidatePipelineResourceCompatibility(const PipelineResourceDesc& ResDesc,
                                            const char*                 ShaderName,
                                            const char*                 SignatureName) noexcept(false);
 
+/// Waits until the shader is compiled and throws an exception if the shader
+/// can't be used to create the pipeline (e.g. the compilation has failed).
+void WaitForShaderCompilation(IShader* pShader) noexcept(false);
+
 
 /// Copies ray tracing shader group names and also initializes the mapping from the group name to its index.
 void CopyRTShaderGroupNames(std::unordered_map<HashMapStringKey, Uint32>& NameToGroupIndex,
@@ -372,6 +378,9 @@ public:
             return;
         }
 
+        if (!WaitForInitialization("CreateShaderResourceBinding"))
+            return;
+
         return this->GetResourceSignature(0)->CreateShaderResourceBinding(ppShaderResourceBinding, InitStaticResources);
     }
 
@@ -385,6 +394,9 @@ public:
             return nullptr;
         }
 
+        if (!WaitForInitialization("GetStaticVariableByName"))
+            return nullptr;
+
         if ((m_ActiveShaderStages & ShaderType) == 0)
         {
             LOG_WARNING_MESSAGE("Unable to find static variable '", Name, "' in shader stage ", GetShaderTypeLiteralName(ShaderType),
@@ -405,6 +417,9 @@ public:
             return nullptr;
         }
 
+        if (!WaitForInitialization("GetStaticVariableByIndex"))
+            return nullptr;
+
         if ((m_ActiveShaderStages & ShaderType) == 0)
         {
             LOG_WARNING_MESSAGE("Unable to get static variable at index ", Index, " in shader stage ", GetShaderTypeLiteralName(ShaderType),
@@ -424,6 +439,9 @@ public:
             return 0;
         }
 
+        if (!WaitForInitialization("GetStaticVariableCount"))
+            return 0;
+
         if ((m_ActiveShaderStages & ShaderType) == 0)
         {
             LOG_WARNING_MESSAGE("Unable to get the number of static variables in shader stage ", GetShaderTypeLiteralName(ShaderType),
@@ -445,6 +463,9 @@ public:
             return;
         }
 
+        if (!WaitForInitialization("BindStaticResources"))
+            return;
+
         return this->GetResourceSignature(0)->BindStaticResources(ShaderStages, pResourceMapping, Flags);
     }
 
@@ -457,6 +478,9 @@ public:
             return;
         }
 
+        if (!WaitForInitialization("InitializeStaticSRBResources"))
+            return;
+
         return this->GetResourceSignature(0)->InitializeStaticSRBResources(pSRB);
     }
 
@@ -481,7 +505,14 @@ public:
             return;
         }
 
-        auto* pDstSign = static_cast<PipelineStateImplType*>(pDstPipeline)->GetResourceSignature(0);
+        if (!WaitForInitialization("CopyStaticResources"))
+            return;
+
+        auto* pDstPipelineImpl = static_cast<PipelineStateImplType*>(pDstPipeline);
+        if (!pDstPipelineImpl->WaitForInitialization("CopyStaticResources"))
+            return;
+
+        auto* pDstSign = pDstPipelineImpl->GetResourceSignature(0);
         return this->GetResourceSignature(0)->CopyStaticResources(pDstSign);
     }
 
@@ -494,6 +525,9 @@ public:
     /// Implementation of IPipelineState::GetResourceSignature().
     virtual PipelineResourceSignatureImplType* DILIGENT_CALL_TYPE GetResourceSignature(Uint32 Index) const override final
     {
+        if (!WaitForInitialization("GetResourceSignature"))
+            return nullptr;
+
         VERIFY_EXPR(Index < m_SignatureCount);
         return m_Signatures[Index];
     }
@@ -512,6 +546,9 @@ public:
         const auto& lhs = *static_cast<const PipelineStateImplType*>(this);
         const auto& rhs = *pPSOImpl;
 
+        if (!lhs.WaitForInitialization("IsCompatibleWith") || !rhs.WaitForInitialization("IsCompatibleWith"))
+            return false;
+
         const auto SignCount = lhs.GetResourceSignatureCount();
         if (SignCount != rhs.GetResourceSignatureCount())
             return false;
@@ -532,6 +569,40 @@ public:
         return m_ActiveShaderStages;
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(Bool WaitForCompletion) override final
+    {
+        if (WaitForCompletion && m_pInitTask)
+            m_pInitTask->WaitForCompletion();
+
+        VERIFY(m_Status.load() != PIPELINE_STATE_STATUS_UNINITIALIZED, "Pipeline state status has not been initialized by the backend implementation");
+        return m_Status.load();
+    }
+
+    bool IsReady() const
+    {
+        return m_Status.load() == PIPELINE_STATE_STATUS_READY;
+    }
+
+    /// Waits until the asynchronous initialization is complete and returns true if the pipeline is ready.
+    /// If the pipeline failed to initialize, logs an error message and returns false.
+    bool WaitForInitialization(const char* MethodName) const
+    {
+        // Fast path for pipelines that are ready, which are used by the device context on every draw
+        if (IsReady())
+            return true;
+
+        if (m_pInitTask)
+            m_pInitTask->WaitForCompletion();
+
+        if (IsReady())
+            return true;
+
+        LOG_ERROR_MESSAGE("IPipelineState::", MethodName, " can't be called for pipeline state '", this->m_Desc.Name,
+                          "' that failed to initialize.");
+        return false;
+    }
+
 protected:
     using TNameToGroupIndexMap = std::unordered_map<HashMapStringKey, Uint32>;
 
@@ -603,6 +674,41 @@ protected:
         ReserveResourceSignatures(CreateInfo, MemPool);
     }
 
+    /// Enqueues the pipeline initialization task into the thread pool.
+
+    /// \param [in] pThreadPool      - Thread pool that will run the task.
+    /// \param [in] ppPrerequisites  - Tasks that must complete before the initialization starts
+    ///                                (e.g. asynchronous shader compilation tasks). Null entries are allowed.
+    /// \param [in] NumPrerequisites - The number of elements in ppPrerequisites array.
+    /// \param [in] InitHandler      - Function that initializes the pipeline. It must set the status
+    ///                                to PIPELINE_STATE_STATUS_READY on success and throw an exception on failure.
+    ///
+    /// \remarks   The handler is executed by a worker thread and may reference this object.
+    ///            The derived class must therefore call GetStatus(true) in its destructor.
+    template <typename HandlerType>
+    void EnqueueInitTask(IThreadPool*  pThreadPool,
+                         IAsyncTask**  ppPrerequisites,
+                         Uint32        NumPrerequisites,
+                         HandlerType&& InitHandler)
+    {
+        VERIFY_EXPR(pThreadPool != nullptr);
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+        m_pInitTask = EnqueueAsyncWork(
+            pThreadPool, ppPrerequisites, NumPrerequisites,
+            [this, InitHandler = std::forward<HandlerType>(InitHandler)](Uint32 ThreadId) {
+                try
+                {
+                    InitHandler();
+                    VERIFY_EXPR(m_Status.load() == PIPELINE_STATE_STATUS_READY);
+                }
+                catch (...)
+                {
+                    LOG_ERROR_MESSAGE("Failed to create pipeline state '", (this->m_Desc.Name != nullptr ? this->m_Desc.Name : ""), "' asynchronously");
+                    m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                }
+            });
+    }
+
 public:
     template <typename ShaderImplType, typename TShaderStages>
     static void ExtractShaders(const GraphicsPipelineStateCreateInfo& CreateInfo,
@@ -617,6 +723,7 @@ public:
         auto AddShaderStage = [&](IShader* pShader) {
             if (pShader != nullptr)
             {
+                WaitForShaderCompilation(pShader);
                 RefCntAutoPtr<ShaderImplType> pShaderImpl{pShader, ShaderImplType::IID_InternalImpl};
                 VERIFY(pShaderImpl, "Unexpected shader object implementation");
                 ShaderStages.emplace_back(pShaderImpl);
@@ -672,6 +779,7 @@ public:
         VERIFY_EXPR(CreateInfo.PSODesc.PipelineType == PIPELINE_TYPE_COMPUTE);
         VERIFY_EXPR(CreateInfo.pCS != nullptr);
         VERIFY_EXPR(CreateInfo.pCS->GetDesc().ShaderType == SHADER_TYPE_COMPUTE);
+        WaitForShaderCompilation(CreateInfo.pCS);
 
         RefCntAutoPtr<ShaderImplType> pShaderImpl{CreateInfo.pCS, ShaderImplType::IID_InternalImpl};
         VERIFY(pShaderImpl, "Unexpected shader object implementation");
@@ -693,6 +801,7 @@ public:
         auto AddShader = [&ShaderStages, &UniqueShaders, &ActiveShaderStages](IShader* pShader) {
             if (pShader != nullptr && UniqueShaders.insert(pShader).second)
             {
+                WaitForShaderCompilation(pShader);
                 const auto ShaderType = pShader->GetDesc().ShaderType;
                 const auto StageInd   = GetShaderTypePipelineIndex(ShaderType, PIPELINE_TYPE_RAY_TRACING);
                 auto&      Stage      = ShaderStages[StageInd];
@@ -753,6 +862,7 @@ public:
         VERIFY_EXPR(CreateInfo.PSODesc.PipelineType == PIPELINE_TYPE_TILE);
         VERIFY_EXPR(CreateInfo.pTS != nullptr);
         VERIFY_EXPR(CreateInfo.pTS->GetDesc().ShaderType == SHADER_TYPE_TILE);
+        WaitForShaderCompilation(CreateInfo.pTS);
 
         RefCntAutoPtr<ShaderImplType> pShaderImpl{CreateInfo.pTS, ShaderImplType::IID_InternalImpl};
         VERIFY(pShaderImpl, "Unexpected shader object implementation");
@@ -1246,9 +1356,14 @@ protected:
         void*                   m_pPipelineDataRawMem = nullptr;
     };
 
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_UNINITIALIZED};
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
+
+private:
+    RefCntAutoPtr<IAsyncTask> m_pInitTask;
 };
 
 } // namespace Diligent
@@ -44,6 +44,7 @@
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -151,7 +152,9 @@ public:
         m_SBTAllocator        {RawMemAllocator, sizeof(ShaderBindingTableImplType),         8},
         m_PipeResSignAllocator{RawMemAllocator, sizeof(PipelineResourceSignatureImplType), 16},
         m_MemObjAllocator     {RawMemAllocator, sizeof(DeviceMemoryImplType),              16},
-        m_PSOCacheAllocator   {RawMemAllocator, sizeof(PipelineStateCacheImplType),         4}
+        m_PSOCacheAllocator   {RawMemAllocator, sizeof(PipelineStateCacheImplType),         4},
+        m_pShaderCompilationThreadPool{EngineCI.pAsyncShaderCompilationThreadPool},
+        m_NumAsyncShaderCompilationThreads{EngineCI.NumAsyncShaderCompilationThreads}
     // clang-format on
     {
         // Initialize texture format info
@@ -205,6 +208,34 @@ public:
 
     ~RenderDeviceBase()
     {
+        if (m_pShaderCompilationThreadPool && m_bOwnsShaderCompilationThreadPool)
+        {
+            // All shaders hold strong references to the device, so there must be no tasks left
+            VERIFY(m_pShaderCompilationThreadPool->GetQueueSize() == 0 && m_pShaderCompilationThreadPool->GetRunningTaskCount() == 0,
+                   "Render device is destroyed while there are shader compilation tasks in progress");
+            m_pShaderCompilationThreadPool->StopThreads();
+        }
+    }
+
+    /// Returns the thread pool that compiles shaders created with the SHADER_COMPILE_FLAG_ASYNCHRONOUS flag.
+
+    /// \remarks   If the application did not provide the thread pool through EngineCreateInfo::pAsyncShaderCompilationThreadPool,
+    ///            the engine-owned pool is created when this method is called for the first time.
+    ///            Returns null if asynchronous compilation is disabled.
+    IThreadPool* GetShaderCompilationThreadPool()
+    {
+        std::lock_guard<std::mutex> Lock{m_ShaderCompilationThreadPoolMtx};
+        if (!m_pShaderCompilationThreadPool && m_NumAsyncShaderCompilationThreads != 0)
+        {
+            ThreadPoolCreateInfo PoolCI;
+            PoolCI.NumThreads = m_NumAsyncShaderCompilationThreads != ~0u ?
+                m_NumAsyncShaderCompilationThreads :
+                std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+
+            m_pShaderCompilationThreadPool     = CreateThreadPool(PoolCI);
+            m_bOwnsShaderCompilationThreadPool = true;
+        }
+        return m_pShaderCompilationThreadPool;
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderDevice, ObjectBase<BaseInterface>)
@@ -600,6 +631,12 @@ protected:
     FixedBlockMemoryAllocator m_PipeResSignAllocator; ///< Allocator for pipeline resource signature objects
     FixedBlockMemoryAllocator m_MemObjAllocator;      ///< Allocator for device memory objects
     FixedBlockMemoryAllocator m_PSOCacheAllocator;    ///< Allocator for pipeline state cache objects
+
+private:
+    std::mutex                 m_ShaderCompilationThreadPoolMtx;
+    RefCntAutoPtr<IThreadPool> m_pShaderCompilationThreadPool;
+    const Uint32               m_NumAsyncShaderCompilationThreads;
+    bool                       m_bOwnsShaderCompilationThreadPool = false;
 };
 
 } // namespace Diligent
@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "Shader.h"
 #include "DeviceObjectBase.hpp"
@@ -39,6 +40,8 @@
 #include "PlatformMisc.hpp"
 #include "EngineMemory.h"
 #include "Align.hpp"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -147,8 +150,78 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Shader, TDeviceObjectBase)
 
+    /// Implementation of IShader::GetStatus().
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(Bool WaitForCompletion) override
+    {
+        if (WaitForCompletion && m_pCompileTask)
+            m_pCompileTask->WaitForCompletion();
+
+        VERIFY(m_Status.load() != SHADER_STATUS_UNINITIALIZED, "Shader status has not been initialized by the backend implementation");
+        return m_Status.load();
+    }
+
+    /// Returns the task that compiles the shader asynchronously, or null if the shader
+    /// was compiled synchronously.
+    IAsyncTask* GetCompileTask() const
+    {
+        return m_pCompileTask;
+    }
+
+    bool IsCompiling() const
+    {
+        return m_Status.load() == SHADER_STATUS_COMPILING;
+    }
+
+protected:
+    /// Checks if the shader should be compiled asynchronously.
+    static bool IsAsyncCompilationRequested(const ShaderCreateInfo& ShaderCI,
+                                            IThreadPool*            pCompilationThreadPool,
+                                            IDataBlob**             ppCompilerOutput)
+    {
+        return (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 &&
+            pCompilationThreadPool != nullptr &&
+            // Compiler output can only be returned by the synchronous compilation
+            ppCompilerOutput == nullptr &&
+            // There is nothing to compile
+            ShaderCI.ByteCode == nullptr;
+    }
+
+    /// Enqueues the shader compilation task into the thread pool.
+
+    /// \param [in] pCompilationThreadPool - Thread pool that will run the task.
+    /// \param [in] CompileHandler         - Function that compiles the shader and initializes its resources.
+    ///                                      It must set the status to SHADER_STATUS_READY on success
+    ///                                      and throw an exception on failure.
+    ///
+    /// \remarks   The handler is executed by a worker thread and may reference this object.
+    ///            The derived class must therefore call GetStatus(true) in its destructor.
+    template <typename HandlerType>
+    void EnqueueCompileTask(IThreadPool* pCompilationThreadPool, HandlerType&& CompileHandler)
+    {
+        VERIFY_EXPR(pCompilationThreadPool != nullptr);
+        m_Status.store(SHADER_STATUS_COMPILING);
+        m_pCompileTask = EnqueueAsyncWork(
+            pCompilationThreadPool,
+            [this, CompileHandler = std::forward<HandlerType>(CompileHandler)](Uint32 ThreadId) {
+                try
+                {
+                    CompileHandler();
+                    VERIFY_EXPR(m_Status.load() == SHADER_STATUS_READY);
+                }
+                catch (...)
+                {
+                    LOG_ERROR_MESSAGE("Failed to compile shader '", (this->m_Desc.Name != nullptr ? this->m_Desc.Name : ""), "' asynchronously");
+                    m_Status.store(SHADER_STATUS_FAILED);
+                }
+            });
+    }
+
+    std::atomic<SHADER_STATUS> m_Status{SHADER_STATUS_UNINITIALIZED};
+
 private:
     const std::string m_CombinedSamplerSuffix;
+
+    RefCntAutoPtr<IAsyncTask> m_pCompileTask;
 };
 
 } // namespace Diligent
@@ -31,6 +31,7 @@
 /// Implementation of the Diligent::ShaderBase template class
 
 #include <vector>
+#include <algorithm>
 
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
@@ -804,6 +805,8 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
 
     const PipelineResourceDesc& GetDesc() const { return m_ParentManager.GetResourceDesc(m_ResIndex); }
 
+    Uint32 GetResourceIndex() const { return m_ResIndex; }
+
 protected:
     // Variable manager that owns this variable
     VarManagerType& m_ParentManager;
@@ -890,6 +893,21 @@ protected:
         }
     }
 
+    // Finds the variable that references the resource with the given index in the signature.
+    // The variables must be sorted by the resource index, which is the order in which they are
+    // enumerated by PipelineResourceSignatureBase::ProcessResources().
+    template <typename VarType>
+    static VarType* FindVariableByResourceIndex(VarType* pVariables, Uint32 NumVariables, Uint32 ResIndex)
+    {
+        auto* const pEnd = pVariables + NumVariables;
+
+        auto* pVar = std::lower_bound(pVariables, pEnd, ResIndex,
+                                      [](const VarType& Var, Uint32 Idx) {
+                                          return Var.GetResourceIndex() < Idx;
+                                      });
+        return pVar != pEnd && pVar->GetResourceIndex() == ResIndex ? pVar : nullptr;
+    }
+
 
 protected:
     IObject& m_Owner;
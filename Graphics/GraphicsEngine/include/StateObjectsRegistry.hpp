@@ -30,11 +30,11 @@
 /// \file
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
-#include <unordered_map>
 #include <atomic>
 
 #include "DeviceObject.h"
 #include "STDAllocator.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -68,7 +68,7 @@ public:
     static constexpr int DeletedObjectsToPurge = 32;
 
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
+        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for FlatHashMap<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
         m_RegistryName{RegistryName}
     {}
 
@@ -208,8 +208,8 @@ private:
     std::atomic<long> m_NumDeletedObjects{0};
 
     /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                    HashMapElem;
+    FlatHashMap<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
 
     /// Registry name used for debug output
     const String m_RegistryName;
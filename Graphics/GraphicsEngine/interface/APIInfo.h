@@ -30,7 +30,7 @@
 /// \file
 /// Diligent API information
 
-#define DILIGENT_API_VERSION 254000
+#define DILIGENT_API_VERSION 254008
 
 #include "../../../Primitives/interface/BasicTypes.h"
 
@@ -30,6 +30,7 @@
 /// Definition of the Diligent::IDearchiver interface and related data structures
 
 #include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/ThreadPool.h"
 #include "PipelineResourceSignature.h"
 #include "PipelineState.h"
 
@@ -239,6 +240,11 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     ///
     /// \warning    If the archive was loaded without making a copy, the application
     ///             must not modify its contents while it is in use by the dearchiver.
+    ///
+    /// \note       Only the archive table of contents is read when the archive is loaded.
+    ///             Resources are read from the archive data when they are unpacked, so
+    ///             the data blob may reference a memory-mapped file (see MappedFileDataBlob)
+    ///             to avoid loading the entire archive into memory.
     /// 
     /// \warning    This method is not thread-safe and must not be called simultaneously
     ///             with other methods.
@@ -275,6 +281,37 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
                                              const PipelineStateUnpackInfo REF UnpackInfo,
                                              IPipelineState**                  ppPSO) PURE;
 
+    /// Unpacks multiple pipeline state objects from the device object archive in parallel.
+
+    /// \param [in]  pUnpackInfos - An array of NumPipelines pipeline state unpack infos,
+    ///                            see Diligent::PipelineStateUnpackInfo.
+    /// \param [in]  NumPipelines - The number of pipelines to unpack.
+    /// \param [in]  pThreadPool  - Thread pool that will be used to unpack the pipelines.
+    ///                            If null, the pipelines are unpacked on the calling thread
+    ///                            before the method returns.
+    /// \param [out] ppPSOs       - An array of NumPipelines elements where pointers to the unpacked
+    ///                            pipeline state objects will be written. The pointer to the i-th
+    ///                            pipeline is written when the i-th task completes; it is null
+    ///                            if the pipeline failed to unpack.
+    ///                            The function calls AddRef() for every written PSO.
+    /// \param [out] ppTasks      - An optional array of NumPipelines elements where pointers to the
+    ///                            tasks that unpack the pipelines will be written.
+    ///                            The function calls AddRef(), so that every task will have
+    ///                            one reference. When pThreadPool is null, null pointers are written.
+    ///
+    /// \note   Shaders that are shared between the pipelines are unpacked only once.
+    ///
+    ///         The method copies the unpack infos, but all objects they reference (the device,
+    ///         the PSO cache, etc.) as well as the ppPSOs array must stay alive until all tasks complete.
+    ///
+    ///         This method is thread-safe.
+    VIRTUAL void METHOD(UnpackPipelineStates)(THIS_
+                                              const PipelineStateUnpackInfo* pUnpackInfos,
+                                              Uint32                         NumPipelines,
+                                              IThreadPool*                   pThreadPool,
+                                              IPipelineState**               ppPSOs,
+                                              IAsyncTask**                   ppTasks DEFAULT_VALUE(nullptr)) PURE;
+
     /// Unpacks resource signature from the device object archive.
 
     /// \param [in]  UnpackInfo  - Resource signature unpack info, see Diligent::ResourceSignatureUnpackInfo.
@@ -332,6 +369,7 @@ DILIGENT_END_INTERFACE
 #    define IDearchiver_LoadArchive(This, ...)             CALL_IFACE_METHOD(Dearchiver, LoadArchive,             This, __VA_ARGS__)
 #    define IDearchiver_UnpackShader(This, ...)            CALL_IFACE_METHOD(Dearchiver, UnpackShader,            This, __VA_ARGS__)
 #    define IDearchiver_UnpackPipelineState(This, ...)     CALL_IFACE_METHOD(Dearchiver, UnpackPipelineState,     This, __VA_ARGS__)
+#    define IDearchiver_UnpackPipelineStates(This, ...)    CALL_IFACE_METHOD(Dearchiver, UnpackPipelineStates,    This, __VA_ARGS__)
 #    define IDearchiver_UnpackResourceSignature(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature, This, __VA_ARGS__)
 #    define IDearchiver_UnpackRenderPass(This, ...)        CALL_IFACE_METHOD(Dearchiver, UnpackRenderPass,        This, __VA_ARGS__)
 #    define IDearchiver_Store(This, ...)                   CALL_IFACE_METHOD(Dearchiver, Store,                   This, __VA_ARGS__)
@@ -3391,6 +3391,21 @@ struct EngineCreateInfo
     /// operations in the engine
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
 
+    /// Pointer to the thread pool that will be used to compile shaders
+    /// created with the SHADER_COMPILE_FLAG_ASYNCHRONOUS flag.
+
+    /// \remarks   If null, the engine will create its own thread pool when the first
+    ///            asynchronous shader is requested, see NumAsyncShaderCompilationThreads.
+    struct IThreadPool* pAsyncShaderCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of threads in the engine-owned asynchronous shader compilation thread pool.
+
+    /// \remarks   This member is ignored if pAsyncShaderCompilationThreadPool is not null.
+    ///            If 0xFFFFFFFF (default), the engine will use the number of hardware threads minus one.
+    ///            If 0, asynchronous shader compilation is disabled and all shaders are
+    ///            compiled synchronously.
+    Uint32 NumAsyncShaderCompilationThreads DEFAULT_INITIALIZER(0xFFFFFFFFu);
+
 #if DILIGENT_CPP_INTERFACE
     EngineCreateInfo() noexcept
     {
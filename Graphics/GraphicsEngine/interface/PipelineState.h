@@ -634,7 +634,20 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// by the PSO's resource signatures.
     PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES       = 1u << 2u,
 
-    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES
+    /// Create the pipeline state asynchronously.
+
+    /// \remarks   When this flag is set, IRenderDevice::CreateGraphicsPipelineState and
+    ///            IRenderDevice::CreateComputePipelineState return immediately and the pipeline
+    ///            is initialized by the shader compilation thread pool (see EngineCreateInfo::pAsyncShaderCompilationThreadPool).
+    ///            If any of the shaders is still being compiled asynchronously (see SHADER_COMPILE_FLAG_ASYNCHRONOUS),
+    ///            the pipeline initialization starts after all shaders are compiled.
+    ///            Use IPipelineState::GetStatus() to query the pipeline status.
+    ///
+    ///            The flag is ignored and the pipeline is created synchronously if the backend does not
+    ///            support asynchronous pipeline creation or if no thread pool is available.
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 1u << 3u,
+
+    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_ASYNCHRONOUS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
@@ -954,6 +967,24 @@ struct TilePipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
 typedef struct TilePipelineStateCreateInfo TilePipelineStateCreateInfo;
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint32)
+{
+    /// Initial pipeline state status.
+    PIPELINE_STATE_STATUS_UNINITIALIZED = 0,
+
+    /// The pipeline state is being initialized.
+    PIPELINE_STATE_STATUS_COMPILING,
+
+    /// The pipeline state has been successfully initialized
+    /// and is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// The pipeline state initialization has failed.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
 // {06084AE5-6A71-4FE8-84B9-395DD489A28C}
 static const struct INTERFACE_ID IID_PipelineState =
     {0x6084ae5, 0x6a71, 0x4fe8, {0x84, 0xb9, 0x39, 0x5d, 0xd4, 0x89, 0xa2, 0x8c}};
@@ -1154,6 +1185,19 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method will wait until the pipeline state
+    ///                                 is initialized. This parameter only has effect for pipelines
+    ///                                 created with the PSO_CREATE_FLAG_ASYNCHRONOUS flag.
+    ///
+    /// \return     The pipeline state status.
+    ///
+    /// \remarks    The pipeline state can only be used when the status is PIPELINE_STATE_STATUS_READY.
+    ///             Draw and dispatch commands that use a pipeline that is not ready are skipped.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    Bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -1178,6 +1222,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
 #    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
 #    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                    CALL_IFACE_METHOD(PipelineState, GetStatus,                    This, __VA_ARGS__)
 
 // clang-format on
 
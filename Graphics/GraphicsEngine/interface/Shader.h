@@ -327,7 +327,19 @@ DILIGENT_TYPED_ENUM(SHADER_COMPILE_FLAGS, Uint32)
     /// Don't load shader reflection.
     SHADER_COMPILE_FLAG_SKIP_REFLECTION         = 0x02,
 
-    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_SKIP_REFLECTION
+    /// Compile the shader asynchronously.
+
+    /// \remarks   When this flag is set, IRenderDevice::CreateShader returns immediately and the
+    ///            shader is compiled by the thread pool specified by EngineCreateInfo::pAsyncShaderCompilationThreadPool
+    ///            (or by the engine-owned pool, see EngineCreateInfo::NumAsyncShaderCompilationThreads).
+    ///            Use IShader::GetStatus() to query the compilation status.
+    ///
+    ///            The flag is ignored and the shader is compiled synchronously if the backend does not
+    ///            support asynchronous compilation, if no thread pool is available, or if
+    ///            the application requested the compiler output (ppCompilerOutput is not null).
+    SHADER_COMPILE_FLAG_ASYNCHRONOUS            = 0x04,
+
+    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_ASYNCHRONOUS
 };
 DEFINE_FLAG_ENUM_OPERATORS(SHADER_COMPILE_FLAGS);
 
@@ -924,6 +936,24 @@ typedef struct ShaderCodeBufferDesc
 } ShaderCodeBufferDesc;
 
 
+/// Shader status
+DILIGENT_TYPED_ENUM(SHADER_STATUS, Uint32)
+{
+    /// Initial shader status.
+    SHADER_STATUS_UNINITIALIZED = 0,
+
+    /// The shader is being compiled.
+    SHADER_STATUS_COMPILING,
+
+    /// The shader has been successfully compiled
+    /// and is ready to be used.
+    SHADER_STATUS_READY,
+
+    /// The shader compilation has failed.
+    SHADER_STATUS_FAILED
+};
+
+
 #define DILIGENT_INTERFACE_NAME IShader
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -973,6 +1003,19 @@ DILIGENT_BEGIN_INTERFACE(IShader, IDeviceObject)
     VIRTUAL void METHOD(GetBytecode)(THIS_
                                      const void** ppBytecode,
                                      Uint64 REF   Size) CONST PURE;
+
+    /// Returns the shader status, see Diligent::SHADER_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method will wait until the shader compilation
+    ///                                 is complete. This parameter only has effect for shaders
+    ///                                 created with the SHADER_COMPILE_FLAG_ASYNCHRONOUS flag.
+    ///
+    /// \return     The shader status.
+    ///
+    /// \remarks    Shader resources and bytecode are only available when the status is
+    ///             SHADER_STATUS_READY.
+    VIRTUAL SHADER_STATUS METHOD(GetStatus)(THIS_
+                                            Bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -988,6 +1031,7 @@ DILIGENT_END_INTERFACE
 #    define IShader_GetResourceDesc(This, ...)       CALL_IFACE_METHOD(Shader, GetResourceDesc,  This, __VA_ARGS__)
 #    define IShader_GetConstantBufferDesc(This, ...) CALL_IFACE_METHOD(Shader, GetConstantBufferDesc,  This, __VA_ARGS__)
 #    define IShader_GetBytecode(This, ...)           CALL_IFACE_METHOD(Shader, GetBytecode,      This, __VA_ARGS__)
+#    define IShader_GetStatus(This, ...)             CALL_IFACE_METHOD(Shader, GetStatus,        This, __VA_ARGS__)
 
 // clang-format on
 
@@ -27,6 +27,7 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -104,12 +105,13 @@ DearchiverBase::DeviceType DearchiverBase::GetArchiveDeviceType(const IRenderDev
 template <typename CreateInfoType>
 struct DearchiverBase::PSOData
 {
-    DynamicLinearAllocator Allocator;
-    CreateInfoType         CreateInfo{};
-    PSOCreateInternalInfo  InternalCI;
-    SerializedPSOAuxData   AuxData;
-    TPRSNames              PRSNames{};
-    const char*            RenderPassName = nullptr;
+    DynamicLinearAllocatorPool::ArenaHandle Arena;
+    DynamicLinearAllocator&                 Allocator;
+    CreateInfoType                          CreateInfo{};
+    PSOCreateInternalInfo                   InternalCI;
+    SerializedPSOAuxData                    AuxData;
+    TPRSNames                               PRSNames{};
+    const char*                             RenderPassName = nullptr;
 
     // Strong references to pipeline resource signatures, render pass, etc.
     std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
@@ -117,8 +119,9 @@ struct DearchiverBase::PSOData
 
     static const ResourceType ArchiveResType;
 
-    explicit PSOData(IMemoryAllocator& Allocator, Uint32 BlockSize = 2 << 10) :
-        Allocator{Allocator, BlockSize}
+    explicit PSOData(DynamicLinearAllocatorPool& AllocatorPool) :
+        Arena{AllocatorPool.GetArena()},
+        Allocator{*Arena}
     {}
 
     bool Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser);
@@ -132,13 +135,15 @@ private:
 
 struct DearchiverBase::RPData
 {
-    DynamicLinearAllocator Allocator;
-    RenderPassDesc         Desc;
+    DynamicLinearAllocatorPool::ArenaHandle Arena;
+    DynamicLinearAllocator&                 Allocator;
+    RenderPassDesc                          Desc;
 
     static constexpr ResourceType ArchiveResType = ResourceType::RenderPass;
 
-    explicit RPData(IMemoryAllocator& Allocator, Uint32 BlockSize = 1 << 10) :
-        Allocator{Allocator, BlockSize}
+    explicit RPData(DynamicLinearAllocatorPool& AllocatorPool) :
+        Arena{AllocatorPool.GetArena()},
+        Allocator{*Arena}
     {}
 
     bool Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser);
@@ -154,7 +159,7 @@ bool DearchiverBase::NamedResourceCache<ResType>::Get(ResourceType Type, const c
 
     std::unique_lock<std::mutex> Lock{m_Mtx};
 
-    auto it = m_Map.find(NamedResourceKey{Type, Name});
+    auto it = m_Map.find(ResourceKey{Type, Name});
     if (it == m_Map.end())
         return false;
 
@@ -173,7 +178,7 @@ void DearchiverBase::NamedResourceCache<ResType>::Set(ResourceType Type, const c
     VERIFY_EXPR(pResource != nullptr);
 
     std::unique_lock<std::mutex> Lock{m_Mtx};
-    m_Map.emplace(NamedResourceKey{Type, Name, /*CopyName = */ true}, pResource);
+    m_Map.emplace(ResourceKey{Type, Name, /*CopyName = */ true}, pResource);
 }
 
 // Instantiation is required by UnpackResourceSignatureImpl
@@ -407,20 +412,22 @@ void DearchiverBase::PSOData<RayTracingPipelineStateCreateInfo>::CreatePipeline(
 template <typename CreateInfoType>
 bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
                                       PSOData<CreateInfoType>& PSO,
-                                      IRenderDevice*           pDevice)
+                                      IRenderDevice*           pDevice,
+                                      IThreadPool*             pThreadPool)
 {
     const auto& pObjArchive = Archive.pObjArchive;
     VERIFY_EXPR(pObjArchive);
     const auto  DevType       = GetArchiveDeviceType(pDevice);
-    const auto& ShaderIdxData = pObjArchive->GetDeviceSpecificData(PSO.ArchiveResType, PSO.CreateInfo.PSODesc.Name, DevType);
+    const auto  ShaderIdxData = pObjArchive->GetDeviceSpecificData(PSO.ArchiveResType, PSO.CreateInfo.PSODesc.Name, DevType);
     if (!ShaderIdxData)
         return false;
 
-    DynamicLinearAllocator Allocator{GetRawAllocator()};
+    auto  Arena     = m_AllocatorPool.GetArena();
+    auto& Allocator = *Arena;
 
     DeviceObjectArchive::ShaderIndexArray ShaderIndices;
     {
-        Serializer<SerializerMode::Read> Ser{ShaderIdxData};
+        Serializer<SerializerMode::Read> Ser{ShaderIdxData, /*InPlaceArrays = */ true};
         if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &Allocator))
         {
             LOG_ERROR_MESSAGE("Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
@@ -432,35 +439,48 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
     auto& ShaderCache = Archive.CachedShaders[static_cast<size_t>(DevType)];
 
     PSO.Shaders.resize(ShaderIndices.Count);
-    for (Uint32 i = 0; i < ShaderIndices.Count; ++i)
-    {
-        auto& pShader{PSO.Shaders[i]};
-
-        const Uint32 Idx = ShaderIndices.pIndices[i];
 
+    // Try to get cached shaders. Shaders that are being unpacked by other threads
+    // are not unpacked again - we wait until they are added to the cache instead.
+    std::vector<Uint32> MissingShaders;
+    std::vector<Uint32> PendingShaders;
+    {
+        std::unique_lock<std::mutex> ReadLock{ShaderCache.Mtx};
+        for (Uint32 i = 0; i < ShaderIndices.Count; ++i)
         {
-            std::unique_lock<std::mutex> ReadLock{ShaderCache.Mtx};
+            const Uint32 Idx = ShaderIndices.pIndices[i];
             if (Idx < ShaderCache.Shaders.size())
-            {
-                // Try to get cached shader
-                pShader = ShaderCache.Shaders[Idx];
-                if (pShader)
-                    continue;
-            }
+                PSO.Shaders[i] = ShaderCache.Shaders[Idx];
+            if (PSO.Shaders[i])
+                continue;
+
+            if (ShaderCache.InProgress.insert(Idx).second)
+                MissingShaders.push_back(i);
+            else
+                PendingShaders.push_back(i);
         }
+    }
 
-        const auto& SerializedShader = pObjArchive->GetSerializedShader(DevType, Idx);
-        if (!SerializedShader)
-            return false;
+    if (!MissingShaders.empty())
+    {
+        // Read all missing shaders at once so that compressed shaders can be decompressed in a batch
+        std::vector<Uint32> MissingShaderIndices(MissingShaders.size());
+        for (size_t i = 0; i < MissingShaders.size(); ++i)
+            MissingShaderIndices[i] = ShaderIndices.pIndices[MissingShaders[i]];
 
+        std::vector<SerializedData> SerializedShaders(MissingShaders.size());
+
+        bool Success = pObjArchive->GetSerializedShaders(DevType, MissingShaderIndices.data(), MissingShaderIndices.size(), SerializedShaders.data(), pThreadPool);
+        for (size_t i = 0; i < MissingShaders.size() && Success; ++i)
         {
             ShaderCreateInfo ShaderCI;
             {
-                Serializer<SerializerMode::Read> ShaderSer{SerializedShader};
+                Serializer<SerializerMode::Read> ShaderSer{SerializedShaders[i]};
                 if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(ShaderSer, ShaderCI))
                 {
                     LOG_ERROR_MESSAGE("Failed to deserialize shader create info. Archive file may be corrupted or invalid.");
-                    return false;
+                    Success = false;
+                    break;
                 }
                 VERIFY_EXPR(ShaderSer.IsEnded());
             }
@@ -468,17 +488,49 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
             if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0)
                 ShaderCI.CompileFlags |= SHADER_COMPILE_FLAG_SKIP_REFLECTION;
 
+            auto& pShader{PSO.Shaders[MissingShaders[i]]};
             pShader = UnpackShader(ShaderCI, pDevice);
             if (!pShader)
-                return false;
+                Success = false;
         }
 
-        // Add to the cache
+        // Add unpacked shaders to the cache and release the threads that wait for them.
+        // This must be done even if unpacking failed.
         {
             std::unique_lock<std::mutex> WriteLock{ShaderCache.Mtx};
-            if (Idx >= ShaderCache.Shaders.size())
-                ShaderCache.Shaders.resize(size_t{Idx} + 1);
-            ShaderCache.Shaders[Idx] = pShader;
+            for (size_t i = 0; i < MissingShaders.size(); ++i)
+            {
+                const Uint32 Idx     = MissingShaderIndices[i];
+                const auto&  pShader = PSO.Shaders[MissingShaders[i]];
+                if (pShader)
+                {
+                    if (Idx >= ShaderCache.Shaders.size())
+                        ShaderCache.Shaders.resize(size_t{Idx} + 1);
+                    ShaderCache.Shaders[Idx] = pShader;
+                }
+                ShaderCache.InProgress.erase(Idx);
+            }
+        }
+        ShaderCache.Cond.notify_all();
+
+        if (!Success)
+            return false;
+    }
+
+    if (!PendingShaders.empty())
+    {
+        std::unique_lock<std::mutex> ReadLock{ShaderCache.Mtx};
+        for (Uint32 i : PendingShaders)
+        {
+            const Uint32 Idx = ShaderIndices.pIndices[i];
+            ShaderCache.Cond.wait(ReadLock, [&]() { return ShaderCache.InProgress.find(Idx) == ShaderCache.InProgress.end(); });
+            if (Idx < ShaderCache.Shaders.size())
+                PSO.Shaders[i] = ShaderCache.Shaders[Idx];
+            if (!PSO.Shaders[i])
+            {
+                LOG_ERROR_MESSAGE("Failed to unpack shader ", Idx, " for pipeline '", PSO.CreateInfo.PSODesc.Name, "'.");
+                return false;
+            }
         }
     }
 
@@ -490,18 +542,21 @@ DearchiverBase::ArchiveData* DearchiverBase::FindArchive(ResourceType ResType, c
     VERIFY_EXPR(ResType != ResourceType::Undefined);
     VERIFY_EXPR(ResName != nullptr);
 
-    const auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{ResType, ResName});
-    if (archive_idx_it == m_ResNameToArchiveIdx.end())
-        return nullptr;
-
-    auto& Archive = m_Archives[archive_idx_it->second];
-    if (!Archive.pObjArchive)
+    // Archives keep resources sorted by name, so the lookup does not
+    // require any preprocessing when the archive is loaded.
+    for (auto& Archive : m_Archives)
     {
-        UNEXPECTED("Null object archives should never be added to the list. This is a bug.");
-        return nullptr;
+        if (!Archive.pObjArchive)
+        {
+            UNEXPECTED("Null object archives should never be added to the list. This is a bug.");
+            continue;
+        }
+
+        if (Archive.pObjArchive->HasResource(ResType, ResName))
+            return &Archive;
     }
 
-    return &Archive;
+    return nullptr;
 }
 
 template <typename PSOCreateInfoType>
@@ -591,6 +646,7 @@ static bool ModifyPipelineStateCreateInfo(PSOCreateInfoType&             CreateI
 
 template <typename CreateInfoType>
 void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& UnpackInfo,
+                                             IThreadPool*                   pThreadPool,
                                              IPipelineState**               ppPSO)
 {
     VERIFY_EXPR(UnpackInfo.pDevice != nullptr);
@@ -611,7 +667,7 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
     if (pArchiveData == nullptr)
         return;
 
-    PSOData<CreateInfoType> PSO{GetRawAllocator()};
+    PSOData<CreateInfoType> PSO{m_AllocatorPool};
     if (!pArchiveData->pObjArchive->LoadResourceCommonData(ResType, UnpackInfo.Name, PSO))
         return;
 
@@ -630,7 +686,7 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
     if (!UnpackPSOSignatures(PSO, UnpackInfo.pDevice))
         return;
 
-    if (!UnpackPSOShaders(*pArchiveData, PSO, UnpackInfo.pDevice))
+    if (!UnpackPSOShaders(*pArchiveData, PSO, UnpackInfo.pDevice, pThreadPool))
         return;
 
     PSO.AssignShaders();
@@ -664,32 +720,9 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
             }
         }
 
-        auto       pObjArchive = std::make_unique<DeviceObjectArchive>(DeviceObjectArchive::CreateInfo{pArchiveData, ContentVersion, MakeCopy});
-        const auto ArchiveIdx  = m_Archives.size();
-
-        const auto& ArchiveResources = pObjArchive->GetNamedResources();
-        for (const auto& it : ArchiveResources)
-        {
-            const auto     ResType      = it.first.GetType();
-            const auto*    ResName      = it.first.GetName();
-            constexpr auto MakeNameCopy = true;
-
-            const auto it_inserted = m_ResNameToArchiveIdx.emplace(NamedResourceKey{ResType, ResName, MakeNameCopy}, ArchiveIdx);
-            if (!it_inserted.second)
-            {
-                const auto& OtherArchiveResources = m_Archives[it_inserted.first->second].pObjArchive->GetNamedResources();
-                const auto  it_other              = OtherArchiveResources.find(NamedResourceKey{ResType, ResName});
-
-                const auto IsDuplicate =
-                    (it_other != OtherArchiveResources.end()) &&
-                    (it.second == it_other->second);
-                if (!IsDuplicate)
-                {
-                    LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
-                }
-            }
-        }
-
+        // Only the archive header and table of contents are read here.
+        // Resources are resolved when they are unpacked.
+        auto pObjArchive = std::make_unique<DeviceObjectArchive>(DeviceObjectArchive::CreateInfo{pArchiveData, ContentVersion, MakeCopy});
         m_Archives.emplace_back(std::move(pObjArchive));
 
         return true;
@@ -702,6 +735,11 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
 }
 
 void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO)
+{
+    UnpackPipelineState(UnpackInfo, nullptr, ppPSO);
+}
+
+void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackInfo, IThreadPool* pThreadPool, IPipelineState** ppPSO)
 {
     if (!VerifyPipelineStateUnpackInfo(UnpackInfo, ppPSO))
         return;
@@ -712,19 +750,19 @@ void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackIn
     {
         case PIPELINE_TYPE_GRAPHICS:
         case PIPELINE_TYPE_MESH:
-            UnpackPipelineStateImpl<GraphicsPipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            UnpackPipelineStateImpl<GraphicsPipelineStateCreateInfo>(UnpackInfo, pThreadPool, ppPSO);
             break;
 
         case PIPELINE_TYPE_COMPUTE:
-            UnpackPipelineStateImpl<ComputePipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            UnpackPipelineStateImpl<ComputePipelineStateCreateInfo>(UnpackInfo, pThreadPool, ppPSO);
             break;
 
         case PIPELINE_TYPE_RAY_TRACING:
-            UnpackPipelineStateImpl<RayTracingPipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            UnpackPipelineStateImpl<RayTracingPipelineStateCreateInfo>(UnpackInfo, pThreadPool, ppPSO);
             break;
 
         case PIPELINE_TYPE_TILE:
-            UnpackPipelineStateImpl<TilePipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            UnpackPipelineStateImpl<TilePipelineStateCreateInfo>(UnpackInfo, pThreadPool, ppPSO);
             break;
 
         case PIPELINE_TYPE_INVALID:
@@ -734,6 +772,53 @@ void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackIn
     }
 }
 
+void DearchiverBase::UnpackPipelineStates(const PipelineStateUnpackInfo* pUnpackInfos,
+                                          Uint32                         NumPipelines,
+                                          IThreadPool*                   pThreadPool,
+                                          IPipelineState**               ppPSOs,
+                                          IAsyncTask**                   ppTasks)
+{
+    DEV_CHECK_ERR(NumPipelines == 0 || pUnpackInfos != nullptr, "pUnpackInfos must not be null");
+    DEV_CHECK_ERR(NumPipelines == 0 || ppPSOs != nullptr, "ppPSOs must not be null");
+
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        ppPSOs[i] = nullptr;
+        if (ppTasks != nullptr)
+            ppTasks[i] = nullptr;
+    }
+
+    if (pThreadPool == nullptr)
+    {
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+            UnpackPipelineState(pUnpackInfos[i], nullptr, &ppPSOs[i]);
+        return;
+    }
+
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        const auto& UnpackInfo = pUnpackInfos[i];
+
+        // The task may start after this method returns, so keep a copy of the unpack info
+        // and the name, and hold strong references to the dearchiver and the thread pool.
+        // The pool is also used to read the shaders of the pipeline in parallel.
+        auto pTask = EnqueueAsyncWork(
+            pThreadPool,
+            [pThis    = RefCntAutoPtr<DearchiverBase>{this},
+             pPool    = RefCntAutoPtr<IThreadPool>{pThreadPool},
+             TaskInfo = UnpackInfo,
+             Name     = String{UnpackInfo.Name != nullptr ? UnpackInfo.Name : ""},
+             HasName  = UnpackInfo.Name != nullptr,
+             ppPSO    = &ppPSOs[i]](Uint32 /*ThreadId*/) mutable {
+                TaskInfo.Name = HasName ? Name.c_str() : nullptr;
+                pThis->UnpackPipelineState(TaskInfo, pPool, ppPSO);
+            });
+
+        if (ppTasks != nullptr)
+            ppTasks[i] = pTask.Detach();
+    }
+}
+
 static bool ModifyShaderDesc(ShaderDesc&             Desc,
                              const ShaderUnpackInfo& UnpackInfo)
 {
@@ -772,7 +857,7 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
     VERIFY_EXPR(pObjArchive);
 
     const auto  DevType       = GetArchiveDeviceType(UnpackInfo.pDevice);
-    const auto& ShaderIdxData = pObjArchive->GetDeviceSpecificData(ResType, UnpackInfo.Name, DevType);
+    const auto  ShaderIdxData = pObjArchive->GetDeviceSpecificData(ResType, UnpackInfo.Name, DevType);
     if (!ShaderIdxData)
         return;
 
@@ -787,7 +872,7 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
         VERIFY_EXPR(Ser.IsEnded());
     }
 
-    const auto& SerializedShader = pObjArchive->GetSerializedShader(DevType, Idx);
+    const auto SerializedShader = pObjArchive->GetSerializedShader(DevType, Idx);
     if (!SerializedShader)
         return;
 
@@ -849,7 +934,7 @@ void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IR
     const auto& pObjArchive = pArchiveData->pObjArchive;
     VERIFY_EXPR(pObjArchive);
 
-    RPData RP{GetRawAllocator()};
+    RPData RP{m_AllocatorPool};
     if (!pArchiveData->pObjArchive->LoadResourceCommonData(RPData::ArchiveResType, UnpackInfo.Name, RP))
         return;
 
@@ -27,12 +27,17 @@
 #include "DeviceObjectArchive.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 
 #include "Shader.h"
 #include "EngineMemory.h"
 #include "DataBlobImpl.hpp"
+#include "StreamSerializer.hpp"
 #include "PSOSerializer.hpp"
+#include "LZ4Compression.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -70,17 +75,19 @@ DeviceObjectArchive::ArchiveHeader::ArchiveHeader() noexcept
 namespace
 {
 
-template <SerializerMode Mode>
+// Alignment of the table of contents and of the resource and shader data in the archive
+constexpr size_t ArchiveDataAlignment = 8;
+
+template <SerializerMode Mode, typename SerializerType = Serializer<Mode>>
 struct ArchiveSerializer
 {
-    Serializer<Mode>& Ser;
+    SerializerType& Ser;
 
     template <typename T>
     using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
 
     using ArchiveHeader = DeviceObjectArchive::ArchiveHeader;
     using ResourceData  = DeviceObjectArchive::ResourceData;
-    using ShadersVector = std::vector<SerializedData>;
 
     bool SerializeHeader(ConstQual<ArchiveHeader>& Header) const
     {
@@ -92,7 +99,7 @@ struct ArchiveSerializer
     bool SerializeResourceData(ConstQual<ResourceData>& ResData) const
     {
         if (!Ser.Serialize(ResData.Common))
-            return true;
+            return false;
 
         for (auto& DevData : ResData.DeviceSpecific)
         {
@@ -103,42 +110,81 @@ struct ArchiveSerializer
         return true;
     }
 
-    bool SerializeShaders(ConstQual<ShadersVector>& Shaders) const;
+    // Writes zero padding to align the current offset
+    bool AlignOffset() const
+    {
+        static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
+        static constexpr Uint8 Padding[ArchiveDataAlignment] = {};
+
+        const auto Offset      = Ser.GetSize();
+        const auto PaddingSize = AlignUp(Offset, ArchiveDataAlignment) - Offset;
+        return PaddingSize == 0 || Ser.CopyBytes(Padding, PaddingSize);
+    }
 };
 
-template <SerializerMode Mode>
-bool ArchiveSerializer<Mode>::SerializeShaders(ConstQual<ShadersVector>& Shaders) const
+int CompareResources(DeviceObjectArchive::ResourceType Type0, const char* Name0,
+                     DeviceObjectArchive::ResourceType Type1, const char* Name1)
 {
-    static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
+    if (Type0 != Type1)
+        return Type0 < Type1 ? -1 : +1;
 
-    Uint32 NumShaders = static_cast<Uint32>(Shaders.size());
-    if (!Ser(NumShaders))
-        return false;
+    return strcmp(Name0 != nullptr ? Name0 : "", Name1 != nullptr ? Name1 : "");
+}
+
+// Returns the serialized data object that references the source data
+SerializedData MakeDataView(const SerializedData& Data)
+{
+    return SerializedData{Data.Ptr(), Data.Size()};
+}
 
-    for (const auto& Shader : Shaders)
+// Returns the compressed data, or empty object if the data does not benefit from compression
+SerializedData CompressData(DeviceObjectArchive::CompressionMode Mode, const SerializedData& Data)
+{
+    using CompressionMode = DeviceObjectArchive::CompressionMode;
+    static_assert(static_cast<Uint32>(CompressionMode::Count) == 2, "Please handle the new compression mode below");
+    switch (Mode)
     {
-        if (!Ser.Serialize(Shader))
-            return false;
-    }
+        case CompressionMode::None:
+            return {};
+
+        case CompressionMode::LZ4:
+        {
+            SerializedData Compressed{LZ4CompressBound(Data.Size()), GetRawAllocator()};
+
+            const auto CompressedSize = LZ4Compress(Data.Ptr(), Data.Size(), Compressed.Ptr(), Compressed.Size());
+            if (CompressedSize == 0 || CompressedSize >= Data.Size())
+                return {};
+
+            // Copy the data to release the unused memory
+            return SerializedData{Compressed.Ptr(), CompressedSize}.MakeCopy(GetRawAllocator());
+        }
 
-    return true;
+        default:
+            UNEXPECTED("Unexpected compression mode");
+            return {};
+    }
 }
 
-template <>
-bool ArchiveSerializer<SerializerMode::Read>::SerializeShaders(ShadersVector& Shaders) const
+// Returns the decompressed data, or empty object if the data is invalid
+SerializedData DecompressData(DeviceObjectArchive::CompressionMode Mode, const void* pData, size_t Size, size_t DecompressedSize)
 {
-    Uint32 NumShaders = 0;
-    if (!Ser(NumShaders))
-        return false;
+    using CompressionMode = DeviceObjectArchive::CompressionMode;
+    static_assert(static_cast<Uint32>(CompressionMode::Count) == 2, "Please handle the new compression mode below");
 
-    Shaders.resize(NumShaders);
-    for (auto& Shader : Shaders)
+    SerializedData Decompressed{DecompressedSize, GetRawAllocator()};
+    switch (Mode)
     {
-        if (!Ser.Serialize(Shader))
-            return false;
+        case CompressionMode::LZ4:
+            if (!LZ4Decompress(pData, Size, Decompressed.Ptr(), Decompressed.Size()))
+                return {};
+            break;
+
+        default:
+            // Compressed data is not expected
+            return {};
     }
 
-    return true;
+    return Decompressed;
 }
 
 } // namespace
@@ -150,10 +196,13 @@ DeviceObjectArchive::DeviceObjectArchive(Uint32 ContentVersion) noexcept :
 
 void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
 {
+    const auto* const pArchiveData = static_cast<const Uint8*>(m_pArchiveData->GetConstDataPtr());
+    const auto        ArchiveSize  = m_pArchiveData->GetSize();
+
     Serializer<SerializerMode::Read> Reader{
         SerializedData{
-            const_cast<void*>(CI.pData->GetConstDataPtr()),
-            CI.pData->GetSize(),
+            const_cast<Uint8*>(pArchiveData),
+            ArchiveSize,
         },
     };
     ArchiveSerializer<SerializerMode::Read> ArchiveReader{Reader};
@@ -186,87 +235,239 @@ void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
     if (!ArchiveReader.Ser(Header.GitHash))
         LOG_ERROR_AND_THROW("Failed to read Git Hash.");
 
-    Uint32 NumResources = 0;
-    if (!Reader(NumResources))
+    TableOfContents TOC;
+    if (!Reader(TOC.NumResources))
         LOG_ERROR_AND_THROW("Failed to read the number of named resources in the device object archive.");
 
-    for (Uint32 res = 0; res < NumResources; ++res)
+    for (auto& NumShaders : TOC.NumShaders)
+    {
+        if (!Reader(NumShaders))
+            LOG_ERROR_AND_THROW("Failed to read the number of shaders in the device object archive.");
+    }
+
+    for (auto& Compression : m_ShaderCompression)
     {
-        const char*  Name    = nullptr;
-        ResourceType ResType = ResourceType::Undefined;
-        if (!Reader(ResType, Name))
-            LOG_ERROR_AND_THROW("Failed to read the type and name of resource ", res, "/", NumResources, '.');
-        VERIFY_EXPR(Name != nullptr);
-
-        // No need to make the name copy as we keep the source data blob alive.
-        constexpr auto MakeNameCopy = false;
-        auto&          ResData      = m_NamedResources[NamedResourceKey{ResType, Name, MakeNameCopy}];
-
-        if (!ArchiveReader.SerializeResourceData(ResData))
-            LOG_ERROR_AND_THROW("Failed to read data of resource '", Name, "'.");
+        Uint32 Mode = 0;
+        if (!Reader(Mode))
+            LOG_ERROR_AND_THROW("Failed to read the shader compression mode.");
+        if (Mode >= static_cast<Uint32>(CompressionMode::Count))
+            LOG_ERROR_AND_THROW("Unknown shader compression mode: ", Mode, ". Archive file may be corrupted or invalid.");
+        Compression = static_cast<CompressionMode>(Mode);
     }
 
-    for (auto& Shaders : m_DeviceShaders)
+    // The table of contents is referenced in place. Resources and shaders are resolved
+    // only when they are requested, so loading time does not depend on the archive size.
+    auto TOCOffset = AlignUp(Reader.GetSize(), ArchiveDataAlignment);
+
+    auto InitTable = [&](auto*& pTable, Uint32 Count) {
+        using EntryType = std::remove_pointer_t<std::remove_reference_t<decltype(pTable)>>;
+
+        const auto TableSize = sizeof(EntryType) * Count;
+        if (TOCOffset > ArchiveSize || TableSize > ArchiveSize - TOCOffset)
+            LOG_ERROR_AND_THROW("The device object archive table of contents is out of bounds. Archive file may be corrupted or invalid.");
+
+        pTable = Count > 0 ? reinterpret_cast<EntryType*>(pArchiveData + TOCOffset) : nullptr;
+        TOCOffset += TableSize;
+    };
+
+    InitTable(TOC.pResources, TOC.NumResources);
+    for (size_t i = 0; i < TOC.pShaders.size(); ++i)
+        InitTable(TOC.pShaders[i], TOC.NumShaders[i]);
+
+    m_TOC    = TOC;
+    m_UseTOC = true;
+
+#ifdef DILIGENT_DEBUG
+    for (Uint32 i = 1; i < m_TOC.NumResources; ++i)
     {
-        if (!ArchiveReader.SerializeShaders(Shaders))
-            LOG_ERROR_AND_THROW("Failed to read shader data from the device object archive.");
+        const auto& Entry0 = m_TOC.pResources[i - 1];
+        const auto& Entry1 = m_TOC.pResources[i];
+        VERIFY(CompareResources(Entry0.Type, GetTOCEntryName(Entry0), Entry1.Type, GetTOCEntryName(Entry1)) < 0,
+               "Resources in the archive table of contents must be sorted by type and name");
     }
+#endif
 }
 
-void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
+template <typename WriteHandlerType>
+void DeviceObjectArchive::SerializeArchive(IThreadPool* pThreadPool, WriteHandlerType&& WriteHandler) const
 {
-    if (ppDataBlob == nullptr)
+    VERIFY(!m_UseTOC, "The archive data should be used as is");
+
+    // Sort resources by type and name so that they can be found by binary search
+    std::vector<const decltype(m_NamedResources)::value_type*> SortedResources;
+    SortedResources.reserve(m_NamedResources.size());
+    for (const auto& res_it : m_NamedResources)
+        SortedResources.emplace_back(&res_it);
+    std::sort(SortedResources.begin(), SortedResources.end(),
+              [](const auto* pRes0, const auto* pRes1) {
+                  return CompareResources(pRes0->first.GetType(), pRes0->first.GetName(), pRes1->first.GetType(), pRes1->first.GetName()) < 0;
+              });
+
+    // The table of contents is filled when the archive is measured, and is
+    // written as is since the data layout is the same in the write pass.
+    std::vector<ResourceTOCEntry>                                                  ResourceTOC(SortedResources.size());
+    std::array<std::vector<ShaderTOCEntry>, static_cast<size_t>(DeviceType::Count)> ShaderTOC;
+    for (size_t i = 0; i < ShaderTOC.size(); ++i)
+        ShaderTOC[i].resize(m_DeviceShaders[i].size());
+
+    // Shaders are compressed once before the archive is measured.
+    // Shaders that do not benefit from compression are stored as is.
+    std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> CompressedShaders;
+    for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
     {
-        DEV_ERROR("Pointer to the data blob object must not be null");
-        return;
+        if (m_ShaderCompression[dev] == CompressionMode::None)
+            continue;
+
+        const auto& Shaders = m_DeviceShaders[dev];
+        CompressedShaders[dev].resize(Shaders.size());
+        ParallelFor(pThreadPool, size_t{0}, Shaders.size(), size_t{1},
+                    [&](size_t Begin, size_t End) {
+                        for (size_t i = Begin; i < End; ++i)
+                            CompressedShaders[dev][i] = CompressData(m_ShaderCompression[dev], Shaders[i]);
+                    });
     }
-    DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    auto SerializeThis = [this](auto& Ser) {
+    auto SerializeThis = [&](auto& Ser) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
-        const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
+        const auto     ArchiveSer = ArchiveSerializer<SerMode, std::remove_reference_t<decltype(Ser)>>{Ser};
 
         ArchiveHeader Header;
         Header.ContentVersion = m_ContentVersion;
 
-        auto res = ArchiveSer.SerializeHeader(Header);
-        VERIFY(res, "Failed to serialize header");
+        if (!ArchiveSer.SerializeHeader(Header))
+            return false;
+
+        Uint32 NumResources = StaticCast<Uint32>(SortedResources.size());
+        if (!Ser(NumResources))
+            return false;
+
+        for (const auto& Shaders : m_DeviceShaders)
+        {
+            Uint32 NumShaders = StaticCast<Uint32>(Shaders.size());
+            if (!Ser(NumShaders))
+                return false;
+        }
 
-        Uint32 NumResources = StaticCast<Uint32>(m_NamedResources.size());
-        res                 = Ser(NumResources);
-        VERIFY(res, "Failed to serialize the number of resources");
+        for (const auto Compression : m_ShaderCompression)
+        {
+            Uint32 Mode = static_cast<Uint32>(Compression);
+            if (!Ser(Mode))
+                return false;
+        }
 
-        for (const auto& res_it : m_NamedResources)
+        // Table of contents
+        if (!ArchiveSer.AlignOffset())
+            return false;
+        if (!ResourceTOC.empty())
+        {
+            if (!Ser.CopyBytes(ResourceTOC.data(), sizeof(ResourceTOCEntry) * ResourceTOC.size()))
+                return false;
+        }
+        for (const auto& DeviceShaderTOC : ShaderTOC)
         {
-            const auto* Name    = res_it.first.GetName();
-            const auto  ResType = res_it.first.GetType();
+            if (DeviceShaderTOC.empty())
+                continue;
+            if (!Ser.CopyBytes(DeviceShaderTOC.data(), sizeof(ShaderTOCEntry) * DeviceShaderTOC.size()))
+                return false;
+        }
+
+        // Resource data
+        for (size_t i = 0; i < SortedResources.size(); ++i)
+        {
+            const auto* Name = SortedResources[i]->first.GetName();
 
-            res = Ser(ResType, Name);
-            VERIFY(res, "Failed to serialize resource type and name");
+            ResourceTOCEntry Entry;
+            Entry.Type     = SortedResources[i]->first.GetType();
+            Entry.NameSize = StaticCast<Uint32>(strlen(Name) + 1);
 
-            res = ArchiveSer.SerializeResourceData(res_it.second);
-            VERIFY(res, "Failed to serialize resource data");
+            if (!ArchiveSer.AlignOffset())
+                return false;
+            Entry.NameOffset = Ser.GetSize();
+            if (!Ser.CopyBytes(Name, Entry.NameSize))
+                return false;
+
+            if (!ArchiveSer.AlignOffset())
+                return false;
+            Entry.DataOffset = Ser.GetSize();
+            if (!ArchiveSer.SerializeResourceData(SortedResources[i]->second))
+                return false;
+            Entry.DataSize = Ser.GetSize() - Entry.DataOffset;
+
+            VERIFY_EXPR(SerMode == SerializerMode::Measure || memcmp(&ResourceTOC[i], &Entry, sizeof(Entry)) == 0);
+            ResourceTOC[i] = Entry;
         }
 
-        for (auto& Shaders : m_DeviceShaders)
+        // Shader data
+        for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            const auto& Shaders = m_DeviceShaders[dev];
+            for (size_t i = 0; i < Shaders.size(); ++i)
+            {
+                if (!ArchiveSer.AlignOffset())
+                    return false;
+
+                const auto& Data = (i < CompressedShaders[dev].size() && CompressedShaders[dev][i]) ?
+                    CompressedShaders[dev][i] :
+                    Shaders[i];
+
+                ShaderTOCEntry Entry;
+                Entry.Offset           = Ser.GetSize();
+                Entry.Size             = StaticCast<Uint32>(Data.Size());
+                Entry.DecompressedSize = StaticCast<Uint32>(Shaders[i].Size());
+                if (Entry.Size > 0)
+                {
+                    if (!Ser.CopyBytes(Data.Ptr(), Data.Size()))
+                        return false;
+                }
+
+                VERIFY_EXPR(SerMode == SerializerMode::Measure || memcmp(&ShaderTOC[dev][i], &Entry, sizeof(Entry)) == 0);
+                ShaderTOC[dev][i] = Entry;
+            }
         }
+
+        return true;
     };
 
+    // The table of contents requires the offsets of all resources and shaders,
+    // so the archive is measured first. No data is copied in this pass.
     Serializer<SerializerMode::Measure> Measurer;
-    SerializeThis(Measurer);
+    if (!SerializeThis(Measurer))
+    {
+        UNEXPECTED("Measuring the archive should never fail");
+    }
 
-    auto pDataBlob = DataBlobImpl::Create(Measurer.GetSize());
+    WriteHandler(Measurer.GetSize(), SerializeThis);
+}
 
-    Serializer<SerializerMode::Write> Writer{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
-    SerializeThis(Writer);
-    VERIFY_EXPR(Writer.IsEnded());
+void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob, IThreadPool* pThreadPool) const
+{
+    if (ppDataBlob == nullptr)
+    {
+        DEV_ERROR("Pointer to the data blob object must not be null");
+        return;
+    }
+    DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    *ppDataBlob = pDataBlob.Detach();
-}
+    if (m_UseTOC)
+    {
+        // The archive has not been modified since it was loaded
+        *ppDataBlob = DataBlobImpl::MakeCopy(m_pArchiveData).Detach();
+        return;
+    }
+
+    SerializeArchive(pThreadPool, [ppDataBlob](size_t ArchiveSize, auto& SerializeThis) {
+        auto pDataBlob = DataBlobImpl::Create(ArchiveSize);
+
+        Serializer<SerializerMode::Write> Writer{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
+        if (!SerializeThis(Writer))
+        {
+            UNEXPECTED("Writing the archive to the memory blob should never fail as the blob has the measured size");
+        }
+        VERIFY_EXPR(Writer.IsEnded());
 
+        *ppDataBlob = pDataBlob.Detach();
+    });
+}
 
 namespace
 {
@@ -313,6 +514,22 @@ const char* ResourceTypeToString(DeviceObjectArchive::ResourceType Type)
     }
 }
 
+const char* CompressionModeToString(DeviceObjectArchive::CompressionMode Mode)
+{
+    using CompressionMode = DeviceObjectArchive::CompressionMode;
+    static_assert(static_cast<Uint32>(CompressionMode::Count) == 2, "Please handle the new compression mode below");
+    switch (Mode)
+    {
+        // clang-format off
+        case CompressionMode::None: return "None";
+        case CompressionMode::LZ4:  return "LZ4";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected compression mode");
+            return "unknown";
+    }
+}
+
 } // namespace
 
 
@@ -326,22 +543,205 @@ DeviceObjectArchive::DeviceObjectArchive(const CreateInfo& CI) noexcept(false) :
     if (!m_pArchiveData)
         LOG_ERROR_AND_THROW("pData must not be null");
 
+    if ((reinterpret_cast<size_t>(m_pArchiveData->GetConstDataPtr()) % ArchiveDataAlignment) != 0)
+    {
+        // The table of contents is accessed in place and must be properly aligned
+        m_pArchiveData = DataBlobImpl::MakeCopy(m_pArchiveData);
+    }
+
     Deserialize(CI);
 }
 
-const SerializedData& DeviceObjectArchive::GetDeviceSpecificData(ResourceType Type,
-                                                                 const char*  Name,
-                                                                 DeviceType   DevType) const noexcept
+const char* DeviceObjectArchive::GetTOCEntryName(const ResourceTOCEntry& Entry) const noexcept
+{
+    const auto* const pArchiveData = static_cast<const char*>(m_pArchiveData->GetConstDataPtr());
+    const auto        ArchiveSize  = m_pArchiveData->GetSize();
+
+    if (Entry.NameSize == 0 || Entry.NameOffset > ArchiveSize || Entry.NameSize > ArchiveSize - Entry.NameOffset)
+        return nullptr;
+
+    const auto* Name = pArchiveData + static_cast<size_t>(Entry.NameOffset);
+    return Name[Entry.NameSize - 1] == '\0' ? Name : nullptr;
+}
+
+const char* DeviceObjectArchive::ResolveTOCEntry(const ResourceTOCEntry& Entry, ResourceData& Data) const noexcept
+{
+    const auto* const pArchiveData = static_cast<const Uint8*>(m_pArchiveData->GetConstDataPtr());
+    const auto        ArchiveSize  = m_pArchiveData->GetSize();
+
+    const auto* Name = GetTOCEntryName(Entry);
+    if (Name == nullptr || Entry.Type >= ResourceType::Count)
+        return nullptr;
+
+    if (Entry.DataOffset > ArchiveSize || Entry.DataSize > ArchiveSize - Entry.DataOffset)
+        return nullptr;
+
+    Serializer<SerializerMode::Read> Reader{
+        SerializedData{
+            const_cast<Uint8*>(pArchiveData) + static_cast<size_t>(Entry.DataOffset),
+            static_cast<size_t>(Entry.DataSize),
+        },
+    };
+    if (!ArchiveSerializer<SerializerMode::Read>{Reader}.SerializeResourceData(Data))
+        return nullptr;
+    VERIFY_EXPR(Reader.IsEnded());
+
+    return Name;
+}
+
+const char* DeviceObjectArchive::FindResource(ResourceType Type, const char* Name, ResourceData& Data) const noexcept
+{
+    if (Name == nullptr)
+        return nullptr;
+
+    if (m_UseTOC)
+    {
+        const auto* const pBegin = m_TOC.pResources;
+        const auto* const pEnd   = m_TOC.pResources + m_TOC.NumResources;
+
+        const auto* pEntry = std::lower_bound(pBegin, pEnd, Name,
+                                              [this, Type](const ResourceTOCEntry& Entry, const char* Name) {
+                                                  return CompareResources(Entry.Type, GetTOCEntryName(Entry), Type, Name) < 0;
+                                              });
+        if (pEntry == pEnd || CompareResources(pEntry->Type, GetTOCEntryName(*pEntry), Type, Name) != 0)
+            return nullptr;
+
+        const auto* ArchiveName = ResolveTOCEntry(*pEntry, Data);
+        if (ArchiveName == nullptr)
+            LOG_ERROR_MESSAGE("Failed to read data of resource '", Name, "'. Archive file may be corrupted or invalid.");
+        return ArchiveName;
+    }
+    else
+    {
+        auto it = m_NamedResources.find(NamedResourceKey{Type, Name});
+        if (it == m_NamedResources.end())
+            return nullptr;
+
+        Data.Common = MakeDataView(it->second.Common);
+        for (size_t i = 0; i < Data.DeviceSpecific.size(); ++i)
+            Data.DeviceSpecific[i] = MakeDataView(it->second.DeviceSpecific[i]);
+        return it->first.GetName();
+    }
+}
+
+void DeviceObjectArchive::MaterializeTOC() noexcept(false)
+{
+    if (!m_UseTOC)
+        return;
+
+    VERIFY_EXPR(m_NamedResources.empty());
+    try
+    {
+        m_NamedResources.reserve(m_TOC.NumResources);
+        ProcessResources([this](ResourceType Type, const char* Name, const ResourceData& Data) {
+            // No need to make the name copy as we keep the source data blob alive.
+            constexpr auto MakeNameCopy = false;
+            auto&          DstData      = m_NamedResources[NamedResourceKey{Type, Name, MakeNameCopy}];
+
+            DstData.Common = MakeDataView(Data.Common);
+            for (size_t i = 0; i < DstData.DeviceSpecific.size(); ++i)
+                DstData.DeviceSpecific[i] = MakeDataView(Data.DeviceSpecific[i]);
+        });
+
+        for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
+        {
+            auto& Shaders = m_DeviceShaders[dev];
+            Shaders.reserve(m_TOC.NumShaders[dev]);
+            for (Uint32 i = 0; i < m_TOC.NumShaders[dev]; ++i)
+                Shaders.emplace_back(GetSerializedShader(static_cast<DeviceType>(dev), i));
+        }
+    }
+    catch (...)
+    {
+        m_NamedResources.clear();
+        for (auto& Shaders : m_DeviceShaders)
+            Shaders.clear();
+        throw;
+    }
+
+    m_TOC    = {};
+    m_UseTOC = false;
+}
+
+SerializedData DeviceObjectArchive::GetDeviceSpecificData(ResourceType Type,
+                                                          const char*  Name,
+                                                          DeviceType   DevType) const noexcept
 {
-    auto it = m_NamedResources.find(NamedResourceKey{Type, Name});
-    if (it == m_NamedResources.end())
+    ResourceData Data;
+    if (FindResource(Type, Name, Data) == nullptr)
     {
         LOG_ERROR_MESSAGE("Resource '", Name, "' is not present in the archive");
-        static const SerializedData NullData;
-        return NullData;
+        return {};
     }
-    VERIFY_EXPR(SafeStrEqual(Name, it->first.GetName()));
-    return it->second.DeviceSpecific[static_cast<size_t>(DevType)];
+    return std::move(Data.DeviceSpecific[static_cast<size_t>(DevType)]);
+}
+
+SerializedData DeviceObjectArchive::GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+{
+    const auto DevIdx = static_cast<size_t>(Type);
+    if (!m_UseTOC)
+    {
+        const auto& DeviceShaders = m_DeviceShaders[DevIdx];
+        return Idx < DeviceShaders.size() ? MakeDataView(DeviceShaders[Idx]) : SerializedData{};
+    }
+
+    if (Idx >= m_TOC.NumShaders[DevIdx])
+        return {};
+
+    const auto* const pArchiveData = static_cast<const Uint8*>(m_pArchiveData->GetConstDataPtr());
+    const auto        ArchiveSize  = m_pArchiveData->GetSize();
+
+    const auto& Entry = m_TOC.pShaders[DevIdx][Idx];
+    if (Entry.Offset > ArchiveSize || Entry.Size > ArchiveSize - Entry.Offset)
+    {
+        LOG_ERROR_MESSAGE("Failed to read shader ", Idx, ". Archive file may be corrupted or invalid.");
+        return {};
+    }
+
+    auto* const pShaderData = Entry.Size > 0 ? const_cast<Uint8*>(pArchiveData) + static_cast<size_t>(Entry.Offset) : nullptr;
+    if (Entry.Size == Entry.DecompressedSize)
+        return SerializedData{pShaderData, Entry.Size};
+
+    auto Decompressed = DecompressData(m_ShaderCompression[DevIdx], pShaderData, Entry.Size, Entry.DecompressedSize);
+    if (!Decompressed)
+        LOG_ERROR_MESSAGE("Failed to decompress shader ", Idx, ". Archive file may be corrupted or invalid.");
+    return Decompressed;
+}
+
+bool DeviceObjectArchive::GetSerializedShaders(DeviceType      Type,
+                                               const Uint32*   pIndices,
+                                               size_t          NumShaders,
+                                               SerializedData* pShaders,
+                                               IThreadPool*    pThreadPool) const noexcept
+{
+    VERIFY_EXPR(NumShaders == 0 || (pIndices != nullptr && pShaders != nullptr));
+
+    std::atomic<bool> Succeeded{true};
+    // Decompression is the only expensive part, so uncompressed shaders are processed in large chunks
+    const size_t Grain = m_ShaderCompression[static_cast<size_t>(Type)] != CompressionMode::None ? 1 : NumShaders;
+    ParallelFor(pThreadPool, size_t{0}, NumShaders, Grain,
+                [&](size_t Begin, size_t End) {
+                    for (size_t i = Begin; i < End; ++i)
+                    {
+                        pShaders[i] = GetSerializedShader(Type, pIndices[i]);
+                        if (!pShaders[i])
+                            Succeeded.store(false);
+                    }
+                });
+
+    return Succeeded.load();
+}
+
+void DeviceObjectArchive::SetShaderCompression(DeviceType Type, CompressionMode Mode) noexcept(false)
+{
+    VERIFY_EXPR(Mode < CompressionMode::Count);
+    auto& Compression = m_ShaderCompression[static_cast<size_t>(Type)];
+    if (Compression == Mode)
+        return;
+
+    // The archive data must be serialized again
+    MaterializeTOC();
+    Compression = Mode;
 }
 
 std::string DeviceObjectArchive::ToString() const
@@ -381,36 +781,43 @@ std::string DeviceObjectArchive::ToString() const
     //       Direct3D12  504 bytes
     //       Vulkan      881 bytes
     {
-        std::array<std::vector<std::reference_wrapper<const decltype(m_NamedResources)::value_type>>, static_cast<size_t>(ResourceType::Count)> ResourcesByType;
-        for (const auto& it : m_NamedResources)
+        struct ResourceInfo
         {
-            ResourcesByType[static_cast<size_t>(it.first.GetType())].emplace_back(it);
-        }
-
-        for (const auto& Resources : ResourcesByType)
+            const char*                                                  Name       = nullptr;
+            size_t                                                       CommonSize = 0;
+            std::array<size_t, static_cast<size_t>(DeviceType::Count)> DeviceSpecificSizes{};
+        };
+        std::array<std::vector<ResourceInfo>, static_cast<size_t>(ResourceType::Count)> ResourcesByType;
+        ProcessResources([&ResourcesByType](ResourceType Type, const char* Name, const ResourceData& Data) {
+            ResourceInfo Info;
+            Info.Name       = Name;
+            Info.CommonSize = Data.Common.Size();
+            for (size_t i = 0; i < Data.DeviceSpecific.size(); ++i)
+                Info.DeviceSpecificSizes[i] = Data.DeviceSpecific[i].Size();
+            ResourcesByType[static_cast<size_t>(Type)].emplace_back(Info);
+        });
+
+        for (Uint32 res_type = 0; res_type < ResourcesByType.size(); ++res_type)
         {
+            const auto& Resources = ResourcesByType[res_type];
             if (Resources.empty())
                 continue;
 
-            const auto ResType = Resources.front().get().first.GetType();
             Output << SeparatorLine
-                   << ResourceTypeToString(ResType) << " (" << Resources.size() << ")\n";
+                   << ResourceTypeToString(static_cast<ResourceType>(res_type)) << " (" << Resources.size() << ")\n";
             // ------------------
             // Resource Signatures (1)
 
-            for (const auto& res_ref : Resources)
+            for (const auto& Res : Resources)
             {
-                const auto& it = res_ref.get();
-                Output << Ident1 << it.first.GetName() << '\n';
+                Output << Ident1 << Res.Name << '\n';
                 // ..Test PRS
 
-                const auto& Res = it.second;
-
-                auto   MaxSize       = Res.Common.Size();
+                auto   MaxSize       = Res.CommonSize;
                 size_t MaxDevNameLen = strlen(CommonDataName);
-                for (Uint32 i = 0; i < Res.DeviceSpecific.size(); ++i)
+                for (Uint32 i = 0; i < Res.DeviceSpecificSizes.size(); ++i)
                 {
-                    const auto DevDataSize = Res.DeviceSpecific[i].Size();
+                    const auto DevDataSize = Res.DeviceSpecificSizes[i];
 
                     MaxSize = std::max(MaxSize, DevDataSize);
                     if (DevDataSize != 0)
@@ -419,12 +826,12 @@ std::string DeviceObjectArchive::ToString() const
                 const auto SizeFieldW = GetNumFieldWidth(MaxSize);
 
                 Output << Ident2 << std::setw(static_cast<int>(MaxDevNameLen)) << std::left << CommonDataName << ' '
-                       << std::setw(static_cast<int>(SizeFieldW)) << std::right << Res.Common.Size() << " bytes\n";
+                       << std::setw(static_cast<int>(SizeFieldW)) << std::right << Res.CommonSize << " bytes\n";
                 // ....Common     1015 bytes
 
-                for (Uint32 i = 0; i < Res.DeviceSpecific.size(); ++i)
+                for (Uint32 i = 0; i < Res.DeviceSpecificSizes.size(); ++i)
                 {
-                    const auto DevDataSize = Res.DeviceSpecific[i].Size();
+                    const auto DevDataSize = Res.DeviceSpecificSizes[i];
                     if (DevDataSize > 0)
                     {
                         Output << Ident2 << std::setw(static_cast<int>(MaxDevNameLen)) << std::left << ArchiveDeviceTypeToString(i) << ' '
@@ -443,14 +850,14 @@ std::string DeviceObjectArchive::ToString() const
     //     OpenGL(2)
     //       [0] 'Test VS' 4020 bytes
     //       [1] 'Test PS' 4020 bytes
-    //     Vulkan(2)
+    //     Vulkan(2), LZ4 compression
     //       [0] 'Test VS' 8364 bytes
     //       [1] 'Test PS' 7380 bytes
     {
         bool HasShaders = false;
-        for (const auto& Shaders : m_DeviceShaders)
+        for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
         {
-            if (!Shaders.empty())
+            if (GetNumShaders(static_cast<DeviceType>(dev)) != 0)
                 HasShaders = true;
         }
 
@@ -461,22 +868,30 @@ std::string DeviceObjectArchive::ToString() const
             // ------------------
             // Compiled Shaders
 
-            for (Uint32 dev = 0; dev < m_DeviceShaders.size(); ++dev)
+            for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
             {
-                const auto& Shaders = m_DeviceShaders[dev];
-                if (Shaders.empty())
+                const auto NumShaders = GetNumShaders(static_cast<DeviceType>(dev));
+                if (NumShaders == 0)
                     continue;
-                Output << Ident1 << ArchiveDeviceTypeToString(dev) << '(' << Shaders.size() << ")\n";
+                const auto Compression = GetShaderCompression(static_cast<DeviceType>(dev));
+                Output << Ident1 << ArchiveDeviceTypeToString(dev) << '(' << NumShaders << ')';
+                if (Compression != CompressionMode::None)
+                    Output << ", " << CompressionModeToString(Compression) << " compression";
+                Output << '\n';
                 // ..OpenGL(2)
 
                 std::vector<std::string> ShaderNames;
-                ShaderNames.reserve(Shaders.size());
+                ShaderNames.reserve(NumShaders);
+                std::vector<size_t> ShaderSizes;
+                ShaderSizes.reserve(NumShaders);
 
                 size_t MaxSize    = 0;
                 size_t MaxNameLen = 0;
-                for (const auto& ShaderData : Shaders)
+                for (size_t idx = 0; idx < NumShaders; ++idx)
                 {
-                    MaxSize = std::max(MaxSize, ShaderData.Size());
+                    const auto ShaderData = GetSerializedShader(static_cast<DeviceType>(dev), idx);
+                    MaxSize               = std::max(MaxSize, ShaderData.Size());
+                    ShaderSizes.emplace_back(ShaderData.Size());
 
                     ShaderCreateInfo                 ShaderCI;
                     Serializer<SerializerMode::Read> ShaderSer{ShaderData};
@@ -487,13 +902,13 @@ std::string DeviceObjectArchive::ToString() const
                     MaxNameLen = std::max(MaxNameLen, ShaderNames.back().size());
                 }
 
-                const auto IdxFieldW  = GetNumFieldWidth(Shaders.size());
+                const auto IdxFieldW  = GetNumFieldWidth(NumShaders);
                 const auto SizeFieldW = GetNumFieldWidth(MaxSize);
-                for (Uint32 idx = 0; idx < Shaders.size(); ++idx)
+                for (Uint32 idx = 0; idx < NumShaders; ++idx)
                 {
                     Output << Ident2 << '[' << std::setw(static_cast<int>(IdxFieldW)) << std::right << idx << "] "
                            << std::setw(static_cast<int>(MaxNameLen)) << std::left << ShaderNames[idx] << ' '
-                           << std::setw(static_cast<int>(SizeFieldW)) << std::right << Shaders[idx].Size() << " bytes\n";
+                           << std::setw(static_cast<int>(SizeFieldW)) << std::right << ShaderSizes[idx] << " bytes\n";
                     // ....[0] 'Test VS' 4020 bytes
                 }
             }
@@ -506,6 +921,8 @@ std::string DeviceObjectArchive::ToString() const
 
 void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 {
+    MaterializeTOC();
+
     for (auto& res_it : m_NamedResources)
         res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
@@ -514,6 +931,8 @@ void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 
 void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 {
+    MaterializeTOC();
+
     auto& Allocator = GetRawAllocator();
     for (auto& dst_res_it : m_NamedResources)
     {
@@ -521,21 +940,24 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
         // Clear dst device data to make sure we don't have invalid shader indices
         DstData = {};
 
-        auto src_res_it = Src.m_NamedResources.find(dst_res_it.first);
-        if (src_res_it == Src.m_NamedResources.end())
+        ResourceData SrcResData;
+        if (Src.FindResource(dst_res_it.first.GetType(), dst_res_it.first.GetName(), SrcResData) == nullptr)
             continue;
 
-        const auto& SrcData{src_res_it->second.DeviceSpecific[static_cast<size_t>(Dev)]};
+        const auto& SrcData{SrcResData.DeviceSpecific[static_cast<size_t>(Dev)]};
         // Always copy src data even if it is empty
         DstData = SrcData.MakeCopy(Allocator);
     }
 
     // Copy all shaders to make sure PSO shader indices are correct
-    const auto& SrcShaders = Src.m_DeviceShaders[static_cast<size_t>(Dev)];
-    auto&       DstShaders = m_DeviceShaders[static_cast<size_t>(Dev)];
+    m_ShaderCompression[static_cast<size_t>(Dev)] = Src.GetShaderCompression(Dev);
+
+    const auto NumSrcShaders = Src.GetNumShaders(Dev);
+    auto&      DstShaders    = m_DeviceShaders[static_cast<size_t>(Dev)];
     DstShaders.clear();
-    for (const auto& SrcShader : SrcShaders)
-        DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+    DstShaders.reserve(NumSrcShaders);
+    for (size_t i = 0; i < NumSrcShaders; ++i)
+        DstShaders.emplace_back(Src.GetSerializedShader(Dev, i).MakeCopy(Allocator));
 }
 
 void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
@@ -545,6 +967,8 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
+    MaterializeTOC();
+
     auto&                  Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
@@ -552,30 +976,26 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
     std::array<Uint32, static_cast<size_t>(DeviceType::Count)> ShaderBaseIndices{};
     for (size_t i = 0; i < m_DeviceShaders.size(); ++i)
     {
-        const auto& SrcShaders = Src.m_DeviceShaders[i];
-        auto&       DstShaders = m_DeviceShaders[i];
-        ShaderBaseIndices[i]   = static_cast<Uint32>(DstShaders.size());
-        if (SrcShaders.empty())
+        const auto NumSrcShaders = Src.GetNumShaders(static_cast<DeviceType>(i));
+        auto&      DstShaders    = m_DeviceShaders[i];
+        ShaderBaseIndices[i]     = static_cast<Uint32>(DstShaders.size());
+        if (NumSrcShaders == 0)
             continue;
-        DstShaders.reserve(DstShaders.size() + SrcShaders.size());
-        for (const auto& SrcShader : SrcShaders)
-            DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+        DstShaders.reserve(DstShaders.size() + NumSrcShaders);
+        for (size_t j = 0; j < NumSrcShaders; ++j)
+            DstShaders.emplace_back(Src.GetSerializedShader(static_cast<DeviceType>(i), j).MakeCopy(Allocator));
     }
 
     // Copy named resources
-    for (auto& src_res_it : Src.m_NamedResources)
-    {
-        const auto  ResType = src_res_it.first.GetType();
-        const auto* ResName = src_res_it.first.GetName();
-
-        auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, src_res_it.second.MakeCopy(Allocator));
+    Src.ProcessResources([&](ResourceType ResType, const char* ResName, const ResourceData& SrcResData) {
+        auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, SrcResData.MakeCopy(Allocator));
         if (!it_inserted.second)
         {
             // Silently skip duplicate resources
-            if (it_inserted.first->second != src_res_it.second)
+            if (it_inserted.first->second != SrcResData)
                 LOG_WARNING_MESSAGE("Failed to copy resource '", ResName, "': resource with the same name already exists.");
 
-            continue;
+            return;
         }
 
         const auto IsStandaloneShader = (ResType == ResourceType::StandaloneShader);
@@ -642,16 +1062,29 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
                 }
             }
         }
-    }
+    });
 }
 
-void DeviceObjectArchive::Serialize(IFileStream* pStream) const
+bool DeviceObjectArchive::Serialize(IFileStream* pStream, size_t StagingBufferSize, IThreadPool* pThreadPool) const
 {
     DEV_CHECK_ERR(pStream != nullptr, "File stream must not be null");
-    RefCntAutoPtr<IDataBlob> pDataBlob;
-    Serialize(&pDataBlob);
-    VERIFY_EXPR(pDataBlob);
-    pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
+    if (pStream == nullptr)
+        return false;
+
+    if (m_UseTOC)
+    {
+        // The archive has not been modified since it was loaded
+        return pStream->Write(m_pArchiveData->GetConstDataPtr(), m_pArchiveData->GetSize());
+    }
+
+    bool Res = false;
+    SerializeArchive(pThreadPool, [&](size_t ArchiveSize, auto& SerializeThis) {
+        StreamSerializer<SerializerMode::Write> Writer{pStream, StagingBufferSize};
+        // Stream errors are not exceptional, so the failure is reported to the caller
+        Res = SerializeThis(Writer) && Writer.Flush();
+        VERIFY_EXPR(!Res || Writer.GetSize() == ArchiveSize);
+    });
+    return Res;
 }
 
 } // namespace Diligent
@@ -399,12 +399,7 @@ bool RPSerializer<Mode>::SerializeDesc(
                                    return false;
 
 
-                               if (!Ser.SerializeArray(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount,
-                                                       [](Serializer<Mode>&  Ser,
-                                                          ConstQual<Uint32>& Attach) //
-                                                       {
-                                                           return Ser(Attach);
-                                                       }))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount))
                                    return false;
 
                                Uint32 ShadingRateAttachCount = Subpass.pShadingRateAttachment != nullptr ? 1 : 0;
@@ -358,6 +358,46 @@ Uint32 FindResource(const PipelineResourceDesc Resources[],
     return InvalidPipelineResourceIndex;
 }
 
+Uint32 GetResourceNameTableSize(Uint32 NumResources)
+{
+    if (NumResources == 0)
+        return 0;
+
+    Uint32 TableSize = 4;
+    while (TableSize < NumResources * 2)
+        TableSize *= 2;
+    return TableSize;
+}
+
+void InitResourceNameTable(const PipelineResourceDesc Resources[],
+                           Uint32                     NumResources,
+                           Uint32                     NameTable[],
+                           Uint32                     TableSize) noexcept(false)
+{
+    // Resource indices plus one are stored in the lower 16 bits of the table entries
+    static_assert(MAX_RESOURCES_IN_SIGNATURE <= 0xFFFFu, "Resource index does not fit into the name table entry");
+    if (NumResources > MAX_RESOURCES_IN_SIGNATURE)
+        LOG_ERROR_AND_THROW("The number of resources (", NumResources, ") exceeds the maximum allowed value (", MAX_RESOURCES_IN_SIGNATURE, ").");
+
+    VERIFY_EXPR(TableSize == GetResourceNameTableSize(NumResources));
+    if (TableSize == 0)
+        return;
+
+    std::fill(NameTable, NameTable + TableSize, 0u);
+
+    const auto Mask = TableSize - 1;
+    for (Uint32 r = 0; r < NumResources; ++r)
+    {
+        const auto NameHash = CStringHash<Char>{}(Resources[r].Name);
+
+        auto Slot = static_cast<Uint32>(NameHash) & Mask;
+        while (NameTable[Slot] != 0)
+            Slot = (Slot + 1) & Mask;
+
+        NameTable[Slot] = GetResourceNameTableEntryTag(NameHash) | (r + 1);
+    }
+}
+
 /// Returns true if two pipeline resources are compatible
 inline bool PipelineResourcesCompatible(const PipelineResourceDesc& lhs, const PipelineResourceDesc& rhs)
 {
@@ -872,6 +872,21 @@ void ValidatePipelineResourceCompatibility(const PipelineResourceDesc& ResDesc,
     }
 }
 
+void WaitForShaderCompilation(IShader* pShader) noexcept(false)
+{
+    VERIFY_EXPR(pShader != nullptr);
+
+    const auto Status = pShader->GetStatus(/*WaitForCompletion = */ true);
+    if (Status != SHADER_STATUS_READY)
+    {
+        const auto* Name = pShader->GetDesc().Name;
+        if (Status == SHADER_STATUS_FAILED)
+            LOG_ERROR_AND_THROW("Shader '", (Name != nullptr ? Name : ""), "' failed to compile.");
+        else
+            LOG_ERROR_AND_THROW("Shader '", (Name != nullptr ? Name : ""), "' is not ready.");
+    }
+}
+
 void CorrectGraphicsPipelineDesc(GraphicsPipelineDesc& GraphicsPipeline) noexcept
 {
     CorrectBlendStateDesc(GraphicsPipeline);
@@ -249,8 +249,10 @@ private:
         return reinterpret_cast<const ResourceType*>(reinterpret_cast<const Uint8*>(m_pVariables) + Offset)[ResIndex];
     }
 
+    // Returns the variable of the given type that references the resource with
+    // index ResIndex in the signature, or null if there is no such variable.
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceBySignatureIndex(Uint32 ResIndex) const;
 
     template <typename THandleCB,
               typename THandleTexSRV,
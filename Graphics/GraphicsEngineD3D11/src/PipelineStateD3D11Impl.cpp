@@ -337,6 +337,9 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*
             CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateInputLayout(d311InputElements.data(), static_cast<UINT>(d311InputElements.size()), pVSByteCode->GetBufferPointer(), pVSByteCode->GetBufferSize(), &m_pd3d11InputLayout),
                                    "Failed to create the Direct3D11 input layout");
         }
+
+        // Asynchronous pipeline creation is not implemented in this backend
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -355,6 +358,9 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*
         CComPtr<ID3DBlob> pVSByteCode;
         InitInternalObjects(CreateInfo, pVSByteCode);
         VERIFY(!pVSByteCode, "There must be no VS in a compute pipeline.");
+
+        // Asynchronous pipeline creation is not implemented in this backend
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
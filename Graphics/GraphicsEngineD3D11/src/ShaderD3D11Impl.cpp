@@ -121,6 +121,9 @@ ShaderD3D11Impl::ShaderD3D11Impl(IReferenceCounters*     pRefCounters,
             ShaderCI.LoadConstantBufferReflection};
         m_pShaderResources.reset(pResources, STDDeleterRawMem<ShaderResourcesD3D11>(Allocator));
     }
+
+    // Asynchronous compilation is not implemented in this backend, the shader is always ready at this point
+    m_Status.store(SHADER_STATUS_READY);
 }
 
 ShaderD3D11Impl::~ShaderD3D11Impl()
@@ -525,44 +525,59 @@ void ShaderVariableManagerD3D11::BindResources(IResourceMapping* pResourceMappin
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceBySignatureIndex(Uint32 ResIndex) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto& Resource = GetResource<ResourceType>(res);
-        if (strcmp(Resource.GetDesc().Name, Name) == 0)
-            return &Resource;
-    }
-
-    return nullptr;
+    auto* pResources = reinterpret_cast<ResourceType*>(reinterpret_cast<Uint8*>(m_pVariables) + GetResourceOffset<ResourceType>());
+    return FindVariableByResourceIndex(pResources, GetNumResources<ResourceType>(), ResIndex);
 }
 
 IShaderResourceVariable* ShaderVariableManagerD3D11::GetVariable(const Char* Name) const
 {
-    if (auto* pCB = GetResourceByName<ConstBuffBindInfo>(Name))
-        return pCB;
+    if (m_pSignature == nullptr)
+        return nullptr;
+
+    IShaderResourceVariable* pVar = nullptr;
+    m_pSignature->FindResourcesByName(
+        Name,
+        [&](Uint32 ResIndex) {
+            const auto& ResDesc = m_pSignature->GetResourceDesc(ResIndex);
+            static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update the switch below to handle the new shader resource range");
+            switch (ResDesc.ResourceType)
+            {
+                case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                    pVar = GetResourceBySignatureIndex<ConstBuffBindInfo>(ResIndex);
+                    break;
 
-    if (auto* pTexSRV = GetResourceByName<TexSRVBindInfo>(Name))
-        return pTexSRV;
+                case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+                case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+                    pVar = GetResourceBySignatureIndex<TexSRVBindInfo>(ResIndex);
+                    break;
 
-    if (auto* pTexUAV = GetResourceByName<TexUAVBindInfo>(Name))
-        return pTexUAV;
+                case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+                    pVar = GetResourceBySignatureIndex<BuffSRVBindInfo>(ResIndex);
+                    break;
 
-    if (auto* pBuffSRV = GetResourceByName<BuffSRVBindInfo>(Name))
-        return pBuffSRV;
+                case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+                    pVar = GetResourceBySignatureIndex<TexUAVBindInfo>(ResIndex);
+                    break;
 
-    if (auto* pBuffUAV = GetResourceByName<BuffUAVBindInfo>(Name))
-        return pBuffUAV;
+                case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                    pVar = GetResourceBySignatureIndex<BuffUAVBindInfo>(ResIndex);
+                    break;
 
-    if (!m_pSignature->IsUsingCombinedSamplers())
-    {
-        // Immutable samplers are never initialized as variables
-        if (auto* pSampler = GetResourceByName<SamplerBindInfo>(Name))
-            return pSampler;
-    }
+                case SHADER_RESOURCE_TYPE_SAMPLER:
+                    // Immutable samplers are never initialized as variables
+                    if (!m_pSignature->IsUsingCombinedSamplers())
+                        pVar = GetResourceBySignatureIndex<SamplerBindInfo>(ResIndex);
+                    break;
 
-    return nullptr;
+                default:
+                    UNEXPECTED("Unsupported resource type.");
+            }
+            return pVar != nullptr;
+        });
+
+    return pVar;
 }
 
 class ShaderVariableIndexLocator
@@ -878,6 +878,9 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
         {
             m_pd3d12PSO->SetName(WName.c_str());
         }
+
+        // Asynchronous pipeline creation is not implemented in this backend
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -940,6 +943,9 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
         {
             m_pd3d12PSO->SetName(WName.c_str());
         }
+
+        // Asynchronous pipeline creation is not implemented in this backend
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -989,6 +995,9 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
         {
             m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
         }
+
+        // Asynchronous pipeline creation is not implemented in this backend
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -136,6 +136,9 @@ ShaderD3D12Impl::ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
             };
         m_pShaderResources.reset(pResources, STDDeleterRawMem<ShaderResourcesD3D12>(Allocator));
     }
+
+    // Asynchronous compilation is not implemented in this backend, the shader is always ready at this point
+    m_Status.store(SHADER_STATUS_READY);
 }
 
 ShaderD3D12Impl::~ShaderD3D12Impl()
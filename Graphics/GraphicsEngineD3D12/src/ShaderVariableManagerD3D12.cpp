@@ -135,13 +135,18 @@ const ShaderVariableManagerD3D12::ResourceAttribs& ShaderVariableManagerD3D12::G
 
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Name) const
 {
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.GetDesc().Name, Name) == 0)
-            return &Var;
-    }
-    return nullptr;
+    if (m_pSignature == nullptr)
+        return nullptr;
+
+    // Resources with the same name may exist in different shader stages,
+    // so check every resource until one that is handled by this manager is found.
+    ShaderVariableD3D12Impl* pVar = nullptr;
+    m_pSignature->FindResourcesByName(Name,
+                                      [&](Uint32 ResIndex) {
+                                          pVar = FindVariableByResourceIndex(m_pVariables, m_NumVariables, ResIndex);
+                                          return pVar != nullptr;
+                                      });
+    return pVar;
 }
 
 
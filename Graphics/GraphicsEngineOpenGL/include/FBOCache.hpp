@@ -31,6 +31,7 @@
 #include "TextureView.h"
 #include "SpinLock.hpp"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
 #include "GLObjectWrapper.hpp"
 
 namespace Diligent
@@ -57,6 +58,7 @@ public:
                                                         TextureViewGLImpl* ppRTVs[],
                                                         TextureViewGLImpl* pDSV);
 
+    // The returned reference is only valid until the next call to GetFBO()
     const GLObjectWrappers::GLFrameBufferObj& GetFBO(Uint32             NumRenderTargets,
                                                      TextureViewGLImpl* ppRTVs[],
                                                      TextureViewGLImpl* pDSV,
@@ -92,8 +94,8 @@ private:
 
 
     friend class RenderDeviceGLImpl;
-    Threading::SpinLock                                                                      m_CacheLock;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    Threading::SpinLock                                                               m_CacheLock;
+    FlatHashMap<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
 
     // Multimap that sets up correspondence between unique texture id and all
     // FBOs it is used in
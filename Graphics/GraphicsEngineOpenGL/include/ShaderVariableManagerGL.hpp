@@ -251,8 +251,10 @@ private:
         return reinterpret_cast<ResourceType*>(reinterpret_cast<Uint8*>(m_pVariables) + Offset)[ResIndex];
     }
 
+    // Returns the variable of the given type that references the resource with
+    // index ResIndex in the signature, or null if there is no such variable.
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceBySignatureIndex(Uint32 ResIndex) const;
 
     template <typename THandleUB,
               typename THandleTexture,
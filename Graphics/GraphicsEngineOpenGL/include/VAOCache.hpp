@@ -36,6 +36,7 @@
 #include "InputLayout.h"
 #include "SpinLock.hpp"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
 #include "DeviceContextBase.hpp"
 
 namespace Diligent
@@ -64,6 +65,7 @@ public:
         VertexStreamInfo<BufferGLImpl>* const VertexStreams;
         const Uint32                          NumVertexStreams;
     };
+    // The returned reference is only valid until the next call to GetVAO()
     const GLObjectWrappers::GLVertexArrayObj& GetVAO(const VAOAttribs&     Attribs,
                                                      class GLContextState& GLContextState);
     const GLObjectWrappers::GLVertexArrayObj& GetEmptyVAO();
@@ -120,8 +122,8 @@ private:
     // Clears stale entries from m_PSOToKey and m_BuffToKey when a VAO is removed from m_Cache
     void ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys);
 
-    Threading::SpinLock                                                                    m_CacheLock;
-    std::unordered_map<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
+    Threading::SpinLock                                                             m_CacheLock;
+    FlatHashMap<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
 
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_PSOToKey;
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_BuffToKey;
@@ -85,7 +85,6 @@ std::size_t FBOCache::FBOCacheKeyHashFunc::operator()(const FBOCacheKey& Key) co
 
 FBOCache::FBOCache()
 {
-    m_Cache.max_load_factor(0.5f);
     m_TexIdToKey.max_load_factor(0.5f);
 }
 
@@ -326,6 +326,9 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*
         }
 
         InitInternalObjects(CreateInfo, Shaders);
+
+        // GL programs are always linked synchronously as the GL context is bound to the calling thread
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -354,6 +357,9 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                   p
         ExtractShaders<ShaderGLImpl>(CreateInfo, Shaders);
 
         InitInternalObjects(CreateInfo, Shaders);
+
+        // GL programs are always linked synchronously as the GL context is bound to the calling thread
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
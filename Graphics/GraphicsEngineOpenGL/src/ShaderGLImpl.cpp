@@ -197,6 +197,9 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
                                   m_SourceLanguage});
         m_pShaderResources.reset(pResources.release());
     }
+
+    // GL shaders are always compiled synchronously as the GL context is bound to the calling thread
+    m_Status.store(SHADER_STATUS_READY);
 }
 
 ShaderGLImpl::~ShaderGLImpl()
@@ -446,36 +446,48 @@ void ShaderVariableManagerGL::CheckResources(IResourceMapping*
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerGL::GetResourceBySignatureIndex(Uint32 ResIndex) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto&       Resource = GetResource<ResourceType>(res);
-        const auto& ResDesc  = Resource.GetDesc();
-        if (strcmp(ResDesc.Name, Name) == 0)
-            return &Resource;
-    }
-
-    return nullptr;
+    auto* pResources = reinterpret_cast<ResourceType*>(reinterpret_cast<Uint8*>(m_pVariables) + GetResourceOffset<ResourceType>());
+    return FindVariableByResourceIndex(pResources, GetNumResources<ResourceType>(), ResIndex);
 }
 
 
 IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(const Char* Name) const
 {
-    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(Name))
-        return pUB;
-
-    if (auto* pTexture = GetResourceByName<TextureBindInfo>(Name))
-        return pTexture;
-
-    if (auto* pImage = GetResourceByName<ImageBindInfo>(Name))
-        return pImage;
+    if (m_pSignature == nullptr)
+        return nullptr;
+
+    IShaderResourceVariable* pVar = nullptr;
+    m_pSignature->FindResourcesByName(
+        Name,
+        [&](Uint32 ResIndex) {
+            const auto& ResDesc = m_pSignature->GetResourceDesc(ResIndex);
+            if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
+                return false;
 
-    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(Name))
-        return pSSBO;
+            static_assert(BINDING_RANGE_COUNT == 4, "Please update the switch below to handle the new shader resource range");
+            switch (PipelineResourceToBindingRange(ResDesc))
+            {
+                case BINDING_RANGE_UNIFORM_BUFFER:
+                    pVar = GetResourceBySignatureIndex<UniformBuffBindInfo>(ResIndex);
+                    break;
+                case BINDING_RANGE_TEXTURE:
+                    pVar = GetResourceBySignatureIndex<TextureBindInfo>(ResIndex);
+                    break;
+                case BINDING_RANGE_IMAGE:
+                    pVar = GetResourceBySignatureIndex<ImageBindInfo>(ResIndex);
+                    break;
+                case BINDING_RANGE_STORAGE_BUFFER:
+                    pVar = GetResourceBySignatureIndex<StorageBufferBindInfo>(ResIndex);
+                    break;
+                default:
+                    UNEXPECTED("Unsupported resource type.");
+            }
+            return pVar != nullptr;
+        });
 
-    return nullptr;
+    return pVar;
 }
 
 class ShaderVariableLocator
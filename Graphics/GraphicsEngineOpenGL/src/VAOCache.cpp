@@ -47,7 +47,6 @@ namespace Diligent
 VAOCache::VAOCache() :
     m_EmptyVAO{true}
 {
-    m_Cache.max_load_factor(0.5f);
     m_PSOToKey.max_load_factor(0.5f);
     m_BuffToKey.max_load_factor(0.5f);
 }
@@ -410,6 +410,17 @@ private:
     void               CommitViewports();
     void               CommitScissorRects();
 
+    // Returns false if no pipeline state is bound to the context, e.g. because the pipeline
+    // that was set last is not ready yet. Commands that require a pipeline must then be skipped.
+    __forceinline bool CheckPipelineStateIsBound(const char* CmdName) const
+    {
+        if (m_pPipelineState)
+            return true;
+
+        LOG_ERROR_MESSAGE(CmdName, " command is skipped because no pipeline state is bound to the context.");
+        return false;
+    }
+
     void Flush(Uint32               NumCommandLists,
                ICommandList* const* ppCommandLists);
 
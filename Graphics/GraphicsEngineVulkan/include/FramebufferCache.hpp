@@ -34,6 +34,7 @@
 #include <mutex>
 
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -87,8 +88,8 @@ private:
         }
     };
 
-    std::mutex                                                                                            m_Mutex;
-    std::unordered_map<FramebufferCacheKey, VulkanUtilities::FramebufferWrapper, FramebufferCacheKeyHash> m_Cache;
+    std::mutex                                                                                     m_Mutex;
+    FlatHashMap<FramebufferCacheKey, VulkanUtilities::FramebufferWrapper, FramebufferCacheKeyHash> m_Cache;
 
     std::unordered_multimap<VkImageView, FramebufferCacheKey>  m_ViewToKeyMap;
     std::unordered_multimap<VkRenderPass, FramebufferCacheKey> m_RenderPassToKeyMap;
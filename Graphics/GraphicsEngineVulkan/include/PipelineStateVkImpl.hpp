@@ -32,6 +32,7 @@
 
 #include <array>
 #include <memory>
+#include <initializer_list>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -110,6 +111,7 @@ public:
         const TBindIndexToDescSetIndex&                      BindIndexToDescSetIndex,
         bool                                                 bVerifyOnly,
         bool                                                 bStripReflection,
+        IThreadPool*                                         pThreadPool,
         const char*                                          PipelineName,
         TShaderResources*                                    pShaderResources     = nullptr,
         TResourceAttibutions*                                pResourceAttibutions = nullptr) noexcept(false);
@@ -121,11 +123,27 @@ public:
         Uint32                            SRBAllocationGranularity) noexcept(false);
 
 private:
+    template <typename PSOCreateInfoType>
+    void InitPipelineDesc(const PSOCreateInfoType& CreateInfo) noexcept(false);
+
     template <typename PSOCreateInfoType>
     TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
                                       std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
                                       std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false);
 
+    void InitializePipeline(const GraphicsPipelineStateCreateInfo& CreateInfo) noexcept(false);
+    void InitializePipeline(const ComputePipelineStateCreateInfo& CreateInfo) noexcept(false);
+
+    // Starts the pipeline initialization in the shader compilation thread pool.
+    // The pipeline description must already be initialized.
+    void InitializePipelineAsync(IThreadPool* pThreadPool, const GraphicsPipelineStateCreateInfo& CreateInfo);
+    void InitializePipelineAsync(IThreadPool* pThreadPool, const ComputePipelineStateCreateInfo& CreateInfo);
+
+    template <typename PSOCreateInfoType>
+    void EnqueueAsyncInitialization(IThreadPool*                    pThreadPool,
+                                    PSOCreateInfoType               AsyncCI,
+                                    std::initializer_list<IShader*> Shaders);
+
     void InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
                             TShaderStages&                 ShaderStages) noexcept(false);
 
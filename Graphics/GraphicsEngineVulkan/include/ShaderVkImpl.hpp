@@ -37,6 +37,7 @@
 namespace Diligent
 {
 class IDXCompiler;
+struct IBytecodeCache;
 
 /// Shader object object implementation in Vulkan backend.
 class ShaderVkImpl final : public ShaderBase<EngineVkImplTraits>
@@ -55,6 +56,8 @@ public:
         const Uint32               VkVersion;
         const bool                 HasSpirv14;
         IDataBlob** const          ppCompilerOutput;
+        IThreadPool* const         pCompilationThreadPool;
+        IBytecodeCache* const      pBytecodeCache;
     };
     ShaderVkImpl(IReferenceCounters*     pRefCounters,
                  RenderDeviceVkImpl*     pRenderDeviceVk,
@@ -68,6 +71,7 @@ public:
     /// Implementation of IShader::GetResourceCount() in Vulkan backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetResourceCount() const override final
     {
+        DEV_CHECK_ERR(!IsCompiling(), "Shader resources are not available until the shader is compiled. Use GetStatus() to check the shader status.");
         return m_pShaderResources ? m_pShaderResources->GetTotalResources() : 0;
     }
 
@@ -80,6 +84,7 @@ public:
     /// Implementation of IShaderVk::GetSPIRV().
     virtual const std::vector<uint32_t>& DILIGENT_CALL_TYPE GetSPIRV() const override final
     {
+        DEV_CHECK_ERR(!IsCompiling(), "SPIRV bytecode is not available until the shader is compiled. Use GetStatus() to check the shader status.");
         return m_SPIRV;
     }
 
@@ -90,11 +95,15 @@ public:
     virtual void DILIGENT_CALL_TYPE GetBytecode(const void** ppBytecode,
                                                 Uint64&      Size) const override final
     {
+        DEV_CHECK_ERR(!IsCompiling(), "Shader bytecode is not available until the shader is compiled. Use GetStatus() to check the shader status.");
         *ppBytecode = !m_SPIRV.empty() ? m_SPIRV.data() : nullptr;
         Size        = m_SPIRV.size() * sizeof(m_SPIRV[0]);
     }
 
 private:
+    void Initialize(const ShaderCreateInfo& ShaderCI,
+                    const CreateInfo&       VkShaderCI) noexcept(false);
+
     void MapHLSLVertexShaderInputs();
 
     std::shared_ptr<const SPIRVShaderResources> m_pShaderResources;
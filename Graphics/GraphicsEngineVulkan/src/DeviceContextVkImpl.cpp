@@ -279,6 +279,16 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
         return;
 
+    if (!pPipelineStateVk->IsReady())
+    {
+        // The pipeline is still being created asynchronously or has failed to initialize.
+        // Unbind the current pipeline so that the following draw and dispatch commands are skipped.
+        LOG_ERROR_MESSAGE("Pipeline state '", pPipelineStateVk->GetDesc().Name, "' is not ready and can't be bound to the context. "
+                          "Use IPipelineState::GetStatus() to check the pipeline status.");
+        m_pPipelineState.Release();
+        return;
+    }
+
     const auto& PSODesc = pPipelineStateVk->GetDesc();
 
     bool CommitStates  = false;
@@ -809,6 +819,9 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("Draw"))
+        return;
+
     DvpVerifyDrawArguments(Attribs);
 
     PrepareForDraw(Attribs.Flags);
@@ -822,6 +835,9 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DrawIndexed"))
+        return;
+
     DvpVerifyDrawIndexedArguments(Attribs);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -835,6 +851,9 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DrawIndirect"))
+        return;
+
     DvpVerifyDrawIndirectArguments(Attribs);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -870,6 +889,9 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DrawIndexedIndirect"))
+        return;
+
     DvpVerifyDrawIndexedIndirectArguments(Attribs);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -905,6 +927,9 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DrawMesh"))
+        return;
+
     DvpVerifyDrawMeshArguments(Attribs);
 
     PrepareForDraw(Attribs.Flags);
@@ -918,6 +943,9 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DrawMeshIndirect"))
+        return;
+
     DvpVerifyDrawMeshIndirectArguments(Attribs);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -990,6 +1018,9 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DispatchCompute"))
+        return;
+
     DvpVerifyDispatchArguments(Attribs);
 
     PrepareForDispatchCompute();
@@ -1003,6 +1034,9 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    if (!CheckPipelineStateIsBound("DispatchComputeIndirect"))
+        return;
+
     DvpVerifyDispatchIndirectArguments(Attribs);
 
     PrepareForDispatchCompute();
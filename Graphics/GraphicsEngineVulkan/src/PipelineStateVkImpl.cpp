@@ -631,6 +631,7 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
     const TBindIndexToDescSetIndex&                      BindIndexToDescSetIndex,
     bool                                                 bVerifyOnly,
     bool                                                 bStripReflection,
+    IThreadPool*                                         pThreadPool,
     const char*                                          PipelineName,
     TShaderResources*                                    pDvpShaderResources,
     TResourceAttibutions*                                pDvpResourceAttibutions) noexcept(false)
@@ -638,6 +639,9 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
     if (PipelineName == nullptr)
         PipelineName = "<null>";
 
+    // Shaders whose reflection information is stripped in one batch after all resources are remapped
+    std::vector<std::pair<const ShaderVkImpl*, std::vector<uint32_t>*>> StripShaders;
+
     // Verify that pipeline layout is compatible with shader resources and
     // remap resource bindings.
     for (size_t s = 0; s < ShaderStages.size(); ++s)
@@ -734,21 +738,39 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
                 });
 
             if (bStripReflection)
-            {
+                StripShaders.emplace_back(pShader, &SPIRV);
+        }
+    }
+
 #if !DILIGENT_NO_HLSL
-                // We have to strip reflection instructions to fix the following validation error:
-                //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
-                // Optimizer also performs validation and may catch problems with the byte code.
-                // NB: SPIRV offsets become INVALID after this operation.
-                auto StrippedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION);
-                if (!StrippedSPIRV.empty())
-                    SPIRV = std::move(StrippedSPIRV);
-                else
-                    LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
-#endif
+    if (!StripShaders.empty())
+    {
+        // We have to strip reflection instructions to fix the following validation error:
+        //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
+        // Optimizer also performs validation and may catch problems with the byte code.
+        // NB: SPIRV offsets become INVALID after this operation.
+        std::vector<std::vector<uint32_t>> SrcSPIRVs;
+        SrcSPIRVs.reserve(StripShaders.size());
+        for (auto& Shader : StripShaders)
+            SrcSPIRVs.emplace_back(std::move(*Shader.second));
+
+        auto StrippedSPIRVs = OptimizeSPIRVBatch(SrcSPIRVs, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION, pThreadPool);
+        VERIFY_EXPR(StrippedSPIRVs.size() == StripShaders.size());
+        for (size_t i = 0; i < StripShaders.size(); ++i)
+        {
+            auto& SPIRV = *StripShaders[i].second;
+            if (!StrippedSPIRVs[i].empty())
+            {
+                SPIRV = std::move(StrippedSPIRVs[i]);
+            }
+            else
+            {
+                SPIRV = std::move(SrcSPIRVs[i]);
+                LOG_ERROR("Failed to strip reflection information from shader '", StripShaders[i].first->GetDesc().Name, "'. This may indicate a problem with the byte code.");
             }
         }
     }
+#endif
 }
 
 void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo, TShaderStages& ShaderStages) noexcept(false)
@@ -783,6 +805,7 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
                                      BindIndexToDescSetIndex,
                                      VerifyBindings, // VerifyOnly
                                      true,           // bStripReflection
+                                     (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ? GetDevice()->GetShaderCompilationThreadPool() : nullptr,
                                      m_Desc.Name,
 #ifdef DILIGENT_DEVELOPMENT
                                      &m_ShaderResources, &m_ResourceAttibutions
@@ -793,6 +816,18 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
     }
 }
 
+template <typename PSOCreateInfoType>
+void PipelineStateVkImpl::InitPipelineDesc(const PSOCreateInfoType& CreateInfo) noexcept(false)
+{
+    FixedLinearAllocator MemPool{GetRawAllocator()};
+
+    ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
+
+    MemPool.Reserve();
+
+    InitializePipelineDesc(CreateInfo, MemPool);
+}
+
 template <typename PSOCreateInfoType>
 PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
     const PSOCreateInfoType&                           CreateInfo,
@@ -802,22 +837,90 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages);
 
-    FixedLinearAllocator MemPool{GetRawAllocator()};
+    InitPipelineLayout(CreateInfo, ShaderStages);
 
-    ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
+    // Create shader modules and initialize shader stages
+    InitPipelineShaderStages(GetDevice()->GetLogicalDevice(), ShaderStages, ShaderModules, vkShaderStages);
 
-    MemPool.Reserve();
+    return ShaderStages;
+}
 
-    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+void PipelineStateVkImpl::InitializePipeline(const GraphicsPipelineStateCreateInfo& CreateInfo) noexcept(false)
+{
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-    InitializePipelineDesc(CreateInfo, MemPool);
+    InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
 
-    InitPipelineLayout(CreateInfo, ShaderStages);
+    const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
+    CreateGraphicsPipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+}
 
-    // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+void PipelineStateVkImpl::InitializePipeline(const ComputePipelineStateCreateInfo& CreateInfo) noexcept(false)
+{
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-    return ShaderStages;
+    InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+
+    const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
+    CreateComputePipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+}
+
+template <typename PSOCreateInfoType>
+void PipelineStateVkImpl::EnqueueAsyncInitialization(IThreadPool*                    pThreadPool,
+                                                     PSOCreateInfoType               AsyncCI,
+                                                     std::initializer_list<IShader*> Shaders)
+{
+    // The task may run after the application has released the objects referenced by the create info,
+    // so make the create info only reference the data owned by this pipeline and keep strong references
+    // to the shaders and the pipeline cache.
+    AsyncCI.PSODesc = m_Desc;
+    // Resource signatures have been copied by InitializePipelineDesc()
+    AsyncCI.ResourceSignaturesCount = 0;
+    AsyncCI.ppResourceSignatures    = nullptr;
+
+    PSOCreateInternalInfo InternalCI;
+    InternalCI.Flags      = GetInternalCreateFlags(AsyncCI);
+    AsyncCI.pInternalData = nullptr;
+
+    RefCntAutoPtr<IPipelineStateCache> pPSOCache{AsyncCI.pPSOCache};
+
+    std::vector<RefCntAutoPtr<IShader>> ShaderRefs;
+    // The pipeline initialization starts after all shaders have been compiled
+    std::vector<IAsyncTask*> CompileTasks;
+    for (auto* pShader : Shaders)
+    {
+        if (pShader == nullptr)
+            continue;
+
+        ShaderRefs.emplace_back(pShader);
+        if (auto* pCompileTask = ClassPtrCast<ShaderVkImpl>(pShader)->GetCompileTask())
+            CompileTasks.push_back(pCompileTask);
+    }
+
+    EnqueueInitTask(pThreadPool, CompileTasks.data(), static_cast<Uint32>(CompileTasks.size()),
+                    [this, AsyncCI, InternalCI, ShaderRefs = std::move(ShaderRefs), pPSOCache = std::move(pPSOCache)]() {
+                        auto CreateInfo          = AsyncCI;
+                        auto InternalInfo        = InternalCI;
+                        CreateInfo.pInternalData = &InternalInfo;
+
+                        InitializePipeline(CreateInfo);
+                        m_Status.store(PIPELINE_STATE_STATUS_READY);
+                    });
+}
+
+void PipelineStateVkImpl::InitializePipelineAsync(IThreadPool* pThreadPool, const GraphicsPipelineStateCreateInfo& CreateInfo)
+{
+    GraphicsPipelineStateCreateInfo AsyncCI = CreateInfo;
+    // Input layout and render pass are owned by the pipeline
+    AsyncCI.GraphicsPipeline = GetGraphicsPipelineDesc();
+    EnqueueAsyncInitialization(pThreadPool, AsyncCI, {CreateInfo.pVS, CreateInfo.pHS, CreateInfo.pDS, CreateInfo.pGS, CreateInfo.pPS, CreateInfo.pAS, CreateInfo.pMS});
+}
+
+void PipelineStateVkImpl::InitializePipelineAsync(IThreadPool* pThreadPool, const ComputePipelineStateCreateInfo& CreateInfo)
+{
+    EnqueueAsyncInitialization(pThreadPool, CreateInfo, {CreateInfo.pCS});
 }
 
 PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const GraphicsPipelineStateCreateInfo& CreateInfo) :
@@ -825,13 +928,18 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        InitPipelineDesc(CreateInfo);
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+        auto* pThreadPool = (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ? pDeviceVk->GetShaderCompilationThreadPool() : nullptr;
+        if (pThreadPool != nullptr)
+        {
+            InitializePipelineAsync(pThreadPool, CreateInfo);
+        }
+        else
+        {
+            InitializePipeline(CreateInfo);
+            m_Status.store(PIPELINE_STATE_STATUS_READY);
+        }
     }
     catch (...)
     {
@@ -845,13 +953,18 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        InitPipelineDesc(CreateInfo);
 
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+        auto* pThreadPool = (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ? pDeviceVk->GetShaderCompilationThreadPool() : nullptr;
+        if (pThreadPool != nullptr)
+        {
+            InitializePipelineAsync(pThreadPool, CreateInfo);
+        }
+        else
+        {
+            InitializePipeline(CreateInfo);
+            m_Status.store(PIPELINE_STATE_STATUS_READY);
+        }
     }
     catch (...)
     {
@@ -870,6 +983,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
         std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
         std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
+        InitPipelineDesc(CreateInfo);
+
         const auto ShaderStages   = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
         const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
         const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
@@ -882,6 +997,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
         auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(vkShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
         (void)err;
+
+        // Ray tracing pipelines are always created synchronously
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
     }
     catch (...)
     {
@@ -892,6 +1010,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 
 PipelineStateVkImpl::~PipelineStateVkImpl()
 {
+    // Wait for the asynchronous initialization task that references this object
+    GetStatus(true);
+
     Destruct();
 }
 
@@ -940,9 +1061,11 @@ void PipelineStateVkImpl::DvpValidateResourceLimits() const
     std::array<std::array<Uint32, DescCount>, MAX_SHADERS_IN_PIPELINE> PerStageDescriptorCount = {};
     std::array<bool, MAX_SHADERS_IN_PIPELINE>                          ShaderStagePresented    = {};
 
-    for (Uint32 s = 0; s < GetResourceSignatureCount(); ++s)
+    // This method is called by the initialization task, so it must not use GetResourceSignature()
+    // that waits for the task to complete.
+    for (Uint32 s = 0; s < m_SignatureCount; ++s)
     {
-        const auto* pSignature = GetResourceSignature(s);
+        const auto* pSignature = m_Signatures[s].RawPtr();
         if (pSignature == nullptr)
             continue;
 
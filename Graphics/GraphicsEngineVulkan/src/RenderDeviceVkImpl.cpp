@@ -599,6 +599,8 @@ void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
         GetVkVersion(),
         GetLogicalDevice().GetEnabledExtFeatures().Spirv14,
         ppCompilerOutput,
+        (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 ? GetShaderCompilationThreadPool() : nullptr,
+        nullptr, // pBytecodeCache
     };
     CreateShaderImpl(ppShader, ShaderCI, VkShaderCI);
 }
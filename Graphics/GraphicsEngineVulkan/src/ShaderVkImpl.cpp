@@ -71,7 +71,7 @@ std::vector<uint32_t> CompileShaderDXC(const ShaderCreateInfo&         ShaderCI,
     auto* pDXCompiler = VkShaderCI.pDXCompiler;
     VERIFY_EXPR(pDXCompiler != nullptr && pDXCompiler->IsLoaded());
     std::vector<uint32_t> SPIRV;
-    pDXCompiler->Compile(ShaderCI, ShaderCI.HLSLVersion, VulkanDefine, nullptr, &SPIRV, VkShaderCI.ppCompilerOutput);
+    pDXCompiler->Compile(ShaderCI, ShaderCI.HLSLVersion, VulkanDefine, nullptr, &SPIRV, VkShaderCI.ppCompilerOutput, VkShaderCI.pBytecodeCache);
 
 #if !DILIGENT_NO_HLSL
     // SPIR-V bytecode generated from HLSL must be legalized to
@@ -97,7 +97,7 @@ std::vector<uint32_t> CompileShaderGLSLang(const ShaderCreateInfo&         Shade
 #else
     if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
     {
-        SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, VulkanDefine, VkShaderCI.ppCompilerOutput);
+        SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, VulkanDefine, VkShaderCI.ppCompilerOutput, VkShaderCI.pBytecodeCache);
     }
     else
     {
@@ -132,6 +132,7 @@ std::vector<uint32_t> CompileShaderGLSLang(const ShaderCreateInfo&         Shade
         Attribs.AssignBindings             = true;
         Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
         Attribs.ppCompilerOutput           = VkShaderCI.ppCompilerOutput;
+        Attribs.pBytecodeCache             = VkShaderCI.pBytecodeCache;
 
         if (VkShaderCI.VkVersion >= VK_API_VERSION_1_2)
             Attribs.Version = GLSLangUtils::SpirvVersion::Vk120;
@@ -163,6 +164,26 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
         IsDeviceInternal
     }
 // clang-format on
+{
+    if (IsAsyncCompilationRequested(ShaderCI, VkShaderCI.pCompilationThreadPool, VkShaderCI.ppCompilerOutput))
+    {
+        // The create info must be copied as it will be used after the constructor returns.
+        // Device info and adapter info are referenced from the render device, which outlives the shader.
+        EnqueueCompileTask(VkShaderCI.pCompilationThreadPool,
+                           [this,
+                            ShaderCI   = ShaderCreateInfoWrapper{ShaderCI, GetRawAllocator()},
+                            VkShaderCI = VkShaderCI]() {
+                               Initialize(ShaderCI, VkShaderCI);
+                           });
+    }
+    else
+    {
+        Initialize(ShaderCI, VkShaderCI);
+    }
+}
+
+void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI,
+                              const CreateInfo&       VkShaderCI) noexcept(false)
 {
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
@@ -242,6 +263,8 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     {
         m_EntryPoint = ShaderCI.EntryPoint;
     }
+
+    m_Status.store(SHADER_STATUS_READY);
 }
 
 void ShaderVkImpl::MapHLSLVertexShaderInputs()
@@ -277,6 +300,8 @@ void ShaderVkImpl::MapHLSLVertexShaderInputs()
 
 ShaderVkImpl::~ShaderVkImpl()
 {
+    // Make sure that the asynchronous compilation task, which references this object, is complete
+    GetStatus(/*WaitForCompletion = */ true);
 }
 
 void ShaderVkImpl::GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const
@@ -162,6 +162,13 @@ struct BufferSuballocatorCreateInfo
     ///             to true, the validation is disabled.
     ///             The flag is ignored in release builds as the validation is always disabled.
     bool DisableDebugValidation = false;
+
+    /// Whether to manage free buffer regions with the two-level segregated fit (TLSF) algorithm.
+
+    /// \remarks    TLSF allocation and deallocation take constant time, while the default
+    ///             ordered maps take logarithmic time in the number of free regions.
+    ///             TLSF may pick a slightly larger free region than the best fit.
+    bool UseTLSF = false;
 };
 
 /// Creates a new buffer suballocator.
@@ -35,6 +35,28 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 struct BytecodeCacheCreateInfo
 {
     enum RENDER_DEVICE_TYPE DeviceType DEFAULT_INITIALIZER(RENDER_DEVICE_TYPE_UNDEFINED);
+
+    /// An optional path to the directory where the cache stores the byte code on disk.
+
+    /// \remarks   Every byte code is written to a separate file in this directory and is
+    ///             loaded back on the first request, which allows multiple processes (e.g.
+    ///             consecutive archive builds) to share compiled shaders.
+    ///             The directory is created if it does not exist.
+    const Char* DirectoryPath DEFAULT_INITIALIZER(nullptr);
+
+    /// The maximum total size, in bytes, of the byte code files in the cache directory.
+
+    /// \remarks   When the limit is exceeded, the least recently used files are deleted.
+    ///             Zero means there is no limit.
+    Uint64 MaxDirectorySize DEFAULT_INITIALIZER(0);
+
+    /// The maximum total size, in bytes, of the byte code kept in memory.
+
+    /// \remarks   When the limit is exceeded, the least recently used byte code is removed
+    ///             from memory. If the cache directory is used, the byte code is read back from
+    ///             the file on the next request.
+    ///             Zero means there is no limit.
+    Uint64 MaxMemorySize DEFAULT_INITIALIZER(0);
 };
 typedef struct BytecodeCacheCreateInfo BytecodeCacheCreateInfo;
 
@@ -90,6 +112,41 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
     VIRTUAL void METHOD(RemoveBytecode)(THIS_ 
                                         const ShaderCreateInfo REF ShaderCI) PURE;
 
+    /// Returns the byte code for the given content key.
+
+    /// \param [in]  pKey       - A pointer to the key data, for example the preprocessed
+    ///                           shader source combined with the compiler options.
+    /// \param [in]  KeySize    - The size of the key data, in bytes.
+    /// \param [out] ppByteCode - Address of the memory location where a pointer to the
+    ///                           data blob containing the byte code will be written.
+    ///                           The function calls AddRef(), so that the new object will have
+    ///                           one reference.
+    ///
+    /// \remarks    Shader compilers use this method to look up the byte code before compiling
+    ///             the shader. Only the hash of the key is stored in the cache.
+    VIRTUAL void METHOD(GetBytecodeByKey)(THIS_
+                                          const void* pKey,
+                                          size_t      KeySize,
+                                          IDataBlob** ppByteCode) PURE;
+
+    /// Adds the byte code for the given content key to the cache.
+
+    /// \param [in] pKey      - A pointer to the key data.
+    /// \param [in] KeySize   - The size of the key data, in bytes.
+    /// \param [in] pByteCode - A pointer to the byte code to add to the cache.
+    VIRTUAL void METHOD(AddBytecodeByKey)(THIS_
+                                          const void* pKey,
+                                          size_t      KeySize,
+                                          IDataBlob*  pByteCode) PURE;
+
+    /// Removes the byte code for the given content key from the cache.
+
+    /// \param [in] pKey    - A pointer to the key data.
+    /// \param [in] KeySize - The size of the key data, in bytes.
+    VIRTUAL void METHOD(RemoveBytecodeByKey)(THIS_
+                                             const void* pKey,
+                                             size_t      KeySize) PURE;
+
     /// Writes the cache data to the binary data blob.
 
     /// \param [out] ppDataBlob - Address of the memory location where a pointer to the
@@ -98,11 +155,14 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
     ///                           one reference.
     ///
     /// \remarks    The data produced by this method is intended to be used by the Load method.
+    ///             Byte code that is only present in the cache directory is not included.
     VIRTUAL void METHOD(Store)(THIS_
                                IDataBlob** ppDataBlob) PURE;
 
 
     /// Clears the cache and resets it to default state.
+
+    /// \remarks    If the cache uses a directory, all byte code files in it are deleted.
     VIRTUAL void METHOD(Clear)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
@@ -112,12 +172,15 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 // clang-format off
-#    define IBytecodeCache_Load(This, ...)           CALL_IFACE_METHOD(BytecodeCache, Load,           This, __VA_ARGS__)
-#    define IBytecodeCache_GetBytecode(This, ...)    CALL_IFACE_METHOD(BytecodeCache, GetBytecode,    This, __VA_ARGS__)
-#    define IBytecodeCache_AddBytecode(This, ...)    CALL_IFACE_METHOD(BytecodeCache, AddBytecode,    This, __VA_ARGS__)
-#    define IBytecodeCache_RemoveBytecode(This, ...) CALL_IFACE_METHOD(BytecodeCache, RemoveBytecode, This, __VA_ARGS__)
-#    define IBytecodeCache_Store(This, ...)          CALL_IFACE_METHOD(BytecodeCache, Store,          This, __VA_ARGS__)
-#    define IBytecodeCache_Clear(This)               CALL_IFACE_METHOD(BytecodeCache, Clear,          This)
+#    define IBytecodeCache_Load(This, ...)                CALL_IFACE_METHOD(BytecodeCache, Load,                This, __VA_ARGS__)
+#    define IBytecodeCache_GetBytecode(This, ...)         CALL_IFACE_METHOD(BytecodeCache, GetBytecode,         This, __VA_ARGS__)
+#    define IBytecodeCache_AddBytecode(This, ...)         CALL_IFACE_METHOD(BytecodeCache, AddBytecode,         This, __VA_ARGS__)
+#    define IBytecodeCache_RemoveBytecode(This, ...)      CALL_IFACE_METHOD(BytecodeCache, RemoveBytecode,      This, __VA_ARGS__)
+#    define IBytecodeCache_GetBytecodeByKey(This, ...)    CALL_IFACE_METHOD(BytecodeCache, GetBytecodeByKey,    This, __VA_ARGS__)
+#    define IBytecodeCache_AddBytecodeByKey(This, ...)    CALL_IFACE_METHOD(BytecodeCache, AddBytecodeByKey,    This, __VA_ARGS__)
+#    define IBytecodeCache_RemoveBytecodeByKey(This, ...) CALL_IFACE_METHOD(BytecodeCache, RemoveBytecodeByKey, This, __VA_ARGS__)
+#    define IBytecodeCache_Store(This, ...)               CALL_IFACE_METHOD(BytecodeCache, Store,               This, __VA_ARGS__)
+#    define IBytecodeCache_Clear(This)                    CALL_IFACE_METHOD(BytecodeCache, Clear,               This)
 // clang-format on
 
 #endif
@@ -69,6 +69,29 @@ struct RenderStateCacheCreateInfo
     /// shaders. If null, original source factory will be used.
     IShaderSourceInputStreamFactory* pReloadSource DEFAULT_INITIALIZER(nullptr);
 
+    /// Optional path to the journal file.
+    ///
+    /// If not null, the cache works in persistent mode: the journal is loaded when
+    /// the cache is created, and every new shader and pipeline state is appended
+    /// to the journal as soon as it is created. The application does not need to
+    /// call WriteToBlob() or WriteToStream() to save the cache in this mode.
+    ///
+    /// \note   The journal file is memory-mapped, so that only the data of the render
+    ///         states that are actually requested are read from the disk.
+    const Char* JournalFilePath DEFAULT_INITIALIZER(nullptr);
+
+    /// The version of the content in the journal file.
+    /// If the journal was written with a different version, it is discarded.
+    Uint32 JournalContentVersion DEFAULT_INITIALIZER(0);
+
+    /// The number of records in the journal file that triggers compaction.
+    ///
+    /// Every shader or pipeline state appended to the journal adds a new record.
+    /// If the journal contains at least this many records when the cache is created,
+    /// all records are merged into one and the file is rewritten.
+    /// If this value is zero, the journal is never compacted.
+    Uint32 JournalCompactionThreshold DEFAULT_INITIALIZER(64);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr RenderStateCacheCreateInfo() noexcept
     {}
@@ -87,6 +110,32 @@ struct RenderStateCacheCreateInfo
 };
 typedef struct RenderStateCacheCreateInfo RenderStateCacheCreateInfo;
 
+/// Render state cache statistics, see IRenderStateCache::GetStats.
+struct RenderStateCacheStats
+{
+    /// The number of shaders that were found in the cache.
+    Uint32 NumShaderHits DEFAULT_INITIALIZER(0);
+
+    /// The number of shaders that were not found in the cache.
+    Uint32 NumShaderMisses DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that were found in the cache.
+    Uint32 NumPipelineHits DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that were not found in the cache.
+    Uint32 NumPipelineMisses DEFAULT_INITIALIZER(0);
+
+    /// The number of records in the journal file.
+    Uint32 NumJournalRecords DEFAULT_INITIALIZER(0);
+
+    /// The size of the journal file when the cache was created, in bytes.
+    Uint64 JournalBytesLoaded DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes appended to the journal file since the cache was created.
+    Uint64 JournalBytesWritten DEFAULT_INITIALIZER(0);
+};
+typedef struct RenderStateCacheStats RenderStateCacheStats;
+
 #if DILIGENT_C_INTERFACE
 #    define REF *
 #else
@@ -245,6 +294,11 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
     /// Returns the content version of the cache data.
     /// If no data has been loaded, returns ~0u (aka 0xFFFFFFFF).
     VIRTUAL Uint32 METHOD(GetContentVersion)(THIS) CONST PURE;
+
+    /// Returns the cache statistics, see Diligent::RenderStateCacheStats.
+
+    /// \note  Hit and miss counters are reset by the Reset() method.
+    VIRTUAL RenderStateCacheStats METHOD(GetStats)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -264,6 +318,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderStateCache_Reset(This)                              CALL_IFACE_METHOD(RenderStateCache, Reset,                        This)
 #    define IRenderStateCache_Reload(This, ...)                        CALL_IFACE_METHOD(RenderStateCache, Reload,                       This, __VA_ARGS__)
 #    define IRenderStateCache_GetContentVersion(This)                  CALL_IFACE_METHOD(RenderStateCache, GetContentVersion,            This)
+#    define IRenderStateCache_GetStats(This)                           CALL_IFACE_METHOD(RenderStateCache, GetStats,                     This)
 // clang-format on
 
 #endif
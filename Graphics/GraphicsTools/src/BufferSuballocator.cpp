@@ -134,7 +134,8 @@ public:
             {
                 DefaultRawMemoryAllocator::GetAllocator(),
                 StaticCast<size_t>(CreateInfo.Desc.Size),
-                CreateInfo.DisableDebugValidation
+                CreateInfo.DisableDebugValidation,
+                CreateInfo.UseTLSF
             }
         },
         m_MgrSize{m_Mgr.GetMaxSize()},
@@ -25,6 +25,12 @@
  */
 
 #include <unordered_map>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <cstdio>
 
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
@@ -33,6 +39,8 @@
 #include "BytecodeCache.h"
 #include "XXH128Hasher.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
 
 namespace Diligent
 {
@@ -72,12 +80,37 @@ public:
         }
     };
 
+    // Every file in the cache directory contains a single-element cache written in the same
+    // format as the data produced by Store().
+    static constexpr char   FileExtension[]  = ".bin";
+    static constexpr char   TempExtension[]  = ".tmp";
+    static constexpr size_t FileHeaderSize   = sizeof(Uint32) * 2 + sizeof(Uint64) + sizeof(Uint64) * 2 + sizeof(size_t);
+    static constexpr size_t HashStringLength = 32;
+
+    struct FileInfo
+    {
+        size_t                          Size = 0;
+        std::list<XXH128Hash>::iterator LRUPos;
+    };
+    using FileMapType = std::unordered_map<XXH128Hash, FileInfo>;
+
+    struct MemoryEntry
+    {
+        RefCntAutoPtr<IDataBlob>        pBytecode;
+        std::list<XXH128Hash>::iterator LRUPos;
+    };
+    using MemoryMapType = std::unordered_map<XXH128Hash, MemoryEntry>;
+
 public:
     BytecodeCacheImpl(IReferenceCounters*            pRefCounters,
                       const BytecodeCacheCreateInfo& CreateInfo) :
         TBase{pRefCounters},
-        m_DeviceType{CreateInfo.DeviceType}
+        m_DeviceType{CreateInfo.DeviceType},
+        m_MaxMemorySize{CreateInfo.MaxMemorySize},
+        m_MaxDirectorySize{CreateInfo.MaxDirectorySize}
     {
+        if (CreateInfo.DirectoryPath != nullptr && CreateInfo.DirectoryPath[0] != '\0')
+            InitDirectory(CreateInfo.DirectoryPath);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BytecodeCache, TBase);
@@ -106,6 +139,7 @@ public:
             return false;
         }
 
+        std::lock_guard<std::mutex> Lock{m_Mtx};
         for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
         {
             BytecodeCacheElementHeader ElementHeader;
@@ -113,7 +147,7 @@ public:
 
             auto pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
             Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
-            m_HashMap.emplace(ElementHeader.Hash, pBytecode);
+            AddToMemory(ElementHeader.Hash, pBytecode);
         }
 
         return true;
@@ -123,28 +157,39 @@ public:
     {
         DEV_CHECK_ERR(ppByteCode != nullptr, "ppByteCode must not be null.");
         DEV_CHECK_ERR(*ppByteCode == nullptr, "*ppByteCode is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
-        const auto Hash = ComputeHash(ShaderCI);
-        const auto Iter = m_HashMap.find(Hash);
-        if (Iter != m_HashMap.end())
-        {
-            auto pObject = Iter->second;
-            *ppByteCode  = pObject.Detach();
-        }
+        *ppByteCode = FindBytecode(ComputeHash(ShaderCI)).Detach();
     }
 
     virtual void DILIGENT_CALL_TYPE AddBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob* pByteCode) override final
     {
         DEV_CHECK_ERR(pByteCode != nullptr, "pByteCode must not be null.");
-        const auto Hash = ComputeHash(ShaderCI);
-        const auto Iter = m_HashMap.emplace(Hash, pByteCode);
-        if (!Iter.second)
-            Iter.first->second = pByteCode;
+        AddBytecode(ComputeHash(ShaderCI), pByteCode);
     }
 
     virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
     {
-        const auto Hash = ComputeHash(ShaderCI);
-        m_HashMap.erase(Hash);
+        RemoveBytecode(ComputeHash(ShaderCI));
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetBytecodeByKey(const void* pKey, size_t KeySize, IDataBlob** ppByteCode) override final
+    {
+        DEV_CHECK_ERR(pKey != nullptr && KeySize != 0, "The key must not be empty.");
+        DEV_CHECK_ERR(ppByteCode != nullptr, "ppByteCode must not be null.");
+        DEV_CHECK_ERR(*ppByteCode == nullptr, "*ppByteCode is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
+        *ppByteCode = FindBytecode(ComputeHash(pKey, KeySize)).Detach();
+    }
+
+    virtual void DILIGENT_CALL_TYPE AddBytecodeByKey(const void* pKey, size_t KeySize, IDataBlob* pByteCode) override final
+    {
+        DEV_CHECK_ERR(pKey != nullptr && KeySize != 0, "The key must not be empty.");
+        DEV_CHECK_ERR(pByteCode != nullptr, "pByteCode must not be null.");
+        AddBytecode(ComputeHash(pKey, KeySize), pByteCode);
+    }
+
+    virtual void DILIGENT_CALL_TYPE RemoveBytecodeByKey(const void* pKey, size_t KeySize) override final
+    {
+        DEV_CHECK_ERR(pKey != nullptr && KeySize != 0, "The key must not be empty.");
+        RemoveBytecode(ComputeHash(pKey, KeySize));
     }
 
     virtual void DILIGENT_CALL_TYPE Store(IDataBlob** ppDataBlob) override final
@@ -152,6 +197,8 @@ public:
         DEV_CHECK_ERR(ppDataBlob != nullptr, "ppDataBlob must not be null.");
         DEV_CHECK_ERR(*ppDataBlob == nullptr, "*ppDataBlob is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
 
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
         auto WriteData = [&](auto& Stream) //
         {
             BytecodeCacheHeader Header{};
@@ -159,18 +206,61 @@ public:
             Header.Serialize(Stream);
 
             for (auto const& Pair : m_HashMap)
-            {
-                const auto& pBytecode = Pair.second;
+                WriteElement(Stream, Pair.first, Pair.second.pBytecode);
+        };
 
-                BytecodeCacheElementHeader ElementHeader;
-                ElementHeader.Hash     = Pair.first;
-                ElementHeader.DataSize = pBytecode->GetSize();
-                ElementHeader.Serialize(Stream);
+        *ppDataBlob = SerializeToBlob(WriteData).Detach();
+    }
 
-                Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
-            }
-        };
+    virtual void DILIGENT_CALL_TYPE Clear() override final
+    {
+        std::vector<std::string> FilesToDelete;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            m_HashMap.clear();
+            m_MemoryLRU.clear();
+            m_MemorySize = 0;
+
+            for (const auto& File : m_Files)
+                FilesToDelete.emplace_back(GetFilePath(File.first));
+            m_Files.clear();
+            m_FileLRU.clear();
+            m_DirectorySize = 0;
+        }
+        DeleteFiles(FilesToDelete);
+    }
+
+private:
+    XXH128Hash ComputeHash(const ShaderCreateInfo& ShaderCI) const
+    {
+        XXH128State Hasher;
+        Hasher.Update(ShaderCI, m_DeviceType);
+        return Hasher.Digest();
+    }
+
+    XXH128Hash ComputeHash(const void* pKey, size_t KeySize) const
+    {
+        XXH128State Hasher;
+        Hasher.UpdateRaw(pKey, KeySize);
+        Hasher.Update(m_DeviceType);
+        return Hasher.Digest();
+    }
 
+    template <typename SerType>
+    static void WriteElement(SerType& Stream, const XXH128Hash& Hash, IDataBlob* pBytecode)
+    {
+        BytecodeCacheElementHeader ElementHeader;
+        ElementHeader.Hash     = Hash;
+        ElementHeader.DataSize = pBytecode->GetSize();
+        ElementHeader.Serialize(Stream);
+
+        Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
+    }
+
+    template <typename WriteDataType>
+    static RefCntAutoPtr<IDataBlob> SerializeToBlob(WriteDataType& WriteData)
+    {
         Serializer<SerializerMode::Measure> MeasureStream{};
         WriteData(MeasureStream);
 
@@ -180,28 +270,368 @@ public:
         WriteData(WriteStream);
         VERIFY_EXPR(WriteStream.IsEnded());
 
-        *ppDataBlob = DataBlobImpl::Create(Memory.Size(), Memory.Ptr()).Detach();
+        return DataBlobImpl::Create(Memory.Size(), Memory.Ptr());
     }
 
-    virtual void DILIGENT_CALL_TYPE Clear() override final
+    // File operations are performed without holding the mutex, so that threads that
+    // find the byte code in memory are not blocked by other threads reading or writing files.
+    RefCntAutoPtr<IDataBlob> FindBytecode(const XXH128Hash& Hash)
     {
-        m_HashMap.clear();
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            const auto Iter = m_HashMap.find(Hash);
+            if (Iter != m_HashMap.end())
+            {
+                m_MemoryLRU.splice(m_MemoryLRU.end(), m_MemoryLRU, Iter->second.LRUPos);
+                TouchBytecodeFile(Hash);
+                return Iter->second.pBytecode;
+            }
+
+            if (m_Files.find(Hash) == m_Files.end())
+                return {};
+        }
+
+        bool IsCorrupted = false;
+        auto pBytecode   = ReadBytecodeFile(Hash, IsCorrupted);
+
+        std::vector<std::string> FilesToDelete;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            if (pBytecode)
+            {
+                // Another thread may have added the byte code while the file was being read
+                const auto Iter = m_HashMap.find(Hash);
+                if (Iter != m_HashMap.end())
+                    pBytecode = Iter->second.pBytecode;
+                else
+                    AddToMemory(Hash, pBytecode);
+                TouchBytecodeFile(Hash);
+            }
+            else
+            {
+                // The file may have been deleted by another thread or process
+                auto FileIt = m_Files.find(Hash);
+                if (FileIt != m_Files.end())
+                    RemoveFileEntry(FileIt, IsCorrupted ? &FilesToDelete : nullptr);
+            }
+        }
+        DeleteFiles(FilesToDelete);
+
+        return pBytecode;
     }
 
-private:
-    XXH128Hash ComputeHash(const ShaderCreateInfo& ShaderCI) const
+    void AddBytecode(const XXH128Hash& Hash, IDataBlob* pByteCode)
     {
-        XXH128State Hasher;
-        Hasher.Update(ShaderCI, m_DeviceType);
-        return Hasher.Digest();
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            AddToMemory(Hash, pByteCode);
+        }
+
+        WriteBytecodeFile(Hash, pByteCode);
+    }
+
+    void RemoveBytecode(const XXH128Hash& Hash)
+    {
+        std::vector<std::string> FilesToDelete;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            auto Iter = m_HashMap.find(Hash);
+            if (Iter != m_HashMap.end())
+                RemoveFromMemory(Iter);
+
+            auto FileIt = m_Files.find(Hash);
+            if (FileIt != m_Files.end())
+                RemoveFileEntry(FileIt, &FilesToDelete);
+        }
+        DeleteFiles(FilesToDelete);
+    }
+
+    // The following methods must be called with the mutex locked
+
+    void AddToMemory(const XXH128Hash& Hash, IDataBlob* pBytecode)
+    {
+        auto Iter = m_HashMap.find(Hash);
+        if (Iter != m_HashMap.end())
+        {
+            m_MemorySize -= Iter->second.pBytecode->GetSize();
+            Iter->second.pBytecode = pBytecode;
+            m_MemoryLRU.splice(m_MemoryLRU.end(), m_MemoryLRU, Iter->second.LRUPos);
+        }
+        else
+        {
+            m_MemoryLRU.push_back(Hash);
+            m_HashMap.emplace(Hash, MemoryEntry{RefCntAutoPtr<IDataBlob>{pBytecode}, std::prev(m_MemoryLRU.end())});
+        }
+        m_MemorySize += pBytecode->GetSize();
+
+        if (m_MaxMemorySize != 0)
+        {
+            // Byte code that is also stored in the directory will be read back on the next request
+            while (m_MemorySize > m_MaxMemorySize && !m_MemoryLRU.empty())
+                RemoveFromMemory(m_HashMap.find(m_MemoryLRU.front()));
+        }
+    }
+
+    void RemoveFromMemory(MemoryMapType::iterator Iter)
+    {
+        m_MemorySize -= Iter->second.pBytecode->GetSize();
+        m_MemoryLRU.erase(Iter->second.LRUPos);
+        m_HashMap.erase(Iter);
+    }
+
+    void TouchBytecodeFile(const XXH128Hash& Hash)
+    {
+        auto FileIt = m_Files.find(Hash);
+        if (FileIt != m_Files.end())
+            m_FileLRU.splice(m_FileLRU.end(), m_FileLRU, FileIt->second.LRUPos);
+    }
+
+    // Removes the file from the directory bookkeeping. If pFilesToDelete is not null, the file
+    // path is added to the list of files that the caller deletes after unlocking the mutex.
+    void RemoveFileEntry(FileMapType::iterator FileIt, std::vector<std::string>* pFilesToDelete)
+    {
+        if (pFilesToDelete != nullptr)
+            pFilesToDelete->emplace_back(GetFilePath(FileIt->first));
+        m_DirectorySize -= FileIt->second.Size;
+        m_FileLRU.erase(FileIt->second.LRUPos);
+        m_Files.erase(FileIt);
+    }
+
+    void EnforceDirectorySize(std::vector<std::string>& FilesToDelete)
+    {
+        if (m_MaxDirectorySize == 0)
+            return;
+
+        while (m_DirectorySize > m_MaxDirectorySize && !m_FileLRU.empty())
+        {
+            // Only the file is deleted: the byte code remains available in memory unless it is evicted
+            RemoveFileEntry(m_Files.find(m_FileLRU.front()), &FilesToDelete);
+        }
+    }
+
+    static void DeleteFiles(const std::vector<std::string>& FilesToDelete)
+    {
+        for (const auto& FilePath : FilesToDelete)
+            FileSystem::DeleteFile(FilePath.c_str());
+    }
+
+    static std::string HashToString(const XXH128Hash& Hash)
+    {
+        static constexpr char Symbols[] = "0123456789ABCDEF";
+
+        std::string Str;
+        for (auto Part : {Hash.HighPart, Hash.LowPart})
+        {
+            for (Uint64 i = 0; i < 16; ++i)
+                Str += Symbols[(Part >> (Uint64{60} - i * 4)) & 0xFu];
+        }
+        return Str;
+    }
+
+    static bool StringToHash(const char* Str, XXH128Hash& Hash)
+    {
+        Uint64 Parts[2] = {};
+        for (size_t i = 0; i < HashStringLength; ++i)
+        {
+            const auto c = Str[i];
+
+            Uint64 Digit = 0;
+            if (c >= '0' && c <= '9')
+                Digit = c - '0';
+            else if (c >= 'A' && c <= 'F')
+                Digit = c - 'A' + 10;
+            else
+                return false;
+
+            auto& Part = Parts[i / 16];
+            Part       = (Part << 4u) | Digit;
+        }
+        Hash.HighPart = Parts[0];
+        Hash.LowPart  = Parts[1];
+        return true;
+    }
+
+    std::string GetFilePath(const XXH128Hash& Hash) const
+    {
+        return m_Directory + HashToString(Hash) + FileExtension;
+    }
+
+    void InitDirectory(const char* DirectoryPath)
+    {
+        m_Directory = DirectoryPath;
+        if (!FileSystem::PathExists(m_Directory.c_str()) && !FileSystem::CreateDirectory(m_Directory.c_str()))
+        {
+            LOG_ERROR_MESSAGE("Failed to create bytecode cache directory '", m_Directory, "'. The byte code will not be stored on disk.");
+            m_Directory.clear();
+            return;
+        }
+        if (!FileSystem::IsSlash(m_Directory.back()))
+            m_Directory.push_back(FileSystem::SlashSymbol);
+
+        // The directory does not record when the files were last used, so the files found
+        // at start-up are evicted first, in no particular order.
+        const auto SearchRes = FileSystem::Search((m_Directory + '*' + FileExtension).c_str());
+        for (const auto& FileData : SearchRes)
+        {
+            if (FileData->IsDirectory())
+                continue;
+
+            const char* Name = FileData->Name();
+            XXH128Hash  Hash;
+            if (strlen(Name) != HashStringLength + sizeof(FileExtension) - 1 || !StringToHash(Name, Hash))
+                continue;
+
+            FileWrapper File{GetFilePath(Hash).c_str()};
+            if (!File)
+                continue;
+
+            const auto Size = File->GetSize();
+            m_FileLRU.push_back(Hash);
+            m_Files.emplace(Hash, FileInfo{Size, std::prev(m_FileLRU.end())});
+            m_DirectorySize += Size;
+        }
+
+        std::vector<std::string> FilesToDelete;
+        EnforceDirectorySize(FilesToDelete);
+        DeleteFiles(FilesToDelete);
+    }
+
+    // Reads the byte code from the file. Sets IsCorrupted to true if the file exists, but
+    // does not contain valid byte code.
+    RefCntAutoPtr<IDataBlob> ReadBytecodeFile(const XXH128Hash& Hash, bool& IsCorrupted) const
+    {
+        IsCorrupted = false;
+
+        const auto FilePath = GetFilePath(Hash);
+        // The file may have been evicted by another thread after the mutex was released
+        if (!FileSystem::FileExists(FilePath.c_str()))
+            return {};
+
+        auto pFileData = DataBlobImpl::Create();
+        {
+            FileWrapper File{FilePath.c_str()};
+            if (!File || !File->Read(pFileData))
+                return {};
+        }
+
+        // Files are replaced atomically, but the contents may still be corrupted, e.g. by a disk error
+        if (pFileData->GetSize() >= FileHeaderSize)
+        {
+            Serializer<SerializerMode::Read> Stream{SerializedData{pFileData->GetDataPtr(), pFileData->GetSize()}};
+
+            BytecodeCacheHeader        Header;
+            BytecodeCacheElementHeader ElementHeader;
+            Header.Serialize(Stream);
+            ElementHeader.Serialize(Stream);
+            if (Header.Magic == BytecodeCacheHeader::HeaderMagic &&
+                Header.Version == BytecodeCacheHeader::HeaderVersion &&
+                Header.ElementCount == 1 &&
+                ElementHeader.Hash == Hash &&
+                ElementHeader.DataSize == Stream.GetRemainingSize())
+            {
+                return DataBlobImpl::Create(ElementHeader.DataSize, Stream.GetCurrentPtr());
+            }
+        }
+
+        LOG_WARNING_MESSAGE("Bytecode cache file '", FilePath, "' is corrupted and will be deleted.");
+        IsCorrupted = true;
+        return {};
+    }
+
+    void WriteBytecodeFile(const XXH128Hash& Hash, IDataBlob* pByteCode)
+    {
+        if (m_Directory.empty())
+            return;
+
+        auto WriteData = [&](auto& Stream) //
+        {
+            BytecodeCacheHeader Header{};
+            Header.ElementCount = 1;
+            Header.Serialize(Stream);
+            WriteElement(Stream, Hash, pByteCode);
+        };
+        const auto pFileData = SerializeToBlob(WriteData);
+
+        // The data is written to a temporary file that is then renamed, so that other threads
+        // and processes never see a partially written file. The file name is unique for
+        // every write, so that concurrent writes of the same byte code do not interfere.
+        const auto FilePath = GetFilePath(Hash);
+        const auto TempPath = m_Directory + HashToString(Hash) + '.' + std::to_string(m_NextTempFileId.fetch_add(1)) + TempExtension;
+        {
+            FileWrapper File{TempPath.c_str(), EFileAccessMode::Overwrite};
+            if (!File || !File->Write(pFileData->GetConstDataPtr(), pFileData->GetSize()))
+            {
+                LOG_ERROR_MESSAGE("Failed to write bytecode cache file '", TempPath, "'.");
+                File.Close();
+                FileSystem::DeleteFile(TempPath.c_str());
+                return;
+            }
+        }
+
+        if (std::rename(TempPath.c_str(), FilePath.c_str()) != 0)
+        {
+            // On Windows, rename fails if the destination file exists
+            FileSystem::DeleteFile(FilePath.c_str());
+            if (std::rename(TempPath.c_str(), FilePath.c_str()) != 0)
+            {
+                LOG_ERROR_MESSAGE("Failed to rename bytecode cache file '", TempPath, "' to '", FilePath, "'.");
+                FileSystem::DeleteFile(TempPath.c_str());
+                return;
+            }
+        }
+
+        std::vector<std::string> FilesToDelete;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            auto FileIt = m_Files.find(Hash);
+            if (FileIt != m_Files.end())
+            {
+                m_DirectorySize -= FileIt->second.Size;
+                FileIt->second.Size = pFileData->GetSize();
+                m_FileLRU.splice(m_FileLRU.end(), m_FileLRU, FileIt->second.LRUPos);
+            }
+            else
+            {
+                m_FileLRU.push_back(Hash);
+                m_Files.emplace(Hash, FileInfo{pFileData->GetSize(), std::prev(m_FileLRU.end())});
+            }
+            m_DirectorySize += pFileData->GetSize();
+
+            EnforceDirectorySize(FilesToDelete);
+        }
+        DeleteFiles(FilesToDelete);
     }
 
 private:
-    RENDER_DEVICE_TYPE m_DeviceType;
+    const RENDER_DEVICE_TYPE m_DeviceType;
+    const Uint64             m_MaxMemorySize;
+    const Uint64             m_MaxDirectorySize;
 
-    std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>> m_HashMap;
+    std::mutex m_Mtx;
+
+    // Byte code kept in memory, the least recently used entry is at the front of the list
+    MemoryMapType         m_HashMap;
+    std::list<XXH128Hash> m_MemoryLRU;
+    Uint64                m_MemorySize = 0;
+
+    // Cache directory with the trailing slash, or empty string if the directory is not used
+    std::string m_Directory;
+
+    // Files in the cache directory, the least recently used file is at the front of the list
+    FileMapType           m_Files;
+    std::list<XXH128Hash> m_FileLRU;
+    Uint64                m_DirectorySize = 0;
+
+    std::atomic<Uint64> m_NextTempFileId{0};
 };
 
+constexpr char BytecodeCacheImpl::FileExtension[];
+constexpr char BytecodeCacheImpl::TempExtension[];
+
 void CreateBytecodeCache(const BytecodeCacheCreateInfo& CreateInfo,
                          IBytecodeCache**               ppCache)
 {
@@ -34,6 +34,8 @@
 #include <memory>
 #include <unordered_set>
 #include <string>
+#include <atomic>
+#include <cstring>
 
 #include "Archiver.h"
 #include "Dearchiver.h"
@@ -48,6 +50,10 @@
 #include "XXH128Hasher.hpp"
 #include "CallbackWrapper.hpp"
 #include "GraphicsAccessories.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "Align.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -151,6 +157,7 @@ public:
     PROXY_CONST_METHOD2(m_pShader, void, GetResourceDesc, Uint32, Index, ShaderResourceDesc&, ResourceDesc)
     PROXY_CONST_METHOD1(m_pShader, const ShaderCodeBufferDesc*, GetConstantBufferDesc, Uint32, Index)
     PROXY_CONST_METHOD2(m_pShader, void, GetBytecode, const void**, ppBytecode, Uint64&, Size)
+    PROXY_METHOD1(m_pShader, SHADER_STATUS, GetStatus, Bool, WaitForCompletion)
 
     static void Create(RenderStateCacheImpl*   pStateCache,
                        IShader*                pShader,
@@ -234,6 +241,7 @@ public:
     PROXY_CONST_METHOD1(m_pPipeline, bool, IsCompatibleWith, const IPipelineState*, pPSO)
     PROXY_CONST_METHOD(m_pPipeline, Uint32, GetResourceSignatureCount)
     PROXY_CONST_METHOD1(m_pPipeline, IPipelineResourceSignature*, GetResourceSignature, Uint32, Index)
+    PROXY_METHOD1(m_pPipeline, PIPELINE_STATE_STATUS, GetStatus, Bool, WaitForCompletion)
 
     static void Create(RenderStateCacheImpl*          pStateCache,
                        IPipelineState*                pPipeline,
@@ -277,6 +285,53 @@ private:
 constexpr INTERFACE_ID ReloadablePipelineState::IID_InternalImpl;
 
 
+/// Data blob that references a single record of the memory-mapped journal file.
+class JournalRecordDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    JournalRecordDataBlob(IReferenceCounters* pRefCounters,
+                          IDataBlob*          pJournalData,
+                          size_t              Offset,
+                          size_t              Size) :
+        TBase{pRefCounters},
+        m_pJournalData{pJournalData},
+        m_pData{static_cast<Uint8*>(pJournalData->GetDataPtr()) + Offset},
+        m_Size{Size}
+    {
+        VERIFY_EXPR(Offset + Size <= pJournalData->GetSize());
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override final
+    {
+        UNEXPECTED("Journal records can't be resized");
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override final
+    {
+        return m_Size;
+    }
+
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override final
+    {
+        return m_pData;
+    }
+
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override final
+    {
+        return m_pData;
+    }
+
+private:
+    RefCntAutoPtr<IDataBlob> m_pJournalData;
+    Uint8* const             m_pData;
+    const size_t             m_Size;
+};
+
+
 /// Implementation of IRenderStateCache
 class RenderStateCacheImpl final : public ObjectBase<IRenderStateCache>
 {
@@ -378,6 +433,11 @@ public:
         m_ReloadableShaders.clear();
         m_Pipelines.clear();
         m_ReloadablePipelines.clear();
+
+        m_NumShaderHits.store(0);
+        m_NumShaderMisses.store(0);
+        m_NumPipelineHits.store(0);
+        m_NumPipelineMisses.store(0);
     }
 
     virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData) override final;
@@ -387,6 +447,19 @@ public:
         return m_pDearchiver ? m_pDearchiver->GetContentVersion() : ~0u;
     }
 
+    virtual RenderStateCacheStats DILIGENT_CALL_TYPE GetStats() const override final
+    {
+        RenderStateCacheStats Stats;
+        Stats.NumShaderHits       = m_NumShaderHits.load();
+        Stats.NumShaderMisses     = m_NumShaderMisses.load();
+        Stats.NumPipelineHits     = m_NumPipelineHits.load();
+        Stats.NumPipelineMisses   = m_NumPipelineMisses.load();
+        Stats.NumJournalRecords   = m_NumJournalRecords.load();
+        Stats.JournalBytesLoaded  = m_JournalBytesLoaded;
+        Stats.JournalBytesWritten = m_JournalBytesWritten.load();
+        return Stats;
+    }
+
     bool CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
                               IShader**               ppShader);
 
@@ -442,6 +515,41 @@ private:
     bool CreatePipelineState(const CreateInfoType& PSOCreateInfo,
                              IPipelineState**      ppPipelineState);
 
+    // Journal file layout:
+    //
+    //   JournalHeader
+    //   JournalRecordHeader, record data (device object archive), padding to JournalAlignment
+    //   JournalRecordHeader, record data, padding
+    //   ...
+    struct JournalHeader
+    {
+        Uint32 Magic          = 0;
+        Uint32 Version        = 0;
+        Uint32 ContentVersion = 0;
+        Uint32 Padding        = 0;
+    };
+
+    struct JournalRecordHeader
+    {
+        Uint32 Magic   = 0;
+        Uint32 Padding = 0;
+        // Record data size, excluding the padding
+        Uint64 Size = 0;
+    };
+
+    static constexpr Uint32 JournalMagic       = 0x4C4E524A; // JRNL
+    static constexpr Uint32 JournalRecordMagic = 0x44434552; // RECD
+    static constexpr Uint32 JournalVersion     = 1;
+    static constexpr size_t JournalAlignment   = 8;
+
+    void OpenJournal();
+    bool LoadJournal(IDataBlob* pJournalData, Uint32& NumRecords);
+
+    static bool WriteJournalRecord(FileWrapper& File, const void* pData, size_t Size);
+
+    template <typename AddObjectType>
+    void AppendToJournal(const std::string& HashStr, AddObjectType&& AddObject);
+
 private:
     RefCntAutoPtr<IRenderDevice>                   m_pDevice;
     const RENDER_DEVICE_TYPE                       m_DeviceType;
@@ -451,17 +559,31 @@ private:
     RefCntAutoPtr<IArchiver>                       m_pArchiver;
     RefCntAutoPtr<IDearchiver>                     m_pDearchiver;
 
-    std::mutex                                             m_ShadersMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IShader>> m_Shaders;
+    std::mutex                                      m_ShadersMtx;
+    FlatHashMap<XXH128Hash, RefCntWeakPtr<IShader>> m_Shaders;
 
     std::mutex                                           m_ReloadableShadersMtx;
     std::unordered_map<IShader*, RefCntWeakPtr<IShader>> m_ReloadableShaders;
 
-    std::mutex                                                    m_PipelinesMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IPipelineState>> m_Pipelines;
+    std::mutex                                             m_PipelinesMtx;
+    FlatHashMap<XXH128Hash, RefCntWeakPtr<IPipelineState>> m_Pipelines;
 
     std::mutex                                                         m_ReloadablePipelinesMtx;
     std::unordered_map<IPipelineState*, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
+
+    IArchiverFactory* m_pArchiverFactory = nullptr;
+
+    std::string m_JournalFilePath;
+    std::mutex  m_JournalMtx;
+    FileWrapper m_JournalFile;
+
+    std::atomic<Uint32> m_NumShaderHits{0};
+    std::atomic<Uint32> m_NumShaderMisses{0};
+    std::atomic<Uint32> m_NumPipelineHits{0};
+    std::atomic<Uint32> m_NumPipelineMisses{0};
+    std::atomic<Uint32> m_NumJournalRecords{0};
+    Uint64              m_JournalBytesLoaded = 0;
+    std::atomic<Uint64> m_JournalBytesWritten{0};
 };
 
 RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRefCounters,
@@ -488,6 +610,7 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
     pArchiverFactory       = GetArchiverFactory();
 #endif
     VERIFY_EXPR(pArchiverFactory != nullptr);
+    m_pArchiverFactory = pArchiverFactory;
 
     SerializationDeviceCreateInfo SerializationDeviceCI;
     SerializationDeviceCI.DeviceInfo  = m_pDevice->GetDeviceInfo();
@@ -533,6 +656,12 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
     m_pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &m_pDearchiver);
     if (!m_pDearchiver)
         LOG_ERROR_AND_THROW("Failed to create dearchiver");
+
+    if (CreateInfo.JournalFilePath != nullptr)
+    {
+        m_JournalFilePath = CreateInfo.JournalFilePath;
+        OpenJournal();
+    }
 }
 
 #define RENDER_STATE_CACHE_LOG(Level, ...)                         \
@@ -562,6 +691,8 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
     if (!pShader)
         return false;
 
+    (FoundInCache ? m_NumShaderHits : m_NumShaderMisses).fetch_add(1);
+
     if (m_CI.EnableHotReload)
     {
         // Wrap shader in a reloadable shader object
@@ -703,9 +834,14 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         if (pArchivedShader)
         {
             if (m_pArchiver->AddShader(pArchivedShader))
+            {
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added shader '", HashStr, "'.");
+                AppendToJournal(HashStr, [&](IArchiver* pArchiver) { return pArchiver->AddShader(pArchivedShader); });
+            }
             else
+            {
                 LOG_ERROR_MESSAGE("Failed to archive shader '", HashStr, "'.");
+            }
         }
     }
 
@@ -1014,6 +1150,8 @@ bool RenderStateCacheImpl::CreatePipelineState(const CreateInfoType& PSOCreateIn
     if (!pPSO)
         return false;
 
+    (FoundInCache ? m_NumPipelineHits : m_NumPipelineMisses).fetch_add(1);
+
     if (m_CI.EnableHotReload)
     {
         {
@@ -1144,9 +1282,14 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
         if (pSerializedPSO)
         {
             if (m_pArchiver->AddPipelineState(pSerializedPSO))
+            {
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added pipeline '", HashStr, "'.");
+                AppendToJournal(HashStr, [&](IArchiver* pArchiver) { return pArchiver->AddPipelineState(pSerializedPSO); });
+            }
             else
+            {
                 LOG_ERROR_MESSAGE("Failed to archive PSO '", HashStr, "'.");
+            }
         }
     }
     catch (...)
@@ -1156,6 +1299,182 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     return false;
 }
 
+constexpr Uint32 RenderStateCacheImpl::JournalMagic;
+constexpr Uint32 RenderStateCacheImpl::JournalRecordMagic;
+constexpr Uint32 RenderStateCacheImpl::JournalVersion;
+constexpr size_t RenderStateCacheImpl::JournalAlignment;
+
+void RenderStateCacheImpl::OpenJournal()
+{
+    const auto* FilePath = m_JournalFilePath.c_str();
+
+    bool   Rewrite    = true;
+    Uint32 NumRecords = 0;
+    if (FileSystem::FileExists(FilePath))
+    {
+        if (auto pJournalData = MappedFileDataBlob::Create(FilePath))
+        {
+            m_JournalBytesLoaded = pJournalData->GetSize();
+            Rewrite              = !LoadJournal(pJournalData, NumRecords);
+        }
+    }
+
+    if (m_CI.JournalCompactionThreshold != 0 && NumRecords >= m_CI.JournalCompactionThreshold)
+        Rewrite = true;
+
+    if (Rewrite)
+    {
+        // Merge all loaded records into one. This also drops the broken records, if any.
+        RefCntAutoPtr<IDataBlob> pCompactData;
+        if (NumRecords > 0)
+        {
+            if (!m_pDearchiver->Store(&pCompactData))
+                LOG_ERROR_MESSAGE("Failed to compact render state cache journal '", FilePath, "'.");
+            // Release the file mapping before the file is overwritten
+            m_pDearchiver->Reset();
+        }
+
+        const auto NumOldRecords = NumRecords;
+
+        NumRecords = 0;
+        FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+        if (!File)
+        {
+            LOG_ERROR_MESSAGE("Failed to create render state cache journal '", FilePath, "'.");
+            return;
+        }
+
+        JournalHeader Header;
+        Header.Magic          = JournalMagic;
+        Header.Version        = JournalVersion;
+        Header.ContentVersion = m_CI.JournalContentVersion;
+        if (!File->Write(&Header, sizeof(Header)))
+        {
+            LOG_ERROR_MESSAGE("Failed to write render state cache journal '", FilePath, "'.");
+            return;
+        }
+
+        if (pCompactData)
+        {
+            if (WriteJournalRecord(File, pCompactData->GetConstDataPtr(), pCompactData->GetSize()) &&
+                m_pDearchiver->LoadArchive(pCompactData, m_CI.JournalContentVersion))
+            {
+                NumRecords = 1;
+                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Compacted ", NumOldRecords, " journal records into one.");
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Failed to write compacted render state cache journal '", FilePath, "'.");
+            }
+        }
+    }
+
+    m_JournalFile.Open(FileOpenAttribs{FilePath, EFileAccessMode::Append});
+    if (!m_JournalFile)
+        LOG_ERROR_MESSAGE("Failed to open render state cache journal '", FilePath, "' for writing.");
+
+    m_NumJournalRecords.store(NumRecords);
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Opened journal '", FilePath, "' with ", NumRecords, " records.");
+}
+
+bool RenderStateCacheImpl::LoadJournal(IDataBlob* pJournalData, Uint32& NumRecords)
+{
+    const auto* pData = static_cast<const Uint8*>(pJournalData->GetConstDataPtr());
+    const auto  Size  = pJournalData->GetSize();
+
+    JournalHeader Header;
+    if (Size < sizeof(Header))
+        return false;
+    memcpy(&Header, pData, sizeof(Header));
+
+    if (Header.Magic != JournalMagic || Header.Version != JournalVersion)
+    {
+        LOG_WARNING_MESSAGE("'", m_JournalFilePath, "' is not a valid render state cache journal or was written by an incompatible version. The journal will be discarded.");
+        return false;
+    }
+
+    if (Header.ContentVersion != m_CI.JournalContentVersion)
+    {
+        RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Discarding journal '", m_JournalFilePath, "': content version (", Header.ContentVersion,
+                               ") does not match the expected version (", m_CI.JournalContentVersion, ").");
+        return false;
+    }
+
+    size_t Offset = sizeof(Header);
+    while (Offset < Size)
+    {
+        // The last record may be incomplete if the application was terminated while the record was being written
+        JournalRecordHeader RecordHeader;
+        if (Size - Offset < sizeof(RecordHeader))
+            return false;
+        memcpy(&RecordHeader, pData + Offset, sizeof(RecordHeader));
+        Offset += sizeof(RecordHeader);
+
+        if (RecordHeader.Magic != JournalRecordMagic || RecordHeader.Size > Size - Offset)
+        {
+            LOG_WARNING_MESSAGE("Render state cache journal '", m_JournalFilePath, "' contains an incomplete or corrupted record. The record and all records after it will be discarded.");
+            return false;
+        }
+
+        const auto RecordSize = static_cast<size_t>(RecordHeader.Size);
+
+        RefCntAutoPtr<IDataBlob> pRecord{MakeNewRCObj<JournalRecordDataBlob>()(pJournalData, Offset, RecordSize)};
+        if (!m_pDearchiver->LoadArchive(pRecord, m_CI.JournalContentVersion))
+        {
+            LOG_WARNING_MESSAGE("Failed to load record ", NumRecords, " of render state cache journal '", m_JournalFilePath, "'. The record and all records after it will be discarded.");
+            return false;
+        }
+        ++NumRecords;
+
+        Offset += std::min(AlignUp(RecordSize, JournalAlignment), Size - Offset);
+    }
+
+    return true;
+}
+
+bool RenderStateCacheImpl::WriteJournalRecord(FileWrapper& File, const void* pData, size_t Size)
+{
+    static constexpr Uint8 Padding[JournalAlignment] = {};
+
+    JournalRecordHeader RecordHeader;
+    RecordHeader.Magic = JournalRecordMagic;
+    RecordHeader.Size  = Size;
+
+    const auto PaddingSize = AlignUp(Size, JournalAlignment) - Size;
+    return (File->Write(&RecordHeader, sizeof(RecordHeader)) &&
+            File->Write(pData, Size) &&
+            (PaddingSize == 0 || File->Write(Padding, PaddingSize)));
+}
+
+template <typename AddObjectType>
+void RenderStateCacheImpl::AppendToJournal(const std::string& HashStr, AddObjectType&& AddObject)
+{
+    if (!m_JournalFile)
+        return;
+
+    // Every record is a self-contained archive that only contains the new object
+    RefCntAutoPtr<IArchiver> pArchiver;
+    m_pArchiverFactory->CreateArchiver(m_pSerializationDevice, &pArchiver);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    if (pArchiver && AddObject(pArchiver.RawPtr()))
+        pArchiver->SerializeToBlob(m_CI.JournalContentVersion, &pData);
+    if (!pData)
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize '", HashStr, "' for the render state cache journal.");
+        return;
+    }
+
+    std::lock_guard<std::mutex> Guard{m_JournalMtx};
+    if (!WriteJournalRecord(m_JournalFile, pData->GetConstDataPtr(), pData->GetSize()))
+    {
+        LOG_ERROR_MESSAGE("Failed to append '", HashStr, "' to render state cache journal '", m_JournalFilePath, "'.");
+        return;
+    }
+    m_NumJournalRecords.fetch_add(1);
+    m_JournalBytesWritten.fetch_add(sizeof(JournalRecordHeader) + AlignUp(pData->GetSize(), JournalAlignment));
+}
+
 Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
 {
     if (!m_CI.EnableHotReload)
@@ -137,7 +137,8 @@ public:
             {
                 DefaultRawMemoryAllocator::GetAllocator(),
                 CreateInfo.Desc.VertexCount,
-                CreateInfo.DisableDebugValidation
+                CreateInfo.DisableDebugValidation,
+                CreateInfo.UseTLSF
             }
         },
         m_MgrSize         {m_Mgr.GetMaxSize()},
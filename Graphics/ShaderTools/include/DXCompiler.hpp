@@ -45,6 +45,8 @@ struct ID3D12ShaderReflection;
 namespace Diligent
 {
 
+struct IBytecodeCache;
+
 enum class DXCompilerTarget
 {
     Direct3D12, // compiles to DXIL
@@ -76,6 +78,10 @@ public:
         IShaderSourceInputStreamFactory* pShaderSourceStreamFactory = nullptr;
         IDxcBlob**                       ppBlobOut                  = nullptr;
         IDxcBlob**                       ppCompilerOutput           = nullptr;
+
+        // Optional bytecode cache that is checked before the shader is compiled.
+        // The compiled byte code is added to the cache.
+        IBytecodeCache* pBytecodeCache = nullptr;
     };
     virtual bool Compile(const CompileAttribs& Attribs) = 0;
 
@@ -84,7 +90,8 @@ public:
                          const char*             ExtraDefinitions,
                          IDxcBlob**              ppByteCodeBlob,
                          std::vector<uint32_t>*  pByteCode,
-                         IDataBlob**             ppCompilerOutput) noexcept(false) = 0;
+                         IDataBlob**             ppCompilerOutput,
+                         IBytecodeCache*         pBytecodeCache = nullptr) noexcept(false) = 0;
 
 
     using BindInfo            = ResourceBinding::BindInfo;
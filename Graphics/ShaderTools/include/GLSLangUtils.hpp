@@ -34,6 +34,8 @@
 namespace Diligent
 {
 
+struct IBytecodeCache;
+
 namespace GLSLangUtils
 {
 
@@ -63,6 +65,10 @@ struct GLSLtoSPIRVAttribs
     SpirvVersion                     Version                    = SpirvVersion::Vk100;
     IDataBlob**                      ppCompilerOutput           = nullptr;
     bool                             AssignBindings             = true;
+
+    // Optional bytecode cache that is checked before the shader is compiled.
+    // The compiled SPIRV is added to the cache.
+    IBytecodeCache* pBytecodeCache = nullptr;
 };
 
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs);
@@ -70,7 +76,8 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs);
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       SpirvVersion            Version,
                                       const char*             ExtraDefinitions,
-                                      IDataBlob**             ppCompilerOutput);
+                                      IDataBlob**             ppCompilerOutput,
+                                      IBytecodeCache*         pBytecodeCache = nullptr);
 
 } // namespace GLSLangUtils
 
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "FlagEnum.h"
+#include "ThreadPool.hpp"
 
 #include "spirv-tools/libspirv.h"
 
@@ -49,4 +50,56 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
                                     spv_target_env               TargetEnv,
                                     SPIRV_OPTIMIZATION_FLAGS     Passes);
 
+/// SPIRV optimization statistics collected by OptimizeSPIRVBatch().
+struct SPIRVOptimizationStats
+{
+    /// The number of pass groups, one for every optimization flag.
+    static constexpr Uint32 NumPassGroups = 3;
+
+    /// The number of modules that were successfully optimized.
+    Uint32 NumOptimized = 0;
+
+    /// The number of modules that failed to optimize.
+    Uint32 NumFailed = 0;
+
+    /// The total size of the source modules, in words.
+    size_t SrcSize = 0;
+
+    /// The total size of the optimized modules, in words.
+    size_t DstSize = 0;
+
+    /// The total time, in seconds, spent in every pass group by all threads.
+    /// Element i corresponds to the pass group enabled by the (1u << i) flag, e.g.
+    /// PassGroupTime[0] is the time spent in SPIRV_OPTIMIZATION_FLAG_LEGALIZATION passes.
+    double PassGroupTime[NumPassGroups] = {};
+
+    /// Returns the time spent in the pass group enabled by the given flag.
+    double GetPassGroupTime(SPIRV_OPTIMIZATION_FLAGS Flag) const;
+
+    SPIRVOptimizationStats& operator+=(const SPIRVOptimizationStats& Rhs);
+};
+
+/// Optimizes multiple SPIRV modules in parallel.
+
+/// \param [in]  SrcModules  - Source SPIRV modules.
+/// \param [in]  TargetEnv   - Target environment. If SPV_ENV_MAX, the environment is derived
+///                            from the SPIRV version of every module.
+/// \param [in]  Passes      - Optimization passes to run.
+/// \param [in]  pThreadPool - Thread pool to use. If null, all modules are optimized
+///                            on the calling thread.
+/// \param [out] pStats      - Optional pointer to the structure that receives optimization statistics.
+///
+/// \return     Optimized modules in the same order as the source modules.
+///             Modules that failed to optimize are empty.
+///
+/// \remarks    Every thread creates its optimizers once and reuses them for all modules
+///             it processes, so that the pass setup cost is not paid for every module.
+///             Every pass group runs in its own optimizer, which allows measuring the
+///             time of each group at the cost of an extra module parse per enabled group.
+std::vector<std::vector<uint32_t>> OptimizeSPIRVBatch(const std::vector<std::vector<uint32_t>>& SrcModules,
+                                                      spv_target_env                            TargetEnv,
+                                                      SPIRV_OPTIMIZATION_FLAGS                  Passes,
+                                                      IThreadPool*                              pThreadPool,
+                                                      SPIRVOptimizationStats*                   pStats = nullptr);
+
 } // namespace Diligent
@@ -133,6 +133,42 @@ bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(
 ///  Unrolls all include files into a single file
 std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false);
 
+/// Clears the process-wide cache of the #include directives found in shader source files.
+
+/// \remarks   ProcessShaderIncludes() and UnrollShaderIncludes() cache the #include directives
+///            of every source file they scan. A file is re-scanned automatically when its contents
+///            change, so the cache only needs to be cleared to release the memory.
+void ClearShaderIncludeCache();
+
+/// Shader include cache statistics
+struct ShaderIncludeCacheStatistics
+{
+    /// The number of source files in the cache.
+    size_t NumFiles = 0;
+
+    /// The number of times the #include directives of a file were taken from the cache.
+    Uint64 NumHits = 0;
+
+    /// The number of times a file had to be scanned because it was not in the cache or was modified.
+    Uint64 NumMisses = 0;
+};
+
+/// Returns the include cache statistics. The counters are reset by ClearShaderIncludeCache().
+ShaderIncludeCacheStatistics GetShaderIncludeCacheStatistics();
+
+/// Builds the key that identifies the compiled byte code in the bytecode cache
+/// (see IBytecodeCache::GetBytecodeByKey).
+
+/// \param [in] CompilerInfo - Compiler name and version followed by all options and
+///                            definitions that affect the byte code.
+/// \param [in] ShaderCI     - Shader create info that defines the source code. All #include
+///                            directives are expanded, so that the key changes when any
+///                            of the included files changes.
+///
+/// \return     The key, or an empty string if the source code could not be preprocessed,
+///             in which case the cache must not be used.
+std::string BuildBytecodeCacheKey(const std::string& CompilerInfo, const ShaderCreateInfo& ShaderCI) noexcept;
+
 std::string GetShaderCodeTypeName(SHADER_CODE_BASIC_TYPE     BasicType,
                                   SHADER_CODE_VARIABLE_CLASS Class,
                                   Uint32                     NumRows,
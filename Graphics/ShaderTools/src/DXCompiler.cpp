@@ -46,7 +46,9 @@
 
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "StringTools.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "../../GraphicsTools/interface/BytecodeCache.h"
 
 #if D3D12_SUPPORTED
 #    include "WinHPreface.h"
@@ -113,7 +115,8 @@ public:
                          const char*             ExtraDefinitions,
                          IDxcBlob**              ppByteCodeBlob,
                          std::vector<uint32_t>*  pByteCode,
-                         IDataBlob**             ppCompilerOutput) noexcept(false) override final;
+                         IDataBlob**             ppCompilerOutput,
+                         IBytecodeCache*         pBytecodeCache) noexcept(false) override final;
 
     virtual void GetD3D12ShaderReflection(IDxcBlob*                pShaderBytecode,
                                           ID3D12ShaderReflection** ppShaderReflection) override final;
@@ -155,6 +158,9 @@ private:
 
     bool ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
 
+    // Returns the compiler description that is used as the prefix of the bytecode cache key
+    std::string GetBytecodeCacheCompilerInfo(const CompileAttribs& Attribs) const;
+
     enum RES_TYPE : Uint32
     {
         RES_TYPE_CBV     = 0,
@@ -388,6 +394,30 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         CComPtr<IDxcLibrary> pdxcLibrary;
         CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
 
+        std::string CacheKey;
+        if (Attribs.pBytecodeCache != nullptr)
+        {
+            ShaderCreateInfo KeyCI;
+            KeyCI.Source                     = Attribs.Source;
+            KeyCI.SourceLength               = Attribs.SourceLength;
+            KeyCI.pShaderSourceStreamFactory = Attribs.pShaderSourceStreamFactory;
+
+            CacheKey = BuildBytecodeCacheKey(GetBytecodeCacheCompilerInfo(Attribs), KeyCI);
+            if (!CacheKey.empty())
+            {
+                RefCntAutoPtr<IDataBlob> pCachedBytecode;
+                Attribs.pBytecodeCache->GetBytecodeByKey(CacheKey.data(), CacheKey.size(), &pCachedBytecode);
+                if (pCachedBytecode)
+                {
+                    CComPtr<IDxcBlobEncoding> pCachedBlob;
+                    CHECK_D3D_RESULT(pdxcLibrary->CreateBlobWithEncodingOnHeapCopy(pCachedBytecode->GetConstDataPtr(), static_cast<UINT32>(pCachedBytecode->GetSize()), 0, &pCachedBlob),
+                                     "Failed to create DXC blob for the cached byte code");
+                    *Attribs.ppBlobOut = pCachedBlob.Detach();
+                    return true;
+                }
+            }
+        }
+
         CComPtr<IDxcCompiler> pdxcCompiler;
         CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
 
@@ -433,15 +463,24 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         CHECK_D3D_RESULT(pdxcResult->GetResult(&pCompiledBlob), "Failed to get compiled blob from DXC operation result");
 
         // Validate and sign
+        bool Succeeded = false;
         if (m_Target == DXCompilerTarget::Direct3D12)
         {
-            return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
+            Succeeded = ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
         }
         else
         {
             *Attribs.ppBlobOut = pCompiledBlob.Detach();
-            return true;
+            Succeeded          = true;
         }
+
+        if (Succeeded && !CacheKey.empty() && *Attribs.ppBlobOut != nullptr)
+        {
+            auto* pBlob = *Attribs.ppBlobOut;
+            Attribs.pBytecodeCache->AddBytecodeByKey(CacheKey.data(), CacheKey.size(), DataBlobImpl::Create(pBlob->GetBufferSize(), pBlob->GetBufferPointer()));
+        }
+
+        return Succeeded;
     }
     catch (...)
     {
@@ -449,6 +488,35 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
     }
 }
 
+std::string DXCompilerImpl::GetBytecodeCacheCompilerInfo(const CompileAttribs& Attribs) const
+{
+    std::string Info{"DXC "};
+    Info += std::to_string(m_MajorVer) + '.' + std::to_string(m_MinorVer);
+    Info += m_Target == DXCompilerTarget::Direct3D12 ? " DXIL" : " SPIRV";
+    Info += " API " + std::to_string(m_APIVersion);
+    Info += '\n';
+    Info += NarrowString(Attribs.EntryPoint);
+    Info += ' ';
+    Info += NarrowString(Attribs.Profile);
+    for (Uint32 i = 0; i < Attribs.ArgsCount; ++i)
+    {
+        Info += ' ';
+        Info += NarrowString(Attribs.pArgs[i]);
+    }
+    for (Uint32 i = 0; i < Attribs.DefinesCount; ++i)
+    {
+        const auto& Define = Attribs.pDefines[i];
+        Info += " -D";
+        Info += NarrowString(Define.Name);
+        if (Define.Value != nullptr)
+        {
+            Info += '=';
+            Info += NarrowString(Define.Value);
+        }
+    }
+    return Info;
+}
+
 bool DXCompilerImpl::ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
 {
     CComPtr<IDxcValidator> pdxcValidator;
@@ -726,7 +794,8 @@ void DXCompilerImpl::Compile(const ShaderCreateInfo& ShaderCI,
                              const char*             ExtraDefinitions,
                              IDxcBlob**              ppByteCodeBlob,
                              std::vector<uint32_t>*  pByteCode,
-                             IDataBlob**             ppCompilerOutput) noexcept(false)
+                             IDataBlob**             ppCompilerOutput,
+                             IBytecodeCache*         pBytecodeCache) noexcept(false)
 {
     if (!IsLoaded())
     {
@@ -832,6 +901,7 @@ void DXCompilerImpl::Compile(const ShaderCreateInfo& ShaderCI,
     CA.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
     CA.ppBlobOut                  = &pDXIL;
     CA.ppCompilerOutput           = &pDxcLog;
+    CA.pBytecodeCache             = pBytecodeCache;
 
     auto result = Compile(CA);
     HandleHLSLCompilerResult(result, pDxcLog.p, Source, ShaderCI.Desc.Name, ppCompilerOutput);
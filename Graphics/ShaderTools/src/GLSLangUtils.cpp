@@ -43,8 +43,10 @@
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "GraphicsAccessories.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
+#include "../../GraphicsTools/interface/BytecodeCache.h"
 
 // clang-format off
 static constexpr char g_HLSLDefinitions[] =
@@ -403,12 +405,67 @@ void SetupWithSpirvVersion(::glslang::TShader&  Shader,
     }
 }
 
+// Returns the compiler description that is used as the prefix of the bytecode cache key
+std::string GetBytecodeCacheCompilerInfo(const char*              Language,
+                                         SHADER_TYPE              ShaderType,
+                                         SpirvVersion             Version,
+                                         const char*              EntryPoint,
+                                         bool                     AssignBindings,
+                                         SPIRV_OPTIMIZATION_FLAGS OptimizationFlags,
+                                         const std::string&       Preamble)
+{
+    std::string Info{"glslang "};
+    Info += ::glslang::GetGlslVersionString();
+    Info += " generator ";
+    Info += std::to_string(::glslang::GetSpirvGeneratorVersion());
+    Info += '\n';
+    Info += Language;
+    Info += ' ';
+    Info += GetShaderTypeLiteralName(ShaderType);
+    Info += " target ";
+    Info += std::to_string(static_cast<int>(Version));
+    if (EntryPoint != nullptr)
+    {
+        Info += " entry ";
+        Info += EntryPoint;
+    }
+    Info += AssignBindings ? " bindings" : "";
+    Info += " opt ";
+    Info += std::to_string(static_cast<Uint32>(OptimizationFlags));
+    Info += '\n';
+    Info += Preamble;
+    return Info;
+}
+
+std::vector<unsigned int> FindCachedSPIRV(IBytecodeCache* pCache, const std::string& Key)
+{
+    if (Key.empty())
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pBytecode;
+    pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+    if (!pBytecode || pBytecode->GetSize() % sizeof(unsigned int) != 0)
+        return {};
+
+    const auto* pData = static_cast<const unsigned int*>(pBytecode->GetConstDataPtr());
+    return std::vector<unsigned int>{pData, pData + pBytecode->GetSize() / sizeof(unsigned int)};
+}
+
+void AddSPIRVToCache(IBytecodeCache* pCache, const std::string& Key, const std::vector<unsigned int>& SPIRV)
+{
+    if (Key.empty() || SPIRV.empty())
+        return;
+
+    pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(SPIRV.size() * sizeof(SPIRV[0]), SPIRV.data()));
+}
+
 } // namespace
 
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       SpirvVersion            Version,
                                       const char*             ExtraDefinitions,
-                                      IDataBlob**             ppCompilerOutput)
+                                      IDataBlob**             ppCompilerOutput,
+                                      IBytecodeCache*         pBytecodeCache)
 {
     EShLanguage        ShLang = ShaderTypeToShLanguage(ShaderCI.Desc.ShaderType);
     ::glslang::TShader Shader{ShLang};
@@ -445,6 +502,23 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
     }
     Shader.setPreamble(Defines.c_str());
 
+    constexpr SPIRV_OPTIMIZATION_FLAGS OptimizationFlags = SPIRV_OPTIMIZATION_FLAG_LEGALIZATION | SPIRV_OPTIMIZATION_FLAG_PERFORMANCE;
+
+    std::string CacheKey;
+    if (pBytecodeCache != nullptr)
+    {
+        ShaderCreateInfo KeyCI;
+        KeyCI.Source                     = SourceData.Source;
+        KeyCI.SourceLength               = SourceData.SourceLength;
+        KeyCI.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
+
+        CacheKey = BuildBytecodeCacheKey(GetBytecodeCacheCompilerInfo("HLSL", ShaderCI.Desc.ShaderType, Version, ShaderCI.EntryPoint, true, OptimizationFlags, Defines), KeyCI);
+
+        auto CachedSPIRV = FindCachedSPIRV(pBytecodeCache, CacheKey);
+        if (!CachedSPIRV.empty())
+            return CachedSPIRV;
+    }
+
     const char* ShaderStrings[]       = {SourceData.Source};
     const int   ShaderStringLengths[] = {static_cast<int>(SourceData.SourceLength)};
     const char* Names[]               = {ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : ""};
@@ -462,9 +536,11 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
-    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION | SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, OptimizationFlags);
     if (!LegalizedSPIRV.empty())
     {
+        if (pBytecodeCache != nullptr)
+            AddSPIRVToCache(pBytecodeCache, CacheKey, LegalizedSPIRV);
         return LegalizedSPIRV;
     }
     else
@@ -499,6 +575,21 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
         AppendShaderMacros(Defines, Attribs.Macros);
     Shader.setPreamble(Defines.c_str());
 
+    std::string CacheKey;
+    if (Attribs.pBytecodeCache != nullptr)
+    {
+        ShaderCreateInfo KeyCI;
+        KeyCI.Source                     = Attribs.ShaderSource;
+        KeyCI.SourceLength               = static_cast<size_t>(Attribs.SourceCodeLen);
+        KeyCI.pShaderSourceStreamFactory = Attribs.pShaderSourceStreamFactory;
+
+        CacheKey = BuildBytecodeCacheKey(GetBytecodeCacheCompilerInfo("GLSL", Attribs.ShaderType, Attribs.Version, nullptr, Attribs.AssignBindings, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE, Defines), KeyCI);
+
+        auto CachedSPIRV = FindCachedSPIRV(Attribs.pBytecodeCache, CacheKey);
+        if (!CachedSPIRV.empty())
+            return CachedSPIRV;
+    }
+
     IncluderImpl Includer{Attribs.pShaderSourceStreamFactory};
 
     auto SPIRV = CompileShaderInternal(Shader, messages, &Includer, Attribs.ShaderSource, Attribs.SourceCodeLen, Attribs.AssignBindings, shProfile, Attribs.ppCompilerOutput);
@@ -508,6 +599,8 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
     auto OptimizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
     if (!OptimizedSPIRV.empty())
     {
+        if (Attribs.pBytecodeCache != nullptr)
+            AddSPIRVToCache(Attribs.pBytecodeCache, CacheKey, OptimizedSPIRV);
         return OptimizedSPIRV;
     }
     else
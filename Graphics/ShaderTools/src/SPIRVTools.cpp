@@ -25,7 +25,12 @@
  */
 
 #include "SPIRVTools.hpp"
+
+#include <memory>
+
 #include "DebugUtilities.hpp"
+#include "Align.hpp"
+#include "Timer.hpp"
 
 #include "spirv-tools/optimizer.hpp"
 
@@ -105,42 +110,188 @@ spv_target_env SpvTargetEnvFromSPIRV(const std::vector<uint32_t>& SPIRV)
     }
 }
 
-} // namespace
-
-std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+std::unique_ptr<spvtools::Optimizer> CreateSpvOptimizer(spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
 {
-    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
-
-    if (TargetEnv == SPV_ENV_MAX)
-        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
-
-    spvtools::Optimizer SpirvOptimizer(TargetEnv);
-    SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
+    std::unique_ptr<spvtools::Optimizer> pOptimizer{new spvtools::Optimizer{TargetEnv}};
+    pOptimizer->SetMessageConsumer(SpvOptimizerMessageConsumer);
 
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
     if (Passes & SPIRV_OPTIMIZATION_FLAG_LEGALIZATION)
     {
-        SpirvOptimizer.RegisterLegalizationPasses();
+        pOptimizer->RegisterLegalizationPasses();
     }
 
     if (Passes & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE)
     {
-        SpirvOptimizer.RegisterPerformancePasses();
+        pOptimizer->RegisterPerformancePasses();
     }
 
     if (Passes & SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION)
     {
         // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
         // removed by strip-reflect-info pass. SPIRV offsets become INVALID after this operation.
-        SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
+        pOptimizer->RegisterPass(spvtools::CreateStripReflectInfoPass());
     }
 
+    return pOptimizer;
+}
+
+// Optimizers owned by a single thread of OptimizeSPIRVBatch().
+// spvtools::Optimizer::Run() builds a new IR context for every module, so the same
+// optimizer can process any number of modules as long as it is used by one thread at a time.
+class SpvBatchOptimizers
+{
+public:
+    SpvBatchOptimizers(SPIRV_OPTIMIZATION_FLAGS Passes) :
+        m_Passes{Passes}
+    {}
+
+    std::vector<uint32_t> Optimize(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRVOptimizationStats& Stats)
+    {
+        if (TargetEnv == SPV_ENV_MAX)
+            TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+
+        auto& Optimizers = GetOptimizers(TargetEnv);
+
+        std::vector<uint32_t> SPIRV = SrcSPIRV;
+        std::vector<uint32_t> OptimizedSPIRV;
+        for (Uint32 Group = 0; Group < SPIRVOptimizationStats::NumPassGroups; ++Group)
+        {
+            auto& pOptimizer = Optimizers.pOptimizers[Group];
+            if (!pOptimizer)
+                continue;
+
+            Timer GroupTimer;
+            const auto Succeeded = pOptimizer->Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV);
+            Stats.PassGroupTime[Group] += GroupTimer.GetElapsedTime();
+            if (!Succeeded)
+            {
+                ++Stats.NumFailed;
+                return {};
+            }
+            std::swap(SPIRV, OptimizedSPIRV);
+            OptimizedSPIRV.clear();
+        }
+
+        ++Stats.NumOptimized;
+        Stats.SrcSize += SrcSPIRV.size();
+        Stats.DstSize += SPIRV.size();
+
+        return SPIRV;
+    }
+
+private:
+    struct TargetEnvOptimizers
+    {
+        spv_target_env                       TargetEnv;
+        std::unique_ptr<spvtools::Optimizer> pOptimizers[SPIRVOptimizationStats::NumPassGroups];
+    };
+
+    TargetEnvOptimizers& GetOptimizers(spv_target_env TargetEnv)
+    {
+        // Modules in a batch typically share one or two environments, so linear search is sufficient
+        for (auto& Optimizers : m_Optimizers)
+        {
+            if (Optimizers.TargetEnv == TargetEnv)
+                return Optimizers;
+        }
+
+        m_Optimizers.emplace_back();
+        auto& Optimizers{m_Optimizers.back()};
+        Optimizers.TargetEnv = TargetEnv;
+        for (Uint32 Group = 0; Group < SPIRVOptimizationStats::NumPassGroups; ++Group)
+        {
+            const auto GroupFlag = static_cast<SPIRV_OPTIMIZATION_FLAGS>(1u << Group);
+            if (m_Passes & GroupFlag)
+                Optimizers.pOptimizers[Group] = CreateSpvOptimizer(TargetEnv, GroupFlag);
+        }
+        return Optimizers;
+    }
+
+private:
+    const SPIRV_OPTIMIZATION_FLAGS   m_Passes;
+    std::vector<TargetEnvOptimizers> m_Optimizers;
+};
+
+} // namespace
+
+std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
+    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    if (TargetEnv == SPV_ENV_MAX)
+        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+
+    auto pSpirvOptimizer = CreateSpvOptimizer(TargetEnv, Passes);
+
     std::vector<uint32_t> OptimizedSPIRV;
-    if (!SpirvOptimizer.Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
+    if (!pSpirvOptimizer->Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
         OptimizedSPIRV.clear();
 
     return OptimizedSPIRV;
 }
 
+double SPIRVOptimizationStats::GetPassGroupTime(SPIRV_OPTIMIZATION_FLAGS Flag) const
+{
+    VERIFY(IsPowerOfTwo(static_cast<Uint32>(Flag)), "Exactly one flag is expected");
+    for (Uint32 Group = 0; Group < NumPassGroups; ++Group)
+    {
+        if (Flag == (1u << Group))
+            return PassGroupTime[Group];
+    }
+    UNEXPECTED("Unexpected optimization flag");
+    return 0;
+}
+
+SPIRVOptimizationStats& SPIRVOptimizationStats::operator+=(const SPIRVOptimizationStats& Rhs)
+{
+    NumOptimized += Rhs.NumOptimized;
+    NumFailed += Rhs.NumFailed;
+    SrcSize += Rhs.SrcSize;
+    DstSize += Rhs.DstSize;
+    for (Uint32 Group = 0; Group < NumPassGroups; ++Group)
+        PassGroupTime[Group] += Rhs.PassGroupTime[Group];
+    return *this;
+}
+
+std::vector<std::vector<uint32_t>> OptimizeSPIRVBatch(const std::vector<std::vector<uint32_t>>& SrcModules,
+                                                      spv_target_env                            TargetEnv,
+                                                      SPIRV_OPTIMIZATION_FLAGS                  Passes,
+                                                      IThreadPool*                              pThreadPool,
+                                                      SPIRVOptimizationStats*                   pStats)
+{
+    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    std::vector<std::vector<uint32_t>> OptimizedModules(SrcModules.size());
+
+    // The value accumulated by every thread taking part in the reduction owns that thread's
+    // optimizers, so they are created once per thread and reused for all chunks it claims.
+    struct ThreadState
+    {
+        std::shared_ptr<SpvBatchOptimizers> pOptimizers;
+        SPIRVOptimizationStats              Stats;
+    };
+
+    const auto Stats = ParallelReduce(
+        pThreadPool, size_t{0}, SrcModules.size(), size_t{1}, ThreadState{},
+        [&](size_t Begin, size_t End, ThreadState State) {
+            if (!State.pOptimizers)
+                State.pOptimizers = std::make_shared<SpvBatchOptimizers>(Passes);
+            for (size_t i = Begin; i < End; ++i)
+                OptimizedModules[i] = State.pOptimizers->Optimize(SrcModules[i], TargetEnv, State.Stats);
+            return State;
+        },
+        [](ThreadState State0, const ThreadState& State1) {
+            State0.pOptimizers.reset();
+            State0.Stats += State1.Stats;
+            return State0;
+        });
+
+    if (pStats != nullptr)
+        *pStats = Stats.Stats;
+
+    return OptimizedModules;
+}
+
 } // namespace Diligent
@@ -28,6 +28,9 @@
 #include "ShaderToolsCommon.hpp"
 
 #include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
 
 #include "BasicFileSystem.hpp"
 #include "DebugUtilities.hpp"
@@ -35,6 +38,7 @@
 #include "StringDataBlobImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ParsingTools.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -382,6 +386,140 @@ bool FindIncludes(const char* pBuffer, size_t BufferSize, HandlerType&& IncludeH
     return true;
 }
 
+namespace
+{
+
+// #include directive found in the shader source
+struct IncludeDirective
+{
+    // Path to the included file
+    std::string Path;
+
+    // Offset of the directive start ('#') in the source
+    size_t Start = 0;
+
+    // Offset past the closing quote or angle bracket
+    size_t End = 0;
+};
+using IncludeDirectiveList = std::vector<IncludeDirective>;
+
+// Process-wide cache of the #include directives found in shader source files.
+// The same header files are typically included by many shaders, so scanning them
+// once saves a lot of time when many shader permutations are compiled.
+// The entries are keyed by the file path and are only reused if the hash and length
+// of the file contents match, so modified files are automatically re-scanned.
+// The stream factory does not report file modification times, so every file is still
+// read and hashed, but this is an order of magnitude faster than scanning it.
+class ShaderIncludeCache
+{
+public:
+    static ShaderIncludeCache& GetInstance()
+    {
+        static ShaderIncludeCache Instance;
+        return Instance;
+    }
+
+    std::shared_ptr<const IncludeDirectiveList> Find(const std::string& Path, size_t Hash, size_t Length)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Entries.find(Path);
+        if (it == m_Entries.end() || it->second.Hash != Hash || it->second.Length != Length)
+        {
+            ++m_Stats.NumMisses;
+            return {};
+        }
+
+        ++m_Stats.NumHits;
+        return it->second.pIncludes;
+    }
+
+    void Add(const std::string& Path, size_t Hash, size_t Length, std::shared_ptr<const IncludeDirectiveList> pIncludes)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        // Replace the entry for the previous version of the file, if any
+        m_Entries[Path] = Entry{Hash, Length, std::move(pIncludes)};
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Entries.clear();
+        m_Stats = {};
+    }
+
+    ShaderIncludeCacheStatistics GetStatistics()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto Stats     = m_Stats;
+        Stats.NumFiles = m_Entries.size();
+        return Stats;
+    }
+
+private:
+    struct Entry
+    {
+        size_t Hash   = 0;
+        size_t Length = 0;
+
+        std::shared_ptr<const IncludeDirectiveList> pIncludes;
+    };
+
+    std::mutex                             m_Mtx;
+    std::unordered_map<std::string, Entry> m_Entries;
+    ShaderIncludeCacheStatistics           m_Stats;
+};
+
+// Returns the #include directives found in the source. If the source was loaded from
+// the file, the directives are taken from the include cache when the file has not changed.
+template <typename ErrorHandlerType>
+std::shared_ptr<const IncludeDirectiveList> GetIncludeDirectives(const char*        FilePath,
+                                                                 const char*        Source,
+                                                                 size_t             SourceLength,
+                                                                 ErrorHandlerType&& ErrorHandler) noexcept(false)
+{
+    auto& Cache = ShaderIncludeCache::GetInstance();
+
+    size_t Hash = 0;
+    if (FilePath != nullptr)
+    {
+        Hash = ComputeHashRaw(Source, SourceLength);
+        if (auto pIncludes = Cache.Find(FilePath, Hash, SourceLength))
+            return pIncludes;
+    }
+
+    auto pIncludes = std::make_shared<IncludeDirectiveList>();
+    if (!FindIncludes(
+            Source, SourceLength,
+            [&](const std::string& Path, size_t Start, size_t End) //
+            {
+                pIncludes->emplace_back(IncludeDirective{Path, Start, End});
+            },
+            std::forward<ErrorHandlerType>(ErrorHandler)))
+    {
+        return {};
+    }
+
+    // Sources that are not loaded from files (e.g. generated code) are not cached
+    if (FilePath != nullptr)
+        Cache.Add(FilePath, Hash, SourceLength, pIncludes);
+
+    return pIncludes;
+}
+
+} // namespace
+
+void ClearShaderIncludeCache()
+{
+    ShaderIncludeCache::GetInstance().Clear();
+}
+
+ShaderIncludeCacheStatistics GetShaderIncludeCacheStatistics()
+{
+    return ShaderIncludeCache::GetInstance().GetStatistics();
+}
+
 static void ProcessIncludeErrorHandler(const ShaderCreateInfo& ShaderCI, const std::string& Error) noexcept(false)
 {
     std::string FileInfo;
@@ -410,20 +548,22 @@ void ProcessShaderIncludesImpl(const ShaderCreateInfo& ShaderCI, std::unordered_
     FileInfo.SourceLength = SourceData.SourceLength;
     FileInfo.FilePath     = ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "";
 
-    FindIncludes(
-        FileInfo.Source, FileInfo.SourceLength,
-        [&](const std::string& FilePath, size_t Start, size_t End) //
+    const auto pIncludes = GetIncludeDirectives(ShaderCI.FilePath, FileInfo.Source, FileInfo.SourceLength,
+                                                std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+    if (pIncludes)
+    {
+        for (const auto& Include : *pIncludes)
         {
-            if (!Includes.insert(FilePath).second)
-                return;
+            if (!Includes.insert(Include.Path).second)
+                continue;
 
             auto IncludeCI{ShaderCI};
-            IncludeCI.FilePath     = FilePath.c_str();
+            IncludeCI.FilePath     = Include.Path.c_str();
             IncludeCI.Source       = nullptr;
             IncludeCI.SourceLength = 0;
             ProcessShaderIncludesImpl(IncludeCI, Includes, IncludeHandler);
-        },
-        std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+        }
+    }
 
     if (IncludeHandler)
         IncludeHandler(FileInfo);
@@ -453,6 +593,8 @@ static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unor
 {
     const auto SourceData = ReadShaderSourceFile(ShaderCI);
 
+    const auto* const FilePath = ShaderCI.FilePath;
+
     ShaderCI.Source       = SourceData.Source;
     ShaderCI.SourceLength = SourceData.SourceLength;
     ShaderCI.FilePath     = nullptr;
@@ -460,25 +602,29 @@ static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unor
     std::stringstream Stream;
     size_t            PrevIncludeEnd = 0;
 
-    FindIncludes(
-        ShaderCI.Source, ShaderCI.SourceLength, [&](const std::string& Path, size_t IncludeStart, size_t IncludeEnd) {
+    const auto pIncludes = GetIncludeDirectives(FilePath, ShaderCI.Source, ShaderCI.SourceLength,
+                                                std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+    if (pIncludes)
+    {
+        for (const auto& Include : *pIncludes)
+        {
             // Insert text before the include start
-            Stream.write(ShaderCI.Source + PrevIncludeEnd, IncludeStart - PrevIncludeEnd);
+            Stream.write(ShaderCI.Source + PrevIncludeEnd, Include.Start - PrevIncludeEnd);
 
-            if (AllIncludes.insert(Path).second)
+            if (AllIncludes.insert(Include.Path).second)
             {
                 // Process the #include directive
                 ShaderCreateInfo IncludeCI{ShaderCI};
                 IncludeCI.Source       = nullptr;
                 IncludeCI.SourceLength = 0;
-                IncludeCI.FilePath     = Path.c_str();
+                IncludeCI.FilePath     = Include.Path.c_str();
                 auto UnrolledInclude   = UnrollShaderIncludesImpl(IncludeCI, AllIncludes);
                 Stream << UnrolledInclude;
             }
 
-            PrevIncludeEnd = IncludeEnd;
-        },
-        std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+            PrevIncludeEnd = Include.End;
+        }
+    }
 
     // Insert text after the last include
     Stream.write(ShaderCI.Source + PrevIncludeEnd, ShaderCI.SourceLength - PrevIncludeEnd);
@@ -504,6 +650,22 @@ std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(fals
     // Let other exceptions (e.g. 'Failed to load shader source file...') pass through
 }
 
+std::string BuildBytecodeCacheKey(const std::string& CompilerInfo, const ShaderCreateInfo& ShaderCI) noexcept
+{
+    try
+    {
+        std::string Key{CompilerInfo};
+        Key += '\n';
+        Key += UnrollShaderIncludes(ShaderCI);
+        return Key;
+    }
+    catch (...)
+    {
+        // The error will be reported by the compiler
+        return {};
+    }
+}
+
 std::string GetShaderCodeTypeName(SHADER_CODE_BASIC_TYPE     BasicType,
                                   SHADER_CODE_VARIABLE_CLASS Class,
                                   Uint32                     NumRows,
@@ -35,6 +35,7 @@
 #include "SerializedPipelineState.h"
 #include "SerializedShader.h"
 #include "ShaderMacroHelper.hpp"
+#include "ThreadPool.hpp"
 
 #include "ResourceLayoutTestCommon.hpp"
 #include "gtest/gtest.h"
@@ -1274,7 +1275,7 @@ void CreateComputeShader(IRenderDevice*        pDevice,
     }
 }
 
-void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
+void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags, ARCHIVE_COMPRESSION Compression = ARCHIVE_COMPRESSION_NONE, bool UnpackInParallel = false)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
     auto* pDevice          = pEnv->GetDevice();
@@ -1381,6 +1382,14 @@ void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
             {
                 pArchiver->SerializeToBlob(ContentVersion, &pArchive);
                 ASSERT_NE(pArchive, nullptr);
+                if (Compression != ARCHIVE_COMPRESSION_NONE)
+                {
+                    RefCntAutoPtr<IDataBlob> pCompressedArchive;
+                    ASSERT_TRUE(pArchiverFactory->CompressArchive(pArchive, ArchiveInfo.DeviceFlags, Compression, &pCompressedArchive));
+                    ASSERT_NE(pCompressedArchive, nullptr);
+                    EXPECT_LT(pCompressedArchive->GetSize(), pArchive->GetSize());
+                    pArchive = pCompressedArchive;
+                }
                 EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pArchive));
             }
 
@@ -1408,8 +1417,40 @@ void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
         UnpackInfo.pDevice      = pDevice;
         UnpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
 
-        pDearchiver->UnpackPipelineState(UnpackInfo, &pUnpackedPSO);
-        ASSERT_NE(pUnpackedPSO, nullptr);
+        if (UnpackInParallel)
+        {
+            auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+            ASSERT_NE(pThreadPool, nullptr);
+
+            // All pipelines share the same shader, which must be unpacked only once
+            constexpr Uint32 NumPipelines = 8;
+
+            std::array<PipelineStateUnpackInfo, NumPipelines> UnpackInfos;
+            UnpackInfos.fill(UnpackInfo);
+            std::array<IPipelineState*, NumPipelines> ppPSOs{};
+            std::array<IAsyncTask*, NumPipelines>     ppTasks{};
+            pDearchiver->UnpackPipelineStates(UnpackInfos.data(), NumPipelines, pThreadPool, ppPSOs.data(), ppTasks.data());
+            pThreadPool->WaitForAllTasks();
+
+            for (Uint32 i = 0; i < NumPipelines; ++i)
+            {
+                ASSERT_NE(ppTasks[i], nullptr);
+                EXPECT_EQ(ppTasks[i]->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+                ppTasks[i]->Release();
+
+                EXPECT_NE(ppPSOs[i], nullptr);
+                if (i == 0)
+                    pUnpackedPSO.Attach(ppPSOs[i]);
+                else if (ppPSOs[i] != nullptr)
+                    ppPSOs[i]->Release();
+            }
+            ASSERT_NE(pUnpackedPSO, nullptr);
+        }
+        else
+        {
+            pDearchiver->UnpackPipelineState(UnpackInfo, &pUnpackedPSO);
+            ASSERT_NE(pUnpackedPSO, nullptr);
+        }
     }
 
     RefCntAutoPtr<IShaderResourceBinding> pSRB;
@@ -1468,6 +1509,16 @@ TEST(ArchiveTest, ComputePipeline_NoReflection_SplitArchive)
     TestComputePipeline(PSO_ARCHIVE_FLAG_STRIP_REFLECTION | PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES);
 }
 
+TEST(ArchiveTest, ComputePipeline_Compressed)
+{
+    TestComputePipeline(PSO_ARCHIVE_FLAG_NONE, ARCHIVE_COMPRESSION_LZ4);
+}
+
+TEST(ArchiveTest, ComputePipeline_UnpackInParallel)
+{
+    TestComputePipeline(PSO_ARCHIVE_FLAG_NONE, ARCHIVE_COMPRESSION_LZ4, true);
+}
+
 TEST(ArchiveTest, RayTracingPipeline)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
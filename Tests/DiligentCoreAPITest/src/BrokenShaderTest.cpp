@@ -115,6 +115,33 @@ TEST(Shader, BrokenGLSL)
                      DeviceInfo.IsGLDevice() ? 2 : 3);
 }
 
+TEST(Shader, BrokenHLSL_Async)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source         = g_BrokenHLSL;
+    ShaderCI.EntryPoint     = "VSMain";
+    ShaderCI.Desc           = {"Broken async HLSL test", SHADER_TYPE_VERTEX, true};
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.CompileFlags   = SHADER_COMPILE_FLAG_ASYNCHRONOUS;
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    pEnv->SetErrorAllowance(DeviceInfo.IsGLDevice() || DeviceInfo.IsD3DDevice() ? 2 : 4, "\n\nNo worries, testing broken shader...\n\n");
+
+    RefCntAutoPtr<IShader> pBrokenShader;
+    pDevice->CreateShader(ShaderCI, &pBrokenShader, nullptr);
+    // Backends that do not support asynchronous compilation fail synchronously
+    if (pBrokenShader)
+    {
+        EXPECT_EQ(pBrokenShader->GetStatus(/*WaitForCompletion = */ true), SHADER_STATUS_FAILED);
+    }
+}
+
 TEST(Shader, BrokenMSL)
 {
     const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
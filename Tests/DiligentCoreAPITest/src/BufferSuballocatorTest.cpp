@@ -68,7 +68,7 @@ TEST(BufferSuballocatorTest, Create)
     pAlloc.Release();
 }
 
-TEST(BufferSuballocatorTest, Allocate)
+void TestAllocate(bool UseTLSF)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -80,6 +80,7 @@ TEST(BufferSuballocatorTest, Allocate)
     CI.Desc.Name      = "Buffer Suballocator Test";
     CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
     CI.Desc.Size      = 1024;
+    CI.UseTLSF        = UseTLSF;
 
     RefCntAutoPtr<IBufferSuballocator> pAllocator;
     CreateBufferSuballocator(pDevice, CI, &pAllocator);
@@ -149,4 +150,14 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, Allocate)
+{
+    TestAllocate(false);
+}
+
+TEST(BufferSuballocatorTest, Allocate_TLSF)
+{
+    TestAllocate(true);
+}
+
 } // namespace
@@ -25,6 +25,8 @@
  *  of the possibility of such damages.
  */
 
+#include <thread>
+
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 
@@ -182,6 +184,158 @@ TEST(ComputeShaderTest, FillTexture)
     pSwapChain->Present();
 }
 
+TEST(ComputeShaderTest, FillTexture_Async)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    auto* pSwapChain = pEnv->GetSwapChain();
+    auto* pContext   = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<ITestingSwapChain> pTestingSwapChain{pSwapChain, IID_TestingSwapChain};
+    if (!pTestingSwapChain)
+    {
+        GTEST_SKIP() << "Compute shader test requires testing swap chain";
+    }
+
+    pContext->Flush();
+    pContext->InvalidateState();
+
+    ComputeShaderReference(pSwapChain);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Async compute shader test", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = HLSL::FillTextureCS.c_str();
+    ShaderCI.CompileFlags   = SHADER_COMPILE_FLAG_ASYNCHRONOUS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+
+    PSOCreateInfo.PSODesc.Name         = "Async compute shader test";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.Flags                = PSO_CREATE_FLAG_ASYNCHRONOUS;
+    // The pipeline initialization must wait for the shader compilation
+    PSOCreateInfo.pCS = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    while (pPSO->GetStatus() == PIPELINE_STATE_STATUS_COMPILING)
+        std::this_thread::yield();
+    ASSERT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    EXPECT_EQ(pCS->GetStatus(), SHADER_STATUS_READY);
+
+    const auto& SCDesc = pSwapChain->GetDesc();
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_tex2DUAV")->Set(pTestingSwapChain->GetCurrentBackBufferUAV());
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX = (SCDesc.Width + 15) / 16;
+    DispatchAttribs.ThreadGroupCountY = (SCDesc.Height + 15) / 16;
+    pContext->DispatchCompute(DispatchAttribs);
+
+    pSwapChain->Present();
+}
+
+// Test that dispatch commands are skipped when the pipeline is not ready
+TEST(ComputeShaderTest, Dispatch_NotReadyPipeline)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Asynchronous pipeline creation is only supported in Vulkan";
+    }
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Not ready pipeline test", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = HLSL::FillTextureCS.c_str();
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    // The signature does not contain the texture used by the shader, so the pipeline fails to initialize
+    PipelineResourceDesc Resources[] = {
+        {SHADER_TYPE_COMPUTE, "g_UnusedUAV", 1, SHADER_RESOURCE_TYPE_TEXTURE_UAV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+    };
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name         = "Not ready pipeline test";
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_NE(pPRS, nullptr);
+
+    IPipelineResourceSignature* ppSignatures[] = {pPRS};
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+
+    PSOCreateInfo.PSODesc.Name            = "Not ready pipeline test";
+    PSOCreateInfo.PSODesc.PipelineType    = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.Flags                   = PSO_CREATE_FLAG_ASYNCHRONOUS;
+    PSOCreateInfo.ppResourceSignatures    = ppSignatures;
+    PSOCreateInfo.ResourceSignaturesCount = _countof(ppSignatures);
+    PSOCreateInfo.pCS                     = pCS;
+
+    pEnv->SetErrorAllowance(2, "No worries, errors are expected: testing pipeline that failed to initialize\n");
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+    {
+        pEnv->SetErrorAllowance(0);
+        GTEST_SKIP() << "The device does not create pipelines asynchronously";
+    }
+    ASSERT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_FAILED);
+
+    pEnv->SetErrorAllowance(1);
+    pEnv->PushExpectedErrorSubstring("that failed to initialize");
+    EXPECT_EQ(pPSO->GetResourceSignature(0), nullptr);
+
+    pContext->Flush();
+    pContext->InvalidateState();
+
+    pEnv->SetErrorAllowance(2);
+    pEnv->PushExpectedErrorSubstring("command is skipped");
+    pEnv->PushExpectedErrorSubstring("is not ready");
+    pContext->SetPipelineState(pPSO);
+
+    DispatchComputeAttribs DispatchAttribs{1, 1, 1};
+    pContext->DispatchCompute(DispatchAttribs);
+
+    pEnv->SetErrorAllowance(0);
+    pContext->Flush();
+}
+
 // Test that GenerateMips does not mess up compute pipeline in D3D12
 TEST(ComputeShaderTest, GenerateMips_CSInterference)
 {
@@ -33,6 +33,7 @@
 #include "FastRand.hpp"
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
+#include "FileSystem.hpp"
 #include "ResourceLayoutTestCommon.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
@@ -969,6 +970,76 @@ TEST(RenderStateCacheTest, AppendData)
     }
 }
 
+TEST(RenderStateCacheTest, Journal)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    constexpr char JournalPath[] = "RenderStateCacheTest.journal";
+    if (FileSystem::FileExists(JournalPath))
+        FileSystem::DeleteFile(JournalPath);
+
+    constexpr bool UseSignature = false;
+
+    for (Uint32 pass = 0; pass < 4; ++pass)
+    {
+        // 0: empty journal
+        // 1: journal with two records
+        // 2: compacted journal
+        // 3: discarded journal (content version mismatch)
+        const bool PresentInCache = pass == 1 || pass == 2;
+
+        RenderStateCacheCreateInfo CacheCI{pDevice, RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE};
+        CacheCI.JournalFilePath            = JournalPath;
+        CacheCI.JournalContentVersion      = pass < 3 ? ContentVersion : ContentVersion + 1;
+        CacheCI.JournalCompactionThreshold = pass < 2 ? 3 : 2;
+
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+
+        const auto InitialStats = pCache->GetStats();
+        EXPECT_EQ(InitialStats.NumJournalRecords, pass == 1 ? 2u : (pass == 2 ? 1u : 0u));
+
+        RefCntAutoPtr<IShader> pCS;
+        CreateComputeShader(pCache, pShaderSourceFactory, pCS, PresentInCache);
+        ASSERT_NE(pCS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateComputePSO(pCache, PresentInCache, pCS, UseSignature, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+        VerifyComputePSO(pPSO);
+
+        const auto Stats = pCache->GetStats();
+        EXPECT_EQ(Stats.NumShaderHits, PresentInCache ? 1u : 0u);
+        EXPECT_EQ(Stats.NumShaderMisses, PresentInCache ? 0u : 1u);
+        EXPECT_EQ(Stats.NumPipelineHits, PresentInCache ? 1u : 0u);
+        EXPECT_EQ(Stats.NumPipelineMisses, PresentInCache ? 0u : 1u);
+        if (PresentInCache)
+        {
+            EXPECT_EQ(Stats.NumJournalRecords, InitialStats.NumJournalRecords);
+            EXPECT_EQ(Stats.JournalBytesWritten, 0u);
+        }
+        else
+        {
+            EXPECT_EQ(Stats.NumJournalRecords, 2u);
+            EXPECT_GT(Stats.JournalBytesWritten, 0u);
+        }
+    }
+
+    FileSystem::DeleteFile(JournalPath);
+}
+
 TEST(RenderStateCacheTest, RenderDeviceWithCache)
 {
     constexpr bool Execute = false;
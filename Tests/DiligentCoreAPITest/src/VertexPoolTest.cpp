@@ -88,7 +88,7 @@ TEST(VertexPoolTest, Create)
     pAlloc1.Release();
 }
 
-TEST(VertexPoolTest, Allocate)
+void TestAllocate(bool UseTLSF)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -106,6 +106,7 @@ TEST(VertexPoolTest, Allocate)
     CI.Desc.pElements   = Elements;
     CI.Desc.NumElements = _countof(Elements);
     CI.Desc.VertexCount = 128;
+    CI.UseTLSF          = UseTLSF;
 
     RefCntAutoPtr<IVertexPool> pVtxPool;
     CreateVertexPool(pDevice, CI, &pVtxPool);
@@ -178,4 +179,14 @@ TEST(VertexPoolTest, Allocate)
     }
 }
 
+TEST(VertexPoolTest, Allocate)
+{
+    TestAllocate(false);
+}
+
+TEST(VertexPoolTest, Allocate_TLSF)
+{
+    TestAllocate(true);
+}
+
 } // namespace
@@ -26,15 +26,22 @@
  */
 
 #include <array>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "DynamicLinearAllocatorPool.hpp"
 
 #include "gtest/gtest.h"
 
+#include "TestingEnvironment.hpp"
+
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -124,6 +131,119 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, MultiThreaded)
+{
+    constexpr Uint32 AllocSize             = 48;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr Uint32 NumThreads            = 8;
+    constexpr Uint32 NumAllocations        = 1024;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage};
+    EXPECT_GE(TestAllocator.GetNumBlocksInPage(), NumAllocationsPerPage);
+
+    // Every thread frees half of its own allocations and half of the allocations of the next thread
+    std::vector<std::vector<void*>> Allocations(NumThreads);
+    std::vector<std::thread>        Threads(NumThreads);
+
+    auto RunThreads = [&](auto&& Func) {
+        for (Uint32 t = 0; t < NumThreads; ++t)
+            Threads[t] = std::thread{Func, t};
+        for (auto& Thread : Threads)
+            Thread.join();
+    };
+
+    RunThreads([&](Uint32 ThreadId) {
+        auto& ThreadAllocs = Allocations[ThreadId];
+        for (Uint32 i = 0; i < NumAllocations; ++i)
+        {
+            auto* pData = static_cast<Uint32*>(TestAllocator.Allocate(AllocSize, "Fixed block allocator test", __FILE__, __LINE__));
+            for (size_t j = 0; j < AllocSize / sizeof(Uint32); ++j)
+                pData[j] = ThreadId * NumAllocations + i;
+            ThreadAllocs.push_back(pData);
+
+            // Free some blocks to exercise the magazines
+            if ((i % 3) == 2)
+            {
+                TestAllocator.Free(ThreadAllocs[ThreadAllocs.size() - 2]);
+                ThreadAllocs.erase(ThreadAllocs.end() - 2);
+            }
+        }
+    });
+
+    // Check that no block was allocated twice
+    std::vector<void*> AllAllocations;
+    for (const auto& ThreadAllocs : Allocations)
+    {
+        for (auto* pAlloc : ThreadAllocs)
+        {
+            const auto* pData = static_cast<const Uint32*>(pAlloc);
+            for (size_t j = 1; j < AllocSize / sizeof(Uint32); ++j)
+                EXPECT_EQ(pData[0], pData[j]);
+            AllAllocations.push_back(pAlloc);
+        }
+    }
+    std::sort(AllAllocations.begin(), AllAllocations.end());
+    EXPECT_EQ(std::adjacent_find(AllAllocations.begin(), AllAllocations.end()), AllAllocations.end());
+
+    RunThreads([&](Uint32 ThreadId) {
+        auto& OwnAllocs  = Allocations[ThreadId];
+        auto& NextAllocs = Allocations[(ThreadId + 1) % NumThreads];
+        for (size_t i = 0; i < OwnAllocs.size(); i += 2)
+            TestAllocator.Free(OwnAllocs[i]);
+        for (size_t i = 1; i < NextAllocs.size(); i += 2)
+            TestAllocator.Free(NextAllocs[i]);
+    });
+
+    const auto Stats = TestAllocator.GetStatistics();
+    EXPECT_GT(Stats.NumMagazineRefills, 0u);
+    EXPECT_GT(Stats.NumMagazineFlushes, 0u);
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ManyPages)
+{
+    constexpr Uint32 AllocSize             = 24;
+    constexpr Uint32 NumAllocationsPerPage = 8;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage};
+
+    // Allocate enough blocks to create several slabs
+    std::vector<void*> Allocations(TestAllocator.GetNumBlocksInPage() * 100);
+    for (auto& pAlloc : Allocations)
+    {
+        pAlloc = TestAllocator.Allocate(AllocSize, "Fixed block allocator test", __FILE__, __LINE__);
+        memset(pAlloc, 0xFF, AllocSize);
+    }
+
+    auto SortedAllocations = Allocations;
+    std::sort(SortedAllocations.begin(), SortedAllocations.end());
+    EXPECT_EQ(std::adjacent_find(SortedAllocations.begin(), SortedAllocations.end()), SortedAllocations.end());
+
+    for (auto* pAlloc : Allocations)
+        TestAllocator.Free(pAlloc);
+}
+
+TEST(Common_FixedBlockMemoryAllocator, DoubleFree)
+{
+    constexpr Uint32 AllocSize             = 16;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage};
+
+    void* pRawMem0 = TestAllocator.Allocate(AllocSize, "Double free test", __FILE__, __LINE__);
+    TestAllocator.Free(pRawMem0);
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"double freeing memory"};
+        TestAllocator.Free(pRawMem0);
+    }
+
+    // The second free must be ignored, so that the same block is not allocated twice
+    void* pRawMem1 = TestAllocator.Allocate(AllocSize, "Double free test", __FILE__, __LINE__);
+    void* pRawMem2 = TestAllocator.Allocate(AllocSize, "Double free test", __FILE__, __LINE__);
+    EXPECT_NE(pRawMem1, pRawMem2);
+    TestAllocator.Free(pRawMem1);
+    TestAllocator.Free(pRawMem2);
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -289,4 +409,133 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_DynamicLinearAllocator, Markers)
+{
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 256};
+    EXPECT_EQ(Allocator.GetUsedSize(), 0u);
+
+    const auto EmptyMarker = Allocator.GetMarker();
+
+    auto* pData0 = Allocator.Allocate(100, 1);
+    EXPECT_EQ(Allocator.GetUsedSize(), 100u);
+
+    const auto Marker = Allocator.GetMarker();
+    auto*      pData1 = Allocator.Allocate(100, 1);
+    auto*      pData2 = Allocator.Allocate(100, 1);
+    EXPECT_EQ(Allocator.GetBlockCount(), 2u);
+    EXPECT_EQ(Allocator.GetUsedSize(), 300u);
+
+    Allocator.ResetToMarker(Marker);
+    EXPECT_EQ(Allocator.GetUsedSize(), 100u);
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), 300u);
+    // Memory must be reused
+    EXPECT_EQ(Allocator.Allocate(100, 1), pData1);
+    EXPECT_EQ(Allocator.Allocate(100, 1), pData2);
+    EXPECT_EQ(Allocator.GetBlockCount(), 2u);
+
+    Allocator.ResetToMarker(EmptyMarker);
+    EXPECT_EQ(Allocator.GetUsedSize(), 0u);
+    EXPECT_EQ(Allocator.Allocate(100, 1), pData0);
+
+    Allocator.Discard();
+    EXPECT_EQ(Allocator.GetUsedSize(), 0u);
+    EXPECT_EQ(Allocator.GetReservedSize(), 512u);
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), 300u);
+
+    // Allocation that does not fit into the existing blocks
+    EXPECT_NE(Allocator.Allocate(1000, 1), nullptr);
+    EXPECT_EQ(Allocator.GetBlockCount(), 3u);
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), 1000u);
+}
+
+TEST(Common_DynamicLinearAllocatorPool, GetArena)
+{
+    DynamicLinearAllocatorPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 256};
+
+    void* pData = nullptr;
+    {
+        auto Arena = Pool.GetArena();
+        ASSERT_TRUE(Arena);
+
+        // Nested arenas must be different
+        auto Arena2 = Pool.GetArena();
+        ASSERT_TRUE(Arena2);
+        EXPECT_NE(&*Arena, &*Arena2);
+
+        // Arena2 is released first and is cached in the thread slot
+        pData = Arena2->Allocate(100, 16);
+        EXPECT_NE(pData, nullptr);
+
+        const auto Stats = Pool.GetStatistics();
+        EXPECT_EQ(Stats.NumArenas, 2u);
+        EXPECT_EQ(Stats.NumActiveArenas, 2u);
+    }
+
+    {
+        const auto Stats = Pool.GetStatistics();
+        EXPECT_EQ(Stats.NumArenas, 2u);
+        EXPECT_EQ(Stats.NumActiveArenas, 0u);
+        EXPECT_EQ(Stats.ReservedSize, 256u);
+        EXPECT_EQ(Stats.PeakArenaUsedSize, 100u);
+    }
+
+    {
+        // Memory blocks must be reused
+        auto Arena = Pool.GetArena();
+        EXPECT_EQ(Arena->GetUsedSize(), 0u);
+        EXPECT_EQ(Arena->Allocate(100, 16), pData);
+
+        auto Arena2 = std::move(Arena);
+        EXPECT_FALSE(Arena);
+        EXPECT_TRUE(Arena2);
+        EXPECT_EQ(Pool.GetStatistics().NumActiveArenas, 1u);
+        Arena2.Release();
+        EXPECT_EQ(Pool.GetStatistics().NumActiveArenas, 0u);
+    }
+    EXPECT_EQ(Pool.GetStatistics().NumArenas, 2u);
+}
+
+TEST(Common_DynamicLinearAllocatorPool, MultiThreaded)
+{
+    DynamicLinearAllocatorPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 1024};
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{
+            [&Pool](size_t ThreadId) {
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    auto Arena = Pool.GetArena();
+                    ASSERT_EQ(Arena->GetUsedSize(), 0u);
+
+                    auto* pData = Arena->Allocate<size_t>(64 + i % 128);
+                    for (size_t j = 0; j < 64; ++j)
+                        pData[j] = ThreadId;
+
+                    auto Nested = Pool.GetArena();
+                    auto* pNestedData = Nested->Allocate<size_t>(16);
+                    for (size_t j = 0; j < 16; ++j)
+                        pNestedData[j] = ~ThreadId;
+
+                    for (size_t j = 0; j < 64; ++j)
+                        ASSERT_EQ(pData[j], ThreadId);
+                    for (size_t j = 0; j < 16; ++j)
+                        ASSERT_EQ(pNestedData[j], ~ThreadId);
+                }
+            },
+            t};
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Stats = Pool.GetStatistics();
+    EXPECT_EQ(Stats.NumActiveArenas, 0u);
+    EXPECT_LE(Stats.NumArenas, NumThreads * 2);
+    EXPECT_GE(Stats.PeakArenaUsedSize, 64 * sizeof(size_t));
+}
+
 } // namespace
@@ -31,6 +31,7 @@
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 using namespace Diligent;
 
@@ -111,4 +112,31 @@ TEST(Common_Array2DTools, GetArray2DMinMaxValue)
     }
 }
 
+TEST(Common_Array2DTools, GetArray2DMinMaxValue_ThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    FastRandFloat Rnd{0, -100, +100};
+    for (Uint32 test = 0; test < 4; ++test)
+    {
+        const Uint32 Width  = 512 + test * 7;
+        const Uint32 Height = 256 + test * 13;
+        const size_t Stride = Width + test;
+
+        std::vector<float> Data(Stride * size_t{Height});
+        for (auto& Val : Data)
+            Val = Rnd();
+
+        // Place min and max values in different rows
+        Data[(Height / 3) * Stride + test]      = -1000.f;
+        Data[(Height - 1 - test) * Stride + 11] = +1000.f;
+
+        float Min, Max;
+        GetArray2DMinMaxValue(Data.data(), Stride, Width, Height, Min, Max, pThreadPool);
+        EXPECT_EQ(Min, -1000.f);
+        EXPECT_EQ(Max, +1000.f);
+    }
+}
+
 } // namespace
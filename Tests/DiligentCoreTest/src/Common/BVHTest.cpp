@@ -0,0 +1,422 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<BoundBox> GenerateBoxes(size_t NumBoxes, unsigned int Seed)
+{
+    FastRandFloat RndPos{Seed, -100.f, 100.f};
+    FastRandFloat RndSize{Seed + 1, 0.01f, 5.f};
+
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (auto& Box : Boxes)
+    {
+        const float3 Center{RndPos(), RndPos(), RndPos()};
+        const float3 Extent{RndSize(), RndSize(), RndSize()};
+
+        Box.Min = Center - Extent;
+        Box.Max = Center + Extent;
+    }
+    return Boxes;
+}
+
+bool Contains(const BoundBox& Outer, const BoundBox& Inner)
+{
+    return (Outer.Min.x <= Inner.Min.x && Outer.Min.y <= Inner.Min.y && Outer.Min.z <= Inner.Min.z &&
+            Outer.Max.x >= Inner.Max.x && Outer.Max.y >= Inner.Max.y && Outer.Max.z >= Inner.Max.z);
+}
+
+bool Overlaps(const BoundBox& Box0, const BoundBox& Box1)
+{
+    return (Box0.Min.x <= Box1.Max.x && Box0.Max.x >= Box1.Min.x &&
+            Box0.Min.y <= Box1.Max.y && Box0.Max.y >= Box1.Min.y &&
+            Box0.Min.z <= Box1.Max.z && Box0.Max.z >= Box1.Min.z);
+}
+
+void VerifyHierarchy(const BVH& Hierarchy, const std::vector<BoundBox>& Boxes, Uint32 MaxLeafSize)
+{
+    const auto& Nodes       = Hierarchy.GetNodes();
+    const auto& PrimIndices = Hierarchy.GetPrimitiveIndices();
+
+    ASSERT_EQ(PrimIndices.size(), Boxes.size());
+    ASSERT_FALSE(Nodes.empty());
+    EXPECT_LE(Hierarchy.GetDepth(), BVH::MaxDepth);
+
+    std::vector<int> PrimRefs(Boxes.size());
+    for (Uint32 NodeIdx = 0; NodeIdx < Nodes.size(); ++NodeIdx)
+    {
+        const auto& Node = Nodes[NodeIdx];
+        if (Node.IsLeaf())
+        {
+            EXPECT_LE(Node.NumPrimitives, MaxLeafSize);
+            ASSERT_LE(Node.Offset + Node.NumPrimitives, PrimIndices.size());
+            for (Uint32 i = 0; i < Node.NumPrimitives; ++i)
+            {
+                const auto PrimIdx = PrimIndices[Node.Offset + i];
+                ASSERT_LT(PrimIdx, Boxes.size());
+                ++PrimRefs[PrimIdx];
+                EXPECT_TRUE(Contains(Node.GetBoundBox(), Boxes[PrimIdx]));
+            }
+        }
+        else
+        {
+            ASSERT_LT(NodeIdx + 1, Nodes.size());
+            ASSERT_GT(Node.Offset, NodeIdx + 1);
+            ASSERT_LT(Node.Offset, Nodes.size());
+            EXPECT_TRUE(Contains(Node.GetBoundBox(), Nodes[NodeIdx + 1].GetBoundBox()));
+            EXPECT_TRUE(Contains(Node.GetBoundBox(), Nodes[Node.Offset].GetBoundBox()));
+        }
+    }
+
+    for (auto Refs : PrimRefs)
+        EXPECT_EQ(Refs, 1);
+}
+
+TEST(Common_BVH, Empty)
+{
+    BVH Hierarchy{BVHCreateInfo{}};
+    EXPECT_TRUE(Hierarchy.IsEmpty());
+
+    Hierarchy.CastRay(float3{0, 0, 0}, float3{1, 0, 0}, FLT_MAX, [](Uint32, float&) {
+        ADD_FAILURE();
+        return true;
+    });
+    Hierarchy.QueryBox(BoundBox{float3{-1, -1, -1}, float3{1, 1, 1}}, [](Uint32) {
+        ADD_FAILURE();
+        return true;
+    });
+}
+
+TEST(Common_BVH, Build)
+{
+    for (size_t NumBoxes : {1, 2, 3, 5, 17, 100, 1000, 10000})
+    {
+        for (Uint32 MaxLeafSize : {1, 4, 8})
+        {
+            const auto Boxes = GenerateBoxes(NumBoxes, static_cast<unsigned int>(NumBoxes));
+
+            BVHCreateInfo CI;
+            CI.pBoxes        = Boxes.data();
+            CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+            CI.MaxLeafSize   = MaxLeafSize;
+            VerifyHierarchy(BVH{CI}, Boxes, MaxLeafSize);
+        }
+    }
+}
+
+TEST(Common_BVH, BuildDegenerate)
+{
+    // All boxes are the same, so the surface area heuristic can't split them
+    std::vector<BoundBox> Boxes(1000, BoundBox{float3{1, 2, 3}, float3{4, 5, 6}});
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+    VerifyHierarchy(BVH{CI}, Boxes, CI.MaxLeafSize);
+}
+
+TEST(Common_BVH, BuildParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    const auto Boxes = GenerateBoxes(100000, 0);
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+    CI.pThreadPool   = pThreadPool;
+    VerifyHierarchy(BVH{CI}, Boxes, CI.MaxLeafSize);
+}
+
+float CastRayBruteForce(const std::vector<BoundBox>& Boxes, const float3& Origin, const float3& Direction)
+{
+    float ClosestDist = +FLT_MAX;
+    for (const auto& Box : Boxes)
+    {
+        float EnterDist = 0, ExitDist = 0;
+        if (IntersectRayAABB(Origin, Direction, Box, EnterDist, ExitDist))
+            ClosestDist = std::min(ClosestDist, std::max(EnterDist, 0.f));
+    }
+    return ClosestDist;
+}
+
+float CastRay(const BVH& Hierarchy, const std::vector<BoundBox>& Boxes, const float3& Origin, const float3& Direction)
+{
+    float ClosestDist = +FLT_MAX;
+    Hierarchy.CastRay(Origin, Direction, ClosestDist,
+                      [&](Uint32 PrimIdx, float& MaxDist) {
+                          float EnterDist = 0, ExitDist = 0;
+                          if (IntersectRayAABB(Origin, Direction, Boxes[PrimIdx], EnterDist, ExitDist))
+                          {
+                              const float Dist = std::max(EnterDist, 0.f);
+                              if (Dist < MaxDist)
+                              {
+                                  MaxDist     = Dist;
+                                  ClosestDist = Dist;
+                              }
+                          }
+                          return true;
+                      });
+    return ClosestDist;
+}
+
+TEST(Common_BVH, CastRay)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    const auto Boxes = GenerateBoxes(20000, 1);
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+
+    const BVH Hierarchy{CI};
+    CI.pThreadPool = pThreadPool;
+    const BVH ParallelHierarchy{CI};
+
+    FastRandFloat Rnd{2, -1.f, 1.f};
+    for (size_t i = 0; i < 500; ++i)
+    {
+        const float3 Origin = float3{Rnd(), Rnd(), Rnd()} * 150.f;
+        float3       Direction{Rnd(), Rnd(), Rnd()};
+        if (i % 10 == 0)
+        {
+            // Nearly axis-aligned rays.
+            // Note that IntersectRayAABB ignores the axes with zero direction components.
+            Direction               = float3{1e-4f, -1e-4f, 1e-4f};
+            Direction[(i / 10) % 3] = Rnd() < 0 ? -1.f : 1.f;
+        }
+        if (length(Direction) < 1e-3f)
+            continue;
+
+        const auto RefDist = CastRayBruteForce(Boxes, Origin, Direction);
+        EXPECT_EQ(CastRay(Hierarchy, Boxes, Origin, Direction), RefDist);
+        EXPECT_EQ(CastRay(ParallelHierarchy, Boxes, Origin, Direction), RefDist);
+    }
+
+    // Stop the traversal at the first hit
+    Uint32 NumHits = 0;
+    Hierarchy.CastRay(float3{0, 0, -200}, float3{0, 0, 1}, FLT_MAX,
+                      [&](Uint32, float&) {
+                          ++NumHits;
+                          return false;
+                      });
+    EXPECT_LE(NumHits, 1u);
+}
+
+TEST(Common_BVH, QueryBox)
+{
+    const auto Boxes = GenerateBoxes(20000, 3);
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+
+    const BVH Hierarchy{CI};
+
+    const auto QueryBoxes = GenerateBoxes(100, 4);
+    for (const auto& QueryBox : QueryBoxes)
+    {
+        std::vector<Uint32> RefPrims;
+        for (Uint32 i = 0; i < Boxes.size(); ++i)
+        {
+            if (Overlaps(Boxes[i], QueryBox))
+                RefPrims.push_back(i);
+        }
+
+        std::vector<Uint32> Prims;
+        Hierarchy.QueryBox(QueryBox, [&](Uint32 PrimIdx) {
+            if (Overlaps(Boxes[PrimIdx], QueryBox))
+                Prims.push_back(PrimIdx);
+            return true;
+        });
+        std::sort(Prims.begin(), Prims.end());
+        EXPECT_EQ(Prims, RefPrims);
+    }
+}
+
+TEST(Common_BVH, QueryFrustum)
+{
+    const auto Boxes = GenerateBoxes(20000, 5);
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = static_cast<Uint32>(Boxes.size());
+
+    const BVH Hierarchy{CI};
+
+    for (float Angle : {0.f, 1.f, 2.f, 3.f, 4.f, 5.f})
+    {
+        const auto View     = float4x4::Translation(0, 0, 20) * float4x4::RotationY(Angle);
+        const auto Proj     = float4x4::Projection(PI_F / 4.f, 1.f, 1.f, 150.f, false);
+        const auto ViewProj = View * Proj;
+
+        for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR})
+        {
+            ViewFrustum Frustum;
+            ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+            std::vector<BoxVisibility> Visibility(Boxes.size(), BoxVisibility::Invisible);
+            std::vector<int>           NumRefs(Boxes.size());
+            Hierarchy.QueryFrustum(
+                Frustum,
+                [&](Uint32 PrimIdx, BoxVisibility NodeVisibility) {
+                    ++NumRefs[PrimIdx];
+                    Visibility[PrimIdx] = NodeVisibility;
+                },
+                PlaneFlags);
+
+            Uint32 NumFullyVisible = 0;
+            for (Uint32 i = 0; i < Boxes.size(); ++i)
+            {
+                EXPECT_LE(NumRefs[i], 1);
+
+                const auto RefVisibility = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags);
+                if (RefVisibility != BoxVisibility::Invisible)
+                {
+                    EXPECT_NE(Visibility[i], BoxVisibility::Invisible);
+                }
+                if (Visibility[i] == BoxVisibility::FullyVisible)
+                {
+                    EXPECT_EQ(RefVisibility, BoxVisibility::FullyVisible);
+                    ++NumFullyVisible;
+                }
+            }
+            EXPECT_GT(NumFullyVisible, 0u);
+        }
+    }
+}
+
+
+// Generates a height field mesh with 2 * (GridSize - 1)^2 triangles
+void GenerateTerrain(Uint32 GridSize, std::vector<float3>& Vertices, std::vector<Uint32>& Indices)
+{
+    Vertices.resize(size_t{GridSize} * GridSize);
+    for (Uint32 y = 0; y < GridSize; ++y)
+    {
+        for (Uint32 x = 0; x < GridSize; ++x)
+        {
+            const float u = static_cast<float>(x) / static_cast<float>(GridSize - 1);
+            const float v = static_cast<float>(y) / static_cast<float>(GridSize - 1);
+
+            Vertices[x + y * GridSize] = float3{u * 1000.f, std::sin(u * 20.f) * std::cos(v * 15.f) * 50.f, v * 1000.f};
+        }
+    }
+
+    Indices.clear();
+    Indices.reserve(size_t{GridSize - 1} * (GridSize - 1) * 6);
+    for (Uint32 y = 0; y + 1 < GridSize; ++y)
+    {
+        for (Uint32 x = 0; x + 1 < GridSize; ++x)
+        {
+            const Uint32 i0 = x + y * GridSize;
+            const Uint32 i1 = i0 + 1;
+            const Uint32 i2 = i0 + GridSize;
+            const Uint32 i3 = i2 + 1;
+            Indices.insert(Indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    }
+}
+
+TEST(Common_BVH, CastTriangleRays)
+{
+    std::vector<float3> Vertices;
+    std::vector<Uint32> Indices;
+    GenerateTerrain(33, Vertices, Indices);
+
+    const Uint32 NumTriangles = static_cast<Uint32>(Indices.size() / 3);
+
+    std::vector<BoundBox> Boxes(NumTriangles);
+    for (Uint32 i = 0; i < NumTriangles; ++i)
+    {
+        const auto& V0 = Vertices[Indices[i * 3 + 0]];
+        const auto& V1 = Vertices[Indices[i * 3 + 1]];
+        const auto& V2 = Vertices[Indices[i * 3 + 2]];
+
+        Boxes[i] = BoundBox{std::min(std::min(V0, V1), V2), std::max(std::max(V0, V1), V2)};
+    }
+
+    BVHCreateInfo CI;
+    CI.pBoxes        = Boxes.data();
+    CI.NumPrimitives = NumTriangles;
+
+    const BVH Hierarchy{CI};
+    VerifyHierarchy(Hierarchy, Boxes, CI.MaxLeafSize);
+
+    const auto CastTriangleRay = [&](const float3& Origin, const float3& Direction) {
+        float ClosestDist = +FLT_MAX;
+        Hierarchy.CastRay(Origin, Direction, ClosestDist,
+                          [&](Uint32 TriIdx, float& MaxDist) {
+                              const float Dist = IntersectRayTriangle(Vertices[Indices[TriIdx * 3 + 0]],
+                                                                      Vertices[Indices[TriIdx * 3 + 1]],
+                                                                      Vertices[Indices[TriIdx * 3 + 2]],
+                                                                      Origin, Direction);
+                              if (Dist >= 0 && Dist < MaxDist)
+                              {
+                                  MaxDist     = Dist;
+                                  ClosestDist = Dist;
+                              }
+                              return true;
+                          });
+        return ClosestDist;
+    };
+
+    FastRandFloat Rnd{0, 0.f, 1.f};
+    for (size_t i = 0; i < 256; ++i)
+    {
+        const float3 Origin{Rnd() * 1000.f, 200.f, Rnd() * 1000.f};
+        const float3 Direction = normalize(float3{Rnd() - 0.5f, -1.f, Rnd() - 0.5f});
+
+        float RefDist = +FLT_MAX;
+        for (Uint32 tri = 0; tri < NumTriangles; ++tri)
+        {
+            const float Dist = IntersectRayTriangle(Vertices[Indices[tri * 3 + 0]],
+                                                    Vertices[Indices[tri * 3 + 1]],
+                                                    Vertices[Indices[tri * 3 + 2]],
+                                                    Origin, Direction);
+            if (Dist >= 0)
+                RefDist = std::min(RefDist, Dist);
+        }
+        EXPECT_EQ(CastTriangleRay(Origin, Direction), RefDist) << "Ray " << i;
+    }
+}
+
+} // namespace
@@ -0,0 +1,327 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FlatHashMap.hpp"
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "STDAllocator.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_FlatHashMap, Basic)
+{
+    FlatHashMap<int, std::string> Map;
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.size(), size_t{0});
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.find(1), Map.end());
+    EXPECT_EQ(Map.erase(1), size_t{0});
+
+    auto it_inserted = Map.emplace(1, "One");
+    EXPECT_TRUE(it_inserted.second);
+    EXPECT_EQ(it_inserted.first->first, 1);
+    EXPECT_EQ(it_inserted.first->second, "One");
+
+    it_inserted = Map.emplace(1, "Another One");
+    EXPECT_FALSE(it_inserted.second);
+    EXPECT_EQ(it_inserted.first->second, "One");
+
+    EXPECT_TRUE(Map.insert(std::make_pair(2, "Two")).second);
+    EXPECT_TRUE(Map.try_emplace(3, "Three").second);
+    EXPECT_FALSE(Map.try_emplace(3, "Another Three").second);
+    Map[4] = "Four";
+    EXPECT_EQ(Map[4], "Four");
+    EXPECT_EQ(Map.size(), size_t{4});
+    EXPECT_FALSE(Map.empty());
+
+    EXPECT_EQ(Map.count(2), size_t{1});
+    EXPECT_EQ(Map.count(5), size_t{0});
+    EXPECT_EQ(Map.find(3)->second, "Three");
+
+    const auto& ConstMap = Map;
+    EXPECT_EQ(ConstMap.find(4)->second, "Four");
+    EXPECT_EQ(ConstMap.find(5), ConstMap.end());
+
+    EXPECT_EQ(Map.erase(2), size_t{1});
+    EXPECT_EQ(Map.erase(2), size_t{0});
+    EXPECT_EQ(Map.find(2), Map.end());
+    EXPECT_EQ(Map.size(), size_t{3});
+
+    std::vector<int> Keys;
+    for (const auto& it : ConstMap)
+        Keys.push_back(it.first);
+    std::sort(Keys.begin(), Keys.end());
+    EXPECT_EQ(Keys, (std::vector<int>{1, 3, 4}));
+
+    Map.clear();
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.find(1), Map.end());
+    EXPECT_TRUE(Map.emplace(1, "One").second);
+}
+
+TEST(Common_FlatHashMap, Random)
+{
+    // Compare against std::unordered_map using random inserts and erases
+    FlatHashMap<Uint32, Uint32>        Map;
+    std::unordered_map<Uint32, Uint32> RefMap;
+
+    FastRandInt Rnd{0, 0, 4095};
+    for (Uint32 i = 0; i < 100000; ++i)
+    {
+        const auto Key = static_cast<Uint32>(Rnd());
+        if ((i % 3) == 0)
+        {
+            EXPECT_EQ(Map.erase(Key), RefMap.erase(Key));
+        }
+        else
+        {
+            EXPECT_EQ(Map.emplace(Key, i).second, RefMap.emplace(Key, i).second);
+        }
+        ASSERT_EQ(Map.size(), RefMap.size());
+    }
+
+    size_t Count = 0;
+    for (const auto& it : Map)
+    {
+        auto ref_it = RefMap.find(it.first);
+        ASSERT_NE(ref_it, RefMap.end());
+        EXPECT_EQ(it.second, ref_it->second);
+        ++Count;
+    }
+    EXPECT_EQ(Count, RefMap.size());
+
+    for (const auto& it : RefMap)
+    {
+        auto map_it = Map.find(it.first);
+        ASSERT_NE(map_it, Map.end());
+        EXPECT_EQ(map_it->second, it.second);
+    }
+}
+
+TEST(Common_FlatHashMap, Collisions)
+{
+    // All keys have the same hash
+    struct BadHasher
+    {
+        size_t operator()(int) const { return 0; }
+    };
+
+    FlatHashMap<int, int, BadHasher> Map;
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(Map.emplace(i, i * 10).second);
+
+    for (int i = 0; i < 100; i += 2)
+        EXPECT_EQ(Map.erase(i), size_t{1});
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto it = Map.find(i);
+        if ((i % 2) == 0)
+        {
+            EXPECT_EQ(it, Map.end());
+        }
+        else
+        {
+            ASSERT_NE(it, Map.end());
+            EXPECT_EQ(it->second, i * 10);
+        }
+    }
+}
+
+TEST(Common_FlatHashMap, EraseWhileIterating)
+{
+    FlatHashMap<int, int> Map;
+    for (int i = 0; i < 1000; ++i)
+        Map.emplace(i, i);
+
+    // Erase odd elements using the iterator returned by erase()
+    for (auto it = Map.begin(); it != Map.end();)
+    {
+        if ((it->first % 2) != 0)
+            it = Map.erase(it);
+        else
+            ++it;
+    }
+    EXPECT_EQ(Map.size(), size_t{500});
+
+    // Erasing the element must not invalidate other iterators
+    auto it = Map.begin();
+    while (it != Map.end())
+    {
+        auto NextIt = it;
+        ++NextIt;
+        if ((it->first % 4) == 0)
+            Map.erase(it);
+        it = NextIt;
+    }
+    EXPECT_EQ(Map.size(), size_t{250});
+
+    for (const auto& Elem : Map)
+        EXPECT_EQ(Elem.first % 4, 2);
+}
+
+TEST(Common_FlatHashMap, ObjectLifetime)
+{
+    static int NumObjects = 0;
+    struct Object
+    {
+        Object(int _Value) :
+            Value{_Value}
+        {
+            ++NumObjects;
+        }
+        Object(const Object& Other) :
+            Value{Other.Value}
+        {
+            ++NumObjects;
+        }
+        Object(Object&& Other) :
+            Value{Other.Value}
+        {
+            ++NumObjects;
+        }
+        ~Object()
+        {
+            --NumObjects;
+        }
+        int Value;
+    };
+
+    {
+        FlatHashMap<std::string, Object> Map;
+        for (int i = 0; i < 1000; ++i)
+            Map.emplace(std::to_string(i), Object{i});
+        EXPECT_EQ(NumObjects, 1000);
+
+        for (int i = 0; i < 1000; i += 2)
+            Map.erase(std::to_string(i));
+        EXPECT_EQ(NumObjects, 500);
+
+        for (int i = 1; i < 1000; i += 2)
+            EXPECT_EQ(Map.find(std::to_string(i))->second.Value, i);
+
+        FlatHashMap<std::string, Object> Map2{std::move(Map)};
+        EXPECT_TRUE(Map.empty());
+        EXPECT_EQ(Map2.size(), size_t{500});
+        EXPECT_EQ(NumObjects, 500);
+
+        Map = std::move(Map2);
+        EXPECT_TRUE(Map2.empty());
+        EXPECT_EQ(Map.size(), size_t{500});
+        EXPECT_EQ(NumObjects, 500);
+
+        Map.clear();
+        EXPECT_EQ(NumObjects, 0);
+
+        Map.try_emplace("Test", 10);
+        EXPECT_EQ(NumObjects, 1);
+    }
+    EXPECT_EQ(NumObjects, 0);
+}
+
+TEST(Common_FlatHashMap, Reserve)
+{
+    FlatHashMap<int, int> Map;
+    Map.reserve(1000);
+    const auto Capacity = Map.bucket_count();
+    EXPECT_GE(Capacity, size_t{1000});
+
+    Map.emplace(0, 0);
+    const auto* pElem = &*Map.begin();
+    for (int i = 1; i < 1000; ++i)
+        Map.emplace(i, i);
+    // No rehash is expected
+    EXPECT_EQ(Map.bucket_count(), Capacity);
+    EXPECT_EQ(&*Map.find(0), pElem);
+
+    // Erasing and inserting elements must not grow the map indefinitely
+    for (int i = 1000; i < 100000; ++i)
+    {
+        Map.erase(i - 1000);
+        Map.emplace(i, i);
+    }
+    EXPECT_EQ(Map.size(), size_t{1000});
+    EXPECT_EQ(Map.bucket_count(), Capacity);
+}
+
+TEST(Common_FlatHashMap, STDAllocator)
+{
+    using MapElemType = std::pair<const int, std::string>;
+    FlatHashMap<int, std::string, std::hash<int>, std::equal_to<int>, STDAllocatorRawMem<MapElemType>> Map{
+        STD_ALLOCATOR_RAW_MEM(MapElemType, DefaultRawMemoryAllocator::GetAllocator(), "Allocator for FlatHashMap<int, std::string>"),
+    };
+    for (int i = 0; i < 100; ++i)
+        Map.emplace(i, std::to_string(i));
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(Map.find(i)->second, std::to_string(i));
+}
+
+TEST(Common_FlatHashMap, PointerKeys)
+{
+    constexpr size_t NumKeys = 10000;
+
+    FastRandInt         Rnd{0, 0, 0x3FFF};
+    std::vector<Uint64> Keys(NumKeys);
+    std::vector<Uint64> MissingKeys(NumKeys);
+    for (size_t i = 0; i < NumKeys; ++i)
+    {
+        // Use pointer-like keys that are identity-hashed by std::hash
+        const auto Rand = (static_cast<Uint64>(Rnd()) << 14) | static_cast<Uint64>(Rnd());
+        Keys[i]         = ((Rand << 20) | (i * 2)) * 16;
+        MissingKeys[i]  = ((Rand << 20) | (i * 2 + 1)) * 16;
+    }
+
+    FlatHashMap<Uint64, size_t> Map;
+    for (size_t i = 0; i < NumKeys; ++i)
+        EXPECT_TRUE(Map.emplace(Keys[i], i).second);
+    EXPECT_EQ(Map.size(), NumKeys);
+
+    for (size_t i = 0; i < NumKeys; ++i)
+    {
+        auto it = Map.find(Keys[i]);
+        ASSERT_NE(it, Map.end());
+        EXPECT_EQ(it->second, i);
+        EXPECT_EQ(Map.count(MissingKeys[i]), size_t{0});
+    }
+
+    for (auto Key : Keys)
+        EXPECT_EQ(Map.erase(Key), size_t{1});
+    EXPECT_TRUE(Map.empty());
+}
+
+} // namespace
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrustumCulling.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+float4x4 MakeViewProj(float AngleY, const float3& Pos)
+{
+    const auto View = float4x4::Translation(-Pos) * float4x4::RotationY(AngleY);
+    const auto Proj = float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 100.f, false);
+    return View * Proj;
+}
+
+struct BoxArrays
+{
+    explicit BoxArrays(size_t NumBoxes, unsigned int Seed)
+    {
+        FastRandFloat RndPos{Seed, -60.f, 60.f};
+        FastRandFloat RndSize{Seed + 1, 0.1f, 10.f};
+        FastRandFloat RndAngle{Seed + 2, 0.f, 2.f * PI_F};
+
+        AABBs.resize(NumBoxes);
+        OBBs.resize(NumBoxes);
+        for (auto& Arr : AABBData)
+            Arr.resize(NumBoxes);
+        for (auto& Arr : OBBData)
+            Arr.resize(NumBoxes);
+
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const float3 Center{RndPos(), RndPos() * 0.25f, RndPos()};
+            const float3 Extents{RndSize(), RndSize(), RndSize()};
+
+            auto& AABB = AABBs[i];
+            AABB.Min   = Center - Extents;
+            AABB.Max   = Center + Extents;
+            for (int c = 0; c < 3; ++c)
+            {
+                AABBData[c][i]     = AABB.Min[c];
+                AABBData[3 + c][i] = AABB.Max[c];
+            }
+
+            const auto Rotation = float3x3::RotationY(RndAngle()) * float3x3::RotationX(RndAngle());
+
+            auto& OBB  = OBBs[i];
+            OBB.Center = Center;
+            for (int a = 0; a < 3; ++a)
+            {
+                OBB.Axes[a]        = float3{Rotation[a][0], Rotation[a][1], Rotation[a][2]};
+                OBB.HalfExtents[a] = Extents[a];
+
+                OBBData[c_CenterIdx + a][i]      = Center[a];
+                OBBData[c_HalfExtentsIdx + a][i] = Extents[a];
+                for (int c = 0; c < 3; ++c)
+                    OBBData[c_AxesIdx + a * 3 + c][i] = OBB.Axes[a][c];
+            }
+        }
+
+        AABBSoA.MinX = AABBData[0].data();
+        AABBSoA.MinY = AABBData[1].data();
+        AABBSoA.MinZ = AABBData[2].data();
+        AABBSoA.MaxX = AABBData[3].data();
+        AABBSoA.MaxY = AABBData[4].data();
+        AABBSoA.MaxZ = AABBData[5].data();
+
+        OBBSoA.CenterX = OBBData[c_CenterIdx + 0].data();
+        OBBSoA.CenterY = OBBData[c_CenterIdx + 1].data();
+        OBBSoA.CenterZ = OBBData[c_CenterIdx + 2].data();
+        for (int a = 0; a < 3; ++a)
+        {
+            OBBSoA.HalfExtents[a] = OBBData[c_HalfExtentsIdx + a].data();
+            for (int c = 0; c < 3; ++c)
+                OBBSoA.Axes[a][c] = OBBData[c_AxesIdx + a * 3 + c].data();
+        }
+    }
+
+    static constexpr size_t c_CenterIdx      = 0;
+    static constexpr size_t c_HalfExtentsIdx = 3;
+    static constexpr size_t c_AxesIdx        = 6;
+
+    std::vector<BoundBox>            AABBs;
+    std::vector<OrientedBoundingBox> OBBs;
+
+    std::vector<float> AABBData[6];
+    std::vector<float> OBBData[15];
+
+    BoundBoxSoA            AABBSoA;
+    OrientedBoundingBoxSoA OBBSoA;
+};
+
+template <typename FrustumType, typename BoxType, typename BoxSoAType>
+void TestBoxes(const FrustumType&          Frustum,
+               const std::vector<BoxType>& Boxes,
+               const BoxSoAType&           BoxesSoA,
+               FRUSTUM_PLANE_FLAGS         PlaneFlags,
+               IThreadPool*                pThreadPool = nullptr)
+{
+    const auto NumBoxes = Boxes.size();
+
+    std::vector<BoxVisibility> Visibility(NumBoxes);
+    GetBoxesVisibility(Frustum, BoxesSoA, NumBoxes, Visibility.data(), PlaneFlags, pThreadPool);
+
+    std::vector<Uint32> Mask((NumBoxes + 31) / 32, 0xDEADBEEF);
+    GetBoxesVisibilityMask(Frustum, BoxesSoA, NumBoxes, Mask.data(), PlaneFlags, pThreadPool);
+
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const auto RefVisibility = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags);
+        EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i << " of " << NumBoxes;
+
+        const bool IsVisible = (Mask[i / 32] & (1u << (i % 32))) != 0;
+        EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i << " of " << NumBoxes;
+    }
+
+    if (NumBoxes % 32 != 0)
+    {
+        // Bits beyond the last box must be cleared
+        EXPECT_EQ(Mask.back() >> (NumBoxes % 32), 0u);
+    }
+}
+
+template <typename FrustumType>
+void TestFrustum(FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    FrustumType Frustum;
+    ExtractViewFrustumPlanesFromMatrix(MakeViewProj(0.7f, float3{1, 2, -3}), Frustum, false);
+
+    std::vector<size_t> BoxCounts;
+    for (size_t i = 1; i <= 37; ++i)
+        BoxCounts.push_back(i);
+    BoxCounts.push_back(1000);
+
+    for (auto NumBoxes : BoxCounts)
+    {
+        BoxArrays Boxes{NumBoxes, static_cast<unsigned int>(NumBoxes)};
+        TestBoxes(Frustum, Boxes.AABBs, Boxes.AABBSoA, PlaneFlags);
+        TestBoxes(Frustum, Boxes.OBBs, Boxes.OBBSoA, PlaneFlags);
+    }
+}
+
+TEST(Common_FrustumCulling, ViewFrustum)
+{
+    TestFrustum<ViewFrustum>(FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+    TestFrustum<ViewFrustum>(FRUSTUM_PLANE_FLAG_OPEN_NEAR);
+    TestFrustum<ViewFrustum>(FRUSTUM_PLANE_FLAG_LEFT_PLANE | FRUSTUM_PLANE_FLAG_TOP_PLANE);
+    TestFrustum<ViewFrustum>(FRUSTUM_PLANE_FLAG_NONE);
+}
+
+TEST(Common_FrustumCulling, ViewFrustumExt)
+{
+    TestFrustum<ViewFrustumExt>(FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+    TestFrustum<ViewFrustumExt>(FRUSTUM_PLANE_FLAG_OPEN_NEAR);
+    TestFrustum<ViewFrustumExt>(FRUSTUM_PLANE_FLAG_LEFT_PLANE | FRUSTUM_PLANE_FLAG_TOP_PLANE);
+    TestFrustum<ViewFrustumExt>(FRUSTUM_PLANE_FLAG_NONE);
+}
+
+TEST(Common_FrustumCulling, ThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(MakeViewProj(0.7f, float3{1, 2, -3}), Frustum, false);
+
+    // Box counts that are not multiples of the block size
+    for (size_t NumBoxes : {size_t{1000}, size_t{5000}, size_t{10017}})
+    {
+        BoxArrays Boxes{NumBoxes, static_cast<unsigned int>(NumBoxes)};
+        TestBoxes(Frustum, Boxes.AABBs, Boxes.AABBSoA, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, pThreadPool);
+        TestBoxes(Frustum, Boxes.OBBs, Boxes.OBBSoA, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, pThreadPool);
+    }
+}
+
+} // namespace
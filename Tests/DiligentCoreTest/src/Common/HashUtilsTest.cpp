@@ -32,6 +32,7 @@
 
 #include "HashUtils.hpp"
 #include "XXH128Hasher.hpp"
+#include "FastRand.hpp"
 #include "GraphicsTypesOutputInserters.hpp"
 
 #include "gtest/gtest.h"
@@ -186,6 +187,38 @@ TEST(Common_HashUtils, ComputeHashRaw)
     }
 }
 
+TEST(Common_HashUtils, ComputeHashRawLarge)
+{
+    std::vector<Uint8> RefData(4096);
+    FastRandInt        Rnd{0, 0, 255};
+    for (auto& Byte : RefData)
+        Byte = static_cast<Uint8>(Rnd());
+
+    std::unordered_set<size_t> Hashes;
+    for (size_t size : {17, 64, 128, 129, 240, 241, 1000, 1024, 4095, 4096})
+    {
+        const auto RefHash = ComputeHashRaw(RefData.data(), size);
+        EXPECT_TRUE(Hashes.insert(RefHash).second) << size;
+
+        // The hash must not depend on the data alignment
+        for (size_t offset = 1; offset < 16; ++offset)
+        {
+            std::vector<Uint8> Data(size + offset);
+            std::copy(RefData.begin(), RefData.begin() + size, Data.begin() + offset);
+            EXPECT_EQ(ComputeHashRaw(&Data[offset], size), RefHash) << offset << " " << size;
+        }
+
+        // Every byte must affect the hash
+        std::vector<Uint8> Data{RefData.begin(), RefData.begin() + size};
+        for (size_t i : {size_t{0}, size / 2, size - 1})
+        {
+            Data[i] ^= 1;
+            EXPECT_NE(ComputeHashRaw(Data.data(), size), RefHash) << i << " " << size;
+            Data[i] ^= 1;
+        }
+    }
+}
+
 
 template <typename Type>
 class StdHasherTestHelper
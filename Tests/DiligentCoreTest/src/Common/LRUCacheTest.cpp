@@ -43,9 +43,10 @@ struct CacheData
     Uint32 Value = ~0u;
 };
 
-TEST(Common_LRUCache, Get)
+template <typename CacheType>
+void TestGet()
 {
-    LRUCache<int, CacheData> Cache{16};
+    CacheType Cache{16};
 
     constexpr Uint32         NumThreads = 16;
     std::vector<std::thread> Threads(NumThreads);
@@ -81,9 +82,10 @@ TEST(Common_LRUCache, Get)
 }
 
 
-TEST(Common_LRUCache, ReleaseQueue)
+template <typename CacheType>
+void TestReleaseQueue()
 {
-    LRUCache<int, CacheData> Cache{16};
+    CacheType Cache{16};
 
     constexpr Uint32                    NumThreads = 16;
     std::vector<std::thread>            Threads(NumThreads);
@@ -127,9 +129,10 @@ TEST(Common_LRUCache, ReleaseQueue)
 }
 
 
-TEST(Common_LRUCache, Exceptions)
+template <typename CacheType>
+void TestExceptions()
 {
-    LRUCache<int, CacheData> Cache{16};
+    CacheType Cache{16};
 
     constexpr Uint32                    NumThreads = 15; // Use odd number
     std::vector<std::thread>            Threads(NumThreads);
@@ -183,4 +186,125 @@ TEST(Common_LRUCache, Exceptions)
     }
 }
 
+TEST(Common_LRUCache, Get)
+{
+    TestGet<LRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, ReleaseQueue)
+{
+    TestReleaseQueue<LRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, Exceptions)
+{
+    TestExceptions<LRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, Get_Sharded)
+{
+    TestGet<ShardedLRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, ReleaseQueue_Sharded)
+{
+    TestReleaseQueue<ShardedLRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, Exceptions_Sharded)
+{
+    TestExceptions<ShardedLRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, Eviction_Sharded)
+{
+    ShardedLRUCache<int, CacheData> Cache{16, 4};
+    EXPECT_EQ(Cache.GetNumShards(), size_t{4});
+
+    auto Get = [&](int Key) {
+        bool Initialized = false;
+
+        const auto Data = Cache.Get(Key,
+                                    [&](CacheData& Data, size_t& Size) //
+                                    {
+                                        Data.Value  = static_cast<Uint32>(Key);
+                                        Size        = 1;
+                                        Initialized = true;
+                                    });
+        EXPECT_EQ(Data.Value, static_cast<Uint32>(Key));
+        return Initialized;
+    };
+
+    for (int i = 0; i < 16; ++i)
+        EXPECT_TRUE(Get(i));
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{16});
+
+    // All keys are in the cache
+    for (int i = 0; i < 16; ++i)
+        EXPECT_FALSE(Get(i));
+
+    for (int i = 16; i < 64; ++i)
+    {
+        EXPECT_TRUE(Get(i));
+        EXPECT_LE(Cache.GetCurrSize(), size_t{16});
+        // Keep accessing the hot key. It must never be evicted as it is referenced between the sweeps.
+        EXPECT_FALSE(Get(0)) << "The hot key was evicted after adding key " << i;
+    }
+
+    Cache.SetMaxSize(4);
+    EXPECT_TRUE(Get(100));
+    EXPECT_LE(Cache.GetCurrSize(), size_t{4});
+}
+
+template <typename CacheType>
+void TestHotKeys(Uint32 NumThreads)
+{
+    constexpr Uint32 NumIterations = 2000;
+    // A small set of hot keys that all threads access
+    constexpr int NumHotKeys = 32;
+
+    CacheType Cache{NumHotKeys * 4};
+
+    std::vector<std::thread> Threads(NumThreads);
+    std::atomic<Uint32>      NumErrors{0};
+
+    Threading::Signal StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+                for (Uint32 iter = 0; iter < NumIterations; ++iter)
+                {
+                    const int  Key  = static_cast<int>((iter * 7 + ThreadId) % NumHotKeys);
+                    const auto Data = Cache.Get(Key,
+                                                [&](CacheData& Data, size_t& Size) //
+                                                {
+                                                    Data.Value = static_cast<Uint32>(Key);
+                                                    Size       = 1;
+                                                });
+                    if (Data.Value != static_cast<Uint32>(Key))
+                        NumErrors.fetch_add(1);
+                }
+            },
+            i);
+    }
+
+    StartSignal.Trigger(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors.load(), 0u);
+    EXPECT_LE(Cache.GetCurrSize(), size_t{NumHotKeys});
+}
+
+TEST(Common_LRUCache, HotKeys)
+{
+    for (Uint32 NumThreads : {1, 4, 16})
+    {
+        TestHotKeys<LRUCache<int, CacheData>>(NumThreads);
+        TestHotKeys<ShardedLRUCache<int, CacheData>>(NumThreads);
+    }
+}
+
 } // namespace
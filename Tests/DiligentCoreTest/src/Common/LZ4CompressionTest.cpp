@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LZ4Compression.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void TestRoundTrip(const std::vector<Uint8>& Src, size_t MaxCompressedSize = ~size_t{0})
+{
+    std::vector<Uint8> Compressed(LZ4CompressBound(Src.size()));
+
+    const auto CompressedSize = LZ4Compress(Src.data(), Src.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    EXPECT_LE(CompressedSize, MaxCompressedSize);
+
+    std::vector<Uint8> Decompressed(Src.size());
+    EXPECT_TRUE(LZ4Decompress(Compressed.data(), CompressedSize, Decompressed.data(), Decompressed.size()));
+    EXPECT_EQ(Decompressed, Src);
+}
+
+TEST(Common_LZ4Compression, Empty)
+{
+    TestRoundTrip({});
+}
+
+TEST(Common_LZ4Compression, Small)
+{
+    for (size_t Size = 1; Size < 32; ++Size)
+    {
+        std::vector<Uint8> Src(Size);
+        for (size_t i = 0; i < Size; ++i)
+            Src[i] = static_cast<Uint8>(i % 3);
+        TestRoundTrip(Src);
+    }
+}
+
+TEST(Common_LZ4Compression, Repetitive)
+{
+    // Overlapping matches and long match lengths
+    TestRoundTrip(std::vector<Uint8>(100000, 42), 1024);
+
+    std::vector<Uint8> Src(256 << 10);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>((i % 251) ^ (i / 4096));
+    TestRoundTrip(Src, Src.size() / 4);
+}
+
+TEST(Common_LZ4Compression, Random)
+{
+    // Incompressible data and long literal runs
+    FastRandInt Rnd{0, 0, 255};
+
+    std::vector<Uint8> Src(100000);
+    for (auto& Byte : Src)
+        Byte = static_cast<Uint8>(Rnd());
+    TestRoundTrip(Src);
+
+    // Random data with repeated fragments
+    for (size_t i = 0; i + 2048 <= Src.size(); i += 4096)
+        memcpy(&Src[i + 1024], &Src[i], 1024);
+    TestRoundTrip(Src);
+}
+
+TEST(Common_LZ4Compression, InsufficientCapacity)
+{
+    std::vector<Uint8> Src(1024);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>(i * 7);
+
+    std::vector<Uint8> Compressed(LZ4CompressBound(Src.size()));
+    const auto         CompressedSize = LZ4Compress(Src.data(), Src.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+
+    EXPECT_EQ(LZ4Compress(Src.data(), Src.size(), Compressed.data(), CompressedSize - 1), size_t{0});
+}
+
+TEST(Common_LZ4Compression, InvalidData)
+{
+    std::vector<Uint8> Src(4096);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>(i / 16);
+
+    std::vector<Uint8> Compressed(LZ4CompressBound(Src.size()));
+    const auto         CompressedSize = LZ4Compress(Src.data(), Src.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+
+    std::vector<Uint8> Decompressed(Src.size() + 1);
+    // Wrong decompressed size
+    EXPECT_FALSE(LZ4Decompress(Compressed.data(), CompressedSize, Decompressed.data(), Src.size() - 1));
+    EXPECT_FALSE(LZ4Decompress(Compressed.data(), CompressedSize, Decompressed.data(), Src.size() + 1));
+    // Truncated data
+    EXPECT_FALSE(LZ4Decompress(Compressed.data(), CompressedSize / 2, Decompressed.data(), Src.size()));
+
+    // Corrupted data must never result in out-of-bounds access
+    FastRandInt Rnd{1, 0, 255};
+    FastRandInt PosRnd{2, 0, static_cast<int>(CompressedSize - 1)};
+    for (Uint32 i = 0; i < 1000; ++i)
+    {
+        auto Corrupted = Compressed;
+        for (Uint32 j = 0; j < 4; ++j)
+            Corrupted[PosRnd()] = static_cast<Uint8>(Rnd());
+        LZ4Decompress(Corrupted.data(), CompressedSize, Decompressed.data(), Src.size());
+    }
+}
+
+} // namespace
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Wraps float to instantiate the generic versions of the matrix functions,
+// which are replaced with the SIMD implementations for float.
+struct ScalarFloat
+{
+    float f = 0;
+
+    constexpr ScalarFloat() noexcept {}
+    constexpr ScalarFloat(float _f) noexcept :
+        f{_f} {}
+
+    constexpr explicit operator float() const { return f; }
+
+    // clang-format off
+    constexpr ScalarFloat operator+(ScalarFloat r) const { return f + r.f; }
+    constexpr ScalarFloat operator-(ScalarFloat r) const { return f - r.f; }
+    constexpr ScalarFloat operator*(ScalarFloat r) const { return f * r.f; }
+    constexpr ScalarFloat operator/(ScalarFloat r) const { return f / r.f; }
+    constexpr ScalarFloat operator-()              const { return -f; }
+
+    ScalarFloat& operator+=(ScalarFloat r) { f += r.f; return *this; }
+    ScalarFloat& operator-=(ScalarFloat r) { f -= r.f; return *this; }
+    ScalarFloat& operator*=(ScalarFloat r) { f *= r.f; return *this; }
+    // clang-format on
+};
+
+using ScalarFloat4x4 = Matrix4x4<ScalarFloat>;
+
+ScalarFloat4x4 ToScalar(const float4x4& m)
+{
+    return ScalarFloat4x4::MakeMatrix(m.Data());
+}
+
+float4x4 FromScalar(const ScalarFloat4x4& m)
+{
+    return float4x4::MakeMatrix(m.Data());
+}
+
+float4x4 RandomMatrix(FastRandFloat& Rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 16; ++i)
+        m.Data()[i] = Rnd();
+    return m;
+}
+
+std::vector<float4x4> RandomMatrices(size_t Count, unsigned int Seed)
+{
+    FastRandFloat Rnd{Seed, -10.f, 10.f};
+
+    std::vector<float4x4> Matrices(Count);
+    for (auto& m : Matrices)
+        m = RandomMatrix(Rnd);
+    return Matrices;
+}
+
+TEST(Common_BasicMathSIMD, MatrixMultiply)
+{
+    const auto Matrices = RandomMatrices(256, 0);
+    for (size_t i = 0; i + 1 < Matrices.size(); ++i)
+    {
+        const auto& m1 = Matrices[i];
+        const auto& m2 = Matrices[i + 1];
+        EXPECT_EQ(m1 * m2, FromScalar(ToScalar(m1) * ToScalar(m2)));
+    }
+
+    // Negative zeros must be handled the same way as in the generic version
+    const float4x4 m1{-0.f};
+    const float4x4 m2 = float4x4::Identity();
+    const float4x4 m  = m1 * m2;
+    const float4x4 r  = FromScalar(ToScalar(m1) * ToScalar(m2));
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(std::signbit(m.Data()[i]), std::signbit(r.Data()[i]));
+}
+
+TEST(Common_BasicMathSIMD, MatrixTranspose)
+{
+    for (const auto& m : RandomMatrices(16, 1))
+    {
+        EXPECT_EQ(m.Transpose(), FromScalar(ToScalar(m).Transpose()));
+        EXPECT_EQ(m.Transpose().Transpose(), m);
+    }
+}
+
+TEST(Common_BasicMathSIMD, MatrixInverse)
+{
+    for (const auto& m : RandomMatrices(256, 2))
+    {
+        const auto inv    = m.Inverse();
+        const auto RefInv = FromScalar(ToScalar(m).Inverse());
+
+        // Scale the tolerance by the largest element of the inverse matrix
+        float MaxElement = 0;
+        for (int i = 0; i < 16; ++i)
+            MaxElement = std::max(MaxElement, std::abs(RefInv.Data()[i]));
+
+        for (int i = 0; i < 16; ++i)
+            EXPECT_NEAR(inv.Data()[i], RefInv.Data()[i], MaxElement * 1e-4f);
+    }
+
+    {
+        const auto m = float4x4::Scale(2, 4, 8) * float4x4::RotationY(0.5f) * float4x4::Translation(1, 2, 3);
+
+        const auto identity = m * m.Inverse();
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+                EXPECT_NEAR(identity[i][j], i == j ? 1.f : 0.f, 1e-6f);
+        }
+    }
+}
+
+TEST(Common_BasicMathSIMD, TransformVectors)
+{
+    FastRandFloat Rnd{3, -100.f, 100.f};
+
+    const auto m = RandomMatrix(Rnd);
+
+    std::vector<float4> Vectors(37);
+    for (auto& v : Vectors)
+        v = float4{Rnd(), Rnd(), Rnd(), Rnd()};
+
+    std::vector<float4> Transformed(Vectors.size());
+    TransformVectors(Vectors.data(), Transformed.data(), Vectors.size(), m);
+    for (size_t i = 0; i < Vectors.size(); ++i)
+        EXPECT_EQ(Transformed[i], Vectors[i] * m);
+
+    // In-place transformation
+    TransformVectors(Vectors.data(), Vectors.data(), Vectors.size(), m);
+    EXPECT_EQ(Vectors, Transformed);
+}
+
+TEST(Common_BasicMathSIMD, TransformPoints)
+{
+    FastRandFloat Rnd{4, -100.f, 100.f};
+
+    const auto m = float4x4::RotationX(0.3f) * float4x4::Translation(1, 2, 3) * float4x4::Projection(PI_F / 4.f, 1.5f, 0.5f, 100.f, false);
+
+    std::vector<float3> Points(37);
+    for (auto& p : Points)
+        p = float3{Rnd(), Rnd(), Rnd()};
+
+    std::vector<float3> Transformed(Points.size());
+    TransformPoints(Points.data(), Transformed.data(), Points.size(), m);
+    for (size_t i = 0; i < Points.size(); ++i)
+        EXPECT_EQ(Transformed[i], Points[i] * m);
+
+    // In-place transformation
+    TransformPoints(Points.data(), Points.data(), Points.size(), m);
+    EXPECT_EQ(Points, Transformed);
+}
+
+} // namespace
@@ -25,6 +25,7 @@
  */
 
 #include <cstring>
+#include <vector>
 
 #include "Serializer.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -172,4 +173,118 @@ TEST(SerializerTest, SerializerTest)
     }
 }
 
+TEST(SerializerTest, InPlaceArrays)
+{
+    const Uint8  RefU8                   = 0x39;
+    const Uint32 RefArraySize            = 5;
+    const Uint32 RefArray[RefArraySize]  = {0x1251, 0x620, 0x8816, 0x74382, 0x3129};
+    const Uint32 RefArray2Size           = 3;
+    const Uint64 RefArray2[RefArray2Size] = {0x12345678ABCDEF01ull, 0x7, 0xFEDCBA9876543210ull};
+
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const auto WriteData = [&](auto& Ser) {
+        Uint32        ArraySize  = RefArraySize;
+        const Uint32* pArray     = RefArray;
+        Uint32        Array2Size = RefArray2Size;
+        const Uint64* pArray2    = RefArray2;
+        EXPECT_TRUE(Ser(RefU8));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, pArray, ArraySize));
+        EXPECT_TRUE(Ser(RefU8));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, pArray2, Array2Size));
+    };
+
+    Serializer<SerializerMode::Measure> MSer;
+    WriteData(MSer);
+
+    auto Data = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{Data};
+        WriteData(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    const auto IsInData = [](const SerializedData& Data, const void* Ptr) {
+        const auto* pStart = static_cast<const Uint8*>(Data.Ptr());
+        return Ptr >= pStart && Ptr < pStart + Data.Size();
+    };
+
+    const auto ReadData = [&](const SerializedData& SrcData, bool InPlaceArrays, bool ExpectInPlace) {
+        DynamicLinearAllocator Allocator{RawAllocator};
+
+        Serializer<SerializerMode::Read> RSer{SrcData, InPlaceArrays};
+        EXPECT_EQ(RSer.HasInPlaceArrays(), InPlaceArrays);
+
+        Uint8         U8        = 0;
+        Uint32        ArraySize = 0;
+        const Uint32* pArray    = nullptr;
+        EXPECT_TRUE(RSer(U8));
+        EXPECT_EQ(U8, RefU8);
+        EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pArray, ArraySize));
+        ASSERT_EQ(ArraySize, RefArraySize);
+        EXPECT_EQ(IsInData(SrcData, pArray), ExpectInPlace);
+        for (Uint32 i = 0; i < RefArraySize; ++i)
+            EXPECT_EQ(pArray[i], RefArray[i]);
+
+        // Pointers to non-const elements are never set to the source data
+        Uint32  Array2Size = 0;
+        Uint64* pArray2    = nullptr;
+        EXPECT_TRUE(RSer(U8));
+        EXPECT_EQ(U8, RefU8);
+        EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pArray2, Array2Size));
+        ASSERT_EQ(Array2Size, RefArray2Size);
+        EXPECT_FALSE(IsInData(SrcData, pArray2));
+        for (Uint32 i = 0; i < RefArray2Size; ++i)
+            EXPECT_EQ(pArray2[i], RefArray2[i]);
+
+        EXPECT_TRUE(RSer.IsEnded());
+    };
+
+    ReadData(Data, false, false);
+    ReadData(Data, true, true);
+
+    // Misaligned source data: the arrays must be copied
+    {
+        std::vector<Uint8> Buffer(Data.Size() + 1);
+        std::memcpy(&Buffer[1], Data.Ptr(), Data.Size());
+        ReadData(SerializedData{&Buffer[1], Data.Size()}, true, false);
+    }
+}
+
+TEST(SerializerTest, TruncatedAlignment)
+{
+    const Uint8   RefU8         = 0x39;
+    Uint32        RefArraySize  = 1;
+    const Uint32  RefArray[]    = {0x1251};
+    const Uint32* pRefArray     = RefArray;
+    auto&         RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    Serializer<SerializerMode::Measure> MSer;
+    EXPECT_TRUE(MSer(RefU8));
+    EXPECT_TRUE(MSer.SerializeArrayRaw(nullptr, pRefArray, RefArraySize));
+
+    auto Data = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{Data};
+        EXPECT_TRUE(WSer(RefU8));
+        EXPECT_TRUE(WSer.SerializeArrayRaw(nullptr, pRefArray, RefArraySize));
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    // Cut the data right after the array size, so that the alignment padding
+    // before the array elements is past the end of the data.
+    constexpr size_t TruncatedSize = sizeof(Uint8) + sizeof(Uint32);
+    static_assert(TruncatedSize % alignof(Uint32) != 0, "The array must not be aligned");
+
+    DynamicLinearAllocator Allocator{RawAllocator};
+
+    Serializer<SerializerMode::Read> RSer{SerializedData{Data.Ptr(), TruncatedSize}};
+
+    Uint8         U8        = 0;
+    Uint32        ArraySize = 0;
+    const Uint32* pArray    = nullptr;
+    EXPECT_TRUE(RSer(U8));
+    EXPECT_FALSE(RSer.SerializeArrayRaw(&Allocator, pArray, ArraySize));
+}
+
 } // namespace
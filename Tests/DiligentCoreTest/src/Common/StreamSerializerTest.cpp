@@ -0,0 +1,208 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "StreamSerializer.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const char* const RefStr      = "serialized text";
+const char* const RefEmptyStr = "";
+const Uint64      RefU64      = 0x12345678ABCDEF01ull;
+const Uint8       RefU8       = 0x72;
+const Uint32      RefU32      = 0x52830394u;
+const Uint16      RefU16      = 0x4172;
+
+std::vector<Uint8> MakeBytes(size_t Size, Uint8 Seed)
+{
+    std::vector<Uint8> Bytes(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Bytes[i] = static_cast<Uint8>(Seed + i * 7);
+    return Bytes;
+}
+
+// Small byte arrays go through the staging buffer, large ones are written directly
+const std::vector<Uint8> RefBytes1 = MakeBytes(5, 11);
+const std::vector<Uint8> RefBytes2 = MakeBytes(1000, 29);
+const std::vector<Uint8> RefBytes3 = MakeBytes(3, 47);
+
+template <typename SerializerType>
+void WriteData(SerializerType& Ser)
+{
+    EXPECT_TRUE(Ser(RefU16));
+    EXPECT_TRUE(Ser(RefStr));
+    EXPECT_TRUE(Ser(RefEmptyStr));
+    EXPECT_TRUE(Ser(RefU64, RefU8));
+    EXPECT_TRUE(Ser.SerializeBytes(RefBytes1.data(), RefBytes1.size()));
+    EXPECT_TRUE(Ser(RefU32));
+    EXPECT_TRUE(Ser.SerializeBytes(RefBytes2.data(), RefBytes2.size(), 16));
+    EXPECT_TRUE(Ser(RefU8));
+    EXPECT_TRUE(Ser.Serialize(SerializedData{const_cast<Uint8*>(RefBytes3.data()), RefBytes3.size()}));
+    EXPECT_TRUE(Ser.CopyBytes(RefBytes2.data(), RefBytes2.size()));
+    EXPECT_TRUE(Ser(RefU16));
+}
+
+template <typename SerializerType>
+void ReadData(SerializerType& Ser)
+{
+    Uint16 U16 = 0;
+    EXPECT_TRUE(Ser(U16));
+    EXPECT_EQ(U16, RefU16);
+
+    const char* Str = nullptr;
+    EXPECT_TRUE(Ser(Str));
+    EXPECT_STREQ(Str, RefStr);
+
+    const char* EmptyStr = nullptr;
+    EXPECT_TRUE(Ser(EmptyStr));
+    EXPECT_STREQ(EmptyStr, RefEmptyStr);
+
+    Uint64 U64 = 0;
+    Uint8  U8  = 0;
+    EXPECT_TRUE(Ser(U64, U8));
+    EXPECT_EQ(U64, RefU64);
+    EXPECT_EQ(U8, RefU8);
+
+    const void* pBytes   = nullptr;
+    size_t      NumBytes = 0;
+    EXPECT_TRUE(Ser.SerializeBytes(pBytes, NumBytes));
+    ASSERT_EQ(NumBytes, RefBytes1.size());
+    EXPECT_EQ(std::memcmp(pBytes, RefBytes1.data(), NumBytes), 0);
+
+    Uint32 U32 = 0;
+    EXPECT_TRUE(Ser(U32));
+    EXPECT_EQ(U32, RefU32);
+
+    EXPECT_TRUE(Ser.SerializeBytes(pBytes, NumBytes, 16));
+    ASSERT_EQ(NumBytes, RefBytes2.size());
+    EXPECT_EQ(reinterpret_cast<size_t>(pBytes) % 16, size_t{0});
+    EXPECT_EQ(std::memcmp(pBytes, RefBytes2.data(), NumBytes), 0);
+
+    EXPECT_TRUE(Ser(U8));
+    EXPECT_EQ(U8, RefU8);
+
+    SerializedData Data;
+    EXPECT_TRUE(Ser.Serialize(Data));
+    ASSERT_EQ(Data.Size(), RefBytes3.size());
+    EXPECT_EQ(std::memcmp(Data.Ptr(), RefBytes3.data(), Data.Size()), 0);
+
+    std::vector<Uint8> Bytes(RefBytes2.size());
+    EXPECT_TRUE(Ser.CopyBytes(Bytes.data(), Bytes.size()));
+    EXPECT_EQ(Bytes, RefBytes2);
+
+    EXPECT_TRUE(Ser(U16));
+    EXPECT_EQ(U16, RefU16);
+
+    EXPECT_TRUE(Ser.IsEnded());
+}
+
+TEST(StreamSerializerTest, WriteRead)
+{
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    Serializer<SerializerMode::Measure> MSer;
+    WriteData(MSer);
+
+    auto RefData = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{RefData};
+        WriteData(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    for (size_t StagingBufferSize : {size_t{64}, size_t{100}, size_t{256}, StreamSerializer<SerializerMode::Write>::DefaultStagingBufferSize})
+    {
+        auto pBlob = DataBlobImpl::Create();
+        {
+            auto pStream = MemoryFileStream::Create(pBlob);
+
+            StreamSerializer<SerializerMode::Write> WSer{pStream, StagingBufferSize};
+            WriteData(WSer);
+            EXPECT_TRUE(WSer.Flush());
+            EXPECT_FALSE(WSer.HasFailed());
+            EXPECT_EQ(WSer.GetSize(), RefData.Size());
+        }
+
+        // The data layout must be the same as the one produced by Serializer
+        ASSERT_EQ(pBlob->GetSize(), RefData.Size());
+        EXPECT_EQ(std::memcmp(pBlob->GetConstDataPtr(), RefData.Ptr(), RefData.Size()), 0);
+
+        {
+            DynamicLinearAllocator Allocator{RawAllocator};
+
+            auto pStream = MemoryFileStream::Create(pBlob);
+
+            StreamSerializer<SerializerMode::Read> RSer{pStream, StagingBufferSize, &Allocator};
+            ReadData(RSer);
+            EXPECT_FALSE(RSer.HasFailed());
+            EXPECT_EQ(RSer.GetSize(), RefData.Size());
+        }
+    }
+
+    // Serializer must be able to read the data written by StreamSerializer
+    {
+        Serializer<SerializerMode::Read> RSer{RefData};
+        ReadData(RSer);
+    }
+}
+
+TEST(StreamSerializerTest, FlushOnDestroy)
+{
+    auto pBlob = DataBlobImpl::Create();
+    {
+        auto pStream = MemoryFileStream::Create(pBlob);
+
+        StreamSerializer<SerializerMode::Write> WSer{pStream};
+        EXPECT_TRUE(WSer(RefU64, RefU32));
+        EXPECT_EQ(pBlob->GetSize(), size_t{0});
+    }
+    ASSERT_EQ(pBlob->GetSize(), sizeof(RefU64) + sizeof(RefU32));
+
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    auto pStream = MemoryFileStream::Create(pBlob);
+
+    StreamSerializer<SerializerMode::Read> RSer{pStream, StreamSerializer<SerializerMode::Read>::DefaultStagingBufferSize, &Allocator};
+
+    Uint64 U64 = 0;
+    Uint32 U32 = 0;
+    EXPECT_TRUE(RSer(U64, U32));
+    EXPECT_EQ(U64, RefU64);
+    EXPECT_EQ(U32, RefU32);
+    EXPECT_TRUE(RSer.IsEnded());
+}
+
+} // namespace
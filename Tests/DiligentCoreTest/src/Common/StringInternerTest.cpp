@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "StringInterner.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_StringInterner, Intern)
+{
+    StringInterner Interner;
+
+    EXPECT_FALSE(Interner.Intern(nullptr));
+    EXPECT_FALSE(Interner.Find("g_Texture"));
+
+    const std::string Name1{"g_Texture"};
+    const std::string Name2{"g_Texture"};
+    ASSERT_NE(Name1.c_str(), Name2.c_str());
+
+    auto Str1 = Interner.Intern(Name1.c_str());
+    auto Str2 = Interner.Intern(Name2);
+    ASSERT_TRUE(Str1);
+    EXPECT_EQ(Str1, Str2);
+    EXPECT_EQ(Str1.GetStr(), Str2.GetStr());
+    EXPECT_NE(Str1.GetStr(), Name1.c_str());
+    EXPECT_STREQ(Str1.GetStr(), "g_Texture");
+    EXPECT_EQ(Str1.GetLength(), Name1.length());
+    EXPECT_EQ(Str1.GetHash(), Str2.GetHash());
+    EXPECT_EQ(Interner.Find("g_Texture"), Str1);
+    EXPECT_EQ(Interner.GetNumStrings(), 1u);
+
+    // Strings that do not need to be null-terminated
+    auto Str3 = Interner.Intern("g_Texture_sampler", 9);
+    EXPECT_EQ(Str3, Str1);
+
+    auto Str4 = Interner.Intern("g_Texture_sampler");
+    EXPECT_NE(Str4, Str1);
+    EXPECT_STREQ(Str4.GetStr(), "g_Texture_sampler");
+    EXPECT_EQ(Interner.Find("g_Texture_sampler", 9), Str1);
+
+    auto Empty1 = Interner.Intern("");
+    auto Empty2 = Interner.Intern("abc", 0);
+    ASSERT_TRUE(Empty1);
+    EXPECT_EQ(Empty1, Empty2);
+    EXPECT_STREQ(Empty1.GetStr(), "");
+    EXPECT_EQ(Empty1.GetLength(), 0u);
+    EXPECT_EQ(Interner.GetNumStrings(), 3u);
+
+    InternedString Null;
+    EXPECT_FALSE(Null);
+    EXPECT_EQ(Null.GetStr(), nullptr);
+    EXPECT_EQ(Null.GetLength(), 0u);
+    EXPECT_NE(Null, Empty1);
+
+    std::unordered_set<InternedString, InternedString::Hasher> Set{Str1, Str2, Str4, Empty1};
+    EXPECT_EQ(Set.size(), 3u);
+
+    // The global interner
+    const auto GlobalStr = InternString("Global string");
+    EXPECT_EQ(GlobalStr, StringInterner::GetGlobal().Find("Global string"));
+    EXPECT_EQ(GlobalStr, StringInterner::GetGlobal().Intern(std::string{"Global string"}));
+}
+
+TEST(Common_StringInterner, Grow)
+{
+    StringInterner Interner{DefaultRawMemoryAllocator::GetAllocator(), 4};
+
+    constexpr size_t NumStrings = 10000;
+
+    std::vector<InternedString> Handles;
+    for (size_t i = 0; i < NumStrings; ++i)
+        Handles.emplace_back(Interner.Intern("String " + std::to_string(i)));
+    EXPECT_EQ(Interner.GetNumStrings(), NumStrings);
+
+    for (size_t i = 0; i < NumStrings; ++i)
+    {
+        const auto Str = "String " + std::to_string(i);
+        EXPECT_EQ(Interner.Find(Str.c_str()), Handles[i]);
+        EXPECT_EQ(Interner.Intern(Str), Handles[i]);
+        // Handles remain valid after the table has grown
+        EXPECT_EQ(Str, Handles[i].GetStr());
+    }
+    EXPECT_EQ(Interner.GetNumStrings(), NumStrings);
+}
+
+TEST(Common_StringInterner, Multithreading)
+{
+    StringInterner Interner{DefaultRawMemoryAllocator::GetAllocator(), 16};
+
+    constexpr size_t NumStrings = 4096;
+    const size_t     NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::string> Strings(NumStrings);
+    for (size_t i = 0; i < NumStrings; ++i)
+        Strings[i] = "Variable " + std::to_string(i);
+
+    // Every thread interns all strings in a different order
+    std::vector<std::vector<InternedString>> Handles(NumThreads);
+    std::vector<std::thread>                 Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            auto& ThreadHandles = Handles[t];
+            ThreadHandles.resize(NumStrings);
+            for (size_t i = 0; i < NumStrings; ++i)
+            {
+                const size_t Idx   = (i * (2 * t + 1) + t * 97) % NumStrings;
+                ThreadHandles[Idx] = Interner.Intern(Strings[Idx]);
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Interner.GetNumStrings(), NumStrings);
+    for (size_t i = 0; i < NumStrings; ++i)
+    {
+        ASSERT_TRUE(Handles[0][i]);
+        EXPECT_EQ(Strings[i], Handles[0][i].GetStr());
+        for (size_t t = 1; t < NumThreads; ++t)
+            EXPECT_EQ(Handles[t][i], Handles[0][i]);
+    }
+}
+
+} // namespace
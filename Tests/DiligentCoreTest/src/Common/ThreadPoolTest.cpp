@@ -30,6 +30,7 @@
 
 #include <array>
 #include <cmath>
+#include <thread>
 
 #include "ThreadSignal.hpp"
 
@@ -39,11 +40,12 @@ using namespace Diligent;
 namespace
 {
 
-TEST(Common_ThreadPool, EnqueueTask)
+void TestEnqueueTask(THREAD_POOL_MODE Mode)
 {
     constexpr Uint32     NumThreads = 4;
     constexpr Uint32     NumTasks   = 32;
     ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
 
     std::array<std::atomic<bool>, NumThreads> ThreadStarted{};
 
@@ -57,6 +59,7 @@ TEST(Common_ThreadPool, EnqueueTask)
 
     auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
+    EXPECT_EQ(pThreadPool->GetNumThreads(), NumThreads);
 
     std::array<std::atomic<float>, NumTasks>        Results{};
     std::array<std::atomic<bool>, NumTasks>         WorkComplete{};
@@ -98,14 +101,29 @@ TEST(Common_ThreadPool, EnqueueTask)
     EXPECT_EQ(NumThreadsFinished.load(), PoolCI.NumThreads);
 }
 
+TEST(Common_ThreadPool, EnqueueTask)
+{
+    TestEnqueueTask(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
 
-TEST(Common_ThreadPool, ProcessTask)
+TEST(Common_ThreadPool, EnqueueTask_WorkStealing)
+{
+    TestEnqueueTask(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+
+void TestProcessTask(THREAD_POOL_MODE Mode)
 {
     constexpr Uint32 NumThreads = 4;
     constexpr Uint32 NumTasks   = 32;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{0});
+    ThreadPoolCreateInfo PoolCI{0};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
+    // Application threads are not counted
+    EXPECT_EQ(pThreadPool->GetNumThreads(), 0u);
 
     std::vector<std::thread> WorkerThreads(NumThreads);
     for (Uint32 i = 0; i < NumThreads; ++i)
@@ -160,6 +178,16 @@ TEST(Common_ThreadPool, ProcessTask)
     }
 }
 
+TEST(Common_ThreadPool, ProcessTask)
+{
+    TestProcessTask(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, ProcessTask_WorkStealing)
+{
+    TestProcessTask(THREAD_POOL_MODE_WORK_STEALING);
+}
+
 class WaitTask : public AsyncTaskBase
 {
 public:
@@ -169,7 +197,7 @@ public:
         m_WaitSignal{WaitSignal}
     {}
 
-    virtual void Run(Uint32 ThreadId) override final
+    virtual void DILIGENT_CALL_TYPE Run(Uint32 ThreadId) override final
     {
         m_WaitSignal.Wait();
         SetStatus(ASYNC_TASK_STATUS_COMPLETE);
@@ -187,17 +215,20 @@ public:
         AsyncTaskBase{pRefCounters, fPriority}
     {}
 
-    virtual void Run(Uint32 ThreadId) override final
+    virtual void DILIGENT_CALL_TYPE Run(Uint32 ThreadId) override final
     {
         SetStatus(ASYNC_TASK_STATUS_COMPLETE);
     }
 };
 
-TEST(Common_ThreadPool, RemoveTask)
+void TestRemoveTask(THREAD_POOL_MODE Mode)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -209,6 +240,14 @@ TEST(Common_ThreadPool, RemoveTask)
         pThreadPool->EnqueueTask(Task);
     }
 
+    if (Mode == THREAD_POOL_MODE_WORK_STEALING)
+    {
+        // Tasks with equal priority may start in any order, so make sure
+        // that all threads are blocked before enqueueing dummy tasks.
+        for (auto& Task : WaitTasks)
+            Task->WaitUntilRunning();
+    }
+
     std::array<RefCntAutoPtr<DummyTask>, 16> DummyTasks;
     for (auto& Task : DummyTasks)
     {
@@ -246,12 +285,25 @@ TEST(Common_ThreadPool, RemoveTask)
     EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
 }
 
+TEST(Common_ThreadPool, RemoveTask)
+{
+    TestRemoveTask(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
 
-TEST(Common_ThreadPool, Reprioritize)
+TEST(Common_ThreadPool, RemoveTask_WorkStealing)
+{
+    TestRemoveTask(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+
+void TestReprioritize(THREAD_POOL_MODE Mode)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -263,6 +315,14 @@ TEST(Common_ThreadPool, Reprioritize)
         pThreadPool->EnqueueTask(Task);
     }
 
+    if (Mode == THREAD_POOL_MODE_WORK_STEALING)
+    {
+        // Tasks with equal priority may start in any order, so make sure
+        // that all threads are blocked before enqueueing dummy tasks.
+        for (auto& Task : WaitTasks)
+            Task->WaitUntilRunning();
+    }
+
     std::array<RefCntAutoPtr<DummyTask>, 16> DummyTasks;
     for (auto& Task : DummyTasks)
     {
@@ -294,8 +354,95 @@ TEST(Common_ThreadPool, Reprioritize)
     pThreadPool->WaitForAllTasks();
 }
 
+TEST(Common_ThreadPool, Reprioritize)
+{
+    TestReprioritize(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, Reprioritize_WorkStealing)
+{
+    TestReprioritize(THREAD_POOL_MODE_WORK_STEALING);
+}
 
-TEST(Common_ThreadPool, Priorities)
+
+void TestRemoveWhileReprioritizing(THREAD_POOL_MODE Mode)
+{
+    constexpr Uint32 NumThreads  = 4;
+    constexpr Uint32 NumTasks    = 64;
+    constexpr Uint32 RepeatCount = 200;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    std::array<RefCntAutoPtr<WaitTask>, NumThreads> WaitTasks;
+    for (auto& Task : WaitTasks)
+    {
+        Task = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(Task);
+    }
+    // Make sure that dummy tasks can't start
+    for (auto& Task : WaitTasks)
+        Task->WaitUntilRunning();
+
+    for (Uint32 k = 0; k < RepeatCount; ++k)
+    {
+        std::vector<RefCntAutoPtr<DummyTask>> DummyTasks(NumTasks);
+        for (auto& Task : DummyTasks)
+        {
+            Task = MakeNewRCObj<DummyTask>()();
+            pThreadPool->EnqueueTask(Task);
+        }
+        // Tasks with non-zero priority are moved from the worker queues to the priority lane
+        for (Uint32 i = 0; i < NumTasks; ++i)
+            DummyTasks[i]->SetPriority(i % 2 == 0 ? 1.f : -1.f);
+
+        std::atomic<bool> Start{false};
+        std::thread       ReprioritizeThread{
+            [&]() //
+            {
+                while (!Start.load())
+                    std::this_thread::yield();
+                pThreadPool->ReprioritizeAllTasks();
+            }};
+
+        // Every task stays queued, so it must be removed even while it is being moved
+        Start.store(true);
+        for (Uint32 i = 0; i < NumTasks; ++i)
+        {
+            auto res = pThreadPool->RemoveTask(DummyTasks[i]);
+            EXPECT_TRUE(res) << "i=" << i << " (N=" << k << ")";
+        }
+
+        ReprioritizeThread.join();
+
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+        for (auto& Task : DummyTasks)
+            EXPECT_FALSE(Task->IsFinished());
+    }
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+TEST(Common_ThreadPool, RemoveWhileReprioritizing)
+{
+    TestRemoveWhileReprioritizing(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, RemoveWhileReprioritizing_WorkStealing)
+{
+    TestRemoveWhileReprioritizing(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+
+void TestPriorities(THREAD_POOL_MODE Mode)
 {
     constexpr Uint32 NumThreads  = 1;
     constexpr Uint32 NumTasks    = 8;
@@ -303,7 +450,10 @@ TEST(Common_ThreadPool, Priorities)
 
     for (Uint32 k = 0; k < RepeatCount; ++k)
     {
-        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.Mode = Mode;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
         ASSERT_NE(pThreadPool, nullptr);
 
         Threading::Signal       Signal;
@@ -356,4 +506,288 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+TEST(Common_ThreadPool, Priorities)
+{
+    TestPriorities(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, Priorities_WorkStealing)
+{
+    TestPriorities(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+void TestDependencies(THREAD_POOL_MODE Mode)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumLayers  = 8;
+    constexpr Uint32 LayerSize  = 16;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Every task in a layer depends on two tasks from the previous layer
+    std::array<std::array<RefCntAutoPtr<IAsyncTask>, LayerSize>, NumLayers> Tasks;
+    std::array<std::array<std::atomic<bool>, LayerSize>, NumLayers>         Finished{};
+    for (Uint32 layer = 0; layer < NumLayers; ++layer)
+    {
+        for (Uint32 i = 0; i < LayerSize; ++i)
+        {
+            auto Handler = [&Finished, layer, i](Uint32 ThreadId) //
+            {
+                if (layer > 0)
+                {
+                    EXPECT_TRUE(Finished[layer - 1][i]) << "layer=" << layer << " i=" << i;
+                    EXPECT_TRUE(Finished[layer - 1][(i + 1) % LayerSize]) << "layer=" << layer << " i=" << i;
+                }
+                Finished[layer][i].store(true);
+            };
+
+            if (layer == 0)
+            {
+                Tasks[layer][i] = EnqueueAsyncWork(pThreadPool, Handler);
+            }
+            else
+            {
+                IAsyncTask* Prerequisites[] = {Tasks[layer - 1][i], Tasks[layer - 1][(i + 1) % LayerSize]};
+                Tasks[layer][i]             = EnqueueAsyncWork(pThreadPool, Prerequisites, 2, Handler);
+            }
+        }
+    }
+
+    // Wait for the last task to make sure WaitForCompletion works with dependencies
+    Tasks[NumLayers - 1][0]->WaitForCompletion();
+    EXPECT_TRUE(Finished[NumLayers - 1][0]);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+
+    for (Uint32 layer = 0; layer < NumLayers; ++layer)
+    {
+        for (Uint32 i = 0; i < LayerSize; ++i)
+        {
+            EXPECT_EQ(Tasks[layer][i]->GetStatus(), ASYNC_TASK_STATUS_COMPLETE) << "layer=" << layer << " i=" << i;
+        }
+    }
+}
+
+TEST(Common_ThreadPool, Dependencies)
+{
+    TestDependencies(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, Dependencies_WorkStealing)
+{
+    TestDependencies(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+
+void TestRemoveDependentTask(THREAD_POOL_MODE Mode)
+{
+    ThreadPoolCreateInfo PoolCI{1};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+
+    // Prerequisite is enqueued after the dependent task
+    IAsyncTask* pPrerequisite = pWaitTask;
+
+    RefCntAutoPtr<DummyTask> pDependent0{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent0, &pPrerequisite, 1);
+
+    RefCntAutoPtr<DummyTask> pDependent1{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent1, &pPrerequisite, 1);
+
+    // Task that depends on the pending task
+    IAsyncTask*              pPendingPrerequisite = pDependent1;
+    RefCntAutoPtr<DummyTask> pDependent2{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent2, &pPendingPrerequisite, 1);
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 3u);
+
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 3u);
+    EXPECT_TRUE(pThreadPool->ReprioritizeTask(pDependent0));
+
+    // The task is waiting for the prerequisite and can be removed
+    EXPECT_TRUE(pThreadPool->RemoveTask(pDependent1));
+    EXPECT_FALSE(pThreadPool->RemoveTask(pDependent1));
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+
+    EXPECT_EQ(pWaitTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pDependent0->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pDependent1->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+    // The task is released when its prerequisite is removed
+    EXPECT_EQ(pDependent2->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+
+    // Finished prerequisites are ignored
+    RefCntAutoPtr<DummyTask> pDependent3{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent3, &pPrerequisite, 1);
+    pDependent3->WaitForCompletion();
+    EXPECT_EQ(pDependent3->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+}
+
+TEST(Common_ThreadPool, RemoveDependentTask)
+{
+    TestRemoveDependentTask(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, RemoveDependentTask_WorkStealing)
+{
+    TestRemoveDependentTask(THREAD_POOL_MODE_WORK_STEALING);
+}
+
+
+TEST(Common_ThreadPool, ParallelFor)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    auto TestRange = [](IThreadPool* pPool, int Begin, int End, int Grain) {
+        std::vector<std::atomic<int>> Counters(static_cast<size_t>(std::max(End, 0)) + 1);
+        ParallelFor(pPool, Begin, End, Grain,
+                    [&](int ChunkBegin, int ChunkEnd) //
+                    {
+                        EXPECT_LT(ChunkBegin, ChunkEnd);
+                        for (int i = ChunkBegin; i < ChunkEnd; ++i)
+                            Counters[i].fetch_add(1);
+                    });
+        for (int i = 0; i < static_cast<int>(Counters.size()); ++i)
+            EXPECT_EQ(Counters[i].load(), (i >= Begin && i < End) ? 1 : 0) << "i=" << i << " Begin=" << Begin << " End=" << End << " Grain=" << Grain;
+    };
+
+    TestRange(pThreadPool, 0, 0, 1);
+    TestRange(pThreadPool, 5, 3, 1);
+    TestRange(pThreadPool, 0, 1, 1);
+    TestRange(pThreadPool, 0, 1000, 0);
+    TestRange(pThreadPool, 3, 1000, 1);
+    TestRange(pThreadPool, 0, 10000, 7);
+    TestRange(pThreadPool, 17, 10000, 100000);
+    TestRange(nullptr, 0, 1000, 10);
+
+    // The calling thread must process the range even if the pool has no threads
+    {
+        auto pEmptyPool = CreateThreadPool(ThreadPoolCreateInfo{0});
+        TestRange(pEmptyPool, 0, 1000, 10);
+        // Process helper tasks left in the queue
+        while (pEmptyPool->GetQueueSize() > 0)
+            pEmptyPool->ProcessTask(0, false);
+    }
+
+    // Nested parallel loops
+    std::atomic<int> Sum{0};
+    ParallelFor(pThreadPool.RawPtr(), 0, 64, 1,
+                [&](int Begin, int End) //
+                {
+                    for (int i = Begin; i < End; ++i)
+                    {
+                        ParallelFor(pThreadPool.RawPtr(), 0, 100, 10,
+                                    [&](int InnerBegin, int InnerEnd) //
+                                    {
+                                        Sum.fetch_add(InnerEnd - InnerBegin);
+                                    });
+                    }
+                });
+    EXPECT_EQ(Sum.load(), 6400);
+
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_ThreadPool, ParallelReduce)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    auto TestRange = [](IThreadPool* pPool, Uint64 Begin, Uint64 End, Uint64 Grain) {
+        const auto Sum = ParallelReduce(
+            pPool, Begin, End, Grain, Uint64{0},
+            [](Uint64 ChunkBegin, Uint64 ChunkEnd, Uint64 Value) //
+            {
+                for (auto i = ChunkBegin; i < ChunkEnd; ++i)
+                    Value += i;
+                return Value;
+            },
+            [](Uint64 Value0, Uint64 Value1) //
+            {
+                return Value0 + Value1;
+            });
+
+        Uint64 RefSum = 0;
+        for (auto i = Begin; i < End; ++i)
+            RefSum += i;
+        EXPECT_EQ(Sum, RefSum) << "Begin=" << Begin << " End=" << End << " Grain=" << Grain;
+    };
+
+    TestRange(pThreadPool, 0, 0, 1);
+    TestRange(pThreadPool, 0, 1, 1);
+    TestRange(pThreadPool, 0, 100000, 1);
+    TestRange(pThreadPool, 13, 100000, 1000);
+    TestRange(nullptr, 0, 1000, 10);
+
+    pThreadPool->WaitForAllTasks();
+}
+
+
+void TestNestedTasks(THREAD_POOL_MODE Mode)
+{
+    constexpr Uint32 NumThreads   = 4;
+    constexpr Uint32 NumRootTasks = 256;
+    // Every root task enqueues child tasks from the worker thread
+    constexpr Uint32 NumChildTasks = 4;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.Mode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<Uint32> NumTasksCompleted{0};
+    for (Uint32 i = 0; i < NumRootTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [&NumTasksCompleted, pPool = pThreadPool.RawPtr()](Uint32 ThreadId) //
+                         {
+                             for (Uint32 c = 0; c < NumChildTasks; ++c)
+                             {
+                                 EnqueueAsyncWork(pPool,
+                                                  [&NumTasksCompleted](Uint32 ThreadId) //
+                                                  {
+                                                      NumTasksCompleted.fetch_add(1);
+                                                  });
+                             }
+                             NumTasksCompleted.fetch_add(1);
+                         });
+    }
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(NumTasksCompleted.load(), NumRootTasks * (1 + NumChildTasks));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+TEST(Common_ThreadPool, NestedTasks)
+{
+    TestNestedTasks(THREAD_POOL_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, NestedTasks_WorkStealing)
+{
+    TestNestedTasks(THREAD_POOL_MODE_WORK_STEALING);
+}
+
 } // namespace
@@ -25,9 +25,12 @@
  *  of the possibility of such damages.
  */
 
+#include <map>
+
 #include "VariableSizeGPUAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -183,6 +186,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
 
+    for (bool UseTLSF : {false, true})
     {
         const auto NumAllocs = 6;
         int        NumPerms  = 0;
@@ -192,7 +196,9 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
         do
         {
             ++NumPerms;
-            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+            VariableSizeAllocationsManager::CreateInfo CI{Allocator, NumAllocs * 4};
+            CI.UseTLSF = UseTLSF;
+            VariableSizeAllocationsManager ListMgr{CI};
 
             VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
             for (size_t a = 0; a < NumAllocs; ++a)
@@ -205,6 +211,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
             {
                 ListMgr.Free(std::move(allocs[ReleaseOrder[a]]));
             }
+            EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
         } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
         EXPECT_EQ(NumPerms, 720);
     }
@@ -249,4 +256,154 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree_TLSF)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    {
+        VariableSizeAllocationsManager::CreateInfo CI{Allocator, 128};
+        CI.UseTLSF = true;
+        VariableSizeAllocationsManager ListMgr{CI};
+        EXPECT_TRUE(ListMgr.IsTLSF());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+        EXPECT_EQ(ListMgr.GetFragmentation(), 0.f);
+
+        auto a1 = ListMgr.Allocate(17, 4);
+        EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+        EXPECT_EQ(a1.Size, OffsetType{20});
+        EXPECT_EQ(ListMgr.GetUsedSize(), size_t{20});
+
+        // The alignment padding is returned to the free list
+        auto a2 = ListMgr.Allocate(16, 32);
+        EXPECT_EQ(a2.UnalignedOffset, OffsetType{32});
+        EXPECT_EQ(a2.Size, OffsetType{32});
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+        EXPECT_EQ(ListMgr.GetFreeSize(), size_t{128 - 52});
+
+        auto a3 = ListMgr.Allocate(12, 4);
+        EXPECT_EQ(a3.UnalignedOffset, OffsetType{20});
+        EXPECT_EQ(a3.Size, OffsetType{12});
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+        auto a4 = ListMgr.Allocate(128, 1);
+        EXPECT_FALSE(a4.IsValid());
+
+        a4 = ListMgr.Allocate(64, 1);
+        EXPECT_EQ(a4.UnalignedOffset, OffsetType{64});
+        EXPECT_TRUE(ListMgr.IsFull());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{0});
+
+        ListMgr.Free(std::move(a3));
+        ListMgr.Free(std::move(a1));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{32});
+
+        ListMgr.Extend(64);
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{64});
+        EXPECT_NEAR(ListMgr.GetFragmentation(), 1.f / 3.f, 1e-6f);
+
+        auto a5 = ListMgr.Allocate(64, 64);
+        EXPECT_EQ(a5.UnalignedOffset, OffsetType{128});
+
+        ListMgr.Free(std::move(a4));
+        ListMgr.Free(std::move(a2));
+        ListMgr.Free(std::move(a5));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    }
+
+    {
+        VariableSizeAllocationsManager::CreateInfo CI{Allocator, 0};
+        CI.UseTLSF = true;
+        VariableSizeGPUAllocationsManager ListMgr{CI};
+        EXPECT_FALSE(ListMgr.Allocate(1, 1).IsValid());
+
+        ListMgr.Extend(1024);
+        auto a1 = ListMgr.Allocate(1000, 8);
+        EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+        ListMgr.Free(std::move(a1), 0);
+        ListMgr.ReleaseStaleAllocations(0);
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+void TestRandomAllocations(bool UseTLSF)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize = 1 << 20;
+
+    VariableSizeAllocationsManager::CreateInfo CI{Allocator, MaxSize};
+    CI.UseTLSF                   = UseTLSF;
+    CI.DbgDisableDebugValidation = true;
+    VariableSizeAllocationsManager ListMgr{CI};
+
+    FastRand Rnd{0};
+
+    // Allocations ordered by their offset
+    std::map<OffsetType, OffsetType> Allocations;
+    for (Uint32 i = 0; i < 10000; ++i)
+    {
+        if (Rnd() % 3 != 0 || Allocations.empty())
+        {
+            const OffsetType Size      = 1 + Rnd() % 1024;
+            const OffsetType Alignment = OffsetType{1} << (Rnd() % 9);
+
+            auto Alloc = ListMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+                continue;
+
+            const auto AlignedOffset = AlignUp(Alloc.UnalignedOffset, Alignment);
+            EXPECT_LE(AlignedOffset + Size, Alloc.UnalignedOffset + Alloc.Size);
+            EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, MaxSize);
+
+            // Check that the allocation does not overlap with the neighbors
+            auto NextIt = Allocations.lower_bound(Alloc.UnalignedOffset);
+            if (NextIt != Allocations.end())
+            {
+                EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, NextIt->first);
+            }
+            if (NextIt != Allocations.begin())
+            {
+                auto PrevIt = std::prev(NextIt);
+                EXPECT_LE(PrevIt->first + PrevIt->second, Alloc.UnalignedOffset);
+            }
+            Allocations.emplace(Alloc.UnalignedOffset, Alloc.Size);
+        }
+        else
+        {
+            auto it = Allocations.begin();
+            std::advance(it, Rnd() % Allocations.size());
+            ListMgr.Free(it->first, it->second);
+            Allocations.erase(it);
+        }
+    }
+
+    OffsetType UsedSize = 0;
+    for (const auto& Alloc : Allocations)
+        UsedSize += Alloc.second;
+    EXPECT_EQ(ListMgr.GetUsedSize(), UsedSize);
+
+    for (const auto& Alloc : Allocations)
+        ListMgr.Free(Alloc.first, Alloc.second);
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, RandomAllocations)
+{
+    TestRandomAllocations(false);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, RandomAllocations_TLSF)
+{
+    TestRandomAllocations(true);
+}
+
 } // namespace
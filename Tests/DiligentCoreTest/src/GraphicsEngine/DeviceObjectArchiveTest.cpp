@@ -0,0 +1,442 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "../../../../Graphics/GraphicsEngine/include/DeviceObjectArchive.hpp"
+#include "../../../../Graphics/GraphicsEngine/include/EngineMemory.h"
+
+#include <cstring>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "MemoryFileStream.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
+#include "ThreadPool.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using ResourceType = DeviceObjectArchive::ResourceType;
+using DeviceType   = DeviceObjectArchive::DeviceType;
+
+SerializedData MakeTestData(size_t Size, Uint8 Seed)
+{
+    SerializedData Data{Size, GetRawAllocator()};
+    for (size_t i = 0; i < Size; ++i)
+        Data.Ptr<Uint8>()[i] = static_cast<Uint8>(Seed + i);
+    return Data;
+}
+
+struct TestResourceData
+{
+    const char* Name  = nullptr;
+    Uint32      Value = 0;
+
+    bool Deserialize(const char* _Name, Serializer<SerializerMode::Read>& Ser)
+    {
+        Name = _Name;
+        return Ser(Value);
+    }
+};
+
+constexpr Uint32 TestContentVersion = 123;
+
+// NB: device-specific data of pipelines and shaders must contain shader indices, so only use other resource types
+const std::vector<std::pair<ResourceType, const char*>> TestResources = //
+    {
+        {ResourceType::RenderPass, "Render Pass 2"},
+        {ResourceType::ResourceSignature, "Signature B"},
+        {ResourceType::RenderPass, "Signature A"},
+        {ResourceType::ResourceSignature, "Signature A"},
+        {ResourceType::RenderPass, "Render Pass 1"},
+        {ResourceType::ResourceSignature, "Signature AA"},
+};
+
+void InitTestArchive(DeviceObjectArchive& Archive)
+{
+    for (Uint32 i = 0; i < TestResources.size(); ++i)
+    {
+        auto& ResData = Archive.GetResourceData(TestResources[i].first, TestResources[i].second);
+
+        ResData.Common = SerializedData{sizeof(Uint32), GetRawAllocator()};
+        {
+            Serializer<SerializerMode::Write> Ser{ResData.Common};
+            Ser(i);
+        }
+
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)]     = MakeTestData(16 + i, static_cast<Uint8>(i));
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::Direct3D12)] = MakeTestData(5 + i, static_cast<Uint8>(i * 3));
+    }
+
+    for (Uint32 i = 0; i < 3; ++i)
+        Archive.GetDeviceShaders(DeviceType::Vulkan).emplace_back(MakeTestData(64 + i, static_cast<Uint8>(i * 7)));
+    Archive.GetDeviceShaders(DeviceType::OpenGL).emplace_back(MakeTestData(33, 11));
+}
+
+RefCntAutoPtr<IDataBlob> CreateTestArchive()
+{
+    DeviceObjectArchive Archive{TestContentVersion};
+    InitTestArchive(Archive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Archive.Serialize(&pData);
+    return pData;
+}
+
+void VerifyTestArchive(const DeviceObjectArchive& Archive, bool HasVulkanData = true)
+{
+    EXPECT_EQ(Archive.GetContentVersion(), TestContentVersion);
+
+    for (Uint32 i = 0; i < TestResources.size(); ++i)
+    {
+        const auto Type = TestResources[i].first;
+        const auto Name = TestResources[i].second;
+        EXPECT_TRUE(Archive.HasResource(Type, Name));
+
+        TestResourceData ResData;
+        EXPECT_TRUE(Archive.LoadResourceCommonData(Type, Name, ResData));
+        EXPECT_STREQ(ResData.Name, Name);
+        EXPECT_EQ(ResData.Value, i);
+
+        const auto VkData = Archive.GetDeviceSpecificData(Type, Name, DeviceType::Vulkan);
+        if (HasVulkanData)
+            EXPECT_EQ(VkData, MakeTestData(16 + i, static_cast<Uint8>(i)));
+        else
+            EXPECT_FALSE(VkData);
+
+        const auto D3D12Data = Archive.GetDeviceSpecificData(Type, Name, DeviceType::Direct3D12);
+        EXPECT_EQ(D3D12Data, MakeTestData(5 + i, static_cast<Uint8>(i * 3)));
+
+        EXPECT_FALSE(Archive.GetDeviceSpecificData(Type, Name, DeviceType::Direct3D11));
+    }
+
+    EXPECT_FALSE(Archive.HasResource(ResourceType::GraphicsPipeline, "Signature A"));
+    EXPECT_FALSE(Archive.HasResource(ResourceType::ResourceSignature, "Signature"));
+    EXPECT_FALSE(Archive.HasResource(ResourceType::ResourceSignature, "Signature C"));
+    EXPECT_FALSE(Archive.HasResource(ResourceType::ResourceSignature, "Render Pass 1"));
+    EXPECT_FALSE(Archive.HasResource(ResourceType::RenderPass, "Render Pass 3"));
+    EXPECT_FALSE(Archive.HasResource(ResourceType::RenderPass, ""));
+
+    if (HasVulkanData)
+    {
+        ASSERT_EQ(Archive.GetNumShaders(DeviceType::Vulkan), 3u);
+        for (Uint32 i = 0; i < 3; ++i)
+            EXPECT_EQ(Archive.GetSerializedShader(DeviceType::Vulkan, i), MakeTestData(64 + i, static_cast<Uint8>(i * 7)));
+    }
+    else
+    {
+        EXPECT_EQ(Archive.GetNumShaders(DeviceType::Vulkan), 0u);
+    }
+    EXPECT_FALSE(Archive.GetSerializedShader(DeviceType::Vulkan, 3));
+
+    ASSERT_EQ(Archive.GetNumShaders(DeviceType::OpenGL), 1u);
+    EXPECT_EQ(Archive.GetSerializedShader(DeviceType::OpenGL, 0), MakeTestData(33, 11));
+    EXPECT_EQ(Archive.GetNumShaders(DeviceType::Direct3D12), 0u);
+}
+
+TEST(DeviceObjectArchiveTest, SerializeDeserialize)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_NE(pData, nullptr);
+
+    DeviceObjectArchive Archive{DeviceObjectArchive::CreateInfo{pData}};
+    VerifyTestArchive(Archive);
+
+    // Unmodified archive must serialize to the same data
+    RefCntAutoPtr<IDataBlob> pData2;
+    Archive.Serialize(&pData2);
+    ASSERT_NE(pData2, nullptr);
+    ASSERT_EQ(pData2->GetSize(), pData->GetSize());
+    EXPECT_EQ(memcmp(pData2->GetConstDataPtr(), pData->GetConstDataPtr(), pData->GetSize()), 0);
+}
+
+TEST(DeviceObjectArchiveTest, SerializeToStream)
+{
+    auto pRefData = CreateTestArchive();
+    ASSERT_NE(pRefData, nullptr);
+
+    const auto VerifyStreamData = [&](const DeviceObjectArchive& Archive, size_t StagingBufferSize) {
+        auto pStreamData = DataBlobImpl::Create();
+        auto pStream     = MemoryFileStream::Create(pStreamData);
+        EXPECT_TRUE(Archive.Serialize(pStream, StagingBufferSize));
+        ASSERT_EQ(pStreamData->GetSize(), pRefData->GetSize());
+        EXPECT_EQ(memcmp(pStreamData->GetConstDataPtr(), pRefData->GetConstDataPtr(), pRefData->GetSize()), 0);
+    };
+
+    // The archive is larger than the staging buffer, and shader data is larger than the buffer too
+    DeviceObjectArchive Archive{TestContentVersion};
+    InitTestArchive(Archive);
+    VerifyStreamData(Archive, 64);
+    VerifyStreamData(Archive, 100);
+    VerifyStreamData(Archive, 1 << 20);
+
+    // Unmodified archive is written as is
+    DeviceObjectArchive LoadedArchive{DeviceObjectArchive::CreateInfo{pRefData}};
+    VerifyStreamData(LoadedArchive, 64);
+}
+
+// File stream that fails all writes after the given number of bytes has been written
+class FailingFileStream final : public ObjectBase<IFileStream>
+{
+public:
+    using TBase = ObjectBase<IFileStream>;
+
+    FailingFileStream(IReferenceCounters* pRefCounters, size_t MaxSize) :
+        TBase{pRefCounters},
+        m_MaxSize{MaxSize}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_FileStream, TBase);
+
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override final
+    {
+        UNEXPECTED("Reading is not supported");
+    }
+
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override final
+    {
+        UNEXPECTED("Reading is not supported");
+        return false;
+    }
+
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override final
+    {
+        if (m_Size + Size > m_MaxSize)
+            return false;
+        m_Size += Size;
+        return true;
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override final
+    {
+        return m_Size;
+    }
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override final
+    {
+        return true;
+    }
+
+private:
+    const size_t m_MaxSize;
+    size_t       m_Size = 0;
+};
+
+TEST(DeviceObjectArchiveTest, SerializeToFailingStream)
+{
+    auto pRefData = CreateTestArchive();
+    ASSERT_NE(pRefData, nullptr);
+    const auto ArchiveSize = pRefData->GetSize();
+
+    DeviceObjectArchive Archive{TestContentVersion};
+    InitTestArchive(Archive);
+    for (size_t StagingBufferSize : {size_t{64}, size_t{100}, size_t{1} << 20})
+    {
+        for (size_t MaxSize : {size_t{0}, size_t{100}, ArchiveSize / 2, ArchiveSize - 1})
+        {
+            TestingEnvironment::ErrorScope ExpectedErrors{"Failed to write"};
+
+            RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<FailingFileStream>()(MaxSize)};
+            EXPECT_FALSE(Archive.Serialize(pStream, StagingBufferSize)) << "Staging buffer size: " << StagingBufferSize << ", max size: " << MaxSize;
+        }
+    }
+
+    // Unmodified archive is written as is
+    DeviceObjectArchive LoadedArchive{DeviceObjectArchive::CreateInfo{pRefData}};
+    RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<FailingFileStream>()(ArchiveSize - 1)};
+    EXPECT_FALSE(LoadedArchive.Serialize(pStream));
+}
+
+TEST(DeviceObjectArchiveTest, Modify)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_NE(pData, nullptr);
+
+    {
+        DeviceObjectArchive Archive{DeviceObjectArchive::CreateInfo{pData}};
+        Archive.RemoveDeviceData(DeviceType::Vulkan);
+        VerifyTestArchive(Archive, /*HasVulkanData = */ false);
+
+        RefCntAutoPtr<IDataBlob> pData2;
+        Archive.Serialize(&pData2);
+        ASSERT_NE(pData2, nullptr);
+
+        DeviceObjectArchive Archive2{DeviceObjectArchive::CreateInfo{pData2}};
+        VerifyTestArchive(Archive2, /*HasVulkanData = */ false);
+
+        const DeviceObjectArchive SrcArchive{DeviceObjectArchive::CreateInfo{pData}};
+        Archive2.AppendDeviceData(SrcArchive, DeviceType::Vulkan);
+        VerifyTestArchive(Archive2);
+    }
+
+    {
+        DeviceObjectArchive       Archive{TestContentVersion};
+        const DeviceObjectArchive SrcArchive{DeviceObjectArchive::CreateInfo{pData}};
+        Archive.Merge(SrcArchive);
+        VerifyTestArchive(Archive);
+
+        RefCntAutoPtr<IDataBlob> pData2;
+        Archive.Serialize(&pData2);
+        ASSERT_NE(pData2, nullptr);
+        ASSERT_EQ(pData2->GetSize(), pData->GetSize());
+        EXPECT_EQ(memcmp(pData2->GetConstDataPtr(), pData->GetConstDataPtr(), pData->GetSize()), 0);
+    }
+}
+
+TEST(DeviceObjectArchiveTest, MappedFile)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_NE(pData, nullptr);
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "Archive.bin";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(pData->GetConstDataPtr(), pData->GetSize()));
+    }
+
+    auto pMappedData = MappedFileDataBlob::Create(FilePath.c_str());
+    ASSERT_NE(pMappedData, nullptr);
+    ASSERT_EQ(pMappedData->GetSize(), pData->GetSize());
+    EXPECT_EQ(memcmp(pMappedData->GetConstDataPtr(), pData->GetConstDataPtr(), pData->GetSize()), 0);
+
+    {
+        DeviceObjectArchive Archive{DeviceObjectArchive::CreateInfo{pMappedData}};
+        VerifyTestArchive(Archive);
+    }
+
+    pMappedData->Resize(pData->GetSize() / 2);
+    EXPECT_FALSE(pMappedData->IsMapped());
+    ASSERT_EQ(pMappedData->GetSize(), pData->GetSize() / 2);
+    EXPECT_EQ(memcmp(pMappedData->GetConstDataPtr(), pData->GetConstDataPtr(), pData->GetSize() / 2), 0);
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"does not exist"};
+        EXPECT_EQ(MappedFileDataBlob::Create((FilePath + ".missing").c_str()), nullptr);
+    }
+}
+
+TEST(DeviceObjectArchiveTest, Compression)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_NE(pData, nullptr);
+
+    // Test data of Vulkan and OpenGL shaders is not compressible, so add compressible Direct3D11 shaders
+    auto MakeCompressibleData = [](Uint32 Seed) {
+        SerializedData Data{4096, GetRawAllocator()};
+        for (size_t i = 0; i < Data.Size(); ++i)
+            Data.Ptr<Uint8>()[i] = static_cast<Uint8>(Seed + i / 16);
+        return Data;
+    };
+    constexpr Uint32 NumD3D11Shaders = 8;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    RefCntAutoPtr<IDataBlob> pRawData;
+    RefCntAutoPtr<IDataBlob> pCompressedData;
+    {
+        DeviceObjectArchive Archive{DeviceObjectArchive::CreateInfo{pData}};
+        for (Uint32 i = 0; i < NumD3D11Shaders; ++i)
+            Archive.GetDeviceShaders(DeviceType::Direct3D11).emplace_back(MakeCompressibleData(i));
+        Archive.Serialize(&pRawData);
+        ASSERT_NE(pRawData, nullptr);
+
+        Archive.SetShaderCompression(DeviceType::Direct3D11, DeviceObjectArchive::CompressionMode::LZ4);
+        Archive.SetShaderCompression(DeviceType::Vulkan, DeviceObjectArchive::CompressionMode::LZ4);
+        Archive.Serialize(&pCompressedData);
+        ASSERT_NE(pCompressedData, nullptr);
+
+        // Shaders compressed in parallel must produce the same archive
+        RefCntAutoPtr<IDataBlob> pParallelData;
+        Archive.Serialize(&pParallelData, pThreadPool);
+        ASSERT_NE(pParallelData, nullptr);
+        ASSERT_EQ(pParallelData->GetSize(), pCompressedData->GetSize());
+        EXPECT_EQ(memcmp(pParallelData->GetConstDataPtr(), pCompressedData->GetConstDataPtr(), pCompressedData->GetSize()), 0);
+    }
+    EXPECT_LT(pCompressedData->GetSize(), pRawData->GetSize() - NumD3D11Shaders * 3000);
+
+    auto VerifyD3D11Shaders = [&](const DeviceObjectArchive& Archive, IThreadPool* pThreadPool) {
+        ASSERT_EQ(Archive.GetNumShaders(DeviceType::Direct3D11), NumD3D11Shaders);
+        for (Uint32 i = 0; i < NumD3D11Shaders; ++i)
+            EXPECT_EQ(Archive.GetSerializedShader(DeviceType::Direct3D11, i), MakeCompressibleData(i));
+
+        const std::vector<Uint32>   Indices = {5, 0, 7, 3, 3, 1, 6, 2, 4};
+        std::vector<SerializedData> Shaders(Indices.size());
+        EXPECT_TRUE(Archive.GetSerializedShaders(DeviceType::Direct3D11, Indices.data(), Indices.size(), Shaders.data(), pThreadPool));
+        for (size_t i = 0; i < Indices.size(); ++i)
+            EXPECT_EQ(Shaders[i], MakeCompressibleData(Indices[i]));
+    };
+
+    DeviceObjectArchive Archive{DeviceObjectArchive::CreateInfo{pCompressedData}};
+    EXPECT_EQ(Archive.GetShaderCompression(DeviceType::Direct3D11), DeviceObjectArchive::CompressionMode::LZ4);
+    EXPECT_EQ(Archive.GetShaderCompression(DeviceType::Vulkan), DeviceObjectArchive::CompressionMode::LZ4);
+    EXPECT_EQ(Archive.GetShaderCompression(DeviceType::OpenGL), DeviceObjectArchive::CompressionMode::None);
+    VerifyTestArchive(Archive);
+    VerifyD3D11Shaders(Archive, nullptr);
+    VerifyD3D11Shaders(Archive, pThreadPool);
+
+    // Decompress the archive
+    Archive.SetShaderCompression(DeviceType::Direct3D11, DeviceObjectArchive::CompressionMode::None);
+    Archive.SetShaderCompression(DeviceType::Vulkan, DeviceObjectArchive::CompressionMode::None);
+    VerifyTestArchive(Archive);
+    VerifyD3D11Shaders(Archive, pThreadPool);
+
+    RefCntAutoPtr<IDataBlob> pDecompressedData;
+    Archive.Serialize(&pDecompressedData);
+    ASSERT_NE(pDecompressedData, nullptr);
+    ASSERT_EQ(pDecompressedData->GetSize(), pRawData->GetSize());
+    EXPECT_EQ(memcmp(pDecompressedData->GetConstDataPtr(), pRawData->GetConstDataPtr(), pRawData->GetSize()), 0);
+}
+
+TEST(DeviceObjectArchiveTest, InvalidData)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_NE(pData, nullptr);
+
+    {
+        // The header fits into the truncated data, but the table of contents does not
+        TestingEnvironment::ErrorScope ExpectedErrors{"table of contents is out of bounds"};
+        auto                           pTruncatedData = DataBlobImpl::Create(200, pData->GetConstDataPtr());
+        EXPECT_THROW(DeviceObjectArchive(DeviceObjectArchive::CreateInfo{pTruncatedData}), std::runtime_error);
+    }
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Invalid archive content version"};
+        DeviceObjectArchive::CreateInfo CI{pData};
+        CI.ContentVersion = TestContentVersion + 1;
+        EXPECT_THROW(DeviceObjectArchive{CI}, std::runtime_error);
+    }
+}
+
+} // namespace
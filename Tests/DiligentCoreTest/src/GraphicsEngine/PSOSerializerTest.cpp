@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -767,4 +768,74 @@ TEST(PSOSerializerTest, SerializeShaderCI_Source)
     SerializeShaderCreateInfo(false);
 }
 
+TEST(PSOSerializerTest, InPlaceArrays)
+{
+    const char* PRSNames[] = {"PRS-1", "Signature-2", "ResSign-3"};
+
+    LayoutElement LayoutElems[] =
+        {
+            LayoutElement{0, 0, 3, VT_FLOAT32},
+            LayoutElement{1, 0, 3, VT_FLOAT32},
+            LayoutElement{2, 0, 2, VT_FLOAT32},
+            LayoutElement{3, 1, 4, VT_UINT8, true},
+        };
+
+    GraphicsPipelineStateCreateInfo SrcPSO;
+    SrcPSO.PSODesc.PipelineType                        = PIPELINE_TYPE_GRAPHICS;
+    SrcPSO.ResourceSignaturesCount                     = _countof(PRSNames);
+    SrcPSO.GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+    SrcPSO.GraphicsPipeline.InputLayout.NumElements    = _countof(LayoutElems);
+    SrcPSO.GraphicsPipeline.NumRenderTargets           = 1;
+    SrcPSO.GraphicsPipeline.RTVFormats[0]              = TEX_FORMAT_RGBA8_UNORM;
+    SrcPSO.GraphicsPipeline.DSVFormat                  = TEX_FORMAT_D32_FLOAT;
+
+    TPRSNames SrcPRSNames = {};
+    for (Uint32 i = 0; i < SrcPSO.ResourceSignaturesCount; ++i)
+        SrcPRSNames[i] = PRSNames[i];
+
+    const char* RPName = "";
+
+    std::vector<Uint32> ShaderIndices(64);
+    for (Uint32 i = 0; i < ShaderIndices.size(); ++i)
+        ShaderIndices[i] = i * 3;
+
+    DeviceObjectArchive::ShaderIndexArray SrcShaders{ShaderIndices.data(), static_cast<Uint32>(ShaderIndices.size())};
+
+    const auto SerializePSO = [&](auto& Ser) {
+        constexpr auto Mode = std::remove_reference_t<decltype(Ser)>::GetMode();
+        EXPECT_TRUE(PSOSerializer<Mode>::SerializeCreateInfo(Ser, SrcPSO, SrcPRSNames, nullptr, RPName));
+        EXPECT_TRUE(PSOSerializer<Mode>::SerializeShaderIndices(Ser, SrcShaders, nullptr));
+    };
+
+    SerializedData Data;
+    {
+        Serializer<SerializerMode::Measure> MSer;
+        SerializePSO(MSer);
+        Data = MSer.AllocateData(GetRawAllocator());
+    }
+    {
+        Serializer<SerializerMode::Write> WSer{Data};
+        SerializePSO(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    DynamicLinearAllocator Allocator{GetRawAllocator()};
+
+    const auto Deserialize = [&](bool InPlaceArrays) {
+        Allocator.Discard();
+
+        GraphicsPipelineStateCreateInfo       DstPSO;
+        TPRSNames                             DstPRSNames = {};
+        const char*                           DstRPName   = nullptr;
+        DeviceObjectArchive::ShaderIndexArray DstShaders;
+
+        Serializer<SerializerMode::Read> RSer{Data, InPlaceArrays};
+        PSOSerializer<SerializerMode::Read>::SerializeCreateInfo(RSer, DstPSO, DstPRSNames, &Allocator, DstRPName);
+        PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(RSer, DstShaders, &Allocator);
+        return DstShaders.pIndices[DstShaders.Count - 1] + DstPSO.GraphicsPipeline.InputLayout.LayoutElements[0].NumComponents;
+    };
+
+    EXPECT_EQ(Deserialize(false), Deserialize(true));
+}
+
 } // namespace
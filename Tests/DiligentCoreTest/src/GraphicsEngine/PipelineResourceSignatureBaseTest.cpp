@@ -27,11 +27,16 @@
 #include "../../../../Graphics/GraphicsEngine/include/PipelineResourceSignatureBase.hpp"
 #include "CommonlyUsedStates.h"
 
+#include "TestingEnvironment.hpp"
+
 #include "gtest/gtest.h"
 
 #include <array>
+#include <string>
+#include <vector>
 
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -179,4 +184,72 @@ TEST(PipelineResourceSignatureBaseTest, Compatibility)
     }
 }
 
+TEST(PipelineResourceSignatureBaseTest, ResourceNameTable)
+{
+    EXPECT_EQ(GetResourceNameTableSize(0), 0u);
+    EXPECT_GE(GetResourceNameTableSize(1), 2u);
+    EXPECT_GE(GetResourceNameTableSize(100), 200u);
+
+    std::vector<std::string>          Names;
+    std::vector<PipelineResourceDesc> Resources;
+    for (Uint32 i = 0; i < 500; ++i)
+        Names.emplace_back("Resource" + std::to_string(i));
+    for (Uint32 i = 0; i < 500; ++i)
+        Resources.emplace_back(SHADER_TYPE_VERTEX, Names[i].c_str(), 1u, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER);
+    // Resources with the same name in different shader stages
+    Resources.emplace_back(SHADER_TYPE_PIXEL, Names[10].c_str(), 1u, SHADER_RESOURCE_TYPE_TEXTURE_SRV);
+    Resources.emplace_back(SHADER_TYPE_COMPUTE, Names[10].c_str(), 1u, SHADER_RESOURCE_TYPE_TEXTURE_SRV);
+
+    const auto NumResources = static_cast<Uint32>(Resources.size());
+    const auto TableSize    = GetResourceNameTableSize(NumResources);
+    EXPECT_GE(TableSize, NumResources * 2);
+
+    std::vector<Uint32> NameTable(TableSize);
+    InitResourceNameTable(Resources.data(), NumResources, NameTable.data(), TableSize);
+
+    auto FindAll = [&](const char* Name) {
+        std::vector<Uint32> Indices;
+        FindResourcesByName(Resources.data(), NameTable.data(), TableSize, Name,
+                            [&](Uint32 ResIndex) {
+                                Indices.push_back(ResIndex);
+                                return false;
+                            });
+        return Indices;
+    };
+
+    for (Uint32 i = 0; i < 500; ++i)
+    {
+        const auto Indices = FindAll(Names[i].c_str());
+        if (i == 10)
+        {
+            EXPECT_EQ(Indices, (std::vector<Uint32>{10, 500, 501}));
+        }
+        else
+        {
+            EXPECT_EQ(Indices, std::vector<Uint32>{i});
+        }
+    }
+
+    EXPECT_TRUE(FindAll("Resource").empty());
+    EXPECT_TRUE(FindAll("Resource500").empty());
+    EXPECT_TRUE(FindAll("Unknown").empty());
+
+    Uint32 NumCalls = 0;
+    EXPECT_TRUE(FindResourcesByName(Resources.data(), NameTable.data(), TableSize, Names[10].c_str(),
+                                    [&](Uint32 ResIndex) {
+                                        ++NumCalls;
+                                        return (Resources[ResIndex].ShaderStages & SHADER_TYPE_PIXEL) != 0;
+                                    }));
+    EXPECT_EQ(NumCalls, 2u);
+}
+
+TEST(PipelineResourceSignatureBaseTest, ResourceNameTableOverflow)
+{
+    // Resource indices must fit into the lower 16 bits of the table entries
+    const Uint32 NumResources = MAX_RESOURCES_IN_SIGNATURE + 1;
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"exceeds the maximum allowed value"};
+    EXPECT_THROW(InitResourceNameTable(nullptr, NumResources, nullptr, GetResourceNameTableSize(NumResources)), std::runtime_error);
+}
+
 } // namespace
@@ -24,9 +24,15 @@
  *  of the possibility of such damages.
  */
 
+#include <thread>
+#include <vector>
+
 #include "BytecodeCache.h"
 #include "DataBlobImpl.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -186,4 +192,311 @@ TEST(BytecodeCacheTest, Include)
     }
 }
 
+TEST(BytecodeCacheTest, ByKey)
+{
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    const std::string Key0{"glslang;main;float4 main() : SV_Target { return 0; }"};
+    const std::string Key1{"glslang;main;float4 main() : SV_Target { return 1; }"};
+
+    const std::string        Data{"TestString"};
+    RefCntAutoPtr<IDataBlob> pBytecodeSaved = DataBlobImpl::Create(Data.length(), Data.c_str());
+    pCache->AddBytecodeByKey(Key0.data(), Key0.size(), pBytecodeSaved);
+
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key0.data(), Key0.size(), &pBytecode);
+        ASSERT_NE(pBytecode, nullptr);
+        EXPECT_EQ(pBytecode->GetSize(), Data.length());
+        EXPECT_EQ(memcmp(pBytecode->GetConstDataPtr(), Data.c_str(), Data.length()), 0);
+    }
+
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key1.data(), Key1.size(), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+
+    pCache->RemoveBytecodeByKey(Key0.data(), Key0.size());
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key0.data(), Key0.size(), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+}
+
+TEST(BytecodeCacheTest, Directory)
+{
+    Testing::TempDirectory TempDir;
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType    = RENDER_DEVICE_TYPE_VULKAN;
+    CI.DirectoryPath = TempDir.Get().c_str();
+
+    const std::string Key{"SomeCode"};
+    const std::string Data{"TestString"};
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+    }
+
+    {
+        // The byte code written by the first cache must be found by the second one
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        ASSERT_NE(pBytecode, nullptr);
+        EXPECT_EQ(pBytecode->GetSize(), Data.length());
+        EXPECT_EQ(memcmp(pBytecode->GetConstDataPtr(), Data.c_str(), Data.length()), 0);
+
+        pCache->Clear();
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+
+    {
+        // Byte code written for another device type must not be found
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+
+        CI.DeviceType = RENDER_DEVICE_TYPE_D3D12;
+        RefCntAutoPtr<IBytecodeCache> pCacheD3D12;
+        CreateBytecodeCache(CI, &pCacheD3D12);
+        ASSERT_NE(pCacheD3D12, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCacheD3D12->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+}
+
+TEST(BytecodeCacheTest, CorruptedFile)
+{
+    Testing::TempDirectory TempDir;
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType    = RENDER_DEVICE_TYPE_VULKAN;
+    CI.DirectoryPath = TempDir.Get().c_str();
+
+    const std::string Key{"SomeCode"};
+    const std::string Data{"TestString"};
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+    }
+
+    // Truncate the file as if the process was terminated while writing it
+    const auto SearchRes = FileSystem::Search((TempDir.Get() + FileSystem::SlashSymbol + "*.bin").c_str());
+    ASSERT_EQ(SearchRes.size(), size_t{1});
+    {
+        const auto FilePath = TempDir.Get() + FileSystem::SlashSymbol + SearchRes[0]->Name();
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        File->Write(Data.c_str(), Data.length());
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+    EXPECT_TRUE(FileSystem::Search((TempDir.Get() + FileSystem::SlashSymbol + "*.bin").c_str()).empty());
+}
+
+TEST(BytecodeCacheTest, MaxDirectorySize)
+{
+    Testing::TempDirectory TempDir;
+
+    const std::string Data(256, 'x');
+    const std::string Keys[] = {"Code0", "Code1", "Code2"};
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType    = RENDER_DEVICE_TYPE_VULKAN;
+    CI.DirectoryPath = TempDir.Get().c_str();
+    // Enough space for two files only
+    CI.MaxDirectorySize = Data.length() * 2 + 256;
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        pCache->AddBytecodeByKey(Keys[0].data(), Keys[0].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+        pCache->AddBytecodeByKey(Keys[1].data(), Keys[1].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+
+        // Make Code0 the most recently used entry
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Keys[0].data(), Keys[0].size(), &pBytecode);
+        EXPECT_NE(pBytecode, nullptr);
+
+        // Code1 is evicted from the directory, but remains in memory
+        pCache->AddBytecodeByKey(Keys[2].data(), Keys[2].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+        pBytecode.Release();
+        pCache->GetBytecodeByKey(Keys[1].data(), Keys[1].size(), &pBytecode);
+        EXPECT_NE(pBytecode, nullptr);
+    }
+
+    EXPECT_EQ(FileSystem::Search((TempDir.Get() + FileSystem::SlashSymbol + "*.bin").c_str()).size(), size_t{2});
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            RefCntAutoPtr<IDataBlob> pBytecode;
+            pCache->GetBytecodeByKey(Keys[i].data(), Keys[i].size(), &pBytecode);
+            EXPECT_EQ(pBytecode != nullptr, i != 1) << Keys[i];
+        }
+    }
+}
+
+TEST(BytecodeCacheTest, MaxMemorySize)
+{
+    const std::string Data(256, 'x');
+    const std::string Keys[] = {"Code0", "Code1", "Code2"};
+
+    auto HasBytecode = [](IBytecodeCache* pCache, const std::string& Key) {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        return pBytecode != nullptr;
+    };
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType = RENDER_DEVICE_TYPE_VULKAN;
+    // Enough memory for two entries only
+    CI.MaxMemorySize = Data.length() * 2;
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        pCache->AddBytecodeByKey(Keys[0].data(), Keys[0].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+        pCache->AddBytecodeByKey(Keys[1].data(), Keys[1].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+
+        // Make Code0 the most recently used entry
+        EXPECT_TRUE(HasBytecode(pCache, Keys[0]));
+
+        // Code1 is evicted from memory
+        pCache->AddBytecodeByKey(Keys[2].data(), Keys[2].size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+        EXPECT_TRUE(HasBytecode(pCache, Keys[0]));
+        EXPECT_FALSE(HasBytecode(pCache, Keys[1]));
+        EXPECT_TRUE(HasBytecode(pCache, Keys[2]));
+    }
+
+    {
+        // Byte code evicted from memory is read back from the directory
+        Testing::TempDirectory TempDir;
+        CI.DirectoryPath = TempDir.Get().c_str();
+
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (const auto& Key : Keys)
+            pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(Data.length(), Data.c_str()));
+
+        for (const auto& Key : Keys)
+            EXPECT_TRUE(HasBytecode(pCache, Key)) << Key;
+    }
+}
+
+TEST(BytecodeCacheTest, NoTemporaryFiles)
+{
+    Testing::TempDirectory TempDir;
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType    = RENDER_DEVICE_TYPE_VULKAN;
+    CI.DirectoryPath = TempDir.Get().c_str();
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache(CI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    // The files are written to temporary files that are renamed when complete
+    const std::string Key{"SomeCode"};
+    for (const char* Data : {"TestString0", "TestString1"})
+        pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(strlen(Data), Data));
+
+    EXPECT_EQ(FileSystem::Search((TempDir.Get() + FileSystem::SlashSymbol + "*.bin").c_str()).size(), size_t{1});
+    EXPECT_TRUE(FileSystem::Search((TempDir.Get() + FileSystem::SlashSymbol + "*.tmp").c_str()).empty());
+}
+
+TEST(BytecodeCacheTest, Multithreading)
+{
+    Testing::TempDirectory TempDir;
+
+    BytecodeCacheCreateInfo CI;
+    CI.DeviceType       = RENDER_DEVICE_TYPE_VULKAN;
+    CI.DirectoryPath    = TempDir.Get().c_str();
+    CI.MaxDirectorySize = 4096;
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache(CI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    constexpr size_t NumThreads = 4;
+    constexpr size_t NumKeys    = 64;
+
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (size_t i = 0; i < NumKeys; ++i)
+            {
+                const auto Key = std::to_string(i);
+
+                RefCntAutoPtr<IDataBlob> pBytecode;
+                pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+                if (pBytecode)
+                {
+                    EXPECT_EQ(std::string(static_cast<const char*>(pBytecode->GetConstDataPtr()), pBytecode->GetSize()), Key);
+                }
+                else
+                {
+                    pCache->AddBytecodeByKey(Key.data(), Key.size(), DataBlobImpl::Create(Key.length(), Key.c_str()));
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (size_t i = 0; i < NumKeys; ++i)
+    {
+        const auto Key = std::to_string(i);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecodeByKey(Key.data(), Key.size(), &pBytecode);
+        ASSERT_NE(pBytecode, nullptr);
+        EXPECT_EQ(std::string(static_cast<const char*>(pBytecode->GetConstDataPtr()), pBytecode->GetSize()), Key);
+    }
+}
+
 } // namespace
@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#if !DILIGENT_NO_GLSLANG
+
+#    include "GLSLangUtils.hpp"
+#    include "BytecodeCache.h"
+#    include "ObjectBase.hpp"
+#    include "RefCntAutoPtr.hpp"
+
+#    include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Bytecode cache that forwards all calls to another cache and counts the lookups by key
+class CountingBytecodeCache final : public ObjectBase<IBytecodeCache>
+{
+public:
+    using TBase = ObjectBase<IBytecodeCache>;
+
+    CountingBytecodeCache(IReferenceCounters* pRefCounters, IBytecodeCache* pCache) :
+        TBase{pRefCounters},
+        m_pCache{pCache}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BytecodeCache, TBase);
+
+    virtual bool DILIGENT_CALL_TYPE Load(IDataBlob* pData) override final
+    {
+        return m_pCache->Load(pData);
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob** ppByteCode) override final
+    {
+        m_pCache->GetBytecode(ShaderCI, ppByteCode);
+    }
+
+    virtual void DILIGENT_CALL_TYPE AddBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob* pByteCode) override final
+    {
+        m_pCache->AddBytecode(ShaderCI, pByteCode);
+    }
+
+    virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
+    {
+        m_pCache->RemoveBytecode(ShaderCI);
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetBytecodeByKey(const void* pKey, size_t KeySize, IDataBlob** ppByteCode) override final
+    {
+        m_pCache->GetBytecodeByKey(pKey, KeySize, ppByteCode);
+        if (*ppByteCode != nullptr)
+            ++NumHits;
+        else
+            ++NumMisses;
+    }
+
+    virtual void DILIGENT_CALL_TYPE AddBytecodeByKey(const void* pKey, size_t KeySize, IDataBlob* pByteCode) override final
+    {
+        m_pCache->AddBytecodeByKey(pKey, KeySize, pByteCode);
+        ++NumAdds;
+    }
+
+    virtual void DILIGENT_CALL_TYPE RemoveBytecodeByKey(const void* pKey, size_t KeySize) override final
+    {
+        m_pCache->RemoveBytecodeByKey(pKey, KeySize);
+    }
+
+    virtual void DILIGENT_CALL_TYPE Store(IDataBlob** ppDataBlob) override final
+    {
+        m_pCache->Store(ppDataBlob);
+    }
+
+    virtual void DILIGENT_CALL_TYPE Clear() override final
+    {
+        m_pCache->Clear();
+    }
+
+    Uint32 NumHits   = 0;
+    Uint32 NumMisses = 0;
+    Uint32 NumAdds   = 0;
+
+private:
+    RefCntAutoPtr<IBytecodeCache> m_pCache;
+};
+
+TEST(GLSLangUtilsTest, BytecodeCache)
+{
+    GLSLangUtils::InitializeGlslang();
+
+    RefCntAutoPtr<IBytecodeCache> pBytecodeCache;
+    CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pBytecodeCache);
+    ASSERT_NE(pBytecodeCache, nullptr);
+
+    RefCntAutoPtr<CountingBytecodeCache> pCache{MakeNewRCObj<CountingBytecodeCache>()(pBytecodeCache)};
+
+    static constexpr char ShaderSource[] = R"(
+#version 450
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+layout(std140, binding = 0) buffer DataBuffer
+{
+    uint Value;
+} g_Data;
+
+void main()
+{
+    g_Data.Value = 1u;
+}
+)";
+
+    GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
+    Attribs.ShaderType     = SHADER_TYPE_COMPUTE;
+    Attribs.ShaderSource   = ShaderSource;
+    Attribs.SourceCodeLen  = static_cast<int>(sizeof(ShaderSource) - 1);
+    Attribs.pBytecodeCache = pCache;
+
+    const auto SPIRV0 = GLSLangUtils::GLSLtoSPIRV(Attribs);
+    EXPECT_FALSE(SPIRV0.empty());
+    EXPECT_EQ(pCache->NumHits, 0u);
+    EXPECT_EQ(pCache->NumMisses, 1u);
+    EXPECT_EQ(pCache->NumAdds, 1u);
+
+    // The second compilation must take the byte code from the cache
+    const auto SPIRV1 = GLSLangUtils::GLSLtoSPIRV(Attribs);
+    EXPECT_EQ(SPIRV1, SPIRV0);
+    EXPECT_EQ(pCache->NumHits, 1u);
+    EXPECT_EQ(pCache->NumMisses, 1u);
+    EXPECT_EQ(pCache->NumAdds, 1u);
+
+    // Different macros must produce a different key
+    ShaderMacro Macros[] = {{"VALUE", "2"}};
+    Attribs.Macros       = {Macros, _countof(Macros)};
+    GLSLangUtils::GLSLtoSPIRV(Attribs);
+    EXPECT_EQ(pCache->NumHits, 1u);
+    EXPECT_EQ(pCache->NumMisses, 2u);
+    EXPECT_EQ(pCache->NumAdds, 2u);
+
+    GLSLangUtils::FinalizeGlslang();
+}
+
+} // namespace
+
+#endif // !DILIGENT_NO_GLSLANG
@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#if !DILIGENT_NO_GLSLANG
+
+#    include "SPIRVTools.hpp"
+#    include "GLSLangUtils.hpp"
+
+#    include "gtest/gtest.h"
+
+#    include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::vector<std::vector<uint32_t>> CompileTestModules(size_t NumModules)
+{
+    static constexpr char ShaderSource[] = R"(
+#version 450
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout(std140, binding = 0) buffer DataBuffer
+{
+    uint Values[];
+} g_Data;
+
+uint Scale(uint Value)
+{
+    return Value * uint(VALUE) + 1u;
+}
+
+void main()
+{
+    uint Idx = gl_GlobalInvocationID.x;
+    g_Data.Values[Idx] = Scale(g_Data.Values[Idx]);
+}
+)";
+
+    std::vector<std::vector<uint32_t>> Modules;
+    for (size_t i = 0; i < NumModules; ++i)
+    {
+        const auto  Value    = std::to_string(i + 1);
+        ShaderMacro Macros[] = {{"VALUE", Value.c_str()}};
+
+        GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
+        Attribs.ShaderType    = SHADER_TYPE_COMPUTE;
+        Attribs.ShaderSource  = ShaderSource;
+        Attribs.SourceCodeLen = static_cast<int>(sizeof(ShaderSource) - 1);
+        Attribs.Macros        = {Macros, _countof(Macros)};
+
+        auto SPIRV = GLSLangUtils::GLSLtoSPIRV(Attribs);
+        EXPECT_FALSE(SPIRV.empty());
+        Modules.emplace_back(SPIRV.begin(), SPIRV.end());
+    }
+    return Modules;
+}
+
+TEST(SPIRVToolsTest, OptimizeSPIRVBatch)
+{
+    GLSLangUtils::InitializeGlslang();
+
+    const auto Modules = CompileTestModules(8);
+
+    size_t TotalSize = 0;
+    for (const auto& SPIRV : Modules)
+        TotalSize += SPIRV.size();
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    // Every pass group runs in its own optimizer, so the batch output only matches
+    // OptimizeSPIRV() exactly when a single group is enabled.
+    for (auto Passes : {SPIRV_OPTIMIZATION_FLAG_PERFORMANCE, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION})
+    {
+        std::vector<std::vector<uint32_t>> RefModules;
+        for (const auto& SPIRV : Modules)
+        {
+            RefModules.emplace_back(OptimizeSPIRV(SPIRV, SPV_ENV_MAX, Passes));
+            EXPECT_FALSE(RefModules.back().empty());
+        }
+
+        for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+        {
+            SPIRVOptimizationStats Stats;
+
+            const auto OptimizedModules = OptimizeSPIRVBatch(Modules, SPV_ENV_MAX, Passes, pPool, &Stats);
+            ASSERT_EQ(OptimizedModules.size(), Modules.size());
+            for (size_t i = 0; i < Modules.size(); ++i)
+                EXPECT_EQ(OptimizedModules[i], RefModules[i]) << "Module " << i;
+
+            EXPECT_EQ(Stats.NumOptimized, Modules.size());
+            EXPECT_EQ(Stats.NumFailed, 0u);
+            EXPECT_EQ(Stats.SrcSize, TotalSize);
+        }
+    }
+
+    GLSLangUtils::FinalizeGlslang();
+}
+
+TEST(SPIRVToolsTest, OptimizeSPIRVBatch_FailedModule)
+{
+    GLSLangUtils::InitializeGlslang();
+
+    auto Modules = CompileTestModules(4);
+
+    // Invalid magic number
+    Modules[2][0] = 0;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        SPIRVOptimizationStats Stats;
+
+        // The validator reports the invalid module
+        TestingEnvironment::SetErrorAllowance(1);
+        const auto OptimizedModules = OptimizeSPIRVBatch(Modules, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION, pPool, &Stats);
+        TestingEnvironment::SetErrorAllowance(0);
+
+        ASSERT_EQ(OptimizedModules.size(), Modules.size());
+        for (size_t i = 0; i < Modules.size(); ++i)
+        {
+            if (i == 2)
+                EXPECT_TRUE(OptimizedModules[i].empty());
+            else
+                EXPECT_FALSE(OptimizedModules[i].empty()) << "Module " << i;
+        }
+
+        EXPECT_EQ(Stats.NumOptimized, Modules.size() - 1);
+        EXPECT_EQ(Stats.NumFailed, 1u);
+    }
+
+    GLSLangUtils::FinalizeGlslang();
+}
+
+} // namespace
+
+#endif // !DILIGENT_NO_GLSLANG
@@ -25,11 +25,14 @@
  */
 
 #include <deque>
+#include <vector>
 
 #include "ShaderToolsCommon.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
 #include "RenderDevice.h"
 #include "TestingEnvironment.hpp"
+#include "TempDirectory.hpp"
+#include "FileWrapper.hpp"
 
 #include "gtest/gtest.h"
 
@@ -194,6 +197,111 @@ TEST(ShaderPreprocessTest, UnrollIncludes)
     }
 }
 
+TEST(ShaderPreprocessTest, IncludeCache)
+{
+    TempDirectory TmpDir;
+
+    auto WriteFile = [&](const char* Name, const std::string& Source) {
+        const auto  Path = TmpDir.Get() + FileSystem::SlashSymbol + Name;
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Source.data(), Source.size()));
+    };
+
+    WriteFile("Common0.hlsl", "// Common0\n");
+    WriteFile("Common1.hlsl", "// Common1\n");
+    WriteFile("Main.hlsl", "#include \"Common0.hlsl\"\n");
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory(TmpDir.Get().c_str(), &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.Name                  = "TestShader";
+    ShaderCI.FilePath                   = "Main.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    auto GetIncludes = [&]() {
+        std::vector<std::string> Includes;
+        EXPECT_TRUE(ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+            Includes.emplace_back(ProcessInfo.FilePath);
+        }));
+        return Includes;
+    };
+
+    auto CheckStats = [](size_t NumFiles, Uint64 NumHits, Uint64 NumMisses) {
+        const auto Stats = GetShaderIncludeCacheStatistics();
+        EXPECT_EQ(Stats.NumFiles, NumFiles);
+        EXPECT_EQ(Stats.NumHits, NumHits);
+        EXPECT_EQ(Stats.NumMisses, NumMisses);
+    };
+
+    ClearShaderIncludeCache();
+    CheckStats(0, 0, 0);
+
+    const std::vector<std::string> RefIncludes0{"Common0.hlsl", "Main.hlsl"};
+    EXPECT_EQ(GetIncludes(), RefIncludes0);
+    CheckStats(2, 0, 2);
+
+    // Cached include lists must be reused
+    EXPECT_EQ(GetIncludes(), RefIncludes0);
+    CheckStats(2, 2, 2);
+    EXPECT_EQ(UnrollShaderIncludes(ShaderCI), "// Common0\n\n");
+    CheckStats(2, 4, 2);
+
+    // Modified file must be re-scanned
+    WriteFile("Main.hlsl", "#include \"Common1.hlsl\"\n#include \"Common0.hlsl\"\n");
+
+    const std::vector<std::string> RefIncludes1{"Common1.hlsl", "Common0.hlsl", "Main.hlsl"};
+    EXPECT_EQ(GetIncludes(), RefIncludes1);
+    CheckStats(3, 5, 4);
+    EXPECT_EQ(UnrollShaderIncludes(ShaderCI), "// Common1\n\n// Common0\n\n");
+    CheckStats(3, 8, 4);
+
+    ClearShaderIncludeCache();
+    CheckStats(0, 0, 0);
+    EXPECT_EQ(GetIncludes(), RefIncludes1);
+    CheckStats(3, 0, 3);
+}
+
+TEST(ShaderPreprocessTest, BytecodeCacheKey)
+{
+    TempDirectory TmpDir;
+
+    auto WriteFile = [&](const char* Name, const std::string& Source) {
+        const auto  Path = TmpDir.Get() + FileSystem::SlashSymbol + Name;
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Source.data(), Source.size()));
+    };
+
+    WriteFile("Common.hlsl", "// Common0\n");
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory(TmpDir.Get().c_str(), &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.Name                  = "TestShader";
+    ShaderCI.Source                     = "#include \"Common.hlsl\"\n";
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    const auto Key0 = BuildBytecodeCacheKey("Compiler 1.0", ShaderCI);
+    EXPECT_EQ(Key0, "Compiler 1.0\n// Common0\n\n");
+
+    // The key must depend on the compiler info
+    EXPECT_NE(BuildBytecodeCacheKey("Compiler 1.1", ShaderCI), Key0);
+
+    // The key must depend on the included files
+    WriteFile("Common.hlsl", "// Common1\n");
+    EXPECT_NE(BuildBytecodeCacheKey("Compiler 1.0", ShaderCI), Key0);
+
+    // Missing include file
+    TestingEnvironment::ErrorScope ExpectedErrors{"Failed to load shader source file 'Missing.hlsl'", "Failed to create input stream for source file Missing.hlsl"};
+    ShaderCI.Source = "#include \"Missing.hlsl\"\n";
+    EXPECT_TRUE(BuildBytecodeCacheKey("Compiler 1.0", ShaderCI).empty());
+}
+
 TEST(ShaderPreprocessTest, ShaderSourceLanguageDefiniton)
 {
     EXPECT_EQ(ParseShaderSourceLanguageDefinition(""), SHADER_SOURCE_LANGUAGE_DEFAULT);
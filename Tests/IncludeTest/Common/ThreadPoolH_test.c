@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2019-2023 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DiligentCore/Common/interface/ThreadPool.h"
+
+void TestAsyncTask_CInterface(IAsyncTask* pTask)
+{
+    IAsyncTask_Run(pTask, 0);
+    IAsyncTask_Cancel(pTask);
+    IAsyncTask_SetStatus(pTask, ASYNC_TASK_STATUS_COMPLETE);
+    ASYNC_TASK_STATUS Status = IAsyncTask_GetStatus(pTask);
+    (void)Status;
+    IAsyncTask_SetPriority(pTask, 1.f);
+    float Priority = IAsyncTask_GetPriority(pTask);
+    (void)Priority;
+    bool IsFinished = IAsyncTask_IsFinished(pTask);
+    (void)IsFinished;
+    IAsyncTask_WaitForCompletion(pTask);
+    IAsyncTask_WaitUntilRunning(pTask);
+}
+
+void TestThreadPool_CInterface(IThreadPool* pThreadPool, IAsyncTask* pTask)
+{
+    IThreadPool_EnqueueTask(pThreadPool, pTask, (IAsyncTask**)NULL, 0);
+    bool Res = IThreadPool_ReprioritizeTask(pThreadPool, pTask);
+    IThreadPool_ReprioritizeAllTasks(pThreadPool);
+    Res = IThreadPool_RemoveTask(pThreadPool, pTask);
+    IThreadPool_WaitForAllTasks(pThreadPool);
+    Uint32 Count = IThreadPool_GetQueueSize(pThreadPool);
+    Count        = IThreadPool_GetRunningTaskCount(pThreadPool);
+    Count        = IThreadPool_GetNumThreads(pThreadPool);
+    (void)Count;
+    IThreadPool_StopThreads(pThreadPool);
+    Res = IThreadPool_ProcessTask(pThreadPool, 0, false);
+    (void)Res;
+}
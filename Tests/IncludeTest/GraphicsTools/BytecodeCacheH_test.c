@@ -29,7 +29,10 @@
 void TestBytecodeCacheCInterface()
 {
     BytecodeCacheCreateInfo CI;
-    CI.DeviceType = RENDER_DEVICE_TYPE_D3D11;
+    CI.DeviceType       = RENDER_DEVICE_TYPE_D3D11;
+    CI.DirectoryPath    = "BytecodeCache";
+    CI.MaxDirectorySize = 1024;
+    CI.MaxMemorySize    = 512;
 
     IBytecodeCache* pCache = NULL;
     Diligent_CreateBytecodeCache(&CI, &pCache);
@@ -37,6 +40,9 @@ void TestBytecodeCacheCInterface()
     IBytecodeCache_GetBytecode(pCache, (ShaderCreateInfo*)NULL, (IDataBlob**)NULL);
     IBytecodeCache_AddBytecode(pCache, (ShaderCreateInfo*)NULL, (IDataBlob*)NULL);
     IBytecodeCache_RemoveBytecode(pCache, (ShaderCreateInfo*)NULL);
+    IBytecodeCache_GetBytecodeByKey(pCache, (const void*)NULL, 0, (IDataBlob**)NULL);
+    IBytecodeCache_AddBytecodeByKey(pCache, (const void*)NULL, 0, (IDataBlob*)NULL);
+    IBytecodeCache_RemoveBytecodeByKey(pCache, (const void*)NULL, 0);
     IBytecodeCache_Store(pCache, (IDataBlob**)NULL);
     IBytecodeCache_Clear(pCache);
 }
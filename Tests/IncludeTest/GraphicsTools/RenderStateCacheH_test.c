@@ -29,7 +29,8 @@
 void TestRenderStateCacheCInterface()
 {
     RenderStateCacheCreateInfo CI;
-    CI.pDevice = NULL;
+    CI.pDevice         = NULL;
+    CI.JournalFilePath = "cache.journal";
 
     IRenderStateCache* pCache = NULL;
     Diligent_CreateRenderStateCache(&CI, &pCache);
@@ -49,4 +50,6 @@ void TestRenderStateCacheCInterface()
     IRenderStateCache_Reload(pCache, NULL, NULL);
     Uint32 Ver = IRenderStateCache_GetContentVersion(pCache);
     (void)Ver;
+    RenderStateCacheStats Stats = IRenderStateCache_GetStats(pCache);
+    (void)Stats;
 }